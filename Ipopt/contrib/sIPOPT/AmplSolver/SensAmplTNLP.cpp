@@ -153,6 +153,13 @@ namespace Ipopt
     ASL_pfgh* asl = AmplSolverObject();
 
     if (run_sens_) {
+      // With sens_scenario_batch, the solutions of all steps are in
+      // sens_sol_states, one after the other
+      const std::string sol_states_id = "sens_sol_states";
+      NumericMetaDataMapType::const_iterator var_states_it = var_numeric_md.find(sol_states_id);
+      NumericMetaDataMapType::const_iterator z_L_states_it = var_numeric_md.find(sol_states_id + "_z_L");
+      NumericMetaDataMapType::const_iterator z_U_states_it = var_numeric_md.find(sol_states_id + "_z_U");
+      NumericMetaDataMapType::const_iterator con_states_it = con_numeric_md.find(sol_states_id);
       for (Index step=1; step<=n_sens_steps_; ++step) {
 	std::string sol_state_id = "sens_sol_state_";
 	append_Index(sol_state_id, step);
@@ -161,20 +168,32 @@ namespace Ipopt
 	if (num_it!=var_numeric_md.end()) {
 	  suf_rput(sol_state_id.c_str(), ASL_Sufkind_var, const_cast<Number*>(&num_it->second[0]));
 	}
+	else if (var_states_it!=var_numeric_md.end() && (Index)var_states_it->second.size()==n*n_sens_steps_) {
+	  suf_rput(sol_state_id.c_str(), ASL_Sufkind_var, const_cast<Number*>(&var_states_it->second[(step-1)*n]));
+	}
 	std::string sol_state_z_L_id = sol_state_id + "_z_L";
 	num_it = var_numeric_md.find(sol_state_z_L_id);
 	if (num_it!=var_numeric_md.end()) {
 	  suf_rput(sol_state_z_L_id.c_str(), ASL_Sufkind_var, const_cast<Number*>(&num_it->second[0]));
 	}
+	else if (z_L_states_it!=var_numeric_md.end() && (Index)z_L_states_it->second.size()==n*n_sens_steps_) {
+	  suf_rput(sol_state_z_L_id.c_str(), ASL_Sufkind_var, const_cast<Number*>(&z_L_states_it->second[(step-1)*n]));
+	}
 	std::string sol_state_z_U_id = sol_state_id + "_z_U";
 	num_it = var_numeric_md.find(sol_state_z_U_id);
 	if (num_it!=var_numeric_md.end()) {
 	  suf_rput(sol_state_z_U_id.c_str(), ASL_Sufkind_var, const_cast<Number*>(&num_it->second[0]));
 	}
+	else if (z_U_states_it!=var_numeric_md.end() && (Index)z_U_states_it->second.size()==n*n_sens_steps_) {
+	  suf_rput(sol_state_z_U_id.c_str(), ASL_Sufkind_var, const_cast<Number*>(&z_U_states_it->second[(step-1)*n]));
+	}
 	num_it = con_numeric_md.find(sol_state_id);
 	if (num_it!=con_numeric_md.end()) {
 	  suf_rput(sol_state_id.c_str(), ASL_Sufkind_con, const_cast<Number*>(&num_it->second[0]));
 	}
+	else if (con_states_it!=con_numeric_md.end() && (Index)con_states_it->second.size()==m*n_sens_steps_) {
+	  suf_rput(sol_state_id.c_str(), ASL_Sufkind_con, const_cast<Number*>(&con_states_it->second[(step-1)*m]));
+	}
       }
     }
   }
@@ -105,6 +105,9 @@ int main(int argv, char**argc)
   ampl_options_list->AddAmplOption("sens_boundcheck", "sens_boundcheck",
 				   AmplOptionsList::String_Option,
 				   "Set to yes to enable the fix-relax QP adaption to a possible bound check. This feature is experimental.");
+  ampl_options_list->AddAmplOption("sens_scenario_batch", "sens_scenario_batch",
+				   AmplOptionsList::String_Option,
+				   "Set to yes to compute all sensitivity steps together.");
   ampl_options_list->AddAmplOption("n_sens_steps", "n_sens_steps",
 				   AmplOptionsList::Integer_Option,
 				   "Number of sensitivity steps");
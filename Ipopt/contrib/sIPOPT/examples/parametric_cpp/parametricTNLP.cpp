@@ -257,7 +257,15 @@ void ParametricTNLP::finalize_solution(SolverReturn status,
   std::string state;
   std::vector<Number> sens_sol_vec;
   state = "sens_sol_state_1";
-  sens_sol_vec = x_owner_space->GetNumericMetaData(state.c_str());
+  if (x_owner_space->HasNumericMetaData(state.c_str())) {
+    sens_sol_vec = x_owner_space->GetNumericMetaData(state.c_str());
+  }
+  else if (x_owner_space->HasNumericMetaData("sens_sol_states")) {
+    // with sens_scenario_batch, the solutions of all steps are stored
+    // one after the other
+    const std::vector<Number>& sens_sol_states = x_owner_space->GetNumericMetaData("sens_sol_states");
+    sens_sol_vec.assign(sens_sol_states.begin(), sens_sol_states.begin()+x_owner_space->Dim());
+  }
 
   // Print the solution vector
   printf("\n"
@@ -280,6 +288,12 @@ void ParametricTNLP::finalize_metadata(Index n,
   printf("\nDual bound multipliers:\n");
   NumericMetaDataMapType::const_iterator z_L_solution = var_numeric_md.find("sens_sol_state_1_z_L");
   NumericMetaDataMapType::const_iterator z_U_solution = var_numeric_md.find("sens_sol_state_1_z_U");
+  if (z_L_solution==var_numeric_md.end() || z_U_solution==var_numeric_md.end()) {
+    // with sens_scenario_batch, the multipliers of all steps are
+    // stored one after the other, starting with the first step
+    z_L_solution = var_numeric_md.find("sens_sol_states_z_L");
+    z_U_solution = var_numeric_md.find("sens_sol_states_z_U");
+  }
   if (z_L_solution!=var_numeric_md.end() && z_U_solution!=var_numeric_md.end()) {
     for (Index k=0; k<n; ++k) {
       printf("z_L[%d] = %f      z_U[%d] = %f\n", k, z_L_solution->second[k], k, z_U_solution->second[k]);
@@ -289,6 +303,9 @@ void ParametricTNLP::finalize_metadata(Index n,
   // constraint mutlipliers
   printf("\nConstraint multipliers:\n");
   NumericMetaDataMapType::const_iterator lambda_solution = con_numeric_md.find("sens_sol_state_1");
+  if (lambda_solution==con_numeric_md.end()) {
+    lambda_solution = con_numeric_md.find("sens_sol_states");
+  }
   if (lambda_solution!=con_numeric_md.end()) {
     for (Index k=0; k<m; ++k) {
       printf("lambda[%d] = %f\n", k, lambda_solution->second[k]);
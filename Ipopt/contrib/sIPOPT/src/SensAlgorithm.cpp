@@ -22,7 +22,8 @@ namespace Ipopt
     driver_vec_(driver_vec),
     sens_step_calc_(sens_step_calc),
     measurement_(measurement),
-    n_sens_steps_(n_sens_steps) // why doesn't he get this from the options?
+    n_sens_steps_(n_sens_steps), // why doesn't he get this from the options?
+    scenario_batch_(false)
   {
     DBG_START_METH("SensAlgorithm::SensAlgorithm", dbg_verbosity);
 
@@ -37,6 +38,7 @@ namespace Ipopt
   bool SensAlgorithm::InitializeImpl(const OptionsList& options,
 				     const std::string& prefix)
   {
+    options.GetBoolValue("sens_scenario_batch", scenario_batch_, prefix);
     return true;
   }
 
@@ -49,6 +51,10 @@ namespace Ipopt
 
     SensAlgorithmExitStatus retval = SOLVE_SUCCESS;
 
+    if (scenario_batch_) {
+      return RunBatch();
+    }
+
     /* Loop through all steps */
     SmartPtr<IteratesVector> sol = IpData().curr()->MakeNewIteratesVector();
     SmartPtr<DenseVector> delta_u;
@@ -105,4 +111,35 @@ namespace Ipopt
     return retval;
   }
 
+  /** All steps are computed together by the step calculator, and
+   *  the solutions are handed to the measurement at once. */
+  SensAlgorithmExitStatus SensAlgorithm::RunBatch()
+  {
+    DBG_START_METH("SensAlgorithm::RunBatch", dbg_verbosity);
+
+    SensAlgorithmExitStatus retval = SOLVE_SUCCESS;
+
+    std::vector<SmartPtr<DenseVector> > delta_u(n_sens_steps_);
+    std::vector<SmartPtr<IteratesVector> > sol(n_sens_steps_);
+    for (Index step_i=0; step_i<n_sens_steps_; ++step_i) {
+      delta_u[step_i] = measurement_->GetMeasurement(step_i+1);
+      delta_u[step_i]->Print(Jnlst(),J_VECTOR,J_USER1,"delta_u");
+      sol[step_i] = IpData().curr()->MakeNewIteratesVector();
+    }
+
+    sens_step_calc_->MultiStep(delta_u, sol, driver_vec_);
+
+    SmartPtr<const Vector> unscaled_x;
+    for (Index step_i=0; step_i<n_sens_steps_; ++step_i) {
+      sol[step_i]->Print(Jnlst(),J_VECTOR,J_USER1,"sol_vec");
+      // unscale solution...
+      unscaled_x = IpNLP().NLP_scaling()->unapply_vector_scaling_x(sol[step_i]->x());
+      DBG_ASSERT(IsValid(unscaled_x));
+      sol[step_i]->Set_x(*unscaled_x);
+    }
+    measurement_->SetSolutions(sol);
+
+    return retval;
+  }
+
 }
@@ -40,10 +40,14 @@ namespace Ipopt
 
   private:
 
+    /** Computes all steps together (option sens_scenario_batch) */
+    SensAlgorithmExitStatus RunBatch();
+
     std::vector< SmartPtr<SchurDriver> > driver_vec_;
     SmartPtr<SensitivityStepCalculator> sens_step_calc_;
     SmartPtr<Measurement> measurement_;
     Index n_sens_steps_; // I think it is useful to state this number explicitly in the constructor and here.
+    bool scenario_batch_;
 
   };
 }
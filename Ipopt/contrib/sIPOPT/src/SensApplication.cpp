@@ -51,6 +51,15 @@ namespace Ipopt
 					   "n_sens_steps", "Number of steps computed by sIPOPT",
 					   0, 1,
 					   "");
+    roptions->AddLowerBoundedIntegerOption(
+					   "sens_p_block_size",
+					   "Number of columns of the Schur complement data computed together",
+					   1, 64,
+					   "The columns of P = K^(-1)*A for the Schur complement are computed in "
+					   "blocks of this many columns, each with one back-solve for all of its right "
+					   "hand sides.  Larger blocks make better use of the multi-right hand side "
+					   "solves of the linear solver, but need memory for this many full iterate "
+					   "vectors.");
     roptions->AddStringOption2(
 			       "sens_boundcheck",
 			       "Activate boundcheck and re-solve for sIPOPT",
@@ -58,6 +67,24 @@ namespace Ipopt
 			       "no", "don't check bounds and do another SchurSolve",
 			       "yes", "check bounds and resolve Schur decomposition",
 			       "If this option is activated, the algorithm will check the iterate after an initilal Schursolve and will resolve the decomposition if any bounds are not satisfied");
+    roptions->AddStringOption2(
+			       "sens_scenario_batch",
+			       "Compute all sensitivity steps together",
+			       "no",
+			       "no", "compute the steps one after the other",
+			       "yes", "compute all steps together",
+			       "If this option is activated, the steps for all n_sens_steps perturbations "
+			       "are computed together: the initial steps with one back-solve for all "
+			       "right hand sides, and the Schur complement data for the initial bound "
+			       "violations of all steps (see sens_boundcheck) at once.  The solutions "
+			       "are returned in one array per quantity instead of sens_sol_state_1, "
+			       "sens_sol_state_2, ...: the variable metadata sens_sol_states holds the "
+			       "primal solutions of all steps one after the other, that is, n values for "
+			       "step 1, then n values for step 2, and so on; sens_sol_states_z_L and "
+			       "sens_sol_states_z_U hold the bound multipliers in the same layout, and "
+			       "the constraint metadata sens_sol_states holds the m constraint "
+			       "multipliers of each step one after the other.  In the AMPL interface, "
+			       "these arrays are split into the suffixes sens_sol_state_1, ...");
     roptions->AddLowerBoundedNumberOption(
 					  "sens_bound_eps",
 					  "Bound accuracy within which a bound still is considered to be valid",
@@ -117,6 +144,44 @@ namespace Ipopt
 			       "yes", "compute eigenvalue decomposition of reduced hessian",
 			       "no", "don't compute eigenvalue decomposition of reduced hessian",
 			       "The eigenvalue decomposition of the reduced hessian has different meanings depending on the specific problem. For parameter estimation problems, the eigenvalues are linked to the confidence interval of the parameters. See for example Victor Zavala's Phd thesis, chapter 4 for details.");
+    roptions->AddStringOption1(
+			       "rh_output_file",
+			       "File to which the reduced hessian is written",
+			       "",
+			       "*", "Any acceptable standard file name",
+			       "If this is not empty, the columns of the reduced hessian (or the eigenpairs of its "
+			       "randomized approximation, see rh_sketch_rank) are written to this binary file as "
+			       "they are computed, instead of being printed.  The file starts with the 8 characters "
+			       "IPOPTRH1 and the integers kind (0 for columns, 1 for eigenpairs), n and m.  For "
+			       "kind 0, the m indices of the columns follow, for kind 1 the m eigenvalues; then the "
+			       "m vectors with n entries each.  All numbers are in native byte order.");
+    roptions->AddLowerBoundedIntegerOption(
+					   "rh_column_start",
+					   "First column of the reduced hessian that is computed",
+					   0, 0,
+					   "Together with rh_num_columns, this allows to compute only a part of the "
+					   "reduced hessian, or to split its computation over several runs.");
+    roptions->AddLowerBoundedIntegerOption(
+					   "rh_num_columns",
+					   "Number of columns of the reduced hessian that are computed",
+					   0, 0,
+					   "If this is 0, all columns from rh_column_start on are computed.  The "
+					   "columns are computed in blocks of sens_p_block_size columns, and only one "
+					   "block is kept in memory (unless rh_eigendecomp is chosen).");
+    roptions->AddLowerBoundedIntegerOption(
+					   "rh_sketch_rank",
+					   "Rank of a randomized approximation of the reduced hessian",
+					   0, 0,
+					   "If this is positive, the reduced hessian is not computed explicitly.  "
+					   "Instead, the largest eigenvalues and the corresponding eigenvectors are "
+					   "approximated by a randomized range finder, which needs "
+					   "2*(rh_sketch_rank+rh_sketch_oversampling) back-solves.");
+    roptions->AddLowerBoundedIntegerOption(
+					   "rh_sketch_oversampling",
+					   "Oversampling of the randomized approximation of the reduced hessian",
+					   0, 10,
+					   "Number of random directions in addition to rh_sketch_rank.  More "
+					   "oversampling gives more accurate eigenpairs.");
     roptions->AddStringOption2(
 			       "sens_allow_inexact_backsolve",
 			       "Allow inexact computation of backsolve in sIPOPT.",
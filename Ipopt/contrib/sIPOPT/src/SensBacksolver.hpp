@@ -10,6 +10,7 @@
 
 #include "IpAlgStrategy.hpp"
 #include "IpIteratesVector.hpp"
+#include <vector>
 
 namespace Ipopt
 {
@@ -30,6 +31,19 @@ namespace Ipopt
 
     virtual bool Solve(SmartPtr<IteratesVector> delta_lhs, SmartPtr<const IteratesVector> delta_rhs)=0;
 
+    /** Solve for several right hand sides with the same matrix.  The
+     *  default implementation calls Solve for each of them; backsolvers
+     *  that can do the solves together should overload this. */
+    virtual bool MultiSolve(std::vector<SmartPtr<IteratesVector> >& delta_lhsV,
+                            const std::vector<SmartPtr<const IteratesVector> >& delta_rhsV)
+    {
+      bool retval = true;
+      for (Index i=0; i<(Index)delta_rhsV.size() && retval; ++i) {
+        retval = Solve(delta_lhsV[i], delta_rhsV[i]);
+      }
+      return retval;
+    }
+
   };
 
 }
@@ -179,8 +179,8 @@ namespace Ipopt
 				    prefix);
     DBG_ASSERT(retval);
 
-    retval = pcalc->ComputeP();
-
+    // P is computed in ComputeReducedHessian, since it is not needed
+    // for the blocked and the randomized reduced hessian
     SmartPtr<ReducedHessianCalculator> red_hess_calc = new ReducedHessianCalculator(E_0, pcalc);
 
     retval = red_hess_calc->Initialize(jnlst,
@@ -22,7 +22,8 @@ namespace Ipopt
     :
     PCalculator(backsolver, A_data),
     nrows_(0),
-    ncols_(A_data->GetNRowsAdded())
+    ncols_(A_data->GetNRowsAdded()),
+    block_size_(1)
   {
     DBG_START_METH("IndexPCalculator::IndexPCalculator", dbg_verbosity);
   }
@@ -37,6 +38,8 @@ namespace Ipopt
   {
     DBG_START_METH("IndexPCalculator::InitializeImpl", dbg_verbosity);
 
+    options.GetIntegerValue("sens_p_block_size", block_size_, prefix);
+
     SmartPtr<const IteratesVector> iv = IpData().curr();
     nrows_ = 0;
     for (Index i=0; i<iv->NComps(); ++i) {
@@ -54,42 +57,76 @@ namespace Ipopt
 
     // 1. check whether all columns needed by data_A() are in map cols_ - we suppose data_A is IndexSchurData
     const std::vector<Index>* p2col_idx = dynamic_cast<const IndexSchurData*>(GetRawPtr(data_A()))->GetColIndices();
-    Index col;
-    Number* col_values = NULL;
-    Index curr_dim, curr_schur_row=0;
-    SmartPtr<const DenseVector> comp_vec;
-    const Number* comp_values;
-    std::map< Index, SmartPtr<PColumn> >::iterator find_it;
-    SmartPtr<IteratesVector> col_vec = IpData().curr()->MakeNewIteratesVector();
-    SmartPtr<IteratesVector> sol_vec = col_vec->MakeNewIteratesVector();
+
+    // 2. collect the columns that are not yet in the P-matrix, together
+    //    with the rows of data_A() that define them
+    const Index first_new = (Index)cols_.size();
+    std::vector<Index> new_cols;
+    std::vector<Index> new_cols_schur_row;
+    Index curr_schur_row = 0;
     for (std::vector<Index>::const_iterator col_it=p2col_idx->begin(); col_it!=p2col_idx->end(); ++col_it){
-      col = *col_it;
-
-      find_it = cols_.find(col);
-      if (find_it==cols_.end()) {
-	// column is in data_A but not in P-matrix ->create
-	data_A()->GetRow(curr_schur_row, *col_vec);
-	retval = Solver()->Solve(sol_vec, ConstPtr(col_vec));
-	DBG_ASSERT(retval);
-
-	/* This part is for displaying norm2(I_z*K^(-1)*I_1) */
-	DBG_PRINT((dbg_verbosity,"\ncurr_schur_row=%d, ",curr_schur_row));
-	DBG_PRINT((dbg_verbosity,"norm2(z)=%23.16e\n",sol_vec->x()->Nrm2()));
-	/* end displaying norm2 */
-
-	DBG_ASSERT(col_values== NULL);
-	col_values = new Number[nrows_];
-	curr_dim = 0;
-	for (Index j=0; j<sol_vec->NComps(); ++j) {
-	  comp_vec = dynamic_cast<const DenseVector*>(GetRawPtr(sol_vec->GetComp(j)));
-	  comp_values = comp_vec->Values();
-	  IpBlasDcopy(comp_vec->Dim(), comp_values, 1, col_values+curr_dim,1);
+      const Index col = *col_it;
+      if (cols_.find(col)==cols_.end()) {
+	// column is in data_A but not in P-matrix -> reserve its place
+	cols_[col] = first_new + (Index)new_cols.size();
+	new_cols.push_back(col);
+	new_cols_schur_row.push_back(curr_schur_row);
+      }
+      curr_schur_row++;
+    }
+    if (new_cols.empty()) {
+      return retval;
+    }
+    P_values_.resize(cols_.size()*nrows_);
+
+    // 3. compute the new columns in blocks of block_size_ columns, each
+    //    with one back-solve for all of its right hand sides, and store
+    //    them in P_values_
+    const Index n_new = (Index)new_cols.size();
+    for (Index block_start=0; block_start<n_new && retval; block_start+=block_size_) {
+      const Index block_end = Min(n_new, block_start+block_size_);
+      std::vector<SmartPtr<const IteratesVector> > rhsV;
+      std::vector<SmartPtr<IteratesVector> > solV;
+      for (Index k=block_start; k<block_end; ++k) {
+	SmartPtr<IteratesVector> col_vec = IpData().curr()->MakeNewIteratesVector();
+	data_A()->GetRow(new_cols_schur_row[k], *col_vec);
+	rhsV.push_back(ConstPtr(col_vec));
+	solV.push_back(col_vec->MakeNewIteratesVector());
+      }
+
+      retval = Solver()->MultiSolve(solV, rhsV);
+      DBG_ASSERT(retval);
+
+      const Index nblock = block_end-block_start;
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if(nblock>1)
+#endif
+      for (Index k=0; k<nblock; ++k) {
+	const IteratesVector& sol_vec = *solV[k];
+	Number* col_values = &P_values_[(first_new+block_start+k)*nrows_];
+	Index curr_dim = 0;
+	for (Index j=0; j<sol_vec.NComps(); ++j) {
+	  const DenseVector* comp_vec = static_cast<const DenseVector*>(GetRawPtr(sol_vec.GetComp(j)));
+	  DBG_ASSERT(dynamic_cast<const DenseVector*>(GetRawPtr(sol_vec.GetComp(j))));
+	  if (comp_vec->IsHomogeneous()) {
+	    const Number scalar = comp_vec->Scalar();
+	    for (Index i=0; i<comp_vec->Dim(); ++i) {
+	      col_values[curr_dim+i] = scalar;
+	    }
+	  }
+	  else {
+	    IpBlasDcopy(comp_vec->Dim(), comp_vec->Values(), 1, col_values+curr_dim, 1);
+	  }
 	  curr_dim += comp_vec->Dim();
 	}
-	cols_[col] = new PColumn(nrows_, col_values);
-	col_values = NULL;
       }
-      curr_schur_row++;
+
+      /* This part is for displaying norm2(I_z*K^(-1)*I_1) */
+      DBG_DO(for (Index k=0; k<nblock; ++k) {
+	DBG_PRINT((dbg_verbosity,"\ncolumn=%d, ",new_cols[block_start+k]));
+	DBG_PRINT((dbg_verbosity,"norm2(z)=%23.16e\n",solV[k]->x()->Nrm2()));
+      });
+      /* end displaying norm2 */
     }
 
     return retval;
@@ -145,10 +182,20 @@ namespace Ipopt
     // Compute S = B^T*P from indices, factors and P
     const std::vector<Index>* data_A_idx = dynamic_cast<const IndexSchurData*>(GetRawPtr(data_A()))->GetColIndices();
     const std::vector<Index>* data_B_idx = dynamic_cast<const IndexSchurData*>(GetRawPtr(B))->GetColIndices();
-    Index col_count = 0;
-    for (std::vector<Index>::const_iterator a_it=data_A_idx->begin(); a_it!=data_A_idx->end(); ++a_it) {
-      cols_[*a_it]->GetSchurMatrixRows(data_B_idx, S_values+col_count*ncols_);
-      col_count++;
+    const Index n_A = (Index)data_A_idx->size();
+    const Index n_B = (Index)data_B_idx->size();
+    std::vector<const Number*> P_cols(n_A);
+    for (Index col_count=0; col_count<n_A; ++col_count) {
+      P_cols[col_count] = &P_values_[cols_[(*data_A_idx)[col_count]]*nrows_];
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(n_A*n_B>10000)
+#endif
+    for (Index col_count=0; col_count<n_A; ++col_count) {
+      Number* S_col = S_values+col_count*ncols_;
+      for (Index i=0; i<n_B; ++i) {
+	S_col[i] = -P_cols[col_count][(*data_B_idx)[i]];
+      }
     }
     return retval;
   }
@@ -162,13 +209,12 @@ namespace Ipopt
   {
     DBG_START_METH("IndexPCalculator::PrintImpl", dbg_verbosity);
 
-    const Number* col_val;
     jnlst.PrintfIndented(level, category, indent,
                          "%sIndexPCalculator \"%s\" with %d rows and %d columns:\n",
                          prefix.c_str(), name.c_str(), nrows_, ncols_ );
     Index col_counter = 0;
-    for (std::map< Index, SmartPtr<PColumn> >::const_iterator j=cols_.begin(); j!=cols_.end(); ++j) {
-      col_val = j->second->Values();
+    for (std::map<Index, Index>::const_iterator j=cols_.begin(); j!=cols_.end(); ++j) {
+      const Number* col_val = &P_values_[j->second*nrows_];
       for (Index i=0; i<nrows_; ++i) {
 	jnlst.PrintfIndented(level, category, indent,
 			     "%s%s[%5d,%5d]=%23.16e\n",
@@ -177,33 +223,4 @@ namespace Ipopt
       col_counter++;
     }
   }
-
-  PColumn::PColumn(Index nrows, Number* values)
-    :
-    nrows_(nrows),
-    val_(values)
-  {
-    DBG_START_METH("PColumn::PColumn", dbg_verbosity);
-  }
-
-  PColumn::~PColumn()
-  {
-    DBG_START_METH("PColumn::~PColumn", dbg_verbosity);
-    delete[] val_;
-  }
-
-  void PColumn::GetSchurMatrixRows(const std::vector<Index>* row_idx_B, Number* S_col) const
-  {
-    DBG_START_METH("PColumn::GetSchurMatrixRows", dbg_verbosity);
-
-    for (Index i=0; i<row_idx_B->size(); ++i) {
-      S_col[i] = -val_[(*row_idx_B)[i]];
-    }
-  }
-
-  const Number* PColumn::Values() const
-  {
-    DBG_START_METH("PColumn::Values", dbg_verbosity);
-    return val_;
-  }
 }
@@ -9,11 +9,11 @@
 
 #include "SensPCalculator.hpp"
 
+#include <map>
+#include <vector>
+
 namespace Ipopt
 {
-  /* Forward declarations */
-  class PColumn;
-
   class IndexPCalculator : public PCalculator
   {
     /** This class is the implementation of the PCalculator that corresponds
@@ -49,28 +49,16 @@ namespace Ipopt
     /** Cols of P */
     Index ncols_;
 
-    std::map< Index, SmartPtr<PColumn> > cols_;
-
-  };
-
-  class PColumn : public ReferencedObject
-  {
-    /** This class provides an easy interface for PCalculators with data where columns are
-     *  not necessarily in adjacent parts of memory. */
-
-  public:
-    PColumn(Index nrows, Number* values);
-
-    virtual ~PColumn();
+    /** Number of columns of P that are computed with one back-solve */
+    Index block_size_;
 
-    virtual void GetSchurMatrixRows(const std::vector<Index>* row_idx_B, Number* S) const;
+    /** Values of the columns of P that have been computed, stored
+     *  column by column (nrows_ values per column) in one array */
+    std::vector<Number> P_values_;
 
-    virtual const Number* Values() const;
+    /** Position of the columns in P_values_ for each KKT column */
+    std::map<Index, Index> cols_;
 
-  private:
-
-    Index nrows_;
-    Number* val_;
   };
 
 }
@@ -40,6 +40,16 @@ namespace Ipopt
 
     /** This function does whatever the measurement machine does with the solution of the SensAlgorithm */
     virtual void SetSolution(Index measurement_number, SmartPtr<IteratesVector> sol) =0;
+
+    /** This function does whatever the measurement machine does with the solutions of
+     *  all steps of the SensAlgorithm, where sol[i] belongs to measurement number i+1.
+     *  The default implementation calls SetSolution for each of them. */
+    virtual void SetSolutions(const std::vector<SmartPtr<IteratesVector> >& sol)
+    {
+      for (Index i=0; i<(Index)sol.size(); ++i) {
+	SetSolution(i+1, sol[i]);
+      }
+    }
   };
 }
 
@@ -7,6 +7,7 @@
 #include "SensMetadataMeasurement.hpp"
 #include "SensUtils.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace Ipopt
@@ -160,6 +161,41 @@ namespace Ipopt
     z_U_owner_space_nonconst->SetNumericMetaData(sens_sol, z_U_sol);
   }
 
+  void MetadataMeasurement::SetSolutions(const std::vector<SmartPtr<IteratesVector> >& sol)
+  {
+    DBG_START_METH("MetadataMeasurement::SetSolutions", dbg_verbosity);
+
+    const std::string sens_sol = "sens_sol_states";
+    const Index n_steps = (Index)sol.size();
+
+    // components x, s, y_c, y_d, z_L, z_U of the IteratesVector
+    const Index n_comps = 6;
+    const DenseVectorSpace* owner_space[n_comps] = {
+      GetRawPtr(x_owner_space_), GetRawPtr(s_owner_space_),
+      GetRawPtr(y_c_owner_space_), GetRawPtr(y_d_owner_space_),
+      GetRawPtr(z_L_owner_space_), GetRawPtr(z_U_owner_space_)
+    };
+    for (Index j=0; j<n_comps; ++j) {
+      if (!owner_space[j]) {
+	continue;
+      }
+      const Index dim = owner_space[j]->Dim();
+      std::vector<Number> all_sol(dim*n_steps);
+      bool is_dense = true;
+      for (Index i=0; i<n_steps && is_dense; ++i) {
+	SmartPtr<const DenseVector> comp = dynamic_cast<const DenseVector*>(GetRawPtr(sol[i]->GetComp(j)));
+	is_dense = IsValid(comp);
+	if (is_dense && dim>0) {
+	  const Number* comp_val = comp->ExpandedValues();
+	  std::copy(comp_val, comp_val+dim, all_sol.begin()+i*dim);
+	}
+      }
+      if (is_dense) {
+	const_cast<DenseVectorSpace*>(owner_space[j])->SetNumericMetaData(sens_sol, all_sol);
+      }
+    }
+  }
+
   std::vector<Index> MetadataMeasurement::GetIntegerSuffix(std::string suffix_string)
   {
     DBG_START_METH("MetadataMeasurement::GetIntegerSuffix", dbg_verbosity);
@@ -33,6 +33,10 @@ namespace Ipopt
 
     virtual void SetSolution(Index measurement_number, SmartPtr<IteratesVector> sol);
 
+    /** Stores the solutions of all steps in the metadata "sens_sol_states" of the
+     *  owner spaces, one after the other (that is, with Dim()*sol.size() values). */
+    virtual void SetSolutions(const std::vector<SmartPtr<IteratesVector> >& sol);
+
     /** suffix handler methods */
 
     virtual std::vector<Index> GetIntegerSuffix(std::string suffix_string);
@@ -6,6 +6,10 @@
 
 #include "SensReducedHessianCalculator.hpp"
 #include "IpDenseGenMatrix.hpp"
+#include "IpDenseSymMatrix.hpp"
+#include "IpDenseVector.hpp"
+#include "IpBlas.hpp"
+#include "IpLapack.hpp"
 
 namespace Ipopt
 {
@@ -32,6 +36,12 @@ namespace Ipopt
   {
     DBG_START_METH("ReducedHessianCalculator::InitializeImpl", dbg_verbosity);
     options.GetBoolValue("rh_eigendecomp", compute_eigenvalues_, prefix);
+    options.GetStringValue("rh_output_file", output_file_, prefix);
+    options.GetIntegerValue("rh_column_start", column_start_, prefix);
+    options.GetIntegerValue("rh_num_columns", num_columns_, prefix);
+    options.GetIntegerValue("rh_sketch_rank", sketch_rank_, prefix);
+    options.GetIntegerValue("rh_sketch_oversampling", sketch_oversampling_, prefix);
+    options.GetIntegerValue("sens_p_block_size", block_size_, prefix);
     return true;
   }
 
@@ -39,11 +49,19 @@ namespace Ipopt
   {
     DBG_START_METH("ReducedHessianCalculator::ComputeReducedHessian", dbg_verbosity);
 
+    if (sketch_rank_ > 0) {
+      return ComputeReducedHessianSketch();
+    }
+    if (!output_file_.empty() || column_start_ > 0 || num_columns_ > 0) {
+      return ComputeReducedHessianBlocked();
+    }
+
     Index dim_S = hess_data_->GetNRowsAdded();
     //SmartPtr<DenseGenMatrixSpace> S_space = new DenseGenMatrixSpace(dim_S, dim_S);
     //SmartPtr<DenseGenMatrix> S = new DenseGenMatrix(GetRawPtr(S_space));
+    bool retval = pcalc_->ComputeP();
     SmartPtr<Matrix> S;
-    bool retval = pcalc_->GetSchurMatrix(GetRawPtr(hess_data_), S);
+    retval = pcalc_->GetSchurMatrix(GetRawPtr(hess_data_), S) && retval;
 
     SmartPtr<DenseSymMatrix> S_sym = dynamic_cast<DenseSymMatrix*>(GetRawPtr(S));
     if (!IsValid(S_sym)) {
@@ -51,6 +69,345 @@ namespace Ipopt
       throw (exc);
     }
 
+    PrintScalingWarning();
+
+    // Unscale by objective factor and multiply by (-1)
+    Number obj_scal = IpNLP().NLP_scaling()->apply_obj_scaling(1.0);
+    DBG_PRINT((dbg_verbosity, "Objective scaling = %f\n", obj_scal));
+    Number* s_val = S_sym->Values();
+    for (Index k=0; k<(S->NRows())*(S->NCols()); ++k) {
+      s_val[k] *= -obj_scal;
+    }
+
+    S->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"RedHessian unscaled");
+
+    if ( compute_eigenvalues_ ) {
+      SmartPtr<DenseGenMatrixSpace> eigenvectorspace = new DenseGenMatrixSpace(dim_S, dim_S);
+      SmartPtr<DenseGenMatrix> eigenvectors = new DenseGenMatrix(GetRawPtr(eigenvectorspace));
+      SmartPtr<DenseVectorSpace> eigenvaluesspace = new DenseVectorSpace(dim_S);
+      SmartPtr<DenseVector> eigenvalues = new DenseVector(GetRawPtr(eigenvaluesspace));
+
+      eigenvectors->ComputeEigenVectors(*S_sym, *eigenvalues);
+      eigenvalues->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"Eigenvalues of reduced hessian matrix");
+    }
+
+    return retval;
+  }
+
+  bool ReducedHessianCalculator::ComputeReducedHessianBlocked()
+  {
+    DBG_START_METH("ReducedHessianCalculator::ComputeReducedHessianBlocked", dbg_verbosity);
+
+    const Index dim_S = hess_data_->GetNRowsAdded();
+    const Index first_col = Min(column_start_, dim_S);
+    Index ncols = dim_S-first_col;
+    if (num_columns_ > 0) {
+      ncols = Min(ncols, num_columns_);
+    }
+
+    PrintScalingWarning();
+    const Number obj_scal = IpNLP().NLP_scaling()->apply_obj_scaling(1.0);
+
+    FILE* fp = NULL;
+    if (!output_file_.empty()) {
+      fp = OpenOutputFile(0, dim_S, ncols);
+      if (!fp) {
+        return false;
+      }
+      for (Index j=0; j<ncols; ++j) {
+        const int col = first_col+j;
+        fwrite(&col, sizeof(int), 1, fp);
+      }
+    }
+
+    // The whole matrix is only kept for the eigenvalue decomposition
+    SmartPtr<DenseSymMatrix> S_sym;
+    if (compute_eigenvalues_) {
+      if (ncols == dim_S) {
+        SmartPtr<DenseSymMatrixSpace> S_space = new DenseSymMatrixSpace(dim_S);
+        S_sym = new DenseSymMatrix(GetRawPtr(S_space));
+      }
+      else {
+        Jnlst().Printf(J_WARNING, J_MAIN,
+                       "The eigenvalues of the reduced hessian are only computed if all of its columns are computed.\n");
+      }
+    }
+    else if (!fp) {
+      Jnlst().Printf(J_INSUPPRESSIBLE, J_USER1,
+                     "\nColumns %d to %d of the reduced hessian (dimension %d):\n",
+                     first_col, first_col+ncols-1, dim_S);
+    }
+
+    bool retval = true;
+    std::vector<Number> S_cols(dim_S*Min(block_size_, Max(ncols, 1)));
+    for (Index block_start=0; block_start<ncols && retval; block_start+=block_size_) {
+      const Index nblock = Min(block_size_, ncols-block_start);
+      std::vector<SmartPtr<const IteratesVector> > rhsV(nblock);
+      for (Index k=0; k<nblock; ++k) {
+        SmartPtr<IteratesVector> col_vec = IpData().curr()->MakeNewIteratesVector();
+        hess_data_->GetRow(first_col+block_start+k, *col_vec);
+        rhsV[k] = ConstPtr(col_vec);
+      }
+      retval = SolveBlock(rhsV, obj_scal, &S_cols[0]);
+      if (!retval) {
+        break;
+      }
+
+      // Stream the columns of the block
+      if (fp) {
+        fwrite(&S_cols[0], sizeof(Number), dim_S*nblock, fp);
+        fflush(fp);
+      }
+      if (IsValid(S_sym)) {
+        Number* s_val = S_sym->Values();
+        for (Index k=0; k<nblock; ++k) {
+          IpBlasDcopy(dim_S, &S_cols[k*dim_S], 1,
+                      s_val+(first_col+block_start+k)*dim_S, 1);
+        }
+      }
+      else if (!fp) {
+        for (Index k=0; k<nblock; ++k) {
+          for (Index i=0; i<dim_S; ++i) {
+            Jnlst().Printf(J_INSUPPRESSIBLE, J_USER1,
+                           "RedHessian unscaled[%5d,%5d]=%23.16e\n",
+                           i, first_col+block_start+k, S_cols[k*dim_S+i]);
+          }
+        }
+      }
+    }
+    if (fp) {
+      fclose(fp);
+      if (retval) {
+        Jnlst().Printf(J_SUMMARY, J_MAIN,
+                       "Wrote %d columns of the reduced hessian to %s.\n",
+                       ncols, output_file_.c_str());
+      }
+    }
+    if (!retval) {
+      Jnlst().Printf(J_ERROR, J_MAIN,
+                     "Solving the KKT systems for the reduced hessian failed.\n");
+      return false;
+    }
+
+    if (IsValid(S_sym)) {
+      if (!fp) {
+        S_sym->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"RedHessian unscaled");
+      }
+      SmartPtr<DenseGenMatrixSpace> eigenvectorspace = new DenseGenMatrixSpace(dim_S, dim_S);
+      SmartPtr<DenseGenMatrix> eigenvectors = new DenseGenMatrix(GetRawPtr(eigenvectorspace));
+      SmartPtr<DenseVectorSpace> eigenvaluesspace = new DenseVectorSpace(dim_S);
+      SmartPtr<DenseVector> eigenvalues = new DenseVector(GetRawPtr(eigenvaluesspace));
+
+      eigenvectors->ComputeEigenVectors(*S_sym, *eigenvalues);
+      eigenvalues->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"Eigenvalues of reduced hessian matrix");
+    }
+
+    return true;
+  }
+
+  bool ReducedHessianCalculator::ComputeReducedHessianSketch()
+  {
+    DBG_START_METH("ReducedHessianCalculator::ComputeReducedHessianSketch", dbg_verbosity);
+
+    const Index dim_S = hess_data_->GetNRowsAdded();
+    const Index nsketch = Min(dim_S, sketch_rank_+sketch_oversampling_);
+    if (nsketch == 0) {
+      return true;
+    }
+
+    PrintScalingWarning();
+    const Number obj_scal = IpNLP().NLP_scaling()->apply_obj_scaling(1.0);
+
+    // 1. Y = M*Omega for a random matrix Omega with entries +-1 (the
+    //    seed is fixed, so that the results are reproducible)
+    std::vector<Number> Omega(dim_S*nsketch);
+    unsigned short state[3] = {0x330E, 0x1234, 0xABCD};
+    for (Index k=0; k<dim_S*nsketch; ++k) {
+      Omega[k] = (IpRandom01(state) < 0.5) ? -1. : 1.;
+    }
+    std::vector<Number> Q(dim_S*nsketch);
+    if (!MultiplyBlocks(&Omega[0], nsketch, obj_scal, &Q[0])) {
+      return false;
+    }
+
+    // 2. Orthonormal basis Q of the range of Y (modified Gram-Schmidt
+    //    with reorthogonalization); columns that are numerically in
+    //    the span of the previous ones are dropped
+    Index rank = 0;
+    for (Index j=0; j<nsketch; ++j) {
+      Number* y = &Q[j*dim_S];
+      const Number norm0 = IpBlasDnrm2(dim_S, y, 1);
+      for (Index pass=0; pass<2; ++pass) {
+        for (Index i=0; i<rank; ++i) {
+          const Number* q = &Q[i*dim_S];
+          IpBlasDaxpy(dim_S, -IpBlasDdot(dim_S, q, 1, y, 1), q, 1, y, 1);
+        }
+      }
+      const Number norm = IpBlasDnrm2(dim_S, y, 1);
+      if (norm <= 1e-12*norm0 || norm == 0.) {
+        continue;
+      }
+      IpBlasDscal(dim_S, 1./norm, y, 1);
+      if (rank < j) {
+        IpBlasDcopy(dim_S, y, 1, &Q[rank*dim_S], 1);
+      }
+      rank++;
+    }
+    if (rank == 0) {
+      Jnlst().Printf(J_WARNING, J_MAIN,
+                     "The randomized approximation of the reduced hessian is zero.\n");
+      return true;
+    }
+
+    // 3. Projection B = Q^T*M*Q and its eigenvalue decomposition
+    std::vector<Number> MQ(dim_S*rank);
+    if (!MultiplyBlocks(&Q[0], rank, obj_scal, &MQ[0])) {
+      return false;
+    }
+    std::vector<Number> B(rank*rank);
+    IpBlasDgemm(true, false, rank, rank, dim_S, 1., &Q[0], dim_S,
+                &MQ[0], dim_S, 0., &B[0], rank);
+    for (Index j=0; j<rank; ++j) {
+      for (Index i=j+1; i<rank; ++i) {
+        const Number b = 0.5*(B[i+j*rank]+B[j+i*rank]);
+        B[i+j*rank] = b;
+        B[j+i*rank] = b;
+      }
+    }
+    std::vector<Number> lambda(rank);
+    Index info;
+    IpLapackDsyev(true, rank, &B[0], rank, &lambda[0], info);
+    if (info != 0) {
+      Jnlst().Printf(J_ERROR, J_MAIN,
+                     "The eigenvalue decomposition for the reduced hessian approximation failed (info = %d).\n", info);
+      return false;
+    }
+
+    // 4. The approximation consists of the (algebraically) largest
+    //    eigenvalues, with the eigenvectors U = Q*V
+    const Index napprox = Min(sketch_rank_, rank);
+    const Index first = rank-napprox;
+    std::vector<Number> U(dim_S*napprox);
+    IpBlasDgemm(false, false, dim_S, napprox, rank, 1., &Q[0], dim_S,
+                &B[first*rank], rank, 0., &U[0], dim_S);
+
+    SmartPtr<DenseVectorSpace> eigenvaluesspace = new DenseVectorSpace(napprox);
+    SmartPtr<DenseVector> eigenvalues = new DenseVector(GetRawPtr(eigenvaluesspace));
+    eigenvalues->SetValues(&lambda[first]);
+    eigenvalues->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"Eigenvalues of reduced hessian approximation");
+
+    if (!output_file_.empty()) {
+      FILE* fp = OpenOutputFile(1, dim_S, napprox);
+      if (!fp) {
+        return false;
+      }
+      fwrite(&lambda[first], sizeof(Number), napprox, fp);
+      fwrite(&U[0], sizeof(Number), dim_S*napprox, fp);
+      fclose(fp);
+      Jnlst().Printf(J_SUMMARY, J_MAIN,
+                     "Wrote %d eigenpairs of the reduced hessian approximation to %s.\n",
+                     napprox, output_file_.c_str());
+    }
+    else {
+      SmartPtr<DenseGenMatrixSpace> U_space = new DenseGenMatrixSpace(dim_S, napprox);
+      SmartPtr<DenseGenMatrix> U_mat = new DenseGenMatrix(GetRawPtr(U_space));
+      IpBlasDcopy(dim_S*napprox, &U[0], 1, U_mat->Values(), 1);
+      U_mat->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"Eigenvectors of reduced hessian approximation");
+    }
+
+    return true;
+  }
+
+  bool ReducedHessianCalculator::SolveBlock(const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+					    Number factor, Number* S_cols)
+  {
+    DBG_START_METH("ReducedHessianCalculator::SolveBlock", dbg_verbosity);
+
+    const Index nrhs = (Index)rhsV.size();
+    const Index dim_S = hess_data_->GetNRowsAdded();
+
+    if (row_comp_.empty() && dim_S > 0) {
+      // Position of the rows of hess_data_ in the iterates vector
+      SmartPtr<const IteratesVector> iv = IpData().curr();
+      std::vector<Index> comp_start(iv->NComps()+1, 0);
+      for (Index j=0; j<iv->NComps(); ++j) {
+        comp_start[j+1] = comp_start[j] + iv->GetComp(j)->Dim();
+      }
+      row_comp_.resize(dim_S);
+      row_pos_.resize(dim_S);
+      row_factor_.resize(dim_S);
+      std::vector<Index> indices;
+      std::vector<Number> factors;
+      for (Index i=0; i<dim_S; ++i) {
+        hess_data_->GetMultiplyingVectors(i, indices, factors);
+        DBG_ASSERT(indices.size()==1);
+        Index comp = 0;
+        while (!(indices[0] < comp_start[comp+1])) {
+          comp++;
+        }
+        row_comp_[i] = comp;
+        row_pos_[i] = indices[0]-comp_start[comp];
+        row_factor_[i] = factors[0];
+        indices.clear();
+        factors.clear();
+      }
+    }
+
+    std::vector<SmartPtr<IteratesVector> > solV(nrhs);
+    for (Index k=0; k<nrhs; ++k) {
+      solV[k] = rhsV[k]->MakeNewIteratesVector();
+    }
+    bool retval = pcalc_->Solver()->MultiSolve(solV, rhsV);
+    if (!retval) {
+      return false;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(nrhs>1)
+#endif
+    for (Index k=0; k<nrhs; ++k) {
+      Number* S_col = S_cols+k*dim_S;
+      for (Index i=0; i<dim_S; ++i) {
+        const DenseVector* comp_vec = static_cast<const DenseVector*>(GetRawPtr(solV[k]->GetComp(row_comp_[i])));
+        const Number val = comp_vec->IsHomogeneous() ? comp_vec->Scalar() :
+                           comp_vec->Values()[row_pos_[i]];
+        S_col[i] = factor*row_factor_[i]*val;
+      }
+    }
+
+    return true;
+  }
+
+  bool ReducedHessianCalculator::MultiplyBlocks(const Number* W, Index ncols,
+						Number factor, Number* MW)
+  {
+    DBG_START_METH("ReducedHessianCalculator::MultiplyBlocks", dbg_verbosity);
+
+    const Index dim_S = hess_data_->GetNRowsAdded();
+    SmartPtr<DenseVectorSpace> w_space = new DenseVectorSpace(dim_S);
+    SmartPtr<DenseVector> w = new DenseVector(GetRawPtr(w_space));
+    for (Index block_start=0; block_start<ncols; block_start+=block_size_) {
+      const Index nblock = Min(block_size_, ncols-block_start);
+      std::vector<SmartPtr<const IteratesVector> > rhsV(nblock);
+      for (Index k=0; k<nblock; ++k) {
+        SmartPtr<IteratesVector> rhs = IpData().curr()->MakeNewIteratesVector();
+        w->SetValues(W+(block_start+k)*dim_S);
+        hess_data_->TransMultiply(*w, *rhs);
+        rhsV[k] = ConstPtr(rhs);
+      }
+      if (!SolveBlock(rhsV, factor, MW+block_start*dim_S)) {
+        Jnlst().Printf(J_ERROR, J_MAIN,
+                       "Solving the KKT systems for the reduced hessian failed.\n");
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void ReducedHessianCalculator::PrintScalingWarning()
+  {
+    DBG_START_METH("ReducedHessianCalculator::PrintScalingWarning", dbg_verbosity);
+
     bool have_x_scaling, have_c_scaling, have_d_scaling;
     have_x_scaling = IpNLP().NLP_scaling()->have_x_scaling();
     have_c_scaling = IpNLP().NLP_scaling()->have_c_scaling();
@@ -79,29 +436,23 @@ namespace Ipopt
 		     "-------------------------------------------------------------------------------\n\n");
 
     }
+  }
 
-    // Unscale by objective factor and multiply by (-1)
-    Number obj_scal = IpNLP().NLP_scaling()->apply_obj_scaling(1.0);
-    DBG_PRINT((dbg_verbosity, "Objective scaling = %f\n", obj_scal));
-    Number* s_val = S_sym->Values();
-    for (Index k=0; k<(S->NRows())*(S->NCols()); ++k) {
-      s_val[k] *= -obj_scal;
-    }
-
-    S->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"RedHessian unscaled");
-
-    if ( compute_eigenvalues_ ) {
-      SmartPtr<DenseGenMatrixSpace> eigenvectorspace = new DenseGenMatrixSpace(dim_S, dim_S);
-      SmartPtr<DenseGenMatrix> eigenvectors = new DenseGenMatrix(GetRawPtr(eigenvectorspace));
-      SmartPtr<DenseVectorSpace> eigenvaluesspace = new DenseVectorSpace(dim_S);
-      SmartPtr<DenseVector> eigenvalues = new DenseVector(GetRawPtr(eigenvaluesspace));
+  FILE* ReducedHessianCalculator::OpenOutputFile(Index kind, Index dim, Index ncols)
+  {
+    DBG_START_METH("ReducedHessianCalculator::OpenOutputFile", dbg_verbosity);
 
-      eigenvectors->ComputeEigenVectors(*S_sym, *eigenvalues);
-      eigenvalues->Print(Jnlst(),J_INSUPPRESSIBLE,J_USER1,"Eigenvalues of reduced hessian matrix");
+    FILE* fp = fopen(output_file_.c_str(), "wb");
+    if (!fp) {
+      Jnlst().Printf(J_ERROR, J_MAIN,
+                     "Cannot open the reduced hessian output file %s.\n",
+                     output_file_.c_str());
+      return NULL;
     }
-
-    return retval;
+    const int header[3] = {kind, dim, ncols};
+    fwrite("IPOPTRH1", 1, 8, fp);
+    fwrite(header, sizeof(int), 3, fp);
+    return fp;
   }
 
-
 }
@@ -11,6 +11,10 @@
 #include "SensSchurData.hpp"
 #include "SensPCalculator.hpp"
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 namespace Ipopt
 {
 
@@ -32,6 +36,53 @@ namespace Ipopt
 
   private:
 
+    /** Computes the columns rh_column_start to
+     *  rh_column_start+rh_num_columns-1 of the reduced hessian in blocks
+     *  of sens_p_block_size columns, with one back-solve for each
+     *  block.  The columns of a block are written as soon as they are
+     *  available, to rh_output_file (if set) or to the journal, so that
+     *  the whole matrix is never stored (unless its eigenvalues are
+     *  requested). */
+    bool ComputeReducedHessianBlocked();
+
+    /** Computes a randomized approximation of rank rh_sketch_rank of
+     *  the reduced hessian, M ~ U*diag(lambda)*U^T, from the products
+     *  of M with rh_sketch_rank+rh_sketch_oversampling random vectors
+     *  and with an orthonormal basis of their range. */
+    bool ComputeReducedHessianSketch();
+
+    /** Solves the KKT systems for the right hand sides rhsV with one
+     *  back-solve and stores factor times the rows selected by
+     *  hess_data_ of the solutions (i.e., factor*E*K^{-1}*rhs) in
+     *  the columns of S_cols. */
+    bool SolveBlock(const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+                    Number factor, Number* S_cols);
+
+    /** Computes M*W for the ncols columns of W (dim x ncols, stored
+     *  column by column) in blocks of sens_p_block_size columns. */
+    bool MultiplyBlocks(const Number* W, Index ncols, Number factor,
+                        Number* MW);
+
+    /** Prints a warning if the problem is scaled */
+    void PrintScalingWarning();
+
+    /** Opens rh_output_file and writes the header of the binary
+     *  format.  The file is
+     *
+     *  - the 8 characters "IPOPTRH1",
+     *  - the kind of the data (int): 0 for columns of the reduced
+     *    hessian, 1 for the eigenpairs of an approximation,
+     *  - the dimension n of the reduced hessian (int),
+     *  - the number m of columns or eigenpairs (int),
+     *  - for kind 0, the indices of the m columns (m ints), and for
+     *    kind 1, the m eigenvalues (m doubles) in ascending order,
+     *  - the m columns or eigenvectors (m*n doubles, one column after
+     *    the other),
+     *
+     *  all in the native byte order.  Returns NULL if the file cannot
+     *  be opened. */
+    FILE* OpenOutputFile(Index kind, Index dim, Index ncols);
+
     /** Pointer to Schurdata object holding the indices for selecting the free variables */
     SmartPtr<SchurData> hess_data_;
 
@@ -40,6 +91,32 @@ namespace Ipopt
 
     /** True, if option rh_eigendecomp was set to yes */
     bool compute_eigenvalues_;
+
+    /**@name Algorithmic parameters */
+    //@{
+    /** Binary output file (empty for output to the journal) */
+    std::string output_file_;
+    /** First column of the reduced hessian that is computed */
+    Index column_start_;
+    /** Number of columns that are computed (0 for all) */
+    Index num_columns_;
+    /** Rank of the randomized approximation (0 for none) */
+    Index sketch_rank_;
+    /** Number of additional random vectors for the approximation */
+    Index sketch_oversampling_;
+    /** Number of KKT systems solved together */
+    Index block_size_;
+    //@}
+
+    /**@name Position of the rows of hess_data_ in the iterates
+     *  vector: component, index in the component and factor of each
+     *  row */
+    //@{
+    std::vector<Index> row_comp_;
+    std::vector<Index> row_pos_;
+    std::vector<Number> row_factor_;
+    //@}
+
   };
 
 }
@@ -44,4 +44,12 @@ namespace Ipopt
 
     return retval;
   }
+
+  bool SimpleBacksolver::MultiSolve(std::vector<SmartPtr<IteratesVector> >& delta_lhsV,
+				    const std::vector<SmartPtr<const IteratesVector> >& delta_rhsV)
+  {
+    DBG_START_METH("SimpleBacksolver::MultiSolve", dbg_verbosity);
+
+    return pd_solver_->MultiSolve(1.0, 0.0, delta_rhsV, delta_lhsV, allow_inexact_);
+  }
 } // end namespace
@@ -29,6 +29,11 @@ namespace Ipopt {
 
     bool Solve(SmartPtr<IteratesVector> delta_lhs, SmartPtr<const IteratesVector> delta_rhs);
 
+    /** Solves for all right hand sides with one call of the
+     *  PDSystemSolver, so that the back-solves are done together. */
+    bool MultiSolve(std::vector<SmartPtr<IteratesVector> >& delta_lhsV,
+                    const std::vector<SmartPtr<const IteratesVector> >& delta_rhsV);
+
 
   private:
 
@@ -30,11 +30,33 @@ namespace Ipopt
      *  a step using its SchurDriver, checks bounds, and returns it */
     virtual bool Step(DenseVector& delta_u, IteratesVector& sol);
 
+    /** Calculates the steps for several perturbations together: the
+     *  KKT residuals are computed once, the initial steps are computed
+     *  with one back-solve for all right hand sides, and the columns
+     *  of P for the initial bound violations of all steps are computed
+     *  together. */
+    virtual bool MultiStep(const std::vector<SmartPtr<DenseVector> >& delta_u,
+			   std::vector<SmartPtr<IteratesVector> >& sol,
+			   const std::vector<SmartPtr<SchurDriver> >& driver_vec);
+
     bool BoundCheck(IteratesVector& sol,
 		    std::vector<Index>& x_bound_violations_idx,
 		    std::vector<Number>& x_bound_violations_du);
 
   private:
+    /** Returns the KKT residuals at the current point */
+    SmartPtr<const IteratesVector> KKTResiduals();
+
+    /** Corrects the step sol with the SchurDriver until no bounds are
+     *  violated any more.  x_bound_violations_idx and
+     *  x_bound_violations_du are the violations of sol on entry (as
+     *  returned by BoundCheck). */
+    bool BoundCorrection(IteratesVector& sol,
+			 SmartPtr<const IteratesVector> delta_u_long,
+			 SmartPtr<IteratesVector> Kr_s,
+			 std::vector<Index>& x_bound_violations_idx,
+			 std::vector<Number>& x_bound_violations_du);
+
     SmartPtr<SchurData> ift_data_;
     SmartPtr<SensBacksolver> backsolver_;
     Number bound_eps_;
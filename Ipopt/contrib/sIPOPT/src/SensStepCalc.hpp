@@ -9,14 +9,13 @@
 
 #include "IpAlgStrategy.hpp"
 #include "SensSchurDriver.hpp"
+#include "IpDenseVector.hpp"
+#include "IpIteratesVector.hpp"
+#include <vector>
 
 
 namespace Ipopt
 {
-  /** Forward declarations */
-  class DenseVector;
-  class IteratesVector;
-
   class SensitivityStepCalculator : public AlgorithmStrategyObject
   {
     /* This is the interface for the classes that perform the actual step. */
@@ -65,6 +64,22 @@ namespace Ipopt
      *  a step using its SchurDriver, checks bounds, and returns it */
     virtual bool Step(DenseVector& delta_u, IteratesVector& sol) =0;
 
+    /** Calculates the steps for several perturbations delta_u[i],
+     *  each with its own SchurDriver driver_vec[i].  The default
+     *  implementation calls Step for each of them; step calculators
+     *  that can share work between the steps should overload this. */
+    virtual bool MultiStep(const std::vector<SmartPtr<DenseVector> >& delta_u,
+			   std::vector<SmartPtr<IteratesVector> >& sol,
+			   const std::vector<SmartPtr<SchurDriver> >& driver_vec)
+    {
+      bool retval = true;
+      for (Index i=0; i<(Index)delta_u.size() && retval; ++i) {
+	SetSchurDriver(driver_vec[i]);
+	retval = Step(*delta_u[i], *sol[i]);
+      }
+      return retval;
+    }
+
 
   private:
     SmartPtr<SchurDriver> driver_;
@@ -225,6 +225,11 @@ InitializeProblem(Index N)
   alpha_ = p.alpha();
   beta_ = p.beta();
 
+  // The problem might be initialized more than once
+  delete [] y_T_;
+  delete [] a_y_;
+  delete [] a_u_;
+
   y_T_ = new Number[Nx_+1];
   for (Index j=0; j<=Nx_; j++) {
     y_T_[j] = p.y_T(x_grid(j));
@@ -43,3 +43,13 @@ RegisteredTNLPs::PrintRegisteredProblems()
     printf("%s\n", it->first.c_str());
   }
 }
+
+void
+RegisteredTNLPs::GetRegisteredProblemNames(std::vector<std::string>& names)
+{
+  names.clear();
+  for (std::map<std::string, SmartPtr<RegisteredTNLP> >::iterator it = RegisteredTNLPListMap().begin();
+       it != RegisteredTNLPListMap().end(); it++) {
+    names.push_back(it->first);
+  }
+}
@@ -11,6 +11,7 @@
 
 #include "IpTNLP.hpp"
 #include <map>
+#include <vector>
 
 using namespace Ipopt;
 
@@ -37,6 +38,7 @@ public:
   {}
   static SmartPtr<RegisteredTNLP> GetTNLP(const std::string name);
   static void PrintRegisteredProblems();
+  static void GetRegisteredProblemNames(std::vector<std::string>& names);
 private:
   void RegisterTNLP(const SmartPtr<RegisteredTNLP>& tnlp,
                     const std::string name);
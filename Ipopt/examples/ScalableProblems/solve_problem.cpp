@@ -7,6 +7,7 @@
 // Authors:  Andreas Waechter            IBM    2004-11-05
 
 #include "IpIpoptApplication.hpp"
+#include "IpSolveStatistics.hpp"
 #include "RegisteredTNLP.hpp"
 
 #ifdef HAVE_CONFIG_H
@@ -46,6 +47,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 //**********************************************************************
 // Stuff for benchmarking
@@ -151,6 +153,103 @@ static void print_problems()
   RegisteredTNLPs::PrintRegisteredProblems();
 }
 
+// Outcome of one solve, for the comparison in the thread test
+struct SolveResult
+{
+  bool initialized;
+  ApplicationReturnStatus status;
+  Index iterations;
+  Number objective;
+};
+
+// Solve one problem without output.  This creates its own
+// IpoptApplication, so that it can be called from several threads.
+static SolveResult solve_quietly(const SmartPtr<RegisteredTNLP>& tnlp, Index N)
+{
+  SolveResult result;
+  result.initialized = false;
+  result.status = Internal_Error;
+  result.iterations = -1;
+  result.objective = 0.;
+
+  if (!tnlp->InitializeProblem(N)) {
+    return result;
+  }
+  result.initialized = true;
+
+  SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+  app->Options()->SetIntegerValue("print_level", 0);
+  app->Options()->SetStringValue("sb", "yes");
+  result.status = app->Initialize();
+  if (result.status != Solve_Succeeded) {
+    return result;
+  }
+  result.status = app->OptimizeTNLP(GetRawPtr(tnlp));
+
+  SmartPtr<SolveStatistics> stats = app->Statistics();
+  if (IsValid(stats)) {
+    result.iterations = stats->IterationCount();
+    result.objective = stats->FinalObjective();
+  }
+  return result;
+}
+
+// Solve all registered problems one after the other, and then again
+// with several IpoptApplications running in nthreads threads at the
+// same time (if compiled with OpenMP).  The results of the two runs
+// must be identical.  Returns the number of differences.
+static int thread_test(int nthreads, Index N)
+{
+  std::vector<std::string> names;
+  RegisteredTNLPs::GetRegisteredProblemNames(names);
+  const int nprob = (int)names.size();
+  std::vector<SmartPtr<RegisteredTNLP> > tnlps(nprob);
+  for (int i=0; i<nprob; i++) {
+    tnlps[i] = RegisteredTNLPs::GetTNLP(names[i]);
+  }
+
+  std::vector<SolveResult> serial(nprob);
+  std::vector<SolveResult> parallel(nprob);
+  for (int i=0; i<nprob; i++) {
+    serial[i] = solve_quietly(tnlps[i], N);
+  }
+
+#ifdef _OPENMP
+  printf("Solving %d problems with size %d in %d threads.\n\n",
+         nprob, N, nthreads);
+  #pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+#else
+  printf("Compiled without OpenMP support, solving %d problems with size %d serially.\n\n",
+         nprob, N);
+#endif
+  for (int i=0; i<nprob; i++) {
+    // Every problem is solved in only one thread, since the
+    // registered TNLP objects store the data of the problem
+    parallel[i] = solve_quietly(tnlps[i], N);
+  }
+
+  int ndiffs = 0;
+  for (int i=0; i<nprob; i++) {
+    if (!serial[i].initialized) {
+      printf("%-20s  skipped (invalid size)\n", names[i].c_str());
+      continue;
+    }
+    const bool identical =
+      parallel[i].initialized &&
+      serial[i].status == parallel[i].status &&
+      serial[i].iterations == parallel[i].iterations &&
+      serial[i].objective == parallel[i].objective;
+    printf("%-20s  status %3d  iter %5d  obj %23.16e  %s\n",
+           names[i].c_str(), (int)serial[i].status, serial[i].iterations,
+           serial[i].objective, identical ? "identical" : "DIFFERENT");
+    if (!identical) {
+      ndiffs++;
+    }
+  }
+  printf("\n%d problems with different results.\n", ndiffs);
+  return ndiffs;
+}
+
 int main(int argv, char* argc[])
 {
   if (argv==2 && !strcmp(argc[1],"list")) {
@@ -158,6 +257,16 @@ int main(int argv, char* argc[])
     return 0;
   }
 
+  if (argv==4 && !strcmp(argc[1],"threads")) {
+    int nthreads = atoi(argc[2]);
+    Index N = atoi(argc[3]);
+    if (nthreads <= 0 || N <= 0) {
+      printf("Given number of threads or problem size is invalid.\n");
+      return -3;
+    }
+    return thread_test(nthreads, N);
+  }
+
 #ifdef TIME_LIMIT
   if (argv==4) {
     int runtime = atoi(argc[3]);
@@ -172,6 +281,9 @@ int main(int argv, char* argc[])
       printf("          where N is a positive parameter determining problem size\n");
       printf("       %s list\n", argc[0]);
       printf("          to list all registered problems.\n");
+      printf("       %s threads NTHREADS N\n", argc[0]);
+      printf("          to solve all registered problems with size N serially and in\n");
+      printf("          NTHREADS threads at the same time, and compare the results.\n");
       return -1;
     }
 
@@ -0,0 +1,156 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpIpoptApplication.hpp"
+#include "IpSolveStatistics.hpp"
+#include "hs071_nlp.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Ipopt;
+
+// Benchmark for the solution of many small problems with the same
+// structure: the problem of hs071_nlp with different starting points
+// is solved once by IpoptApplication::OptimizeTNLP for each problem,
+// and once by IpoptApplication::OptimizeTNLPs for all problems.  The
+// batch keeps the algorithm objects of a thread for all problems
+// with the same structure, and the results must be the same as those
+// of the single solves.
+
+// HS071 with a shifted starting point.  The final objective value is
+// stored instead of printing the solution.
+class HS071_Shifted : public HS071_NLP
+{
+public:
+  HS071_Shifted(Number shift)
+      :
+      shift_(shift),
+      obj_value_(0.)
+  {}
+
+  virtual bool get_starting_point(Index n, bool init_x, Number* x,
+                                  bool init_z, Number* z_L, Number* z_U,
+                                  Index m, bool init_lambda,
+                                  Number* lambda)
+  {
+    HS071_NLP::get_starting_point(n, init_x, x, init_z, z_L, z_U,
+                                  m, init_lambda, lambda);
+    for (Index i=0; i<n; i++) {
+      x[i] += shift_;
+    }
+    return true;
+  }
+
+  virtual void finalize_solution(SolverReturn status,
+                                 Index n, const Number* x, const Number* z_L, const Number* z_U,
+                                 Index m, const Number* g, const Number* lambda,
+                                 Number obj_value,
+                                 const IpoptData* ip_data,
+                                 IpoptCalculatedQuantities* ip_cq)
+  {
+    obj_value_ = obj_value;
+  }
+
+  Number ObjValue() const
+  {
+    return obj_value_;
+  }
+
+private:
+  Number shift_;
+  Number obj_value_;
+};
+
+int main(int argv, char* argc[])
+{
+  int nproblems = 10000;
+  if (argv > 1) {
+    nproblems = atoi(argc[1]);
+  }
+  int nthreads = 0;
+  if (argv > 2) {
+    nthreads = atoi(argc[2]);
+  }
+  if (argv > 3 || nproblems <= 0 || nthreads < 0) {
+    printf("Usage: %s [number of problems [number of threads]]\n", argc[0]);
+    return -1;
+  }
+
+  std::vector<SmartPtr<HS071_Shifted> > problems(nproblems);
+  std::vector<SmartPtr<TNLP> > tnlps(nproblems);
+  for (int i=0; i<nproblems; i++) {
+    // shifts in [-0.5, 0.5], so that the starting point stays within
+    // the bounds [1, 5]
+    problems[i] = new HS071_Shifted(Number(i%101)/100. - 0.5);
+    tnlps[i] = GetRawPtr(problems[i]);
+  }
+
+  SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+  app->Options()->SetIntegerValue("print_level", 0);
+  app->Options()->SetStringValue("sb", "yes");
+  app->Options()->SetIntegerValue("batch_num_threads", nthreads);
+  ApplicationReturnStatus status = app->Initialize();
+  if (status != Solve_Succeeded) {
+    printf("\n\n*** Error during initialization!\n");
+    return (int) status;
+  }
+
+  // One problem after the other
+  Number start = WallclockTime();
+  int nsolved_single = 0;
+  std::vector<Index> iterations_single(nproblems, -1);
+  std::vector<Number> obj_single(nproblems);
+  for (int i=0; i<nproblems; i++) {
+    if (app->OptimizeTNLP(tnlps[i]) == Solve_Succeeded) {
+      nsolved_single++;
+    }
+    iterations_single[i] = app->Statistics()->IterationCount();
+    obj_single[i] = problems[i]->ObjValue();
+  }
+  Number time_single = WallclockTime() - start;
+
+  // All problems in one batch
+  std::vector<ApplicationReturnStatus> batch_status;
+  std::vector<SmartPtr<SolveStatistics> > batch_stats;
+  start = WallclockTime();
+  app->OptimizeTNLPs(tnlps, batch_status, batch_stats);
+  Number time_batch = WallclockTime() - start;
+  int nsolved_batch = 0;
+  int ndifferent = 0;
+  Index iterations = 0;
+  for (int i=0; i<nproblems; i++) {
+    if (batch_status[i] == Solve_Succeeded) {
+      nsolved_batch++;
+    }
+    Index iterations_batch = -1;
+    if (IsValid(batch_stats[i])) {
+      iterations_batch = batch_stats[i]->IterationCount();
+      iterations += iterations_batch;
+    }
+    if (iterations_batch != iterations_single[i] ||
+        problems[i]->ObjValue() != obj_single[i]) {
+      ndifferent++;
+    }
+  }
+
+  printf("Number of problems:           %d\n", nproblems);
+  printf("OptimizeTNLP:   %8d solved in %8.3f s  (%10.1f solves/s)\n",
+         nsolved_single, time_single, nproblems/Max(time_single, 1e-9));
+  printf("OptimizeTNLPs:  %8d solved in %8.3f s  (%10.1f solves/s)\n",
+         nsolved_batch, time_batch, nproblems/Max(time_batch, 1e-9));
+  printf("Speedup of the batch:         %8.2f\n",
+         time_single/Max(time_batch, 1e-9));
+  printf("Average number of iterations in the batch: %.2f\n",
+         Number(iterations)/nproblems);
+  printf("Problems with results different from OptimizeTNLP: %d\n",
+         ndifferent);
+
+  return (nsolved_batch == nproblems && ndifferent == 0) ? 0 : 1;
+}
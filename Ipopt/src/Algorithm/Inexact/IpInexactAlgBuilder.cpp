@@ -36,12 +36,16 @@
 #include "IpInexactSearchDirCalc.hpp"
 #include "IpInexactNewtonNormal.hpp"
 #include "IpInexactPDSolver.hpp"
+#include "IpInexactMinresAugSystemSolver.hpp"
 
 #include "IpMa27TSolverInterface.hpp"
 #include "IpMa57TSolverInterface.hpp"
+#include "IpNativeSolverInterface.hpp"
 #include "IpMc19TSymScalingMethod.hpp"
 #include "IpInexactTSymScalingMethod.hpp"
-#include "IpIterativePardisoSolverInterface.hpp"
+#ifdef HAVE_PARDISO
+# include "IpIterativePardisoSolverInterface.hpp"
+#endif
 #include "IpInexactNormalTerminationTester.hpp"
 #include "IpInexactPDTerminationTester.hpp"
 
@@ -57,7 +61,6 @@
 #endif
 
 #include "HSLLoader.h"
-#include "PardisoLoader.h"
 
 namespace Ipopt
 {
@@ -108,6 +111,17 @@ namespace Ipopt
       "none", "no scaling will be performed",
       "slack-based", "scale the linear system as in paper",
       "");
+    roptions->AddStringOption2(
+      "inexact_linear_solver",
+      "Solver for the augmented system in the inexact approach",
+      "linear_solver",
+      "linear_solver", "use the solver selected with the linear_solver option",
+      "minres", "use the built-in matrix-free MINRES solver",
+      "The MINRES solver only accesses the Hessian and the Jacobians "
+      "through matrix-vector products and uses a block diagonal "
+      "preconditioner, so that the memory requirement is linear in the "
+      "number of nonzeros.  With this choice, the linear_solver option is "
+      "ignored for the inexact approach.");
   }
 
   SmartPtr<IpoptAlgorithm>
@@ -124,9 +138,19 @@ namespace Ipopt
 
     SmartPtr<InexactNormalTerminationTester> NormalTester;
     SmartPtr<SparseSymLinearSolverInterface> SolverInterface;
+    SmartPtr<AugSystemSolver> AugSolver;
+    std::string inexact_linear_solver;
+    options.GetStringValue("inexact_linear_solver", inexact_linear_solver,
+                           prefix);
     std::string linear_solver;
     options.GetStringValue("linear_solver", linear_solver, prefix);
-    if (linear_solver=="ma27") {
+    if (inexact_linear_solver=="minres") {
+      NormalTester = new InexactNormalTerminationTester();
+      SmartPtr<IterativeSolverTerminationTester> pd_tester =
+        new InexactPDTerminationTester();
+      AugSolver = new InexactMinresAugSystemSolver(*NormalTester, *pd_tester);
+    }
+    else if (linear_solver=="ma27") {
 #ifndef COINHSL_HAS_MA27
 # ifdef HAVE_LINEARSOLVERLOADER
       SolverInterface = new Ma27TSolverInterface();
@@ -174,24 +198,12 @@ namespace Ipopt
       NormalTester = new InexactNormalTerminationTester();
       SmartPtr<IterativeSolverTerminationTester> pd_tester =
         new InexactPDTerminationTester();
-#ifndef HAVE_PARDISO
-# ifdef HAVE_LINEARSOLVERLOADER
+#ifdef HAVE_PARDISO
       SolverInterface = new IterativePardisoSolverInterface(*NormalTester, *pd_tester);
-      char buf[256];
-      int rc = LSL_loadPardisoLib(NULL, buf, 255);
-      if (rc) {
-        std::string errmsg;
-        errmsg = "Selected linear solver Pardiso not available.\nTried to obtain Pardiso from shared library \"";
-        errmsg += LSL_PardisoLibraryName();
-        errmsg += "\", but the following error occured:\n";
-        errmsg += buf;
-        THROW_EXCEPTION(OPTION_INVALID, errmsg.c_str());
-      }
-# else
-      THROW_EXCEPTION(OPTION_INVALID, "Support for Pardiso has not been compiled into Ipopt.");
-# endif
 #else
-      SolverInterface = new IterativePardisoSolverInterface(*NormalTester, *pd_tester);
+      // The iterative Pardiso solver needs the termination test
+      // callback, which the Pardiso loader does not provide
+      THROW_EXCEPTION(OPTION_INVALID, "Support for the iterative Pardiso solver has not been compiled into Ipopt.  Choose inexact_linear_solver=minres.");
 #endif
 
     }
@@ -215,25 +227,29 @@ namespace Ipopt
 #endif
 
     }
+    else if (linear_solver=="native") {
+      SolverInterface = new NativeSolverInterface();
+    }
     else {
       THROW_EXCEPTION(OPTION_INVALID,
                       "Inexact version not available for this selection of linear solver.");
     }
 
-    SmartPtr<TSymScalingMethod> ScalingMethod;
+    if (IsNull(AugSolver)) {
+      SmartPtr<TSymScalingMethod> ScalingMethod;
 
-    std::string inexact_linear_system_scaling;
-    options.GetStringValue("inexact_linear_system_scaling",
-                           inexact_linear_system_scaling, prefix);
-    if (inexact_linear_system_scaling=="slack-based") {
-      ScalingMethod = new InexactTSymScalingMethod();
-    }
+      std::string inexact_linear_system_scaling;
+      options.GetStringValue("inexact_linear_system_scaling",
+                             inexact_linear_system_scaling, prefix);
+      if (inexact_linear_system_scaling=="slack-based") {
+        ScalingMethod = new InexactTSymScalingMethod();
+      }
 
-    SmartPtr<SymLinearSolver> ScaledSolver =
-      new TSymLinearSolver(SolverInterface, ScalingMethod);
+      SmartPtr<SymLinearSolver> ScaledSolver =
+        new TSymLinearSolver(SolverInterface, ScalingMethod);
 
-    SmartPtr<AugSystemSolver> AugSolver =
-      new StdAugSystemSolver(*ScaledSolver);
+      AugSolver = new StdAugSystemSolver(*ScaledSolver);
+    }
 
     // Create the object for initializing the iterates Initialization
     // object.  We include both the warm start and the defaut
@@ -310,7 +326,11 @@ namespace Ipopt
     // TODO: Find out about the following:
     //options_list.SetNumericValueIfUnset("bound_relax_factor", 0.);
     options_list.SetNumericValueIfUnset("kappa_d", 0.);
+#ifdef HAVE_PARDISO
     options_list.SetStringValueIfUnset("linear_solver", "pardiso");
+#else
+    options_list.SetStringValueIfUnset("inexact_linear_solver", "minres");
+#endif
     options_list.SetStringValue("linear_scaling_on_demand", "no");
     options_list.SetStringValue("replace_bounds", "yes");
   }
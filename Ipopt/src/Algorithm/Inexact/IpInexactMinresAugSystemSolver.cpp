@@ -0,0 +1,574 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpInexactMinresAugSystemSolver.hpp"
+#include "IpTripletHelper.hpp"
+
+#ifdef HAVE_CMATH
+# include <cmath>
+#else
+# ifdef HAVE_MATH_H
+#  include <math.h>
+# else
+#  error "don't have header file for math"
+# endif
+#endif
+
+#include <limits>
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  /** Smallest value of a diagonal entry of the preconditioner */
+  static const Number min_prec_diag = 1e-8;
+
+  /** Add the diagonal of J diag(diag_x)^{-1} J^T to diag */
+  static void AddSchurDiagonal(const Matrix& J, const Number* diag_x,
+                               Number* diag)
+  {
+    Index nnz = TripletHelper::GetNumberEntries(J);
+    Index* irn = new Index[nnz];
+    Index* jcn = new Index[nnz];
+    Number* vals = new Number[nnz];
+    TripletHelper::FillRowCol(nnz, J, irn, jcn);
+    TripletHelper::FillValues(nnz, J, vals);
+    for (Index k=0; k<nnz; k++) {
+      diag[irn[k]-1] += vals[k]*vals[k]/diag_x[jcn[k]-1];
+    }
+    delete [] irn;
+    delete [] jcn;
+    delete [] vals;
+  }
+
+  /** Add (D + delta I) vec to result, where D can be NULL */
+  static void AddDiagTimesVector(const Vector* D, Number delta,
+                                 const Vector& vec, Vector& result)
+  {
+    if (D) {
+      SmartPtr<Vector> tmp = vec.MakeNewCopy();
+      tmp->ElementWiseMultiply(*D);
+      result.Axpy(1., *tmp);
+    }
+    if (delta != 0.) {
+      result.Axpy(delta, vec);
+    }
+  }
+
+  InexactMinresAugSystemSolver::
+  InexactMinresAugSystemSolver(IterativeSolverTerminationTester& normal_tester,
+                               IterativeSolverTerminationTester& pd_tester)
+      :
+      AugSystemSolver(),
+      normal_tester_(&normal_tester),
+      pd_tester_(&pd_tester),
+      W_(NULL),
+      D_x_(NULL),
+      D_s_(NULL),
+      J_c_(NULL),
+      D_c_(NULL),
+      J_d_(NULL),
+      D_d_(NULL)
+  {
+    DBG_START_METH("InexactMinresAugSystemSolver::InexactMinresAugSystemSolver()",
+                   dbg_verbosity);
+  }
+
+  InexactMinresAugSystemSolver::~InexactMinresAugSystemSolver()
+  {
+    DBG_START_METH("InexactMinresAugSystemSolver::~InexactMinresAugSystemSolver()",
+                   dbg_verbosity);
+  }
+
+  void InexactMinresAugSystemSolver::RegisterOptions(SmartPtr<RegisteredOptions> roptions)
+  {
+    roptions->AddLowerBoundedIntegerOption(
+      "minres_max_iter",
+      "Maximum number of MINRES iterations",
+      1, 2000,
+      "This is the maximal number of iterations of the built-in MINRES "
+      "solver for the inexact algorithm (inexact_linear_solver=minres).  "
+      "The value for the normal step can be set with the prefix "
+      "\"normal.\".");
+    roptions->AddBoundedNumberOption(
+      "minres_relative_tol",
+      "Relative residual tolerance for MINRES",
+      0.0, true, 1.0, true, 1e-10,
+      "The MINRES iteration stops when the norm of the residual is below "
+      "this factor times the norm of the right hand side, even if the "
+      "termination tests are not satisfied.  The value for the normal "
+      "step can be set with the prefix \"normal.\".");
+  }
+
+  bool InexactMinresAugSystemSolver::InitializeImpl(const OptionsList& options,
+      const std::string& prefix)
+  {
+    // PD system
+    options.GetIntegerValue("minres_max_iter", minres_max_iter_, prefix);
+    options.GetNumericValue("minres_relative_tol",
+                            minres_relative_tol_, prefix);
+    // Normal system
+    options.GetIntegerValue("minres_max_iter", normal_minres_max_iter_,
+                            prefix+"normal.");
+    options.GetNumericValue("minres_relative_tol",
+                            normal_minres_relative_tol_, prefix+"normal.");
+
+    std::string inexact_linear_system_scaling;
+    options.GetStringValue("inexact_linear_system_scaling",
+                           inexact_linear_system_scaling, prefix);
+    requires_scaling_ = (inexact_linear_system_scaling=="slack-based");
+
+    bool retval = normal_tester_->Initialize(Jnlst(), IpNLP(), IpData(),
+                  IpCq(), options, prefix);
+    if (retval) {
+      retval = pd_tester_->Initialize(Jnlst(), IpNLP(), IpData(),
+                                      IpCq(), options, prefix);
+    }
+
+    return retval;
+  }
+
+  ESymSolverStatus InexactMinresAugSystemSolver::Solve(
+    const SymMatrix* W,
+    double W_factor,
+    const Vector* D_x,
+    double delta_x,
+    const Vector* D_s,
+    double delta_s,
+    const Matrix* J_c,
+    const Vector* D_c,
+    double delta_c,
+    const Matrix* J_d,
+    const Vector* D_d,
+    double delta_d,
+    const Vector& rhs_x,
+    const Vector& rhs_s,
+    const Vector& rhs_c,
+    const Vector& rhs_d,
+    Vector& sol_x,
+    Vector& sol_s,
+    Vector& sol_c,
+    Vector& sol_d,
+    bool check_NegEVals,
+    Index numberOfNegEVals)
+  {
+    DBG_START_METH("InexactMinresAugSystemSolver::Solve",dbg_verbosity);
+    DBG_ASSERT(!check_NegEVals);
+
+    IpData().TimingStats().LinearSystemBackSolve().Start();
+
+    W_ = W;
+    W_factor_ = W_factor;
+    D_x_ = D_x;
+    delta_x_ = delta_x;
+    D_s_ = D_s;
+    delta_s_ = delta_s;
+    J_c_ = J_c;
+    D_c_ = D_c;
+    delta_c_ = delta_c;
+    J_d_ = J_d;
+    D_d_ = D_d;
+    delta_d_ = delta_d;
+    if (requires_scaling_) {
+      scaling_slacks_ = InexCq().curr_scaling_slacks();
+    }
+    else {
+      scaling_slacks_ = NULL;
+    }
+
+    // Space for the vectors of the (slack-scaled) augmented system
+    const Index ndim = rhs_x.Dim() + rhs_s.Dim() + rhs_c.Dim() + rhs_d.Dim();
+    SmartPtr<CompoundVectorSpace> aug_space =
+      new CompoundVectorSpace(4, ndim);
+    aug_space->SetCompSpace(0, *rhs_x.OwnerSpace());
+    aug_space->SetCompSpace(1, *rhs_s.OwnerSpace());
+    aug_space->SetCompSpace(2, *rhs_c.OwnerSpace());
+    aug_space->SetCompSpace(3, *rhs_d.OwnerSpace());
+
+    // Right hand side of the scaled system
+    SmartPtr<CompoundVector> rhs = aug_space->MakeNewCompoundVector();
+    rhs->GetCompNonConst(0)->Copy(rhs_x);
+    rhs->GetCompNonConst(1)->Copy(rhs_s);
+    if (IsValid(scaling_slacks_)) {
+      rhs->GetCompNonConst(1)->ElementWiseMultiply(*scaling_slacks_);
+    }
+    rhs->GetCompNonConst(2)->Copy(rhs_c);
+    rhs->GetCompNonConst(3)->Copy(rhs_d);
+
+    IterativeSolverTerminationTester* tester;
+    Index max_iter;
+    Number relative_tol;
+    bool is_normal = false;
+    if (IsNull(InexData().normal_x()) && InexData().compute_normal()) {
+      tester = GetRawPtr(normal_tester_);
+      max_iter = normal_minres_max_iter_;
+      relative_tol = normal_minres_relative_tol_;
+      is_normal = true;
+    }
+    else {
+      tester = GetRawPtr(pd_tester_);
+      max_iter = minres_max_iter_;
+      relative_tol = minres_relative_tol_;
+    }
+
+    SmartPtr<CompoundVector> sol = aug_space->MakeNewCompoundVector();
+    sol->Set(0.);
+
+    const Number norm2_rhs = rhs->Nrm2();
+    Index iter = 0;
+    if (norm2_rhs == 0.) {
+      test_result_ = IterativeSolverTerminationTester::OTHER_SATISFIED;
+    }
+    else {
+      SmartPtr<CompoundVector> inv_prec = aug_space->MakeNewCompoundVector();
+      ComputePreconditioner(*inv_prec);
+
+      bool retval = tester->InitializeSolve();
+      ASSERT_EXCEPTION(retval, INTERNAL_ABORT, "tester->InitializeSolve(); returned false");
+      test_result_ = IterativeSolverTerminationTester::CONTINUE;
+
+      // Preconditioned MINRES (Paige and Saunders), starting from
+      // zero.  In addition to the iterate, the residual is updated
+      // with the products of the matrix with the search directions,
+      // so that only one product with the matrix is computed per
+      // iteration.
+      SmartPtr<CompoundVector> resid = aug_space->MakeNewCompoundVector();
+      resid->Copy(*rhs);
+      SmartPtr<CompoundVector> r1 = aug_space->MakeNewCompoundVector();
+      r1->Copy(*rhs);
+      SmartPtr<CompoundVector> r2 = aug_space->MakeNewCompoundVector();
+      r2->Copy(*rhs);
+      SmartPtr<CompoundVector> y = aug_space->MakeNewCompoundVector();
+      y->Copy(*rhs);
+      y->ElementWiseMultiply(*inv_prec);
+      SmartPtr<CompoundVector> v = aug_space->MakeNewCompoundVector();
+      SmartPtr<CompoundVector> Av = aug_space->MakeNewCompoundVector();
+      SmartPtr<CompoundVector> w = aug_space->MakeNewCompoundVector();
+      w->Set(0.);
+      SmartPtr<CompoundVector> w1 = aug_space->MakeNewCompoundVector();
+      w1->Set(0.);
+      SmartPtr<CompoundVector> w2 = aug_space->MakeNewCompoundVector();
+      w2->Set(0.);
+      SmartPtr<CompoundVector> Aw = aug_space->MakeNewCompoundVector();
+      Aw->Set(0.);
+      SmartPtr<CompoundVector> Aw1 = aug_space->MakeNewCompoundVector();
+      Aw1->Set(0.);
+      SmartPtr<CompoundVector> Aw2 = aug_space->MakeNewCompoundVector();
+      Aw2->Set(0.);
+      SmartPtr<CompoundVector> tmp;
+
+      Number* sol_vals = new Number[ndim];
+      Number* resid_vals = new Number[ndim];
+
+      Number beta = sqrt(rhs->Dot(*y));
+      Number oldb = 0.;
+      Number dbar = 0.;
+      Number epsln = 0.;
+      Number phibar = beta;
+      Number cs = -1.;
+      Number sn = 0.;
+
+      while (iter < max_iter) {
+        iter++;
+
+        // Lanczos step
+        v->Copy(*y);
+        v->Scal(1./beta);
+        MultAugMatrix(*v, *Av);
+        y->Copy(*Av);
+        if (iter >= 2) {
+          y->Axpy(-beta/oldb, *r1);
+        }
+        Number alfa = v->Dot(*y);
+        y->Axpy(-alfa/beta, *r2);
+        tmp = r1;
+        r1 = r2;
+        r2 = y;
+        y = tmp;
+        y->Copy(*r2);
+        y->ElementWiseMultiply(*inv_prec);
+        oldb = beta;
+        beta = sqrt(Max(r2->Dot(*y), 0.));
+
+        // Apply the previous rotation and compute the new one
+        Number oldeps = epsln;
+        Number delta = cs*dbar + sn*alfa;
+        Number gbar = sn*dbar - cs*alfa;
+        epsln = sn*beta;
+        dbar = -cs*beta;
+        Number gamma = Max(sqrt(gbar*gbar + beta*beta),
+                           std::numeric_limits<Number>::epsilon());
+        cs = gbar/gamma;
+        sn = beta/gamma;
+        Number phi = cs*phibar;
+        phibar = sn*phibar;
+
+        // Update the search direction, the iterate, and the residual
+        tmp = w1;
+        w1 = w2;
+        w2 = w;
+        w = tmp;
+        w->AddTwoVectors(1./gamma, *v, -oldeps/gamma, *w1, 0.);
+        w->Axpy(-delta/gamma, *w2);
+        tmp = Aw1;
+        Aw1 = Aw2;
+        Aw2 = Aw;
+        Aw = tmp;
+        Aw->AddTwoVectors(1./gamma, *Av, -oldeps/gamma, *Aw1, 0.);
+        Aw->Axpy(-delta/gamma, *Aw2);
+        sol->Axpy(phi, *w);
+        resid->Axpy(-phi, *Aw);
+
+        TripletHelper::FillValuesFromVector(ndim, *sol, sol_vals);
+        TripletHelper::FillValuesFromVector(ndim, *resid, resid_vals);
+        test_result_ = tester->TestTermination(ndim, sol_vals, resid_vals,
+                                               iter, norm2_rhs);
+        Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                       "Termination Tester Result = %d.\n", test_result_);
+        if (test_result_ != IterativeSolverTerminationTester::CONTINUE) {
+          break;
+        }
+        Number norm2_resid = resid->Nrm2();
+        if (norm2_resid <= relative_tol*norm2_rhs || beta == 0.) {
+          break;
+        }
+      }
+
+      delete [] sol_vals;
+      delete [] resid_vals;
+
+      tester->Clear();
+    }
+
+    if (is_normal) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Number of MINRES iterations for normal step = %d.\n", iter);
+    }
+    else {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Number of MINRES iterations for PD step = %d.\n", iter);
+    }
+    if (iter == max_iter &&
+        test_result_ == IterativeSolverTerminationTester::CONTINUE) {
+      Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                     "MINRES did not satisfy the termination tests within %d iterations.\n",
+                     max_iter);
+    }
+
+    // Unscale the solution
+    sol_x.Copy(*sol->GetComp(0));
+    sol_s.Copy(*sol->GetComp(1));
+    if (IsValid(scaling_slacks_)) {
+      sol_s.ElementWiseMultiply(*scaling_slacks_);
+    }
+    sol_c.Copy(*sol->GetComp(2));
+    sol_d.Copy(*sol->GetComp(3));
+
+    W_ = NULL;
+    D_x_ = NULL;
+    D_s_ = NULL;
+    J_c_ = NULL;
+    D_c_ = NULL;
+    J_d_ = NULL;
+    D_d_ = NULL;
+    scaling_slacks_ = NULL;
+
+    IpData().TimingStats().LinearSystemBackSolve().End();
+
+    if (test_result_ == IterativeSolverTerminationTester::MODIFY_HESSIAN) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Termination tester requests modification of Hessian\n");
+      return SYMSOLVER_WRONG_INERTIA;
+    }
+    if (test_result_ == IterativeSolverTerminationTester::TEST_2_SATISFIED) {
+      // Termination Test 2 is satisfied, set the step for the primal
+      // iterates to zero
+      sol_x.Set(0.);
+      sol_s.Set(0.);
+    }
+    return SYMSOLVER_SUCCESS;
+  }
+
+  void InexactMinresAugSystemSolver::MultAugMatrix(const CompoundVector& vec,
+      CompoundVector& result) const
+  {
+    DBG_START_METH("InexactMinresAugSystemSolver::MultAugMatrix",
+                   dbg_verbosity);
+
+    SmartPtr<const Vector> vec_x = vec.GetComp(0);
+    SmartPtr<const Vector> vec_c = vec.GetComp(2);
+    SmartPtr<const Vector> vec_d = vec.GetComp(3);
+    SmartPtr<Vector> res_x = result.GetCompNonConst(0);
+    SmartPtr<Vector> res_s = result.GetCompNonConst(1);
+    SmartPtr<Vector> res_c = result.GetCompNonConst(2);
+    SmartPtr<Vector> res_d = result.GetCompNonConst(3);
+
+    // Unscaled slack component
+    SmartPtr<Vector> vec_s = vec.GetComp(1)->MakeNewCopy();
+    if (IsValid(scaling_slacks_)) {
+      vec_s->ElementWiseMultiply(*scaling_slacks_);
+    }
+
+    // x: (W + D_x + delta_x I) x + J_c^T c + J_d^T d
+    if (W_factor_ != 0.) {
+      W_->MultVector(W_factor_, *vec_x, 0., *res_x);
+    }
+    else {
+      res_x->Set(0.);
+    }
+    AddDiagTimesVector(D_x_, delta_x_, *vec_x, *res_x);
+    J_c_->TransMultVector(1., *vec_c, 1., *res_x);
+    J_d_->TransMultVector(1., *vec_d, 1., *res_x);
+
+    // s: (D_s + delta_s I) s - d
+    res_s->Set(0.);
+    AddDiagTimesVector(D_s_, delta_s_, *vec_s, *res_s);
+    res_s->Axpy(-1., *vec_d);
+    if (IsValid(scaling_slacks_)) {
+      res_s->ElementWiseMultiply(*scaling_slacks_);
+    }
+
+    // c: J_c x + (D_c - delta_c I) c
+    J_c_->MultVector(1., *vec_x, 0., *res_c);
+    AddDiagTimesVector(D_c_, -delta_c_, *vec_c, *res_c);
+
+    // d: J_d x - s + (D_d - delta_d I) d
+    J_d_->MultVector(1., *vec_x, 0., *res_d);
+    res_d->Axpy(-1., *vec_s);
+    AddDiagTimesVector(D_d_, -delta_d_, *vec_d, *res_d);
+  }
+
+  void InexactMinresAugSystemSolver::ComputePreconditioner(CompoundVector& inv_prec) const
+  {
+    DBG_START_METH("InexactMinresAugSystemSolver::ComputePreconditioner",
+                   dbg_verbosity);
+
+    const Index nx = inv_prec.GetComp(0)->Dim();
+    const Index ns = inv_prec.GetComp(1)->Dim();
+    const Index nc = inv_prec.GetComp(2)->Dim();
+    const Index nd = inv_prec.GetComp(3)->Dim();
+
+    // x block: |diag(W) + D_x + delta_x|
+    Number* diag_x = new Number[nx];
+    if (D_x_) {
+      TripletHelper::FillValuesFromVector(nx, *D_x_, diag_x);
+    }
+    else {
+      for (Index i=0; i<nx; i++) {
+        diag_x[i] = 0.;
+      }
+    }
+    if (W_factor_ != 0.) {
+      Index nnz = TripletHelper::GetNumberEntries(*W_);
+      Index* irn = new Index[nnz];
+      Index* jcn = new Index[nnz];
+      Number* vals = new Number[nnz];
+      TripletHelper::FillRowCol(nnz, *W_, irn, jcn);
+      TripletHelper::FillValues(nnz, *W_, vals);
+      for (Index k=0; k<nnz; k++) {
+        if (irn[k] == jcn[k]) {
+          diag_x[irn[k]-1] += W_factor_*vals[k];
+        }
+      }
+      delete [] irn;
+      delete [] jcn;
+      delete [] vals;
+    }
+    for (Index i=0; i<nx; i++) {
+      diag_x[i] = Max(fabs(diag_x[i] + delta_x_), min_prec_diag);
+    }
+
+    // s block: |D_s + delta_s| (times the squared slack scaling)
+    Number* diag_s = new Number[ns];
+    if (D_s_) {
+      TripletHelper::FillValuesFromVector(ns, *D_s_, diag_s);
+    }
+    else {
+      for (Index i=0; i<ns; i++) {
+        diag_s[i] = 0.;
+      }
+    }
+    for (Index i=0; i<ns; i++) {
+      diag_s[i] = Max(fabs(diag_s[i] + delta_s_), min_prec_diag);
+    }
+
+    // c and d blocks: diagonal of the Schur complement with respect
+    // to the x and s blocks, plus |D_c - delta_c| and |D_d - delta_d|
+    Number* diag_c = new Number[nc];
+    if (D_c_) {
+      TripletHelper::FillValuesFromVector(nc, *D_c_, diag_c);
+    }
+    else {
+      for (Index i=0; i<nc; i++) {
+        diag_c[i] = 0.;
+      }
+    }
+    for (Index i=0; i<nc; i++) {
+      diag_c[i] = fabs(diag_c[i] - delta_c_);
+    }
+    AddSchurDiagonal(*J_c_, diag_x, diag_c);
+
+    Number* diag_d = new Number[nd];
+    if (D_d_) {
+      TripletHelper::FillValuesFromVector(nd, *D_d_, diag_d);
+    }
+    else {
+      for (Index i=0; i<nd; i++) {
+        diag_d[i] = 0.;
+      }
+    }
+    for (Index i=0; i<nd; i++) {
+      diag_d[i] = fabs(diag_d[i] - delta_d_) + 1./diag_s[i];
+    }
+    AddSchurDiagonal(*J_d_, diag_x, diag_d);
+
+    // Invert the diagonals
+    for (Index i=0; i<nx; i++) {
+      diag_x[i] = 1./diag_x[i];
+    }
+    for (Index i=0; i<ns; i++) {
+      diag_s[i] = 1./diag_s[i];
+    }
+    for (Index i=0; i<nc; i++) {
+      diag_c[i] = 1./Max(diag_c[i], min_prec_diag);
+    }
+    for (Index i=0; i<nd; i++) {
+      diag_d[i] = 1./Max(diag_d[i], min_prec_diag);
+    }
+
+    TripletHelper::PutValuesInVector(nx, diag_x, *inv_prec.GetCompNonConst(0));
+    TripletHelper::PutValuesInVector(ns, diag_s, *inv_prec.GetCompNonConst(1));
+    if (IsValid(scaling_slacks_)) {
+      SmartPtr<Vector> inv_prec_s = inv_prec.GetCompNonConst(1);
+      inv_prec_s->ElementWiseDivide(*scaling_slacks_);
+      inv_prec_s->ElementWiseDivide(*scaling_slacks_);
+    }
+    TripletHelper::PutValuesInVector(nc, diag_c, *inv_prec.GetCompNonConst(2));
+    TripletHelper::PutValuesInVector(nd, diag_d, *inv_prec.GetCompNonConst(3));
+
+    delete [] diag_x;
+    delete [] diag_s;
+    delete [] diag_c;
+    delete [] diag_d;
+  }
+
+  Index InexactMinresAugSystemSolver::NumberOfNegEVals() const
+  {
+    DBG_START_METH("InexactMinresAugSystemSolver::NumberOfNegEVals",dbg_verbosity);
+    DBG_ASSERT(false && "MINRES does not compute the inertia");
+    return -1;
+  }
+
+  bool InexactMinresAugSystemSolver::IncreaseQuality()
+  {
+    return false;
+  }
+
+} // namespace Ipopt
@@ -0,0 +1,190 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPINEXACTMINRESAUGSYSTEMSOLVER_HPP__
+#define __IPINEXACTMINRESAUGSYSTEMSOLVER_HPP__
+
+#include "IpAugSystemSolver.hpp"
+#include "IpCompoundVector.hpp"
+#include "IpInexactCq.hpp"
+#include "IpIterativeSolverTerminationTester.hpp"
+
+namespace Ipopt
+{
+
+  /** Matrix-free solver for the augmented system in the inexact
+   *  algorithm.  The (slack-scaled) augmented system is solved with
+   *  the preconditioned MINRES method, where the matrix is only
+   *  accessed through the MultVector and TransMultVector methods of
+   *  W, J_c and J_d, so that the system is never assembled.  The
+   *  preconditioner is block diagonal: the x and s blocks are
+   *  approximated by the absolute values of their diagonals, and the
+   *  constraint blocks by the diagonal of the corresponding Schur
+   *  complement.
+   *
+   *  As for the iterative Pardiso solver, the termination tester
+   *  (for the normal step or for the primal-dual step) is called in
+   *  every iteration and decides when the iteration can be stopped;
+   *  its result is stored in the global variable test_result_ for
+   *  the InexactPDSolver.
+   */
+  class InexactMinresAugSystemSolver: public AugSystemSolver
+  {
+  public:
+    /**@name Constructors/Destructors */
+    //@{
+    /** Constructor, given the termination testers for the normal
+     *  step and for the primal-dual step. */
+    InexactMinresAugSystemSolver(IterativeSolverTerminationTester& normal_tester,
+                                 IterativeSolverTerminationTester& pd_tester);
+
+    /** Default destructor */
+    virtual ~InexactMinresAugSystemSolver();
+    //@}
+
+    /** overloaded from AlgorithmStrategyObject */
+    bool InitializeImpl(const OptionsList& options,
+                        const std::string& prefix);
+
+    /** Solve the augmented system for one right hand side.  The
+     *  inertia of the matrix is not available, so check_NegEVals
+     *  must be false. */
+    virtual ESymSolverStatus Solve(
+      const SymMatrix* W,
+      double W_factor,
+      const Vector* D_x,
+      double delta_x,
+      const Vector* D_s,
+      double delta_s,
+      const Matrix* J_c,
+      const Vector* D_c,
+      double delta_c,
+      const Matrix* J_d,
+      const Vector* D_d,
+      double delta_d,
+      const Vector& rhs_x,
+      const Vector& rhs_s,
+      const Vector& rhs_c,
+      const Vector& rhs_d,
+      Vector& sol_x,
+      Vector& sol_s,
+      Vector& sol_c,
+      Vector& sol_d,
+      bool check_NegEVals,
+      Index numberOfNegEVals);
+
+    /** Number of negative eigenvalues.  Not available for this
+     *  solver. */
+    virtual Index NumberOfNegEVals() const;
+
+    /** Query whether inertia is computed by linear solver.  MINRES
+     *  does not compute the inertia. */
+    virtual bool ProvidesInertia() const
+    {
+      return false;
+    }
+
+    /** Request to increase quality of solution for next solve.  The
+     *  accuracy is controlled by the termination tests, so this
+     *  returns false. */
+    virtual bool IncreaseQuality();
+
+    /** Methods for IpoptType */
+    //@{
+    static void RegisterOptions(SmartPtr<RegisteredOptions> roptions);
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Default constructor */
+    InexactMinresAugSystemSolver();
+
+    /** Copy Constructor */
+    InexactMinresAugSystemSolver(const InexactMinresAugSystemSolver&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const InexactMinresAugSystemSolver&);
+    //@}
+
+    /** Method to easily access Inexact data */
+    InexactData& InexData()
+    {
+      InexactData& inexact_data =
+        static_cast<InexactData&>(IpData().AdditionalData());
+      DBG_ASSERT(dynamic_cast<InexactData*>(&IpData().AdditionalData()));
+      return inexact_data;
+    }
+
+    /** Method to easily access Inexact calculated quantities */
+    InexactCq& InexCq()
+    {
+      InexactCq& inexact_cq =
+        static_cast<InexactCq&>(IpCq().AdditionalCq());
+      DBG_ASSERT(dynamic_cast<InexactCq*>(&IpCq().AdditionalCq()));
+      return inexact_cq;
+    }
+
+    /** Compute the product of the (slack-scaled) augmented system
+     *  matrix of the current solve with vec. */
+    void MultAugMatrix(const CompoundVector& vec,
+                       CompoundVector& result) const;
+
+    /** Compute the inverse of the block diagonal preconditioner for
+     *  the (slack-scaled) augmented system matrix of the current
+     *  solve. */
+    void ComputePreconditioner(CompoundVector& inv_prec) const;
+
+    /** Termination tester for normal step computation */
+    SmartPtr<IterativeSolverTerminationTester> normal_tester_;
+
+    /** Termination tester for primal-dual step computation */
+    SmartPtr<IterativeSolverTerminationTester> pd_tester_;
+
+    /** @name Algorithmic parameters */
+    //@{
+    /** Maximal number of MINRES iterations for the primal-dual step */
+    Index minres_max_iter_;
+    /** Relative residual tolerance for the primal-dual step */
+    Number minres_relative_tol_;
+    /** Maximal number of MINRES iterations for the normal step */
+    Index normal_minres_max_iter_;
+    /** Relative residual tolerance for the normal step */
+    Number normal_minres_relative_tol_;
+    /** Flag indicating whether the system is scaled by the slacks */
+    bool requires_scaling_;
+    //@}
+
+    /** @name Augmented system matrix of the current solve */
+    //@{
+    const SymMatrix* W_;
+    Number W_factor_;
+    const Vector* D_x_;
+    Number delta_x_;
+    const Vector* D_s_;
+    Number delta_s_;
+    const Matrix* J_c_;
+    const Vector* D_c_;
+    Number delta_c_;
+    const Matrix* J_d_;
+    const Vector* D_d_;
+    Number delta_d_;
+    /** Slack scaling factors (NULL if the system is not scaled) */
+    SmartPtr<const Vector> scaling_slacks_;
+    //@}
+  };
+
+} // namespace Ipopt
+
+#endif
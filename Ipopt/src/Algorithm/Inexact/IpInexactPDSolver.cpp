@@ -20,8 +20,6 @@
 
 #include "IpIterativeSolverTerminationTester.hpp"
 
-extern Ipopt::IterativeSolverTerminationTester::ETerminationTest test_result_;
-
 namespace Ipopt
 {
 
@@ -75,7 +73,11 @@ namespace Ipopt
 
     std::string linear_solver;
     options.GetStringValue("linear_solver", linear_solver, prefix);
-    is_pardiso_ = (linear_solver=="pardiso");
+    std::string inexact_linear_solver;
+    options.GetStringValue("inexact_linear_solver", inexact_linear_solver,
+                           prefix);
+    is_iterative_ = (linear_solver=="pardiso" ||
+                     inexact_linear_solver=="minres");
 
     if (!augSysSolver_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(),
                                    options, prefix)) {
@@ -249,7 +251,7 @@ namespace Ipopt
         InexData().set_tangential_x(tangential_x);
         InexData().set_tangential_s(tangential_s);
 
-        if (!is_pardiso_) {
+        if (!is_iterative_) {
           // check if we need to modify the system
           bool modify_hessian = HessianRequiresChange();
           if (modify_hessian) {
@@ -130,9 +130,10 @@ namespace Ipopt
     Index inexact_regularization_ls_count_trigger_;
     //@}
 
-    /** flag indicating if we are dealing with the Pardiso solver
+    /** flag indicating if we are dealing with an iterative solver
+     *  (Pardiso or MINRES) that applies the termination tests
      *  (temporary) */
-    bool is_pardiso_;
+    bool is_iterative_;
 
     Index last_info_ls_count_;
   };
@@ -6,6 +6,7 @@
 //
 // Authors:  Andreas Waechter            IBM    2008-09-05
 
+#include "IpoptConfig.h"
 #include "IpInexactRegOp.hpp"
 #include "IpRegOptions.hpp"
 
@@ -16,7 +17,10 @@
 #include "IpInexactPDSolver.hpp"
 #include "IpInexactLSAcceptor.hpp"
 #include "IpInexactCq.hpp"
-#include "IpIterativePardisoSolverInterface.hpp"
+#ifdef HAVE_PARDISO
+# include "IpIterativePardisoSolverInterface.hpp"
+#endif
+#include "IpInexactMinresAugSystemSolver.hpp"
 #include "IpInexactNormalTerminationTester.hpp"
 #include "IpInexactPDTerminationTester.hpp"
 
@@ -33,7 +37,10 @@ namespace Ipopt
     InexactPDSolver::RegisterOptions(roptions);
     InexactLSAcceptor::RegisterOptions(roptions);
     InexactCq::RegisterOptions(roptions);
+#ifdef HAVE_PARDISO
     IterativePardisoSolverInterface::RegisterOptions(roptions);
+#endif
+    InexactMinresAugSystemSolver::RegisterOptions(roptions);
     InexactNormalTerminationTester::RegisterOptions(roptions);
     InexactPDTerminationTester::RegisterOptions(roptions);
   }
@@ -44,8 +44,8 @@
 #endif
 
 
-Ipopt::IterativeSolverTerminationTester* global_tester_ptr_;
-Ipopt::IterativeSolverTerminationTester::ETerminationTest test_result_;
+/** Termination tester called from Pardiso's callback */
+static Ipopt::IterativeSolverTerminationTester* global_tester_ptr_;
 extern "C"
 {
   int IpoptTerminationTest(int n, double* sol, double* resid, int iter, double norm2_rhs) {
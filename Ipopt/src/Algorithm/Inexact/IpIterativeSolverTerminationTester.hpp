@@ -126,4 +126,9 @@ namespace Ipopt
 
 } // namespace Ipopt
 
+/** Result of the last termination test in the iterative solver for
+ *  the augmented system (Pardiso or MINRES).  InexactPDSolver uses it
+ *  to decide how to treat the computed step. */
+extern Ipopt::IterativeSolverTerminationTester::ETerminationTest test_result_;
+
 #endif
@@ -16,6 +16,7 @@
 #include "IpCGPenaltyCq.hpp"
 
 #include "IpStdAugSystemSolver.hpp"
+#include "IpDomainDecompAugSystemSolver.hpp"
 #include "IpAugRestoSystemSolver.hpp"
 #include "IpPDFullSpaceSolver.hpp"
 #include "IpPDPerturbationHandler.hpp"
@@ -60,6 +61,7 @@
 #include "IpMa77SolverInterface.hpp"
 #include "IpMa86SolverInterface.hpp"
 #include "IpMa97SolverInterface.hpp"
+#include "IpNativeSolverInterface.hpp"
 #include "IpMc19TSymScalingMethod.hpp"
 #include "IpPardisoSolverInterface.hpp"
 #include "IpSlackBasedTSymScalingMethod.hpp"
@@ -138,7 +140,7 @@ namespace Ipopt
   void AlgorithmBuilder::RegisterOptions(SmartPtr<RegisteredOptions> roptions)
   {
     roptions->SetRegisteringCategory("Linear Solver");
-    roptions->AddStringOption9(
+    roptions->AddStringOption10(
       "linear_solver",
       "Linear solver used for step computations.",
 #ifdef COINHSL_HAS_MA27
@@ -165,7 +167,7 @@ namespace Ipopt
 #       ifdef COINHSL_HAS_MA77
         "ma77",
 #       else
-        "ma27",
+        "native",
 #       endif
 #      endif
 #     endif
@@ -182,6 +184,7 @@ namespace Ipopt
       "pardiso", "use the Pardiso package",
       "wsmp", "use WSMP package",
       "mumps", "use MUMPS package",
+      "native", "use the built-in sparse LDL^T solver",
       "custom", "use custom linear solver",
       "Determines which linear algebra package is to be used for the "
       "solution of the augmented linear system (for obtaining the search "
@@ -189,6 +192,21 @@ namespace Ipopt
       "Note, the code must have been compiled with the linear solver you want "
       "to choose. Depending on your Ipopt installation, not all options are "
       "available.");
+    roptions->AddStringOption2(
+      "aug_system_solver",
+      "Method for solving the augmented system.",
+      "standard",
+      "standard", "factorize the whole system with the linear solver",
+      "schur-complement", "domain decomposition with a Schur complement for the separator",
+      "With \"schur-complement\", the augmented system is partitioned into "
+      "independent subdomains and a separator.  The subdomains are "
+      "factorized concurrently with the built-in sparse LDL^T solver, and "
+      "the Schur complement of the separator is factorized as a dense "
+      "matrix.  The partition is taken from the integer meta data "
+      "\"subdomain\" of the variables if the NLP provides it, and is "
+      "computed otherwise (see \"schur_num_subdomains\").  If a subdomain "
+      "block is singular, the whole system is factorized with the solver "
+      "selected by \"linear_solver\" and \"linear_system_scaling\".");
     roptions->SetRegisteringCategory("Linear Solver");
     roptions->AddStringOption3(
       "linear_system_scaling",
@@ -472,12 +490,18 @@ namespace Ipopt
 #endif
 
     }
+    else if (linear_solver=="native") {
+      SolverInterface = new NativeSolverInterface();
+    }
     else if (linear_solver=="custom") {
       ASSERT_EXCEPTION(IsValid(custom_solver_), OPTION_INVALID,
                        "Selected linear solver CUSTOM not available.");
       use_custom_solver = true;
     }
 
+    std::string aug_system_solver;
+    options.GetStringValue("aug_system_solver", aug_system_solver, prefix);
+
     SmartPtr<AugSystemSolver> AugSolver;
     if (use_custom_solver) {
       AugSolver = custom_solver_;
@@ -522,6 +546,12 @@ namespace Ipopt
         new TSymLinearSolver(SolverInterface, ScalingMethod);
 
       AugSolver = new StdAugSystemSolver(*ScaledSolver);
+
+      if (aug_system_solver=="schur-complement") {
+        // The standard solver factorizes the whole system if a
+        // subdomain block is singular
+        AugSolver = new DomainDecompAugSystemSolver(*AugSolver);
+      }
     }
 
     Index enum_int;
@@ -696,6 +726,7 @@ namespace Ipopt
       SmartPtr<HessianUpdater> resto_HessUpdater;
       switch (hessian_approximation) {
       case EXACT:
+      case FINDIFF_VALUES:
         resto_HessUpdater = new ExactHessianUpdater();
         break;
       case LIMITED_MEMORY:
@@ -822,6 +853,7 @@ namespace Ipopt
     SmartPtr<HessianUpdater> HessUpdater;
     switch (hessian_approximation) {
     case EXACT:
+    case FINDIFF_VALUES:
       HessUpdater = new ExactHessianUpdater();
       break;
     case LIMITED_MEMORY:
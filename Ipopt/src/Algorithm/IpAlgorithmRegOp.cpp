@@ -12,6 +12,7 @@
 #include "IpAdaptiveMuUpdate.hpp"
 #include "IpAlgBuilder.hpp"
 #include "IpDefaultIterateInitializer.hpp"
+#include "IpDomainDecompAugSystemSolver.hpp"
 #include "IpBacktrackingLineSearch.hpp"
 #include "IpFilterLSAcceptor.hpp"
 #include "IpGradientScaling.hpp"
@@ -50,6 +51,8 @@ namespace Ipopt
     DefaultIterateInitializer::RegisterOptions(roptions);
     roptions->SetRegisteringCategory("Main Algorithm");
     AlgorithmBuilder::RegisterOptions(roptions);
+    roptions->SetRegisteringCategory("Linear Solver");
+    DomainDecompAugSystemSolver::RegisterOptions(roptions);
     roptions->SetRegisteringCategory("Line Search");
     BacktrackingLineSearch::RegisterOptions(roptions);
     roptions->SetRegisteringCategory("Line Search");
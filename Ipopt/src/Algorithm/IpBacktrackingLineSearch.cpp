@@ -85,6 +85,18 @@ namespace Ipopt
       "Accept a trial point after maximal this number of steps.",
       -1, -1,
       "Even if it does not satisfy line search conditions.");
+    roptions->AddLowerBoundedIntegerOption(
+      "concurrent_trial_points",
+      "Number of trial step sizes for which the functions are evaluated together.",
+      1, 1,
+      "If larger than 1, the objective function and the constraints are "
+      "evaluated concurrently (with OpenMP) at up to this many trial points "
+      "of the backtracking line search, for the next step sizes that would "
+      "be tried.  The points are then checked for acceptability in the usual "
+      "order.  This requires that the method thread_safe_evaluation of the "
+      "TNLP returns true; otherwise the points are evaluated one after the "
+      "other.  This is only useful if the function evaluations are "
+      "expensive.");
 
     roptions->AddStringOption10(
       "alpha_for_y",
@@ -207,6 +219,7 @@ namespace Ipopt
     options.GetBoolValue("magic_steps", magic_steps_, prefix);
     options.GetBoolValue("accept_every_trial_step", accept_every_trial_step_, prefix);
     options.GetIntegerValue("accept_after_max_steps", accept_after_max_steps_, prefix);
+    options.GetIntegerValue("concurrent_trial_points", concurrent_trial_points_, prefix);
     Index enum_int;
     bool is_default = !options.GetEnumValue("alpha_for_y", enum_int, prefix);
     alpha_for_y_ = AlphaForYEnum(enum_int);
@@ -688,6 +701,11 @@ namespace Ipopt
     }
 
     if (!accept) {
+      // Trial values of x for which the functions have already been
+      // evaluated concurrently
+      std::vector<SmartPtr<const Vector> > trial_xs;
+      Index next_trial_x = 0;
+
       // Loop over decreaseing step sizes until acceptable point is
       // found or until step size becomes too small
 
@@ -701,7 +719,21 @@ namespace Ipopt
 
         try {
           // Compute the primal trial point
-          IpData().SetTrialPrimalVariablesFromStep(alpha_primal, *actual_delta->x(), *actual_delta->s());
+          if (concurrent_trial_points_>1 && !in_watchdog_ &&
+              !accept_every_trial_step_) {
+            if (next_trial_x == (Index)trial_xs.size()) {
+              ComputeConcurrentTrialPoints(alpha_primal, alpha_min,
+                                           *actual_delta->x(), trial_xs);
+              next_trial_x = 0;
+            }
+            IpData().SetTrialPrimalVariables(*trial_xs[next_trial_x],
+                                             alpha_primal,
+                                             *actual_delta->s());
+            next_trial_x++;
+          }
+          else {
+            IpData().SetTrialPrimalVariablesFromStep(alpha_primal, *actual_delta->x(), *actual_delta->s());
+          }
 
           if (magic_steps_) {
             PerformMagicStep();
@@ -796,6 +828,48 @@ namespace Ipopt
     return accept;
   }
 
+  void BacktrackingLineSearch::ComputeConcurrentTrialPoints(Number alpha_primal,
+      Number alpha_min,
+      const Vector& delta_x,
+      std::vector<SmartPtr<const Vector> >& trial_xs)
+  {
+    DBG_START_METH("BacktrackingLineSearch::ComputeConcurrentTrialPoints",
+                   dbg_verbosity);
+
+    // The first step size is always tried, the following ones only
+    // if they are larger than alpha_min (as in the backtracking loop)
+    trial_xs.clear();
+    Number alpha = alpha_primal;
+    do {
+      SmartPtr<Vector> trial_x = IpData().curr()->x()->MakeNew();
+      trial_x->AddTwoVectors(1., *IpData().curr()->x(), alpha, delta_x, 0.);
+      trial_xs.push_back(ConstPtr(trial_x));
+      alpha *= alpha_red_factor_;
+    }
+    while ((Index)trial_xs.size()<concurrent_trial_points_ && alpha>alpha_min);
+
+    if (trial_xs.size()==1) {
+      return;
+    }
+
+    std::vector<const Vector*> trial_x_ptrs(trial_xs.size());
+    for (Index k=0; k<(Index)trial_xs.size(); k++) {
+      trial_x_ptrs[k] = GetRawPtr(trial_xs[k]);
+    }
+    if (!IpNLP().EvalConcurrently((Index)trial_xs.size(), &trial_x_ptrs[0])) {
+      // The NLP does not support concurrent evaluations; evaluate the
+      // trial points one at a time from now on
+      Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
+                     "NLP does not support concurrent evaluations, setting concurrent_trial_points to 1.\n");
+      concurrent_trial_points_ = 1;
+      trial_xs.resize(1);
+      return;
+    }
+    Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
+                   "Evaluated functions concurrently at %d trial points.\n",
+                   (Index)trial_xs.size());
+  }
+
   void BacktrackingLineSearch::StartWatchDog()
   {
     DBG_START_FUN("BacktrackingLineSearch::StartWatchDog", dbg_verbosity);
@@ -855,8 +929,16 @@ namespace Ipopt
   {
     DBG_START_FUN("BacktrackingLineSearch::PerformDualStep", dbg_verbosity);
 
-    // set the bound multipliers from the step
-    IpData().SetTrialBoundMultipliersFromStep(alpha_dual, *delta->z_L(), *delta->z_U(), *delta->v_L(), *delta->v_U());
+    // Only the step size for y that minimizes the dual infeasibility
+    // depends on the trial bound multipliers.  Otherwise, all
+    // multipliers are set at once below.
+    const bool min_dual_infeas =
+      (alpha_for_y_ == MIN_DUAL_INFEAS_ALPHA_FOR_Y ||
+       alpha_for_y_ == SAFE_MIN_DUAL_INFEAS_ALPHA_FOR_Y);
+    if (min_dual_infeas) {
+      // set the bound multipliers from the step
+      IpData().SetTrialBoundMultipliersFromStep(alpha_dual, *delta->z_L(), *delta->z_U(), *delta->v_L(), *delta->v_U());
+    }
 
     Number alpha_y=-1.;
     switch (alpha_for_y_) {
@@ -933,7 +1015,12 @@ namespace Ipopt
     DBG_PRINT((1, "alpha_y = %e\n", alpha_y));
     DBG_PRINT_VECTOR(2, "delta_y_c", *delta->y_c());
     DBG_PRINT_VECTOR(2, "delta_y_d", *delta->y_d());
-    IpData().SetTrialEqMultipliersFromStep(alpha_y, *delta->y_c(), *delta->y_d());
+    if (min_dual_infeas) {
+      IpData().SetTrialEqMultipliersFromStep(alpha_y, *delta->y_c(), *delta->y_d());
+    }
+    else {
+      IpData().SetTrialMultipliersFromStep(alpha_y, alpha_dual, *delta);
+    }
 
     // Set some information for iteration summary output
     IpData().Set_info_alpha_primal(alpha_primal);
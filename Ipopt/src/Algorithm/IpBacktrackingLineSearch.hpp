@@ -194,6 +194,17 @@ namespace Ipopt
                       Number& alpha_primal,
                       SmartPtr<IteratesVector>& actual_delta);
 
+    /** Compute the trial values of x for the step sizes
+     *  alpha_primal, alpha_primal*alpha_red_factor_, ... (at most
+     *  concurrent_trial_points_ of them, and after the first only
+     *  those larger than alpha_min), and let the NLP evaluate the
+     *  functions at these points concurrently.  If the NLP does not
+     *  support this, trial_xs has only the first point on return. */
+    void ComputeConcurrentTrialPoints(Number alpha_primal,
+                                      Number alpha_min,
+                                      const Vector& delta_x,
+                                      std::vector<SmartPtr<const Vector> >& trial_xs);
+
     /** Perform magic steps.  Take the current values of the slacks in
      *  trial and replace them by better ones that lead to smaller
      *  values of the barrier function and less constraint
@@ -266,6 +277,9 @@ namespace Ipopt
      *  point.  If set to value other than -1, we accept a trial point
      *  even if it is not satisfying acceptance criteria. */
     Index accept_after_max_steps_;
+    /** Number of trial points at which the functions are evaluated
+     *  concurrently. */
+    Index concurrent_trial_points_;
     /** Indicates whether problem can be expected to be infeasible.
      *  This will trigger requesting a tighter reduction in
      *  infeasibility the first time the restoration phase is
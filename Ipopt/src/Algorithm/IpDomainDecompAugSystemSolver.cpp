@@ -0,0 +1,1170 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpoptConfig.h"
+#include "IpDomainDecompAugSystemSolver.hpp"
+#include "IpNativeOrdering.hpp"
+#include "IpTripletHelper.hpp"
+#include "IpDenseVector.hpp"
+
+#include <algorithm>
+#include <map>
+
+#ifdef HAVE_CMATH
+# include <cmath>
+#else
+# ifdef HAVE_MATH_H
+#  include <math.h>
+# else
+#  error "don't have header file for math"
+# endif
+#endif
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  /** Number of columns of B_p that are solved for at once when the
+   *  Schur complement is computed */
+  static const Index schur_block_size = 32;
+
+  DomainDecompAugSystemSolver::DomainDecompAugSystemSolver(AugSystemSolver& full_solver)
+      :
+      AugSystemSolver(),
+      n_x_(0),
+      n_c_(0),
+      n_d_(0),
+      dim_(0),
+      nz_w_(0),
+      nz_jac_c_(0),
+      nz_jac_d_(0),
+      initialized_(false),
+      have_factorization_(false),
+      negevals_(0),
+      full_solver_(&full_solver),
+      use_full_solver_(false),
+      pivtol_changed_(false),
+      w_factor_(0.),
+      delta_x_(0.),
+      delta_s_(0.),
+      delta_c_(0.),
+      delta_d_(0.)
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::DomainDecompAugSystemSolver()",
+                   dbg_verbosity);
+    DBG_ASSERT(IsValid(full_solver_));
+  }
+
+  DomainDecompAugSystemSolver::~DomainDecompAugSystemSolver()
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::~DomainDecompAugSystemSolver()",
+                   dbg_verbosity);
+  }
+
+  void DomainDecompAugSystemSolver::RegisterOptions(SmartPtr<RegisteredOptions> roptions)
+  {
+    roptions->AddLowerBoundedIntegerOption(
+      "schur_num_subdomains",
+      "Number of subdomains for the Schur complement augmented system solver.",
+      1, 4,
+      "This is the number of subdomains into which the augmented system is "
+      "partitioned if \"aug_system_solver\" is \"schur-complement\" and the "
+      "NLP does not provide the \"subdomain\" meta data for the variables.  "
+      "Fewer subdomains are used if the graph of the variables cannot "
+      "be split further.");
+    roptions->AddLowerBoundedIntegerOption(
+      "schur_num_threads",
+      "Number of threads for the Schur complement augmented system solver.",
+      0, 0,
+      "The subdomains are factorized concurrently.  The value 0 uses the "
+      "OpenMP default.  This option has only an effect if Ipopt has been "
+      "compiled with OpenMP support.");
+  }
+
+  bool DomainDecompAugSystemSolver::InitializeImpl(const OptionsList& options,
+      const std::string& prefix)
+  {
+    options.GetIntegerValue("schur_num_subdomains", num_subdomains_, prefix);
+    options.GetIntegerValue("schur_num_threads", num_threads_, prefix);
+    // The following options are registered by NativeSolverInterface
+    options.GetNumericValue("native_pivtol", pivtol_, prefix);
+    if (options.GetNumericValue("native_pivtolmax", pivtolmax_, prefix)) {
+      ASSERT_EXCEPTION(pivtolmax_>=pivtol_, OPTION_INVALID,
+                       "Option \"native_pivtolmax\": This value must be between "
+                       "native_pivtol and 0.5.");
+    }
+    else {
+      pivtolmax_ = Max(pivtolmax_, pivtol_);
+    }
+    options.GetNumericValue("native_small", small_pivot_, prefix);
+
+    // Reset all private data
+    initialized_ = false;
+    have_factorization_ = false;
+    use_full_solver_ = false;
+    pivtol_changed_ = false;
+    subdomains_.clear();
+    sep_rows_.clear();
+    schur_factorization_ = NULL;
+    w_tag_ = TaggedObject::Tag();
+    d_x_tag_ = TaggedObject::Tag();
+    d_s_tag_ = TaggedObject::Tag();
+    j_c_tag_ = TaggedObject::Tag();
+    d_c_tag_ = TaggedObject::Tag();
+    j_d_tag_ = TaggedObject::Tag();
+    d_d_tag_ = TaggedObject::Tag();
+
+    return full_solver_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(),
+                                    options, prefix);
+  }
+
+  ESymSolverStatus DomainDecompAugSystemSolver::MultiSolve(
+    const SymMatrix* W,
+    double W_factor,
+    const Vector* D_x,
+    double delta_x,
+    const Vector* D_s,
+    double delta_s,
+    const Matrix* J_c,
+    const Vector* D_c,
+    double delta_c,
+    const Matrix* J_d,
+    const Vector* D_d,
+    double delta_d,
+    std::vector<SmartPtr<const Vector> >& rhs_xV,
+    std::vector<SmartPtr<const Vector> >& rhs_sV,
+    std::vector<SmartPtr<const Vector> >& rhs_cV,
+    std::vector<SmartPtr<const Vector> >& rhs_dV,
+    std::vector<SmartPtr<Vector> >& sol_xV,
+    std::vector<SmartPtr<Vector> >& sol_sV,
+    std::vector<SmartPtr<Vector> >& sol_cV,
+    std::vector<SmartPtr<Vector> >& sol_dV,
+    bool check_NegEVals,
+    Index numberOfNegEVals)
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::MultiSolve",dbg_verbosity);
+    DBG_ASSERT(J_c && J_d && "Currently, you MUST specify J_c and J_d in the augmented system");
+
+    const Index nrhs = (Index)rhs_xV.size();
+    DBG_ASSERT(nrhs>0);
+    DBG_ASSERT(nrhs==(Index)rhs_sV.size());
+    DBG_ASSERT(nrhs==(Index)rhs_cV.size());
+    DBG_ASSERT(nrhs==(Index)rhs_dV.size());
+    DBG_ASSERT(nrhs==(Index)sol_xV.size());
+    DBG_ASSERT(nrhs==(Index)sol_sV.size());
+    DBG_ASSERT(nrhs==(Index)sol_cV.size());
+    DBG_ASSERT(nrhs==(Index)sol_dV.size());
+
+    // The structure is computed again if W appears for the first time
+    // or if the dimensions have changed
+    const SymMatrix* Wgive = (W && W_factor!=0.) ? W : NULL;
+    bool new_structure = !initialized_;
+    if (!new_structure) {
+      new_structure =
+        rhs_xV[0]->Dim() != n_x_ || rhs_cV[0]->Dim() != n_c_ ||
+        rhs_dV[0]->Dim() != n_d_ ||
+        TripletHelper::GetNumberEntries(*J_c) != nz_jac_c_ ||
+        TripletHelper::GetNumberEntries(*J_d) != nz_jac_d_ ||
+        (Wgive && TripletHelper::GetNumberEntries(*Wgive) != nz_w_);
+    }
+    if (new_structure) {
+      IpData().TimingStats().LinearSystemSymbolicFactorization().Start();
+      ESymSolverStatus retval =
+        InitializeStructure(Wgive, *J_c, *J_d, *rhs_xV[0], *rhs_cV[0],
+                            *rhs_dV[0]);
+      IpData().TimingStats().LinearSystemSymbolicFactorization().End();
+      if (retval != SYMSOLVER_SUCCESS) {
+        if (retval == SYMSOLVER_FATAL_ERROR) {
+          THROW_EXCEPTION(FATAL_ERROR_IN_LINEAR_SOLVER,
+                          "The structure of the augmented system is invalid.");
+        }
+        return retval;
+      }
+    }
+
+    // Check if the input data has changed:
+    if (new_structure || pivtol_changed_ ||
+        (!have_factorization_ && !use_full_solver_) ||
+        AugmentedSystemChanged(W, W_factor, D_x, delta_x, D_s, delta_s,
+                               *J_c, D_c, delta_c, *J_d, D_d, delta_d)) {
+      FillValues(Wgive, W_factor, D_x, delta_x, D_s, delta_s,
+                 *J_c, D_c, delta_c, *J_d, D_d, delta_d);
+      UpdateTags(W, W_factor, D_x, delta_x, D_s, delta_s,
+                 *J_c, D_c, delta_c, *J_d, D_d, delta_d);
+      pivtol_changed_ = false;
+      use_full_solver_ = false;
+
+      bool subdomain_singular = false;
+      IpData().TimingStats().LinearSystemFactorization().Start();
+      ESymSolverStatus retval = Factorization(check_NegEVals,
+                                              numberOfNegEVals,
+                                              subdomain_singular);
+      IpData().TimingStats().LinearSystemFactorization().End();
+      have_factorization_ = (retval == SYMSOLVER_SUCCESS);
+      if (subdomain_singular) {
+        // The augmented system itself might not be singular, so that
+        // it is solved as a whole
+        Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                       "Schur complement solver: solving the full system instead.\n");
+        use_full_solver_ = true;
+      }
+      else if (retval != SYMSOLVER_SUCCESS) {
+        Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                       "Factorization failed with retval = %d\n", retval);
+        return retval;
+      }
+    }
+    else if (!use_full_solver_ && check_NegEVals &&
+             numberOfNegEVals != negevals_) {
+      return SYMSOLVER_WRONG_INERTIA;
+    }
+
+    if (use_full_solver_) {
+      return full_solver_->MultiSolve(W, W_factor, D_x, delta_x, D_s, delta_s,
+                                      J_c, D_c, delta_c, J_d, D_d, delta_d,
+                                      rhs_xV, rhs_sV, rhs_cV, rhs_dV,
+                                      sol_xV, sol_sV, sol_cV, sol_dV,
+                                      check_NegEVals, numberOfNegEVals);
+    }
+
+    // Order of the right hand sides is x, s, c, d
+    std::vector<Number> rhssol(nrhs*dim_);
+    for (Index irhs=0; irhs<nrhs; irhs++) {
+      Number* r = &rhssol[irhs*dim_];
+      TripletHelper::FillValuesFromVector(n_x_, *rhs_xV[irhs], r);
+      TripletHelper::FillValuesFromVector(n_d_, *rhs_sV[irhs], r+n_x_);
+      TripletHelper::FillValuesFromVector(n_c_, *rhs_cV[irhs],
+                                          r+n_x_+n_d_);
+      TripletHelper::FillValuesFromVector(n_d_, *rhs_dV[irhs],
+                                          r+n_x_+n_d_+n_c_);
+    }
+
+    IpData().TimingStats().LinearSystemBackSolve().Start();
+    SolveFactorized(nrhs, &rhssol[0]);
+    IpData().TimingStats().LinearSystemBackSolve().End();
+
+    for (Index irhs=0; irhs<nrhs; irhs++) {
+      const Number* r = &rhssol[irhs*dim_];
+      TripletHelper::PutValuesInVector(n_x_, r, *sol_xV[irhs]);
+      TripletHelper::PutValuesInVector(n_d_, r+n_x_, *sol_sV[irhs]);
+      TripletHelper::PutValuesInVector(n_c_, r+n_x_+n_d_, *sol_cV[irhs]);
+      TripletHelper::PutValuesInVector(n_d_, r+n_x_+n_d_+n_c_,
+                                       *sol_dV[irhs]);
+    }
+
+    return SYMSOLVER_SUCCESS;
+  }
+
+  ESymSolverStatus
+  DomainDecompAugSystemSolver::InitializeStructure(const SymMatrix* W,
+      const Matrix& J_c,
+      const Matrix& J_d,
+      const Vector& x,
+      const Vector& c,
+      const Vector& d)
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::InitializeStructure",
+                   dbg_verbosity);
+
+    initialized_ = false;
+    have_factorization_ = false;
+    n_x_ = x.Dim();
+    n_c_ = c.Dim();
+    n_d_ = d.Dim();
+    dim_ = n_x_+n_d_+n_c_+n_d_;
+    nz_w_ = W ? TripletHelper::GetNumberEntries(*W) : 0;
+    nz_jac_c_ = TripletHelper::GetNumberEntries(J_c);
+    nz_jac_d_ = TripletHelper::GetNumberEntries(J_d);
+
+    // Triplets in the order W, diagonal, J_c, J_d, -I (for s and d)
+    const Index nz = nz_w_ + dim_ + nz_jac_c_ + nz_jac_d_ + n_d_;
+    airn_.resize(nz);
+    ajcn_.resize(nz);
+    avals_.resize(nz);
+    Index pos = 0;
+    if (nz_w_>0) {
+      TripletHelper::FillRowCol(nz_w_, *W, &airn_[pos], &ajcn_[pos]);
+      pos += nz_w_;
+    }
+    for (Index i=0; i<dim_; i++) {
+      airn_[pos] = i+1;
+      ajcn_[pos] = i+1;
+      pos++;
+    }
+    if (nz_jac_c_>0) {
+      TripletHelper::FillRowCol(nz_jac_c_, J_c, &airn_[pos], &ajcn_[pos],
+                                n_x_+n_d_, 0);
+      pos += nz_jac_c_;
+    }
+    if (nz_jac_d_>0) {
+      TripletHelper::FillRowCol(nz_jac_d_, J_d, &airn_[pos], &ajcn_[pos],
+                                n_x_+n_d_+n_c_, 0);
+      pos += nz_jac_d_;
+    }
+    for (Index i=0; i<n_d_; i++) {
+      airn_[pos] = n_x_+n_d_+n_c_+i+1;
+      ajcn_[pos] = n_x_+i+1;
+      pos++;
+    }
+    DBG_ASSERT(pos == nz);
+
+    // Convert to 0-based positions in the upper triangular part
+    for (Index k=0; k<nz; k++) {
+      Index irow = airn_[k]-1;
+      Index jcol = ajcn_[k]-1;
+      if (irow<0 || irow>=dim_ || jcol<0 || jcol>=dim_) {
+        Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                       "The index of a matrix is out of range.\nPlease check your implementation of the Jacobian and Hessian matrices.\n");
+        return SYMSOLVER_FATAL_ERROR;
+      }
+      if (irow > jcol) {
+        std::swap(irow, jcol);
+      }
+      airn_[k] = irow;
+      ajcn_[k] = jcol;
+    }
+
+    std::vector<Index> part;
+    const Index nparts = ComputePartition(x, c, d, part);
+
+    // Local numbering of the rows in the subdomains and the separator
+    subdomains_.clear();
+    subdomains_.resize(nparts);
+    sep_rows_.clear();
+    std::vector<Index> loc(dim_);
+    for (Index i=0; i<dim_; i++) {
+      if (part[i] >= 0) {
+        loc[i] = (Index)subdomains_[part[i]].rows.size();
+        subdomains_[part[i]].rows.push_back(i);
+      }
+      else {
+        loc[i] = (Index)sep_rows_.size();
+        sep_rows_.push_back(i);
+      }
+    }
+    const Index nsep = (Index)sep_rows_.size();
+
+    // Distribute the entries into the blocks
+    sep_entry_row_.clear();
+    sep_entry_col_.clear();
+    sep_entry_pos_.clear();
+    std::vector<std::vector<Index> > block_irn(nparts);
+    std::vector<std::vector<Index> > block_jcn(nparts);
+    // Couplings as (separator row, local row, triplet position)
+    std::vector<std::vector<std::pair<Index, std::pair<Index, Index> > > >
+    couplings(nparts);
+    for (Index k=0; k<nz; k++) {
+      const Index irow = airn_[k];
+      const Index jcol = ajcn_[k];
+      const Index pi = part[irow];
+      const Index pj = part[jcol];
+      if (pi>=0 && pj>=0) {
+        DBG_ASSERT(pi == pj);
+        Subdomain& sub = subdomains_[pi];
+        sub.block_pos.push_back(k);
+        block_irn[pi].push_back(loc[irow]+1);
+        block_jcn[pi].push_back(loc[jcol]+1);
+      }
+      else if (pi<0 && pj<0) {
+        sep_entry_row_.push_back(loc[irow]);
+        sep_entry_col_.push_back(loc[jcol]);
+        sep_entry_pos_.push_back(k);
+      }
+      else if (pi>=0) {
+        couplings[pi].push_back(std::make_pair(loc[jcol],
+                                               std::make_pair(loc[irow], k)));
+      }
+      else {
+        couplings[pj].push_back(std::make_pair(loc[irow],
+                                               std::make_pair(loc[jcol], k)));
+      }
+    }
+
+    // Store the couplings by separator columns
+    for (Index p=0; p<nparts; p++) {
+      Subdomain& sub = subdomains_[p];
+      std::sort(couplings[p].begin(), couplings[p].end());
+      sub.sep.clear();
+      sub.coupling_ptr.clear();
+      sub.coupling_row.clear();
+      sub.coupling_pos.clear();
+      for (Index e=0; e<(Index)couplings[p].size(); e++) {
+        const Index q = couplings[p][e].first;
+        if (sub.sep.empty() || sub.sep.back() != q) {
+          sub.sep.push_back(q);
+          sub.coupling_ptr.push_back(e);
+        }
+        sub.coupling_row.push_back(couplings[p][e].second.first);
+        sub.coupling_pos.push_back(couplings[p][e].second.second);
+      }
+      sub.coupling_ptr.push_back((Index)couplings[p].size());
+      const Index nsp = (Index)sub.sep.size();
+      sub.schur_update.resize(nsp*nsp);
+    }
+
+    // Symbolic factorizations of the subdomain blocks
+    bool failed = false;
+#ifdef _OPENMP
+    const Index nthreads = (num_threads_ > 0) ? num_threads_ : omp_get_max_threads();
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads) if(nparts>1)
+#endif
+    for (Index p=0; p<nparts; p++) {
+      Subdomain& sub = subdomains_[p];
+      const Index nrows = (Index)sub.rows.size();
+      const Index nblock = (Index)sub.block_pos.size();
+      sub.converter = new TripletToCSRConverter(0);
+      const Index nz_csr =
+        sub.converter->InitializeConverter(nrows, nblock, &block_irn[p][0],
+                                           &block_jcn[p][0]);
+      sub.triplet_vals.resize(nblock);
+      sub.csr_vals.resize(nz_csr);
+      SmartPtr<NativeSymbolicFactorization> symbolic =
+        new NativeSymbolicFactorization();
+      ESymSolverStatus retval =
+        symbolic->Analyze(nrows, nz_csr, sub.converter->IA(),
+                          sub.converter->JA(),
+                          NativeSymbolicFactorization::AMD_ORDERING);
+      if (retval != SYMSOLVER_SUCCESS) {
+#ifdef _OPENMP
+        #pragma omp critical (DomainDecompAnalyze)
+#endif
+        failed = true;
+      }
+      else {
+        sub.factorization = new NativeLDLFactorization(ConstPtr(symbolic));
+      }
+    }
+    if (failed) {
+      return SYMSOLVER_FATAL_ERROR;
+    }
+
+    // Symbolic factorization of the dense Schur complement
+    schur_.resize(nsep*nsep);
+    schur_factorization_ = NULL;
+    if (nsep>0) {
+      const Index nz_schur = nsep*(nsep+1)/2;
+      std::vector<Index> ia(nsep+1);
+      std::vector<Index> ja(nz_schur);
+      Index f = 0;
+      for (Index i=0; i<nsep; i++) {
+        ia[i] = f;
+        for (Index j=i; j<nsep; j++) {
+          ja[f++] = j;
+        }
+      }
+      ia[nsep] = f;
+      schur_csr_vals_.resize(nz_schur);
+      SmartPtr<NativeSymbolicFactorization> symbolic =
+        new NativeSymbolicFactorization();
+      ESymSolverStatus retval =
+        symbolic->Analyze(nsep, nz_schur, &ia[0], &ja[0],
+                          NativeSymbolicFactorization::AMD_ORDERING);
+      if (retval != SYMSOLVER_SUCCESS) {
+        return retval;
+      }
+      schur_factorization_ = new NativeLDLFactorization(ConstPtr(symbolic));
+    }
+
+    if (Jnlst().ProduceOutput(J_DETAILED, J_LINEAR_ALGEBRA)) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Schur complement solver: %d subdomains, separator of size %d.\n",
+                     nparts, nsep);
+      for (Index p=0; p<nparts; p++) {
+        Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                       "  subdomain %3d: %8d rows, %6d separator rows coupled\n",
+                       p, (Index)subdomains_[p].rows.size(),
+                       (Index)subdomains_[p].sep.size());
+      }
+    }
+
+    initialized_ = true;
+    return SYMSOLVER_SUCCESS;
+  }
+
+  Index DomainDecompAugSystemSolver::ComputePartition(const Vector& x,
+      const Vector& c,
+      const Vector& d,
+      std::vector<Index>& part) const
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::ComputePartition",
+                   dbg_verbosity);
+
+    const Index nz = (Index)airn_.size();
+    const Index off_s = n_x_;
+    const Index off_c = n_x_+n_d_;
+    const Index off_d = n_x_+n_d_+n_c_;
+
+    // Graph of the augmented system
+    std::vector<Index> ptr(dim_+1, 0);
+    for (Index k=0; k<nz; k++) {
+      if (airn_[k] != ajcn_[k]) {
+        ptr[airn_[k]+1]++;
+        ptr[ajcn_[k]+1]++;
+      }
+    }
+    for (Index i=0; i<dim_; i++) {
+      ptr[i+1] += ptr[i];
+    }
+    std::vector<Index> adj(ptr[dim_]);
+    {
+      std::vector<Index> next(ptr.begin(), ptr.end()-1);
+      for (Index k=0; k<nz; k++) {
+        if (airn_[k] != ajcn_[k]) {
+          adj[next[airn_[k]]++] = ajcn_[k];
+          adj[next[ajcn_[k]]++] = airn_[k];
+        }
+      }
+    }
+
+    part.assign(dim_, -1);
+
+    const DenseVectorSpace* x_space =
+      dynamic_cast<const DenseVectorSpace*>(GetRawPtr(x.OwnerSpace()));
+    const DenseVectorSpace* c_space =
+      dynamic_cast<const DenseVectorSpace*>(GetRawPtr(c.OwnerSpace()));
+    const DenseVectorSpace* d_space =
+      dynamic_cast<const DenseVectorSpace*>(GetRawPtr(d.OwnerSpace()));
+    std::map<Index, Index> md_number;
+    const std::vector<Index>* c_md = NULL;
+    const std::vector<Index>* d_md = NULL;
+    if (x_space && x_space->HasIntegerMetaData("subdomain")) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Schur complement solver: using the subdomain meta data of the NLP.\n");
+      // Subdomain numbers given by the user are renumbered
+      // consecutively
+      const std::vector<Index>& x_md =
+        x_space->GetIntegerMetaData("subdomain");
+      for (Index i=0; i<n_x_; i++) {
+        if (x_md[i] >= 0) {
+          std::map<Index, Index>::iterator it = md_number.find(x_md[i]);
+          if (it == md_number.end()) {
+            it = md_number.insert(std::make_pair(x_md[i],
+                                                 (Index)md_number.size())).first;
+          }
+          part[i] = it->second;
+        }
+      }
+      if (c_space && c_space->HasIntegerMetaData("subdomain")) {
+        c_md = &c_space->GetIntegerMetaData("subdomain");
+      }
+      if (d_space && d_space->HasIntegerMetaData("subdomain")) {
+        d_md = &d_space->GetIntegerMetaData("subdomain");
+      }
+    }
+    else {
+      // Only the variables are partitioned, in the graph in which two
+      // variables are adjacent if they appear together in W or in a
+      // constraint, and the constraints are assigned below as for
+      // the meta data.  Constraints with many variables are left out
+      // of the graph, they usually end up in the separator anyway.
+      const Index max_clique = 64;
+      std::vector<std::pair<Index, Index> > edges;
+      for (Index k=0; k<nz; k++) {
+        if (ajcn_[k]<n_x_ && airn_[k]!=ajcn_[k]) {
+          edges.push_back(std::make_pair(airn_[k], ajcn_[k]));
+          edges.push_back(std::make_pair(ajcn_[k], airn_[k]));
+        }
+      }
+      std::vector<Index> vars;
+      for (Index i=off_c; i<dim_; i++) {
+        vars.clear();
+        for (Index k=ptr[i]; k<ptr[i+1]; k++) {
+          if (adj[k] < n_x_) {
+            vars.push_back(adj[k]);
+          }
+        }
+        if ((Index)vars.size() > max_clique) {
+          continue;
+        }
+        for (Index k=0; k<(Index)vars.size(); k++) {
+          for (Index l=k+1; l<(Index)vars.size(); l++) {
+            edges.push_back(std::make_pair(vars[k], vars[l]));
+            edges.push_back(std::make_pair(vars[l], vars[k]));
+          }
+        }
+      }
+      std::sort(edges.begin(), edges.end());
+      edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+      std::vector<Index> x_ptr(n_x_+1, 0);
+      std::vector<Index> x_adj(edges.size());
+      for (Index k=0; k<(Index)edges.size(); k++) {
+        x_ptr[edges[k].first+1]++;
+        x_adj[k] = edges[k].second;
+      }
+      for (Index i=0; i<n_x_; i++) {
+        x_ptr[i+1] += x_ptr[i];
+      }
+      if (n_x_ > 0) {
+        NativeGraphPartition(n_x_, &x_ptr[0],
+                             x_adj.empty() ? NULL : &x_adj[0],
+                             num_subdomains_, &part[0]);
+      }
+    }
+
+    for (Index i=off_c; i<dim_; i++) {
+      const std::vector<Index>* md = (i<off_d) ? c_md : d_md;
+      if (md) {
+        const Index val = (*md)[(i<off_d) ? i-off_c : i-off_d];
+        if (val >= 0) {
+          std::map<Index, Index>::iterator it = md_number.find(val);
+          if (it != md_number.end()) {
+            part[i] = it->second;
+          }
+        }
+        continue;
+      }
+      // A constraint without meta data belongs to a subdomain only if
+      // all its variables do.  Then the constraint rows of a
+      // subdomain block are complete rows of the Jacobian, which have
+      // full rank if the Jacobian has.  A constraint with a variable
+      // in the separator would lose an entry, and this often makes
+      // the subdomain block singular.
+      Index p = -1;
+      bool coupling = false;
+      for (Index k=ptr[i]; k<ptr[i+1] && !coupling; k++) {
+        const Index j = adj[k];
+        if (j<n_x_) {
+          coupling = (part[j]<0 || (p>=0 && part[j]!=p));
+          p = part[j];
+        }
+      }
+      part[i] = coupling ? -1 : p;
+    }
+    // A slack belongs to the subdomain of its inequality
+    for (Index i=0; i<n_d_; i++) {
+      part[off_s+i] = part[off_d+i];
+    }
+    // Entries between different subdomains are removed by moving
+    // the second row into the separator
+    for (Index k=0; k<nz; k++) {
+      const Index pi = part[airn_[k]];
+      const Index pj = part[ajcn_[k]];
+      if (pi>=0 && pj>=0 && pi!=pj) {
+        part[ajcn_[k]] = -1;
+      }
+    }
+
+    // Each constraint row (c and d) of a subdomain is matched with a
+    // different primal row (x and s) of the same subdomain.  If this
+    // is not possible, the constraint rows of the subdomain block do
+    // not have full structural rank, and the block is singular, since
+    // the diagonal of the c and d rows is usually zero.  Unmatched
+    // constraint rows are moved into the separator.
+    std::vector<Index> mate(dim_, -1);
+    std::vector<Index> seen(dim_, -1);
+    std::vector<Index> path_row;
+    std::vector<Index> path_pos;
+    std::vector<Index> path_via;
+    for (Index r=off_c; r<dim_; r++) {
+      const Index p = part[r];
+      if (p < 0) {
+        continue;
+      }
+      // Cheap assignment first
+      for (Index k=ptr[r]; k<ptr[r+1] && mate[r]<0; k++) {
+        const Index j = adj[k];
+        if (j<off_c && part[j]==p && mate[j]<0) {
+          mate[j] = r;
+          mate[r] = j;
+        }
+      }
+      if (mate[r] >= 0) {
+        continue;
+      }
+      // Depth-first search for an augmenting path
+      path_row.assign(1, r);
+      path_pos.assign(1, ptr[r]);
+      path_via.clear();
+      Index free_j = -1;
+      while (!path_row.empty() && free_j<0) {
+        const Index i = path_row.back();
+        Index& k = path_pos.back();
+        Index next = -1;
+        for (; k<ptr[i+1]; k++) {
+          const Index j = adj[k];
+          if (j<off_c && part[j]==p && seen[j]!=r) {
+            seen[j] = r;
+            if (mate[j] < 0) {
+              free_j = j;
+              break;
+            }
+            next = j;
+            k++;
+            break;
+          }
+        }
+        if (free_j >= 0) {
+          break;
+        }
+        if (next >= 0) {
+          path_via.push_back(next);
+          path_row.push_back(mate[next]);
+          path_pos.push_back(ptr[mate[next]]);
+        }
+        else {
+          path_row.pop_back();
+          path_pos.pop_back();
+          if (!path_via.empty()) {
+            path_via.pop_back();
+          }
+        }
+      }
+      if (free_j >= 0) {
+        path_via.push_back(free_j);
+        for (Index l=0; l<(Index)path_row.size(); l++) {
+          mate[path_row[l]] = path_via[l];
+          mate[path_via[l]] = path_row[l];
+        }
+      }
+      else {
+        part[r] = -1;
+      }
+    }
+
+    // A primal row without off-diagonal entries in its subdomain block
+    // would make the block singular if its diagonal entry is zero
+    for (Index i=0; i<off_c; i++) {
+      const Index p = part[i];
+      if (p < 0) {
+        continue;
+      }
+      bool inside = false;
+      for (Index k=ptr[i]; k<ptr[i+1] && !inside; k++) {
+        inside = (part[adj[k]] == p);
+      }
+      if (!inside) {
+        part[i] = -1;
+      }
+    }
+
+    // Renumber the nonempty subdomains
+    std::vector<Index> number;
+    Index nparts = 0;
+    for (Index i=0; i<dim_; i++) {
+      const Index p = part[i];
+      if (p >= 0) {
+        if (p >= (Index)number.size()) {
+          number.resize(p+1, -1);
+        }
+        if (number[p] < 0) {
+          number[p] = nparts++;
+        }
+        part[i] = number[p];
+      }
+    }
+    return nparts;
+  }
+
+  void DomainDecompAugSystemSolver::FillValues(const SymMatrix* W,
+      double W_factor,
+      const Vector* D_x,
+      double delta_x,
+      const Vector* D_s,
+      double delta_s,
+      const Matrix& J_c,
+      const Vector* D_c,
+      double delta_c,
+      const Matrix& J_d,
+      const Vector* D_d,
+      double delta_d)
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::FillValues",dbg_verbosity);
+
+    Number* vals = &avals_[0];
+    if (nz_w_>0) {
+      if (W) {
+        TripletHelper::FillValues(nz_w_, *W, vals);
+        if (W_factor != 1.) {
+          for (Index k=0; k<nz_w_; k++) {
+            vals[k] *= W_factor;
+          }
+        }
+      }
+      else {
+        // The structure includes W, but W is not part of this system
+        for (Index k=0; k<nz_w_; k++) {
+          vals[k] = 0.;
+        }
+      }
+    }
+    vals += nz_w_;
+
+    const Vector* diags[4] = {D_x, D_s, D_c, D_d};
+    const Number deltas[4] = {delta_x, delta_s, -delta_c, -delta_d};
+    const Index dims[4] = {n_x_, n_d_, n_c_, n_d_};
+    for (Index b=0; b<4; b++) {
+      if (diags[b]) {
+        TripletHelper::FillValuesFromVector(dims[b], *diags[b], vals);
+        for (Index i=0; i<dims[b]; i++) {
+          vals[i] += deltas[b];
+        }
+      }
+      else {
+        for (Index i=0; i<dims[b]; i++) {
+          vals[i] = deltas[b];
+        }
+      }
+      vals += dims[b];
+    }
+
+    if (nz_jac_c_>0) {
+      TripletHelper::FillValues(nz_jac_c_, J_c, vals);
+    }
+    vals += nz_jac_c_;
+    if (nz_jac_d_>0) {
+      TripletHelper::FillValues(nz_jac_d_, J_d, vals);
+    }
+    vals += nz_jac_d_;
+    for (Index i=0; i<n_d_; i++) {
+      vals[i] = -1.;
+    }
+  }
+
+  ESymSolverStatus
+  DomainDecompAugSystemSolver::Factorization(bool check_NegEVals,
+      Index numberOfNegEVals,
+      bool& subdomain_singular)
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::Factorization",
+                   dbg_verbosity);
+
+    const Index nparts = (Index)subdomains_.size();
+    const Index nsep = (Index)sep_rows_.size();
+
+    // Factorize the subdomain blocks and compute their contributions
+    // B_p^T A_pp^{-1} B_p to the Schur complement
+    bool singular = false;
+#ifdef _OPENMP
+    const Index nthreads = (num_threads_ > 0) ? num_threads_ : omp_get_max_threads();
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads) if(nparts>1)
+#endif
+    for (Index p=0; p<nparts; p++) {
+      Subdomain& sub = subdomains_[p];
+      const Index nrows = (Index)sub.rows.size();
+      const Index nblock = (Index)sub.block_pos.size();
+      for (Index k=0; k<nblock; k++) {
+        sub.triplet_vals[k] = avals_[sub.block_pos[k]];
+      }
+      sub.converter->ConvertValues(nblock, &sub.triplet_vals[0],
+                                   (Index)sub.csr_vals.size(),
+                                   &sub.csr_vals[0]);
+      // The subdomains are already factorized concurrently
+      ESymSolverStatus retval =
+        sub.factorization->NumericFactorization(&sub.csr_vals[0], pivtol_,
+            small_pivot_, 1);
+      if (retval != SYMSOLVER_SUCCESS) {
+#ifdef _OPENMP
+        #pragma omp critical (DomainDecompFactorization)
+#endif
+        singular = true;
+        continue;
+      }
+
+      const Index nsp = (Index)sub.sep.size();
+      std::vector<Number> X(nrows*Min(nsp, schur_block_size));
+      for (Index b0=0; b0<nsp; b0+=schur_block_size) {
+        const Index nb = Min(schur_block_size, nsp-b0);
+        // X = A_pp^{-1} B_p(:, b0:b0+nb-1)
+        std::fill(X.begin(), X.begin()+nrows*nb, 0.);
+        for (Index jj=0; jj<nb; jj++) {
+          const Index q = b0+jj;
+          for (Index e=sub.coupling_ptr[q]; e<sub.coupling_ptr[q+1]; e++) {
+            X[jj*nrows + sub.coupling_row[e]] += avals_[sub.coupling_pos[e]];
+          }
+        }
+        sub.factorization->Solve(nb, &X[0]);
+        // B_p^T X, only for the upper triangle
+        for (Index jj=0; jj<nb; jj++) {
+          const Index q = b0+jj;
+          const Number* x = &X[jj*nrows];
+          for (Index a=0; a<=q; a++) {
+            Number sum = 0.;
+            for (Index e=sub.coupling_ptr[a]; e<sub.coupling_ptr[a+1]; e++) {
+              sum += avals_[sub.coupling_pos[e]] * x[sub.coupling_row[e]];
+            }
+            sub.schur_update[a + q*nsp] = sum;
+          }
+        }
+      }
+    }
+    subdomain_singular = singular;
+    if (singular) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Schur complement solver: subdomain block is singular.\n");
+      return SYMSOLVER_SINGULAR;
+    }
+
+    negevals_ = 0;
+    Index ndelayed = 0;
+    for (Index p=0; p<nparts; p++) {
+      negevals_ += subdomains_[p].factorization->NumberOfNegEVals();
+      ndelayed += subdomains_[p].factorization->NumberOfDelayedPivots();
+    }
+
+    if (nsep>0) {
+      // Assemble S = A_SS - sum_p B_p^T A_pp^{-1} B_p (upper triangle)
+      std::fill(schur_.begin(), schur_.end(), 0.);
+      for (Index e=0; e<(Index)sep_entry_pos_.size(); e++) {
+        const Index i = Min(sep_entry_row_[e], sep_entry_col_[e]);
+        const Index j = Max(sep_entry_row_[e], sep_entry_col_[e]);
+        schur_[i + j*nsep] += avals_[sep_entry_pos_[e]];
+      }
+      for (Index p=0; p<nparts; p++) {
+        const Subdomain& sub = subdomains_[p];
+        const Index nsp = (Index)sub.sep.size();
+        for (Index b=0; b<nsp; b++) {
+          for (Index a=0; a<=b; a++) {
+            // sub.sep is sorted, so that sub.sep[a] <= sub.sep[b]
+            schur_[sub.sep[a] + sub.sep[b]*nsep] -=
+              sub.schur_update[a + b*nsp];
+          }
+        }
+      }
+      Index f = 0;
+      for (Index i=0; i<nsep; i++) {
+        for (Index j=i; j<nsep; j++) {
+          schur_csr_vals_[f++] = schur_[i + j*nsep];
+        }
+      }
+
+      ESymSolverStatus retval =
+        schur_factorization_->NumericFactorization(&schur_csr_vals_[0],
+            pivtol_, small_pivot_,
+            num_threads_);
+      if (retval != SYMSOLVER_SUCCESS) {
+        Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                       "Schur complement solver: Schur complement is singular.\n");
+        return retval;
+      }
+      negevals_ += schur_factorization_->NumberOfNegEVals();
+    }
+
+    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                   "Schur complement solver: %d negative eigenvalues, %d delayed pivots in the subdomains.\n",
+                   negevals_, ndelayed);
+
+    if (check_NegEVals && (numberOfNegEVals!=negevals_)) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "In DomainDecompAugSystemSolver::Factorization: negevals_ = %d, but numberOfNegEVals = %d\n",
+                     negevals_, numberOfNegEVals);
+      return SYMSOLVER_WRONG_INERTIA;
+    }
+
+    return SYMSOLVER_SUCCESS;
+  }
+
+  void DomainDecompAugSystemSolver::SolveFactorized(Index nrhs,
+      Number* rhs_vals) const
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::SolveFactorized",
+                   dbg_verbosity);
+
+    const Index nparts = (Index)subdomains_.size();
+    const Index nsep = (Index)sep_rows_.size();
+#ifdef _OPENMP
+    const Index nthreads = (num_threads_ > 0) ? num_threads_ : omp_get_max_threads();
+#endif
+
+    // y_p = A_pp^{-1} r_p
+    std::vector<std::vector<Number> > y(nparts);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads) if(nparts>1)
+#endif
+    for (Index p=0; p<nparts; p++) {
+      const Subdomain& sub = subdomains_[p];
+      const Index nrows = (Index)sub.rows.size();
+      y[p].resize(nrows*nrhs);
+      for (Index irhs=0; irhs<nrhs; irhs++) {
+        for (Index r=0; r<nrows; r++) {
+          y[p][irhs*nrows + r] = rhs_vals[irhs*dim_ + sub.rows[r]];
+        }
+      }
+      sub.factorization->Solve(nrhs, &y[p][0]);
+    }
+
+    if (nsep==0) {
+      for (Index p=0; p<nparts; p++) {
+        const Subdomain& sub = subdomains_[p];
+        const Index nrows = (Index)sub.rows.size();
+        for (Index irhs=0; irhs<nrhs; irhs++) {
+          for (Index r=0; r<nrows; r++) {
+            rhs_vals[irhs*dim_ + sub.rows[r]] = y[p][irhs*nrows + r];
+          }
+        }
+      }
+      return;
+    }
+
+    // x_S = S^{-1} (r_S - sum_p B_p^T y_p)
+    std::vector<Number> xs(nsep*nrhs);
+    for (Index irhs=0; irhs<nrhs; irhs++) {
+      for (Index i=0; i<nsep; i++) {
+        xs[irhs*nsep + i] = rhs_vals[irhs*dim_ + sep_rows_[i]];
+      }
+    }
+    for (Index p=0; p<nparts; p++) {
+      const Subdomain& sub = subdomains_[p];
+      const Index nrows = (Index)sub.rows.size();
+      const Index nsp = (Index)sub.sep.size();
+      for (Index irhs=0; irhs<nrhs; irhs++) {
+        const Number* yp = &y[p][irhs*nrows];
+        Number* xsp = &xs[irhs*nsep];
+        for (Index q=0; q<nsp; q++) {
+          Number sum = 0.;
+          for (Index e=sub.coupling_ptr[q]; e<sub.coupling_ptr[q+1]; e++) {
+            sum += avals_[sub.coupling_pos[e]] * yp[sub.coupling_row[e]];
+          }
+          xsp[sub.sep[q]] -= sum;
+        }
+      }
+    }
+    schur_factorization_->Solve(nrhs, &xs[0]);
+
+    // x_p = A_pp^{-1} (r_p - B_p x_S)
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads) if(nparts>1)
+#endif
+    for (Index p=0; p<nparts; p++) {
+      const Subdomain& sub = subdomains_[p];
+      const Index nrows = (Index)sub.rows.size();
+      const Index nsp = (Index)sub.sep.size();
+      std::vector<Number> z(nrows*nrhs, 0.);
+      for (Index irhs=0; irhs<nrhs; irhs++) {
+        Number* zp = &z[irhs*nrows];
+        const Number* xsp = &xs[irhs*nsep];
+        for (Index q=0; q<nsp; q++) {
+          const Number xq = xsp[sub.sep[q]];
+          for (Index e=sub.coupling_ptr[q]; e<sub.coupling_ptr[q+1]; e++) {
+            zp[sub.coupling_row[e]] += avals_[sub.coupling_pos[e]] * xq;
+          }
+        }
+      }
+      sub.factorization->Solve(nrhs, &z[0]);
+      for (Index k=0; k<nrows*nrhs; k++) {
+        y[p][k] -= z[k];
+      }
+    }
+
+    for (Index p=0; p<nparts; p++) {
+      const Subdomain& sub = subdomains_[p];
+      const Index nrows = (Index)sub.rows.size();
+      for (Index irhs=0; irhs<nrhs; irhs++) {
+        for (Index r=0; r<nrows; r++) {
+          rhs_vals[irhs*dim_ + sub.rows[r]] = y[p][irhs*nrows + r];
+        }
+      }
+    }
+    for (Index irhs=0; irhs<nrhs; irhs++) {
+      for (Index i=0; i<nsep; i++) {
+        rhs_vals[irhs*dim_ + sep_rows_[i]] = xs[irhs*nsep + i];
+      }
+    }
+  }
+
+  void DomainDecompAugSystemSolver::UpdateTags(const SymMatrix* W,
+      double W_factor,
+      const Vector* D_x,
+      double delta_x,
+      const Vector* D_s,
+      double delta_s,
+      const Matrix& J_c,
+      const Vector* D_c,
+      double delta_c,
+      const Matrix& J_d,
+      const Vector* D_d,
+      double delta_d)
+  {
+    w_tag_ = W ? W->GetTag() : TaggedObject::Tag();
+    w_factor_ = W_factor;
+    d_x_tag_ = D_x ? D_x->GetTag() : TaggedObject::Tag();
+    delta_x_ = delta_x;
+    d_s_tag_ = D_s ? D_s->GetTag() : TaggedObject::Tag();
+    delta_s_ = delta_s;
+    d_c_tag_ = D_c ? D_c->GetTag() : TaggedObject::Tag();
+    delta_c_ = delta_c;
+    d_d_tag_ = D_d ? D_d->GetTag() : TaggedObject::Tag();
+    delta_d_ = delta_d;
+    j_c_tag_ = J_c.GetTag();
+    j_d_tag_ = J_d.GetTag();
+  }
+
+  bool DomainDecompAugSystemSolver::AugmentedSystemChanged(
+    const SymMatrix* W,
+    double W_factor,
+    const Vector* D_x,
+    double delta_x,
+    const Vector* D_s,
+    double delta_s,
+    const Matrix& J_c,
+    const Vector* D_c,
+    double delta_c,
+    const Matrix& J_d,
+    const Vector* D_d,
+    double delta_d)
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::AugmentedSystemChanged",
+                   dbg_verbosity);
+
+    return (W && W->GetTag() != w_tag_)
+           || (!W && w_tag_ != TaggedObject::Tag())
+           || (W_factor != w_factor_)
+           || (D_x && D_x->GetTag() != d_x_tag_)
+           || (!D_x && d_x_tag_ != TaggedObject::Tag())
+           || (delta_x != delta_x_)
+           || (D_s && D_s->GetTag() != d_s_tag_)
+           || (!D_s && d_s_tag_ != TaggedObject::Tag())
+           || (delta_s != delta_s_)
+           || (J_c.GetTag() != j_c_tag_)
+           || (D_c && D_c->GetTag() != d_c_tag_)
+           || (!D_c && d_c_tag_ != TaggedObject::Tag())
+           || (delta_c != delta_c_)
+           || (J_d.GetTag() != j_d_tag_)
+           || (D_d && D_d->GetTag() != d_d_tag_)
+           || (!D_d && d_d_tag_ != TaggedObject::Tag())
+           || (delta_d != delta_d_);
+  }
+
+  Index DomainDecompAugSystemSolver::NumberOfNegEVals() const
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::NumberOfNegEVals",
+                   dbg_verbosity);
+    if (use_full_solver_) {
+      return full_solver_->NumberOfNegEVals();
+    }
+    return negevals_;
+  }
+
+  bool DomainDecompAugSystemSolver::IncreaseQuality()
+  {
+    DBG_START_METH("DomainDecompAugSystemSolver::IncreaseQuality",
+                   dbg_verbosity);
+    if (use_full_solver_) {
+      return full_solver_->IncreaseQuality();
+    }
+    if (pivtol_ == pivtolmax_) {
+      return false;
+    }
+    pivtol_changed_ = true;
+
+    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                   "Increasing pivot tolerance for the Schur complement solver from %7.2e ",
+                   pivtol_);
+    pivtol_ = Min(pivtolmax_, pow(pivtol_,0.75));
+    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                   "to %7.2e.\n",
+                   pivtol_);
+    return true;
+  }
+
+} // namespace Ipopt
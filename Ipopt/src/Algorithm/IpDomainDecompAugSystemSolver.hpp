@@ -0,0 +1,333 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IP_DOMAINDECOMPAUGSYSTEMSOLVER_HPP__
+#define __IP_DOMAINDECOMPAUGSYSTEMSOLVER_HPP__
+
+#include "IpAugSystemSolver.hpp"
+#include "IpNativeLDLFactorization.hpp"
+#include "IpTripletToCSRConverter.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+  /** Solver for the augmented system by domain decomposition.
+   *
+   *  The rows of the augmented system are partitioned into
+   *  independent subdomains and a separator, such that there are no
+   *  nonzeros between two different subdomains.  With the
+   *  subdomain blocks A_pp, the couplings B_p between subdomain p and
+   *  the separator, and the separator block A_SS, the system is
+   *  solved with the Schur complement
+   *
+   *     S = A_SS - sum_p B_p^T A_pp^{-1} B_p.
+   *
+   *  The subdomain blocks are factorized concurrently (if Ipopt has
+   *  been compiled with OpenMP support) with the built-in sparse
+   *  LDL^T solver, and S is assembled as a dense matrix and
+   *  factorized with the same solver.  By the Haynsworth inertia
+   *  additivity formula, the number of negative eigenvalues of the
+   *  augmented system is the sum of the ones of the A_pp and of S.
+   *
+   *  The partition is taken from the integer meta data "subdomain"
+   *  for the variables (and, optionally, for the constraints) if the
+   *  NLP provides it.  Values between 0 and the number of subdomains
+   *  minus one assign a variable to a subdomain, -1 assigns it to the
+   *  separator.  Constraints without meta data are assigned to the
+   *  subdomain of their variables, and to the separator if they
+   *  couple different subdomains or contain a separator variable.
+   *  If there is no such meta data, the variables are partitioned by
+   *  repeated nested dissection bisections of the graph in which two
+   *  variables are adjacent if they appear together in W or in a
+   *  constraint.
+   *
+   *  If a subdomain block is singular, the Schur complement is not
+   *  defined even if the augmented system is not singular.  The
+   *  system is then solved with the solver for the full system that
+   *  is given to the constructor, until the matrix changes.
+   */
+  class DomainDecompAugSystemSolver : public AugSystemSolver
+  {
+  public:
+    /**@name Constructors/Destructors */
+    //@{
+    /** Constructor, given the solver for the full system that is
+     *  used if a subdomain block is singular. */
+    DomainDecompAugSystemSolver(AugSystemSolver& full_solver);
+
+    /** Default destructor */
+    virtual ~DomainDecompAugSystemSolver();
+    //@}
+
+    /** overloaded from AlgorithmStrategyObject */
+    bool InitializeImpl(const OptionsList& options,
+                        const std::string& prefix);
+
+    /** Set up the augmented system and solve it for a set of given
+     *  right hand sides. */
+    virtual ESymSolverStatus MultiSolve(
+      const SymMatrix* W,
+      double W_factor,
+      const Vector* D_x,
+      double delta_x,
+      const Vector* D_s,
+      double delta_s,
+      const Matrix* J_c,
+      const Vector* D_c,
+      double delta_c,
+      const Matrix* J_d,
+      const Vector* D_d,
+      double delta_d,
+      std::vector<SmartPtr<const Vector> >& rhs_xV,
+      std::vector<SmartPtr<const Vector> >& rhs_sV,
+      std::vector<SmartPtr<const Vector> >& rhs_cV,
+      std::vector<SmartPtr<const Vector> >& rhs_dV,
+      std::vector<SmartPtr<Vector> >& sol_xV,
+      std::vector<SmartPtr<Vector> >& sol_sV,
+      std::vector<SmartPtr<Vector> >& sol_cV,
+      std::vector<SmartPtr<Vector> >& sol_dV,
+      bool check_NegEVals,
+      Index numberOfNegEVals);
+
+    /** Number of negative eigenvalues detected during last
+     *  factorization (of the full system if it has been solved with
+     *  the full system solver). */
+    virtual Index NumberOfNegEVals() const;
+
+    /** The inertia is computed if the full system solver computes
+     *  it. */
+    virtual bool ProvidesInertia() const
+    {
+      return full_solver_->ProvidesInertia();
+    }
+
+    /** Request to increase quality of solution for next solve.  The
+     *  pivot tolerance for the subdomain and Schur complement
+     *  factorizations is increased (or the request is passed on to
+     *  the full system solver if it has been used for the most recent
+     *  matrix).  Returns false, if the maximal pivot tolerance is
+     *  already used. */
+    virtual bool IncreaseQuality();
+
+    /** Methods for IpoptType */
+    //@{
+    static void RegisterOptions(SmartPtr<RegisteredOptions> roptions);
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Default Constructor */
+    DomainDecompAugSystemSolver();
+
+    /** Copy Constructor */
+    DomainDecompAugSystemSolver(const DomainDecompAugSystemSolver&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const DomainDecompAugSystemSolver&);
+    //@}
+
+    /** Data for one subdomain. */
+    struct Subdomain
+    {
+      /** Global rows of the augmented system in this subdomain */
+      std::vector<Index> rows;
+      /** Separator rows (positions in sep_rows_) coupled to this
+       *  subdomain */
+      std::vector<Index> sep;
+      /** Converter for the triplets of the block A_pp (Fortran
+       *  numbering, as in TSymLinearSolver) */
+      SmartPtr<TripletToCSRConverter> converter;
+      /** Global triplet positions of the entries of A_pp */
+      std::vector<Index> block_pos;
+      /** Values of A_pp in triplet and in CSR format */
+      std::vector<Number> triplet_vals;
+      std::vector<Number> csr_vals;
+      /** The coupling B_p, stored by columns: the entries of column q
+       *  (position in sep) are in
+       *  [coupling_ptr[q], coupling_ptr[q+1]), with the local row in
+       *  coupling_row and the global triplet position in
+       *  coupling_pos. */
+      std::vector<Index> coupling_ptr;
+      std::vector<Index> coupling_row;
+      std::vector<Index> coupling_pos;
+      /** Factorization of A_pp */
+      SmartPtr<NativeLDLFactorization> factorization;
+      /** Contribution B_p^T A_pp^{-1} B_p to the Schur complement
+       *  (dense, for the rows in sep) */
+      std::vector<Number> schur_update;
+    };
+
+    /** Check the internal tags and decide if the passed variables are
+     *  different from what is in the augmented system */
+    bool AugmentedSystemChanged(const SymMatrix* W,
+                                double W_factor,
+                                const Vector* D_x,
+                                double delta_x,
+                                const Vector* D_s,
+                                double delta_s,
+                                const Matrix& J_c,
+                                const Vector* D_c,
+                                double delta_c,
+                                const Matrix& J_d,
+                                const Vector* D_d,
+                                double delta_d);
+
+    void UpdateTags(const SymMatrix* W,
+                    double W_factor,
+                    const Vector* D_x,
+                    double delta_x,
+                    const Vector* D_s,
+                    double delta_s,
+                    const Matrix& J_c,
+                    const Vector* D_c,
+                    double delta_c,
+                    const Matrix& J_d,
+                    const Vector* D_d,
+                    double delta_d);
+
+    /** Compute the triplet structure of the augmented system, the
+     *  partition, and the symbolic factorizations of the subdomain
+     *  blocks and of the Schur complement. */
+    ESymSolverStatus InitializeStructure(const SymMatrix* W,
+                                         const Matrix& J_c,
+                                         const Matrix& J_d,
+                                         const Vector& x,
+                                         const Vector& c,
+                                         const Vector& d);
+
+    /** Compute the partition of the rows of the augmented system into
+     *  subdomains (part[i]>=0) and separator (part[i]==-1).  Returns
+     *  the number of subdomains. */
+    Index ComputePartition(const Vector& x, const Vector& c,
+                           const Vector& d, std::vector<Index>& part) const;
+
+    /** Fill the values of the triplets of the augmented system. */
+    void FillValues(const SymMatrix* W,
+                    double W_factor,
+                    const Vector* D_x,
+                    double delta_x,
+                    const Vector* D_s,
+                    double delta_s,
+                    const Matrix& J_c,
+                    const Vector* D_c,
+                    double delta_c,
+                    const Matrix& J_d,
+                    const Vector* D_d,
+                    double delta_d);
+
+    /** Factorize the subdomain blocks and the Schur complement.
+     *  subdomain_singular is set to true if the factorization failed
+     *  because a subdomain block is singular. */
+    ESymSolverStatus Factorization(bool check_NegEVals,
+                                   Index numberOfNegEVals,
+                                   bool& subdomain_singular);
+
+    /** Solve with the most recent factorization for nrhs right hand
+     *  sides, stored one after the other in rhs_vals (with the
+     *  dimension of the augmented system).  The solutions overwrite
+     *  the right hand sides. */
+    void SolveFactorized(Index nrhs, Number* rhs_vals) const;
+
+    /** @name Dimensions and structure of the augmented system, in the
+     *  order x, s, c, d */
+    //@{
+    Index n_x_;
+    Index n_c_;
+    Index n_d_;
+    Index dim_;
+    /** Number of nonzeros of W in the structure (0 if the structure
+     *  has been computed without W) */
+    Index nz_w_;
+    Index nz_jac_c_;
+    Index nz_jac_d_;
+    /** Triplet structure (0-based) and values of the upper triangular
+     *  part of the augmented system */
+    std::vector<Index> airn_;
+    std::vector<Index> ajcn_;
+    std::vector<Number> avals_;
+    /** Subdomains */
+    std::vector<Subdomain> subdomains_;
+    /** Global rows of the separator */
+    std::vector<Index> sep_rows_;
+    /** Entries of the separator block A_SS: row and column in
+     *  sep_rows_ and global triplet position */
+    std::vector<Index> sep_entry_row_;
+    std::vector<Index> sep_entry_col_;
+    std::vector<Index> sep_entry_pos_;
+    /** Dense Schur complement (column-major, upper triangle) and its
+     *  values in CSR format for the factorization */
+    std::vector<Number> schur_;
+    std::vector<Number> schur_csr_vals_;
+    SmartPtr<NativeLDLFactorization> schur_factorization_;
+    /** Flag indicating whether the structure has been initialized */
+    bool initialized_;
+    /** Flag indicating whether the most recent factorization was
+     *  successful and can be used for the solves */
+    bool have_factorization_;
+    //@}
+
+    /** Number of negative eigenvalues in the most recent
+     *  factorization */
+    Index negevals_;
+
+    /** Solver for the full system, used if a subdomain block is
+     *  singular */
+    SmartPtr<AugSystemSolver> full_solver_;
+
+    /** Flag indicating that a subdomain block of the current matrix
+     *  is singular, so that the full system solver is used */
+    bool use_full_solver_;
+
+    /** Flag indicating that the pivot tolerance has been increased
+     *  since the last factorization */
+    bool pivtol_changed_;
+
+    /**@name Tags and values to track in order to decide whether the
+       matrix has to be updated compared to the most recent call of
+       the Set method.
+     */
+    //@{
+    TaggedObject::Tag w_tag_;
+    double w_factor_;
+    TaggedObject::Tag d_x_tag_;
+    double delta_x_;
+    TaggedObject::Tag d_s_tag_;
+    double delta_s_;
+    TaggedObject::Tag j_c_tag_;
+    TaggedObject::Tag d_c_tag_;
+    double delta_c_;
+    TaggedObject::Tag j_d_tag_;
+    TaggedObject::Tag d_d_tag_;
+    double delta_d_;
+    //@}
+
+    /** @name Algorithmic parameters */
+    //@{
+    /** Number of subdomains for the automatic partition */
+    Index num_subdomains_;
+    /** Number of threads (0 for the OpenMP default) */
+    Index num_threads_;
+    /** Pivot tolerance and its maximal value */
+    Number pivtol_;
+    Number pivtolmax_;
+    /** Zero pivot threshold */
+    Number small_pivot_;
+    //@}
+  };
+
+} // namespace Ipopt
+
+#endif
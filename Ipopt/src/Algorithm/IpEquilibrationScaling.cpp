@@ -238,6 +238,7 @@ namespace Ipopt
                                  const Matrix& Px_U, const Vector& x_U)
   {
     DBG_START_METH("PointPerturber::PointPerturber", dbg_verbosity);
+    IpResetRandom01(random_state_);
     const Number very_large = 1e300;
     // First we compute full-space lower and upper bounds
     SmartPtr<Vector> full_x_L = x0.MakeNew();
@@ -284,7 +285,7 @@ namespace Ipopt
     TripletHelper::FillValuesFromVector(nx, *pert_dir_, pert_vals);
 
     for (Index i=0; i<nx; i++) {
-      Number random = IpRandom01();
+      Number random = IpRandom01(random_state_);
       vals[i] += 2.*(random-0.5)*pert_vals[i];
     }
     delete [] pert_vals;
@@ -130,6 +130,9 @@ namespace Ipopt
 
     /** pointer to the perturbation vector */
     SmartPtr<Vector> pert_dir_;
+
+    /** State of the random number generator for the perturbations */
+    mutable unsigned short random_state_[3];
   };
 
 } // namespace Ipopt
@@ -20,7 +20,7 @@ namespace Ipopt
   //                            Filter entries                             //
   ///////////////////////////////////////////////////////////////////////////
 
-  FilterEntry::FilterEntry(std::vector<Number> vals, Index iter)
+  FilterEntry::FilterEntry(const std::vector<Number>& vals, Index iter)
       :
       vals_(vals),
       iter_(iter)
@@ -38,7 +38,7 @@ namespace Ipopt
       dim_(dim)
   {}
 
-  bool Filter::Acceptable(std::vector<Number> vals) const
+  bool Filter::Acceptable(const std::vector<Number>& vals) const
   {
     DBG_START_METH("FilterLineSearch::Filter::Acceptable", dbg_verbosity);
     DBG_ASSERT((Index)vals.size()==dim_);
@@ -54,7 +54,7 @@ namespace Ipopt
     return acceptable;
   }
 
-  void Filter::AddEntry(std::vector<Number> vals, Index iteration)
+  void Filter::AddEntry(const std::vector<Number>& vals, Index iteration)
   {
     DBG_START_METH("FilterLineSearch::Filter::AddEntry", dbg_verbosity);
     DBG_ASSERT((Index)vals.size()==dim_);
@@ -111,4 +111,98 @@ namespace Ipopt
     }
   }
 
+  ///////////////////////////////////////////////////////////////////////////
+  //                          Two-dimensional filter                       //
+  ///////////////////////////////////////////////////////////////////////////
+
+  Filter2D::Filter2D()
+  {}
+
+  Index Filter2D::LowerBound(Number val1) const
+  {
+    Index lo = 0;
+    Index hi = (Index)entries_.size();
+    while (lo < hi) {
+      Index mid = lo + (hi-lo)/2;
+      if (entries_[mid].val1 < val1) {
+        lo = mid + 1;
+      }
+      else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  bool Filter2D::Acceptable(Number val1, Number val2) const
+  {
+    DBG_START_METH("Filter2D::Acceptable", dbg_verbosity);
+    // The pair is rejected by an entry if it is larger in both
+    // coordinates.  Of all entries with a smaller first coordinate,
+    // the last one has the smallest second coordinate.
+    Index pos = LowerBound(val1);
+    if (pos == 0) {
+      return true;
+    }
+    return (val2 <= entries_[pos-1].val2);
+  }
+
+  void Filter2D::AddEntry(Number val1, Number val2, Index iteration)
+  {
+    DBG_START_METH("Filter2D::AddEntry", dbg_verbosity);
+    Index pos = LowerBound(val1);
+
+    // Nothing to do if an entry dominates the new one
+    if (pos > 0 && entries_[pos-1].val2 <= val2) {
+      return;
+    }
+    if (pos < (Index)entries_.size() && entries_[pos].val1 == val1 &&
+        entries_[pos].val2 <= val2) {
+      return;
+    }
+
+    // The entries dominated by the new one follow directly at pos,
+    // since their second coordinates are decreasing
+    Index end = pos;
+    while (end < (Index)entries_.size() && entries_[end].val2 >= val2) {
+      end++;
+    }
+
+    Entry new_entry;
+    new_entry.val1 = val1;
+    new_entry.val2 = val2;
+    new_entry.iter = iteration;
+    if (end > pos) {
+      entries_[pos] = new_entry;
+      entries_.erase(entries_.begin()+pos+1, entries_.begin()+end);
+    }
+    else {
+      entries_.insert(entries_.begin()+pos, new_entry);
+    }
+  }
+
+  void Filter2D::Clear()
+  {
+    DBG_START_METH("Filter2D::Clear", dbg_verbosity);
+    entries_.clear();
+  }
+
+  void Filter2D::Print(const Journalist& jnlst)
+  {
+    DBG_START_METH("Filter2D::Print", dbg_verbosity);
+    jnlst.Printf(J_DETAILED, J_LINE_SEARCH,
+                 "The current filter has %d entries.\n", (Index)entries_.size());
+    if (!jnlst.ProduceOutput(J_VECTOR, J_LINE_SEARCH)) {
+      return;
+    }
+    for (Index i=0; i<(Index)entries_.size(); i++) {
+      if (i % 10 == 0) {
+        jnlst.Printf(J_VECTOR, J_LINE_SEARCH,
+                     "                phi                    theta            iter\n");
+      }
+      jnlst.Printf(J_VECTOR, J_LINE_SEARCH, "%5d %23.16e %23.16e %5d\n",
+                   i+1, entries_[i].val1, entries_[i].val2, entries_[i].iter);
+    }
+  }
+
 } // namespace Ipopt
@@ -24,7 +24,7 @@ namespace Ipopt
     /**@name Constructors/Destructors */
     //@{
     /** Constructor with the two components and the current iteration count */
-    FilterEntry(std::vector<Number> vals, Index iter);
+    FilterEntry(const std::vector<Number>& vals, Index iter);
 
     /** Default Destructor */
     ~FilterEntry();
@@ -33,7 +33,7 @@ namespace Ipopt
     /** Check acceptability of pair (phi,theta) with respect
      *  to this filter entry.  Returns true, if pair is acceptable.
      */
-    bool Acceptable(std::vector<Number> vals) const
+    bool Acceptable(const std::vector<Number>& vals) const
     {
       Index ncoor = (Index)vals_.size();
       DBG_ASSERT((Index)vals.size() == ncoor);
@@ -53,7 +53,7 @@ namespace Ipopt
     /** Check if this entry is dominated by given coordinates.
      *  Returns true, if this entry is dominated.
      */
-    bool Dominated(std::vector<Number> vals) const
+    bool Dominated(const std::vector<Number>& vals) const
     {
       Index ncoor = (Index)vals_.size();
       DBG_ASSERT((Index)vals.size() == ncoor);
@@ -126,11 +126,11 @@ namespace Ipopt
     /** Check acceptability of given coordinates with respect
      *  to the filter.  Returns true, if pair is acceptable
      */
-    bool Acceptable(std::vector<Number> vals) const;
+    bool Acceptable(const std::vector<Number>& vals) const;
 
     /** Add filter entry for given coordinates.  This will also
      *  delete all dominated entries in the current filter. */
-    void AddEntry(std::vector<Number> vals, Index iteration);
+    void AddEntry(const std::vector<Number>& vals, Index iteration);
 
     /** @name Wrappers for 2-dimensional filter. */
     //@{
@@ -184,6 +184,75 @@ namespace Ipopt
     mutable std::list<FilterEntry*> filter_list_;
   };
 
+  /** Class for a filter with two coordinates.  It can be used
+   *  instead of Filter(2).  Since dominated entries are removed, the
+   *  entries form a staircase: sorted by increasing first
+   *  coordinate, the second coordinate is decreasing.  The entries
+   *  are kept in this order, so that the acceptability of a pair is
+   *  checked by a binary search, and the entries dominated by a new
+   *  entry are found next to its position. */
+  class Filter2D
+  {
+  public:
+    /**@name Constructors/Destructors */
+    //@{
+    /** Default Constructor */
+    Filter2D();
+    /** Default Destructor */
+    ~Filter2D()
+    {}
+    //@}
+
+    /** Check acceptability of pair (val1,val2) with respect to the
+     *  filter.  Returns true, if pair is acceptable. */
+    bool Acceptable(Number val1, Number val2) const;
+
+    /** Add filter entry for given pair.  This will also delete all
+     *  dominated entries in the current filter.  The entry is not
+     *  stored if it is dominated by an entry in the filter, since it
+     *  would not change the filter. */
+    void AddEntry(Number val1, Number val2, Index iteration);
+
+    /** Delete all filter entries */
+    void Clear();
+
+    /** Print current filter entries */
+    void Print(const Journalist& jnlst);
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and 
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Copy Constructor */
+    Filter2D(const Filter2D&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const Filter2D&);
+    //@}
+
+    /** One entry of the filter */
+    struct Entry
+    {
+      Number val1;
+      Number val2;
+      /** iteration number in which this entry was added to filter */
+      Index iter;
+    };
+
+    /** Returns the position of the first entry whose first
+     *  coordinate is not smaller than val1. */
+    Index LowerBound(Number val1) const;
+
+    /** Filter entries, sorted by increasing val1 (and thus
+     *  decreasing val2). */
+    std::vector<Entry> entries_;
+  };
+
 } // namespace Ipopt
 
 #endif
@@ -32,7 +32,6 @@ namespace Ipopt
 
   FilterLSAcceptor::FilterLSAcceptor(const SmartPtr<PDSystemSolver>& pd_solver)
       :
-      filter_(2),
       pd_solver_(pd_solver)
   {
     DBG_START_FUN("FilterLSAcceptor::FilterLSAcceptor",
@@ -242,7 +242,7 @@ namespace Ipopt
     //@}
 
     /** Filter with entries */
-    Filter filter_;
+    Filter2D filter_;
 
     /** @name Filter reset stuff */
     //@{
@@ -101,6 +101,32 @@ namespace Ipopt
       "otherwise specified, the values of \"bound_push\", \"bound_frac\", and "
       "\"bound_mult_init_val\" are set more aggressive, and sets "
       "\"alpha_for_y=bound_mult\".");
+    roptions->SetRegisteringCategory("Main Algorithm");
+    roptions->AddLowerBoundedIntegerOption(
+      "vector_num_threads",
+      "Number of threads for operations on large vectors.",
+      0, 0,
+      "If Ipopt has been compiled with OpenMP support, the element-wise "
+      "operations and reductions on the vectors of the problem with at least "
+      "\"vector_parallel_min_dim\" elements are executed by this number of "
+      "threads.  The value 0 means that the OpenMP default is used.  Sums "
+      "over such vectors are always accumulated in the same fixed blocks, "
+      "also with one thread, so that the results do not depend on the "
+      "number of threads.");
+    roptions->AddLowerBoundedIntegerOption(
+      "vector_parallel_min_dim",
+      "Minimal dimension of vectors for which operations are executed in parallel.",
+      1, 100000,
+      "See \"vector_num_threads\".");
+    roptions->AddLowerBoundedNumberOption(
+      "vector_pool_max_memory",
+      "Maximal memory (in MB) kept for reuse by each vector space.",
+      0.0, false, 100.0,
+      "The memory of vectors that are no longer used is kept by the vector "
+      "space and used again for new vectors, so that no memory has to be "
+      "allocated for the vector values once the algorithm has reached a "
+      "steady state.  This option limits the memory that is kept for each "
+      "vector space of the problem.  The value 0 disables the reuse.");
     roptions->SetRegisteringCategory("");
     roptions->AddStringOption2(
       "sb",
@@ -65,6 +65,8 @@ namespace Ipopt
 #endif
 
     iter_count_ = 0;
+    lowrank_correction_solves_ = 0;
+    lowrank_saved_solves_ = 0;
     curr_mu_ = -1.;
     mu_initialized_ = false;
     curr_tau_ = -1.;
@@ -196,6 +198,25 @@ namespace Ipopt
     set_trial(newvec);
   }
 
+  void IpoptData::SetTrialPrimalVariables(const Vector& trial_x,
+                                          Number alpha,
+                                          const Vector& delta_s)
+  {
+    DBG_ASSERT(have_prototypes_);
+
+    if (IsNull(trial_)) {
+      trial_ = iterates_space_->MakeNewIteratesVector(false);
+    }
+
+    SmartPtr<IteratesVector> newvec = trial_->MakeNewContainer();
+    newvec->Set_x(trial_x);
+
+    newvec->create_new_s();
+    newvec->s_NonConst()->AddTwoVectors(1., *curr_->s(), alpha, delta_s, 0.);
+
+    set_trial(newvec);
+  }
+
   void IpoptData::SetTrialEqMultipliersFromStep(Number alpha,
       const Vector& delta_y_c,
       const Vector& delta_y_d)
@@ -236,6 +257,18 @@ namespace Ipopt
     set_trial(newvec);
   }
 
+  void IpoptData::SetTrialMultipliersFromStep(Number alpha_eq,
+      Number alpha_bound,
+      const IteratesVector& delta)
+  {
+    DBG_ASSERT(have_prototypes_);
+
+    SmartPtr<IteratesVector> newvec = trial()->MakeNewContainer();
+    newvec->CreateNewMultipliersFromStep(*curr(), alpha_eq, alpha_bound, delta);
+
+    set_trial(newvec);
+  }
+
   void IpoptData::AcceptTrialPoint()
   {
     DBG_ASSERT(IsValid(trial_));
@@ -143,6 +143,13 @@ namespace Ipopt
     void SetTrialPrimalVariablesFromStep(Number alpha,
                                          const Vector& delta_x,
                                          const Vector& delta_s);
+    /** Set the primal trial variables to the given values of x
+     *  (which have already been computed from the step) and the
+     *  values of s from the provided step with step length alpha.
+     */
+    void SetTrialPrimalVariables(const Vector& trial_x,
+                                 Number alpha,
+                                 const Vector& delta_s);
     /** Set the values of the trial values for the equality constraint
      *  multipliers (y_c and y_d) from provided step with step length
      *  alpha.
@@ -159,6 +166,16 @@ namespace Ipopt
                                           const Vector& delta_z_U,
                                           const Vector& delta_v_L,
                                           const Vector& delta_v_U);
+    /** Set the trial values for all multipliers from the step delta,
+     *  with step length alpha_eq for the equality constraint
+     *  multipliers (y_c and y_d) and alpha_bound for the bound
+     *  multipliers (z_L, z_U, v_L, v_U).  This is equivalent to
+     *  calling SetTrialEqMultipliersFromStep and
+     *  SetTrialBoundMultipliersFromStep, but creates only one new
+     *  trial container.
+     */
+    void SetTrialMultipliersFromStep(Number alpha_eq, Number alpha_bound,
+                                     const IteratesVector& delta);
 
     /** ToDo: I may need to add versions of set_trial like the
      *  following, but I am not sure 
@@ -478,6 +495,30 @@ namespace Ipopt
     }
     //@}
 
+    /** @name Counters for the back-solves of the low-rank
+     *  corrections of a limited-memory Hessian approximation */
+    //@{
+    /** Number of back-solves performed for the corrections */
+    Index lowrank_correction_solves() const
+    {
+      return lowrank_correction_solves_;
+    }
+    void Add_lowrank_correction_solves(Index nsolves)
+    {
+      lowrank_correction_solves_ += nsolves;
+    }
+    /** Number of back-solves saved because the corrections could be
+     *  reused */
+    Index lowrank_saved_solves() const
+    {
+      return lowrank_saved_solves_;
+    }
+    void Add_lowrank_saved_solves(Index nsolves)
+    {
+      lowrank_saved_solves_ += nsolves;
+    }
+    //@}
+
     /** Return Timing Statistics Object */
     TimingStatistics& TimingStats()
     {
@@ -573,6 +614,12 @@ namespace Ipopt
     /** iteration count */
     Index iter_count_;
 
+    /** @name Counters for the back-solves of the low-rank corrections */
+    //@{
+    Index lowrank_correction_solves_;
+    Index lowrank_saved_solves_;
+    //@}
+
     /** current barrier parameter */
     Number curr_mu_;
     bool mu_initialized_;
@@ -105,6 +105,17 @@ namespace Ipopt
                                         const Vector& yd
                                        ) = 0;
 
+    /** Evaluates the objective function and the constraints at the
+     *  npoints points x[i] concurrently, if this is supported, so
+     *  that later calls of f, c, and d at these points take the
+     *  values from the caches.  Returns false if concurrent
+     *  evaluations are not supported.  The default implementation
+     *  returns false. */
+    virtual bool EvalConcurrently(Index npoints, const Vector* const* x)
+    {
+      return false;
+    }
+
     /** Lower bounds on x */
     virtual SmartPtr<const Vector> x_L() const = 0;
 
@@ -118,6 +118,29 @@ namespace Ipopt
     //    return ret;
   }
 
+  void IteratesVector::CreateNewMultipliersFromStep(const IteratesVector& base,
+      Number alpha_eq,
+      Number alpha_bound,
+      const IteratesVector& delta)
+  {
+    CreateNewCompFromStep(2, base, alpha_eq, *delta.y_c());
+    CreateNewCompFromStep(3, base, alpha_eq, *delta.y_d());
+    CreateNewCompFromStep(4, base, alpha_bound, *delta.z_L());
+    CreateNewCompFromStep(5, base, alpha_bound, *delta.z_U());
+    CreateNewCompFromStep(6, base, alpha_bound, *delta.v_L());
+    CreateNewCompFromStep(7, base, alpha_bound, *delta.v_U());
+  }
+
+  void IteratesVector::CreateNewCompFromStep(Index icomp,
+      const IteratesVector& base,
+      Number alpha,
+      const Vector& delta_comp)
+  {
+    SmartPtr<Vector> comp = owner_space_->GetCompSpace(icomp)->MakeNew();
+    comp->AddTwoVectors(1., *base.GetComp(icomp), alpha, delta_comp, 0.);
+    SetCompNonConst(icomp, *comp);
+  }
+
   IteratesVectorSpace::IteratesVectorSpace(const VectorSpace& x_space, const VectorSpace& s_space,
       const VectorSpace& y_c_space, const VectorSpace& y_d_space,
       const VectorSpace& z_L_space, const VectorSpace& z_U_space,
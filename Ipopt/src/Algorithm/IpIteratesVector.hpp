@@ -442,6 +442,16 @@ namespace Ipopt
       SetCompNonConst(7, v_U);
     }
 
+    /** Create new vectors for all multipliers (y_c, y_d, z_L, z_U,
+     *  v_L, v_U) and set them to the multipliers in base plus the step
+     *  in delta, with step length alpha_eq for the equality
+     *  multipliers and alpha_bound for the bound multipliers.  Each
+     *  new component is computed in a single pass over base and
+     *  delta. */
+    void CreateNewMultipliersFromStep(const IteratesVector& base,
+                                      Number alpha_eq, Number alpha_bound,
+                                      const IteratesVector& delta);
+
     /** Get a sum of the tags of the contained items. There is no
      *  guarantee that this is unique, but there is a high chance it
      *  is unique and it can be used for debug checks relatively
@@ -499,6 +509,11 @@ namespace Ipopt
 
     const IteratesVectorSpace* owner_space_;
 
+    /** Create a new vector for component icomp and set it to the
+     *  component of base plus alpha times delta_comp */
+    void CreateNewCompFromStep(Index icomp, const IteratesVector& base,
+                               Number alpha, const Vector& delta_comp);
+
     /** private method to return the const element from the compound
      *  vector.  This method will return NULL if none is currently
      *  set.
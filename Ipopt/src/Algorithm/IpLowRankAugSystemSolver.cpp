@@ -8,6 +8,7 @@
 
 #include "IpLowRankAugSystemSolver.hpp"
 #include "IpLowRankUpdateSymMatrix.hpp"
+#include "IpDenseVector.hpp"
 
 namespace Ipopt
 {
@@ -15,6 +16,35 @@ namespace Ipopt
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Create a MultiVectorMatrix with the vectors vecs[first],
+   *  ..., vecs[first+ncols-1] as columns. */
+  static SmartPtr<MultiVectorMatrix>
+  MakeColumnBlock(const std::vector<SmartPtr<Vector> >& vecs,
+                  Index first, Index ncols, const VectorSpace& space)
+  {
+    SmartPtr<MultiVectorMatrixSpace> mvspace =
+      new MultiVectorMatrixSpace(ncols, space);
+    SmartPtr<MultiVectorMatrix> mv = mvspace->MakeNewMultiVectorMatrix();
+    for (Index i=0; i<ncols; i++) {
+      mv->SetVectorNonConst(i, *vecs[first+i]);
+    }
+    return mv;
+  }
+
+  /** Same as above for constant vectors */
+  static SmartPtr<MultiVectorMatrix>
+  MakeColumnBlock(const std::vector<SmartPtr<const Vector> >& vecs,
+                  Index first, Index ncols, const VectorSpace& space)
+  {
+    SmartPtr<MultiVectorMatrixSpace> mvspace =
+      new MultiVectorMatrixSpace(ncols, space);
+    SmartPtr<MultiVectorMatrix> mv = mvspace->MakeNewMultiVectorMatrix();
+    for (Index i=0; i<ncols; i++) {
+      mv->SetVector(i, *vecs[first+i]);
+    }
+    return mv;
+  }
+
   LowRankAugSystemSolver::LowRankAugSystemSolver(
     AugSystemSolver& aug_system_solver)
       :
@@ -41,10 +71,11 @@ namespace Ipopt
     first_call_ = true;
     J1_ = NULL;
     J2_ = NULL;
-    Vtilde1_ = NULL;
-    Utilde2_ = NULL;
+    for (Index k=0; k<4; k++) {
+      Vtilde1_[k] = NULL;
+      Utilde2_[k] = NULL;
+    }
     Wdiag_ = NULL;
-    compound_sol_vecspace_ = NULL;
 
     return aug_system_solver_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(),
                                           options, prefix);
@@ -102,6 +133,9 @@ namespace Ipopt
                                    rhs_x, rhs_s, rhs_c, rhs_d,
                                    check_NegEVals, numberOfNegEVals);
       if (retval != SYMSOLVER_SUCCESS) {
+        // The corrections might have been overwritten, so make sure
+        // that they are recomputed in the next call
+        w_tag_ = TaggedObject::Tag();
         return retval;
       }
 
@@ -151,6 +185,36 @@ namespace Ipopt
 
       first_call_ = false;
     }
+    else if (EmptyBlocksChanged(D_c, delta_c, D_d, delta_d)) {
+      // Only data for an empty c or d block changed, which does not
+      // change the corrections
+      Index nsaved = 0;
+      if (IsValid(Vtilde1_[0])) {
+        nsaved += Vtilde1_[0]->NCols();
+      }
+      if (IsValid(Utilde2_[0])) {
+        nsaved += Utilde2_[0]->NCols();
+      }
+      IpData().Add_lowrank_saved_solves(nsaved);
+      Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                     "LowRankAugSystemSolver: Reusing corrections, saved %d solves (total: %d solves, %d saved).\n",
+                     nsaved, IpData().lowrank_correction_solves(),
+                     IpData().lowrank_saved_solves());
+      if (D_c) {
+        d_c_tag_ = D_c->GetTag();
+      }
+      else {
+        d_c_tag_ = TaggedObject::Tag();
+      }
+      delta_c_ = delta_c;
+      if (D_d) {
+        d_d_tag_ = D_d->GetTag();
+      }
+      else {
+        d_d_tag_ = TaggedObject::Tag();
+      }
+      delta_d_ = delta_d;
+    }
 
     // Now solve the system for the given right hand side, using the
     // Sherman-Morrison formula with factorization information already
@@ -170,39 +234,47 @@ namespace Ipopt
       return retval;
     }
 
-    if (IsValid(Vtilde1_) || IsValid(Utilde2_)) {
-      // Create a CompoundVectors to store the right hand side and
-      // solutions
-      SmartPtr<CompoundVector> crhs =
-        compound_sol_vecspace_->MakeNewCompoundVector(false);
-      crhs->SetComp(0, rhs_x);
-      crhs->SetComp(1, rhs_s);
-      crhs->SetComp(2, rhs_c);
-      crhs->SetComp(3, rhs_d);
-      SmartPtr<CompoundVector> csol =
-        compound_sol_vecspace_->MakeNewCompoundVector(false);
-      csol->SetCompNonConst(0, sol_x);
-      csol->SetCompNonConst(1, sol_s);
-      csol->SetCompNonConst(2, sol_c);
-      csol->SetCompNonConst(3, sol_d);
-
-      if (IsValid(Utilde2_)) {
-        Index nU = Utilde2_->NCols();
+    if (IsValid(Vtilde1_[0]) || IsValid(Utilde2_[0])) {
+      // The corrections are applied to each of the components of the
+      // right hand side and solution separately
+      const Vector* rhs[4] = {&rhs_x, &rhs_s, &rhs_c, &rhs_d};
+      Vector* sol[4] = {&sol_x, &sol_s, &sol_c, &sol_d};
+
+      if (IsValid(Utilde2_[0])) {
+        Index nU = Utilde2_[0]->NCols();
         SmartPtr<DenseVectorSpace> bUspace =
           new DenseVectorSpace(nU);
         SmartPtr<DenseVector> bU = bUspace->MakeNewDenseVector();
-        Utilde2_->TransMultVector(1., *crhs, 0., *bU);
+        bU->Set(0.);
+        for (Index k=0; k<4; k++) {
+          if (rhs[k]->Dim() > 0) {
+            Utilde2_[k]->TransMultVector(1., *rhs[k], 1., *bU);
+          }
+        }
         J2_->CholeskySolveVector(*bU);
-        Utilde2_->MultVector(1., *bU, 1., *csol);
+        for (Index k=0; k<4; k++) {
+          if (sol[k]->Dim() > 0) {
+            Utilde2_[k]->MultVector(1., *bU, 1., *sol[k]);
+          }
+        }
       }
-      if (IsValid(Vtilde1_)) {
-        Index nV = Vtilde1_->NCols();
+      if (IsValid(Vtilde1_[0])) {
+        Index nV = Vtilde1_[0]->NCols();
         SmartPtr<DenseVectorSpace> bVspace =
           new DenseVectorSpace(nV);
         SmartPtr<DenseVector> bV = bVspace->MakeNewDenseVector();
-        Vtilde1_->TransMultVector(1., *crhs, 0., *bV);
+        bV->Set(0.);
+        for (Index k=0; k<4; k++) {
+          if (rhs[k]->Dim() > 0) {
+            Vtilde1_[k]->TransMultVector(1., *rhs[k], 1., *bV);
+          }
+        }
         J1_->CholeskySolveVector(*bV);
-        Vtilde1_->MultVector(-1., *bV, 1., *csol);
+        for (Index k=0; k<4; k++) {
+          if (sol[k]->Dim() > 0) {
+            Vtilde1_[k]->MultVector(-1., *bV, 1., *sol[k]);
+          }
+        }
       }
     }
 
@@ -271,29 +343,82 @@ namespace Ipopt
       DBG_PRINT_VECTOR(2, "B0", *B0);
     }
 
-    SmartPtr<MultiVectorMatrix> Vtilde1_x;
+    Index nV = 0;
     if (IsValid(V)) {
-      SmartPtr<MultiVectorMatrix> V_x;
-      Index nV = V->NCols();
-      //DBG_PRINT((1, "delta_x  = %e\n", delta_x));
-      //DBG_PRINT_MATRIX(2, "V", *V);
-      retval = SolveMultiVector(D_x, delta_x, D_s, delta_s, J_c,
-                                D_c, delta_c, J_d, D_d, delta_d,
-                                proto_rhs_x, proto_rhs_s, proto_rhs_c,
-                                proto_rhs_d, *V, P_LM, V_x, Vtilde1_,
-                                Vtilde1_x, check_NegEVals, numberOfNegEVals);
-      if (retval != SYMSOLVER_SUCCESS) {
-        Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
-                       "LowRankAugSystemSolver: SolveMultiVector returned retval = %d for V.\n", retval);
-        return retval;
+      nV = V->NCols();
+    }
+    Index nU = 0;
+    if (IsValid(U)) {
+      nU = U->NCols();
+    }
+    for (Index k=0; k<4; k++) {
+      Vtilde1_[k] = NULL;
+      Utilde2_[k] = NULL;
+    }
+    J1_ = NULL;
+    J2_ = NULL;
+    if (nV+nU == 0) {
+      return retval;
+    }
+
+    // Collect the columns of V and U (in the full x space) as right
+    // hand sides, so that the solutions for all of them are computed
+    // with one call of the augmented system solver
+    std::vector<SmartPtr<const Vector> > rhs_xV(nV+nU);
+    for (Index i=0; i<nV+nU; i++) {
+      SmartPtr<const Vector> col =
+        (i<nV) ? V->GetVector(i) : U->GetVector(i-nV);
+      if (IsNull(P_LM)) {
+        DBG_ASSERT(col->Dim() == proto_rhs_x.Dim());
+        rhs_xV[i] = col;
+      }
+      else {
+        SmartPtr<Vector> fullx = proto_rhs_x.MakeNew();
+        P_LM->MultVector(1., *col, 0., *fullx);
+        rhs_xV[i] = ConstPtr(fullx);
+      }
+    }
+
+    std::vector<SmartPtr<Vector> > sol_xV;
+    std::vector<SmartPtr<Vector> > sol_sV;
+    std::vector<SmartPtr<Vector> > sol_cV;
+    std::vector<SmartPtr<Vector> > sol_dV;
+    retval = SolveMultiVector(D_x, delta_x, D_s, delta_s, J_c,
+                              D_c, delta_c, J_d, D_d, delta_d,
+                              proto_rhs_x, proto_rhs_s, proto_rhs_c,
+                              proto_rhs_d, rhs_xV, sol_xV, sol_sV, sol_cV,
+                              sol_dV, check_NegEVals, numberOfNegEVals);
+    if (retval != SYMSOLVER_SUCCESS) {
+      Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                     "LowRankAugSystemSolver: SolveMultiVector returned retval = %d for V and U.\n", retval);
+      return retval;
+    }
+    IpData().Add_lowrank_correction_solves(nV+nU);
+    Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                   "LowRankAugSystemSolver: Computed corrections with %d solves (total: %d solves, %d saved).\n",
+                   nV+nU, IpData().lowrank_correction_solves(),
+                   IpData().lowrank_saved_solves());
+
+    const VectorSpace* spaces[4] = {
+      GetRawPtr(proto_rhs_x.OwnerSpace()),
+      GetRawPtr(proto_rhs_s.OwnerSpace()),
+      GetRawPtr(proto_rhs_c.OwnerSpace()),
+      GetRawPtr(proto_rhs_d.OwnerSpace())
+    };
+    std::vector<SmartPtr<Vector> >* solV[4] = {&sol_xV, &sol_sV, &sol_cV, &sol_dV};
+
+    if (nV > 0) {
+      SmartPtr<MultiVectorMatrix> V_x =
+        MakeColumnBlock(rhs_xV, 0, nV, *spaces[0]);
+      for (Index k=0; k<4; k++) {
+        Vtilde1_[k] = MakeColumnBlock(*solV[k], 0, nV, *spaces[k]);
       }
-      //DBG_PRINT_MATRIX(2, "Vtilde1_x", *Vtilde1_x);
 
       SmartPtr<DenseSymMatrixSpace> M1space =
         new DenseSymMatrixSpace(nV);
       SmartPtr<DenseSymMatrix> M1 = M1space->MakeNewDenseSymMatrix();
       M1->FillIdentity();
-      M1->HighRankUpdateTranspose(1., *Vtilde1_x, *V_x, 1.);
+      M1->HighRankUpdateTranspose(1., *Vtilde1_[0], *V_x, 1.);
       //DBG_PRINT_MATRIX(2, "M1", *M1);
       SmartPtr<DenseGenMatrixSpace> J1space =
         new DenseGenMatrixSpace(nV, nV);
@@ -309,47 +434,24 @@ namespace Ipopt
         return retval;
       }
     }
-    else {
-      Vtilde1_ = NULL;
-      J1_ = NULL;
-    }
 
-    if (IsValid(U)) {
-      Index nU = U->NCols();
-      SmartPtr<MultiVectorMatrix> U_x;
-      SmartPtr<MultiVectorMatrix> Utilde1;
-      SmartPtr<MultiVectorMatrix> Utilde1_x;
-      SmartPtr<MultiVectorMatrix> Utilde2_x;
-      retval = SolveMultiVector(D_x, delta_x, D_s, delta_s, J_c,
-                                D_c, delta_c, J_d, D_d, delta_d,
-                                proto_rhs_x, proto_rhs_s, proto_rhs_c,
-                                proto_rhs_d, *U, P_LM, U_x, Utilde1,
-                                Utilde1_x, check_NegEVals, numberOfNegEVals);
-      if (retval != SYMSOLVER_SUCCESS) {
-        Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
-                       "LowRankAugSystemSolver: SolveMultiVector returned retval = %d for U.\n", retval);
-        return retval;
+    if (nU > 0) {
+      SmartPtr<MultiVectorMatrix> U_x =
+        MakeColumnBlock(rhs_xV, nV, nU, *spaces[0]);
+      for (Index k=0; k<4; k++) {
+        Utilde2_[k] = MakeColumnBlock(*solV[k], nV, nU, *spaces[k]);
       }
 
-      if (IsNull(Vtilde1_)) {
-        Utilde2_ = Utilde1;
-        Utilde2_x = Utilde1_x;
-      }
-      else {
-        Index nV = Vtilde1_->NCols();
+      if (nV > 0) {
         SmartPtr<DenseGenMatrixSpace> Cspace =
           new DenseGenMatrixSpace(nV, nU);
         SmartPtr<DenseGenMatrix> C = Cspace->MakeNewDenseGenMatrix();
-        C->HighRankUpdateTranspose(1., *Vtilde1_x, *U_x, 0.);
+        C->HighRankUpdateTranspose(1., *Vtilde1_[0], *U_x, 0.);
         J1_->CholeskySolveMatrix(*C);
-        Utilde2_ = Utilde1;
-        Utilde2_->AddRightMultMatrix(-1, *Vtilde1_, *C, 1.);
-        Utilde2_x = Utilde1_x->MakeNewMultiVectorMatrix();
-        for (Index i=0; i<Utilde1_x->NCols(); i++) {
-          const CompoundVector* cvec =
-            static_cast<const CompoundVector*> (GetRawPtr(Utilde2_->GetVector(i)));
-          DBG_ASSERT(cvec);
-          Utilde2_x->SetVector(i, *cvec->GetComp(0));
+        for (Index k=0; k<4; k++) {
+          if (spaces[k]->Dim() > 0) {
+            Utilde2_[k]->AddRightMultMatrix(-1, *Vtilde1_[k], *C, 1.);
+          }
         }
       }
 
@@ -357,7 +459,7 @@ namespace Ipopt
         new DenseSymMatrixSpace(nU);
       SmartPtr<DenseSymMatrix> M2 = M2space->MakeNewDenseSymMatrix();
       M2->FillIdentity();
-      M2->HighRankUpdateTranspose(-1., *Utilde2_x, *U_x, 1.);
+      M2->HighRankUpdateTranspose(-1., *Utilde2_[0], *U_x, 1.);
       SmartPtr<DenseGenMatrixSpace> J2space =
         new DenseGenMatrixSpace(nU, nU);
       J2_ = J2space->MakeNewDenseGenMatrix();
@@ -371,10 +473,6 @@ namespace Ipopt
         return retval;
       }
     }
-    else {
-      J2_ = NULL;
-      Utilde2_ = NULL;
-    }
 
     return retval;
   }
@@ -394,11 +492,11 @@ namespace Ipopt
     const Vector& proto_rhs_s,
     const Vector& proto_rhs_c,
     const Vector& proto_rhs_d,
-    const MultiVectorMatrix& V,
-    const SmartPtr<const Matrix>& P_LM,
-    SmartPtr<MultiVectorMatrix>& V_x,
-    SmartPtr<MultiVectorMatrix>& Vtilde,
-    SmartPtr<MultiVectorMatrix>& Vtilde_x,
+    std::vector<SmartPtr<const Vector> >& rhs_xV,
+    std::vector<SmartPtr<Vector> >& sol_xV,
+    std::vector<SmartPtr<Vector> >& sol_sV,
+    std::vector<SmartPtr<Vector> >& sol_cV,
+    std::vector<SmartPtr<Vector> >& sol_dV,
     bool check_NegEVals,
     Index numberOfNegEVals)
   {
@@ -407,47 +505,27 @@ namespace Ipopt
 
     ESymSolverStatus retval;
 
-    Index nrhs = V.NCols();
+    Index nrhs = (Index)rhs_xV.size();
     DBG_ASSERT(nrhs>0);
 
-    SmartPtr<MultiVectorMatrixSpace> V_xspace =
-      new MultiVectorMatrixSpace(nrhs, *proto_rhs_x.OwnerSpace());
-    V_x = V_xspace->MakeNewMultiVectorMatrix();
-
-    // Create the right hand sides
-    std::vector<SmartPtr<const Vector> > rhs_xV(nrhs);
-    std::vector<SmartPtr<const Vector> > rhs_sV(nrhs);
-    std::vector<SmartPtr<const Vector> > rhs_cV(nrhs);
-    std::vector<SmartPtr<const Vector> > rhs_dV(nrhs);
-
-    for (Index i=0; i<nrhs; i++) {
-      if (IsNull(P_LM)) {
-        rhs_xV[i] = V.GetVector(i);
-        DBG_ASSERT(rhs_xV[i]->Dim() == proto_rhs_x.Dim());
-      }
-      else {
-        SmartPtr<Vector> fullx = proto_rhs_x.MakeNew();
-        P_LM->MultVector(1., *V.GetVector(i), 0., *fullx);
-        rhs_xV[i] = ConstPtr(fullx);
-      }
-      V_x->SetVector(i, *rhs_xV[i]);
-      SmartPtr<Vector> tmp;
-      tmp =  proto_rhs_s.MakeNew();
-      tmp->Set(0.);
-      rhs_sV[i] = ConstPtr(tmp);
-      tmp =  proto_rhs_c.MakeNew();
-      tmp->Set(0.);
-      rhs_cV[i] = ConstPtr(tmp);
-      tmp =  proto_rhs_d.MakeNew();
-      tmp->Set(0.);
-      rhs_dV[i] = ConstPtr(tmp);
-    }
+    // The s, c, and d components of all right hand sides are zero,
+    // so they can share one vector
+    SmartPtr<Vector> tmp;
+    tmp = proto_rhs_s.MakeNew();
+    tmp->Set(0.);
+    std::vector<SmartPtr<const Vector> > rhs_sV(nrhs, ConstPtr(tmp));
+    tmp = proto_rhs_c.MakeNew();
+    tmp->Set(0.);
+    std::vector<SmartPtr<const Vector> > rhs_cV(nrhs, ConstPtr(tmp));
+    tmp = proto_rhs_d.MakeNew();
+    tmp->Set(0.);
+    std::vector<SmartPtr<const Vector> > rhs_dV(nrhs, ConstPtr(tmp));
 
     // now get space for the solution
-    std::vector<SmartPtr<Vector> > sol_xV(nrhs);
-    std::vector<SmartPtr<Vector> > sol_sV(nrhs);
-    std::vector<SmartPtr<Vector> > sol_cV(nrhs);
-    std::vector<SmartPtr<Vector> > sol_dV(nrhs);
+    sol_xV.resize(nrhs);
+    sol_sV.resize(nrhs);
+    sol_cV.resize(nrhs);
+    sol_dV.resize(nrhs);
     for (Index i=0; i<nrhs; i++) {
       sol_xV[i] = proto_rhs_x.MakeNew();
       sol_sV[i] = proto_rhs_s.MakeNew();
@@ -455,7 +533,7 @@ namespace Ipopt
       sol_dV[i] = proto_rhs_d.MakeNew();
     }
 
-    // Call the actual augmented system solver to obtain Vtilde
+    // Call the actual augmented system solver to obtain the solutions
     retval = aug_system_solver_->MultiSolve(GetRawPtr(Wdiag_), 1.0, D_x, delta_x, D_s, delta_s,
                                             &J_c, D_c, delta_c, &J_d, D_d, delta_d,
                                             rhs_xV, rhs_sV, rhs_cV, rhs_dV,
@@ -465,39 +543,6 @@ namespace Ipopt
     if (aug_system_solver_->ProvidesInertia()) {
       num_neg_evals_ = aug_system_solver_->NumberOfNegEVals();
     }
-    if (retval != SYMSOLVER_SUCCESS) {
-      return retval;
-    }
-
-    // Pack the results into Vtilde
-    if (IsNull(compound_sol_vecspace_)) {
-      Index dimx = proto_rhs_x.Dim();
-      Index dims = proto_rhs_s.Dim();
-      Index dimc = proto_rhs_c.Dim();
-      Index dimd = proto_rhs_d.Dim();
-      Index dimtot = dimx+dims+dimc+dimd;
-      SmartPtr<CompoundVectorSpace> vecspace =
-        new CompoundVectorSpace(4, dimtot);
-      vecspace->SetCompSpace(0, *proto_rhs_x.OwnerSpace());
-      vecspace->SetCompSpace(1, *proto_rhs_s.OwnerSpace());
-      vecspace->SetCompSpace(2, *proto_rhs_c.OwnerSpace());
-      vecspace->SetCompSpace(3, *proto_rhs_d.OwnerSpace());
-      compound_sol_vecspace_ = ConstPtr(vecspace);
-    }
-    SmartPtr<MultiVectorMatrixSpace> V1space =
-      new MultiVectorMatrixSpace(nrhs, *compound_sol_vecspace_);
-    Vtilde = V1space->MakeNewMultiVectorMatrix();
-    Vtilde_x = V_xspace->MakeNewMultiVectorMatrix();
-    for (Index i=0; i<nrhs; i++) {
-      Vtilde_x->SetVector(i, *sol_xV[i]);
-      SmartPtr<CompoundVector> cvec =
-        compound_sol_vecspace_->MakeNewCompoundVector(false);
-      cvec->SetCompNonConst(0, *sol_xV[i]);
-      cvec->SetCompNonConst(1, *sol_sV[i]);
-      cvec->SetCompNonConst(2, *sol_cV[i]);
-      cvec->SetCompNonConst(3, *sol_dV[i]);
-      Vtilde->SetVectorNonConst(i, *cvec);
-    }
 
     return retval;
   }
@@ -568,19 +613,43 @@ namespace Ipopt
          || (!D_s && d_s_tag_ != TaggedObject::Tag())
          || (delta_s != delta_s_)
          || (J_c.GetTag() != j_c_tag_)
-         || (D_c && D_c->GetTag() != d_c_tag_)
-         || (!D_c && d_c_tag_ != TaggedObject::Tag())
-         || (delta_c != delta_c_)
-         || (J_d.GetTag() != j_d_tag_)
-         || (D_d && D_d->GetTag() != d_d_tag_)
-         || (!D_d && d_d_tag_ != TaggedObject::Tag())
-         || (delta_d != delta_d_) ) {
+         || (J_d.GetTag() != j_d_tag_) ) {
+      return true;
+    }
+
+    // If there are no equality (inequality) constraints, D_c and
+    // delta_c (D_d and delta_d) do not enter the solutions for the
+    // columns of V and U, so that the corrections can be reused
+    if (J_c.NRows() > 0
+        && ( (D_c && D_c->GetTag() != d_c_tag_)
+             || (!D_c && d_c_tag_ != TaggedObject::Tag())
+             || (delta_c != delta_c_) ) ) {
+      return true;
+    }
+    if (J_d.NRows() > 0
+        && ( (D_d && D_d->GetTag() != d_d_tag_)
+             || (!D_d && d_d_tag_ != TaggedObject::Tag())
+             || (delta_d != delta_d_) ) ) {
       return true;
     }
 
     return false;
   }
 
+  bool LowRankAugSystemSolver::EmptyBlocksChanged(
+    const Vector* D_c,
+    double delta_c,
+    const Vector* D_d,
+    double delta_d)
+  {
+    return ( (D_c && D_c->GetTag() != d_c_tag_)
+             || (!D_c && d_c_tag_ != TaggedObject::Tag())
+             || (delta_c != delta_c_)
+             || (D_d && D_d->GetTag() != d_d_tag_)
+             || (!D_d && d_d_tag_ != TaggedObject::Tag())
+             || (delta_d != delta_d_) );
+  }
+
   Index LowRankAugSystemSolver::NumberOfNegEVals() const
   {
     DBG_ASSERT(!first_call_);
@@ -160,14 +160,16 @@ namespace Ipopt
     bool first_call_;
     SmartPtr<DenseGenMatrix> J1_;
     SmartPtr<DenseGenMatrix> J2_;
-    SmartPtr<MultiVectorMatrix> Vtilde1_;
-    SmartPtr<MultiVectorMatrix> Utilde2_;
+    /** Solutions of the augmented system for the columns of V, split
+     *  into the x, s, c, and d components.  Each component is a
+     *  MultiVectorMatrix with dense columns, so that products with
+     *  it are computed with one BLAS call on a contiguous block. */
+    SmartPtr<MultiVectorMatrix> Vtilde1_[4];
+    /** Corrected solutions for the columns of U, split as Vtilde1_ */
+    SmartPtr<MultiVectorMatrix> Utilde2_[4];
     /** Hessian Matrix passed to the augmented system solver solving
      *  the matrix without the low-rank update. */
     SmartPtr<DiagMatrix> Wdiag_;
-    /** Vector space for Compound vectors that capture the entire
-     *  right hand side and solution vectors .*/
-    SmartPtr<const CompoundVectorSpace> compound_sol_vecspace_;
     //@}
 
     /** Stores the number of negative eigenvalues detected during most
@@ -182,7 +184,7 @@ namespace Ipopt
     /** @name Internal functions */
     //@{
     /** Method for updating the factorization, including J1_, J2_,
-     *  Vtilde1_, Utilde2, Wdiag_, compound_sol_vecspace_ */
+     *  Vtilde1_, Utilde2, Wdiag_ */
     ESymSolverStatus UpdateFactorization(
       const SymMatrix* W,
       double W_factor,
@@ -204,10 +206,11 @@ namespace Ipopt
       Index numberOfNegEVals);
 
     /** Method for solving the augmented system without low-rank
-     *  update for multiple right hand sides that are provided as
-     *  MultiVectorMatrix.  The result is returned as a
-     *  MultiVectorMatrix in Vtilde1.  V_x and Vtilde1_x are V and
-     *  Vtilde1 in the x-space. */
+     *  update for multiple right hand sides, which are zero except
+     *  for the x components given in rhs_xV.  All right hand sides
+     *  are given to the augmented system solver in one call.  The
+     *  components of the solutions are returned in sol_xV, sol_sV,
+     *  sol_cV, and sol_dV. */
     ESymSolverStatus SolveMultiVector(
       const Vector* D_x,
       double delta_x,
@@ -223,11 +226,11 @@ namespace Ipopt
       const Vector& proto_rhs_s,
       const Vector& proto_rhs_c,
       const Vector& proto_rhs_d,
-      const MultiVectorMatrix& V,
-      const SmartPtr<const Matrix>& P_LM,
-      SmartPtr<MultiVectorMatrix>& V_x,
-      SmartPtr<MultiVectorMatrix>& Vtilde1,
-      SmartPtr<MultiVectorMatrix>& Vtilde1_x,
+      std::vector<SmartPtr<const Vector> >& rhs_xV,
+      std::vector<SmartPtr<Vector> >& sol_xV,
+      std::vector<SmartPtr<Vector> >& sol_sV,
+      std::vector<SmartPtr<Vector> >& sol_cV,
+      std::vector<SmartPtr<Vector> >& sol_dV,
       bool check_NegEVals,
       Index numberOfNegEVals);
 
@@ -247,6 +250,17 @@ namespace Ipopt
       const Matrix& J_d,
       const Vector* D_d,
       double delta_d);
+
+    /** Method that returns true if the data for the c or d block of
+     *  the matrix changed since the previous call.  If a block is
+     *  empty, such a change is ignored by
+     *  AugmentedSystemRequiresChange, since it does not change the
+     *  solutions for the columns of V and U. */
+    bool EmptyBlocksChanged(
+      const Vector* D_c,
+      double delta_c,
+      const Vector* D_d,
+      double delta_d);
     //@}
 
   };
@@ -42,6 +42,7 @@ namespace Ipopt
       d_cache_(1),
       jac_d_cache_(1),
       h_cache_(1),
+      max_concurrent_points_(0),
       unscaled_x_cache_(1),
       initialized_(false)
   {}
@@ -122,14 +123,19 @@ namespace Ipopt
       "Lagrangian function only once from the NLP and reuse this information "
       "later.");
     roptions->SetRegisteringCategory("Hessian Approximation");
-    roptions->AddStringOption2(
+    roptions->AddStringOption3(
       "hessian_approximation",
       "Indicates what Hessian information is to be used.",
       "exact",
       "exact", "Use second derivatives provided by the NLP.",
       "limited-memory", "Perform a limited-memory quasi-Newton approximation",
+      "finite-difference-values", "user-provided structure, values by finite differences of the gradients",
       "This determines which kind of information for the Hessian of the "
-      "Lagrangian function is used by the algorithm.");
+      "Lagrangian function is used by the algorithm.  For "
+      "\"finite-difference-values\", the NLP must provide the structure of "
+      "the Hessian and the exact constraint Jacobian, and the Hessian is "
+      "computed from differences of the gradient of the Lagrangian (see "
+      "also \"findiff_coloring\").");
     roptions->AddStringOption2(
       "hessian_approximation_space",
       "Indicates in which subspace the Hessian information is to be approximated.",
@@ -617,6 +623,94 @@ namespace Ipopt
     return retValue;
   }
 
+  bool OrigIpoptNLP::EvalConcurrently(Index npoints, const Vector* const* x)
+  {
+    DBG_START_METH("OrigIpoptNLP::EvalConcurrently", dbg_verbosity);
+    if (npoints<=0) {
+      return false;
+    }
+    // The caches for empty constraint vectors do not depend on x and
+    // are left alone
+    const bool have_c = (c_space_->Dim()>0);
+    const bool have_d = (d_space_->Dim()>0);
+
+    std::vector<SmartPtr<const Vector> > unscaled_x(npoints);
+    std::vector<const Vector*> unscaled_x_ptrs(npoints);
+    std::vector<SmartPtr<Vector> > unscaled_c(npoints);
+    std::vector<Vector*> unscaled_c_ptrs(npoints);
+    std::vector<SmartPtr<Vector> > unscaled_d(npoints);
+    std::vector<Vector*> unscaled_d_ptrs(npoints);
+    for (Index k=0; k<npoints; k++) {
+      // the unscaled points are computed here, since
+      // NLP_scaling() is not called concurrently
+      unscaled_x[k] = get_unscaled_x(*x[k]);
+      unscaled_x_ptrs[k] = GetRawPtr(unscaled_x[k]);
+      unscaled_c[k] = c_space_->MakeNew();
+      unscaled_c_ptrs[k] = GetRawPtr(unscaled_c[k]);
+      unscaled_d[k] = d_space_->MakeNew();
+      unscaled_d_ptrs[k] = GetRawPtr(unscaled_d[k]);
+    }
+
+    std::vector<Number> unscaled_f(npoints);
+    bool* success = new bool[npoints];
+    // f, c, and d are evaluated together, so that the time cannot be
+    // split between them
+    f_c_d_concurrent_eval_time_.Start();
+    bool retval = nlp_->Eval_f_c_d_Concurrently(npoints, &unscaled_x_ptrs[0],
+                  &unscaled_f[0],
+                  &unscaled_c_ptrs[0],
+                  &unscaled_d_ptrs[0],
+                  success);
+    f_c_d_concurrent_eval_time_.End();
+
+    if (retval) {
+      if (npoints>max_concurrent_points_) {
+        // make room for the results at all points and the current
+        // iterate
+        max_concurrent_points_ = npoints;
+        f_cache_.Clear(npoints+1);
+        if (have_c) {
+          c_cache_.Clear(npoints+1);
+        }
+        if (have_d) {
+          d_cache_.Clear(npoints+1);
+        }
+      }
+      f_evals_ += npoints;
+      if (have_c) {
+        c_evals_ += npoints;
+      }
+      if (have_d) {
+        d_evals_ += npoints;
+      }
+
+      // Only successful evaluations are stored, so that an evaluation
+      // error is reported when the values at the point are requested
+      for (Index k=0; k<npoints; k++) {
+        if (!success[k] || !IsFiniteNumber(unscaled_f[k]) ||
+            !IsFiniteNumber(unscaled_c[k]->Nrm2()) ||
+            !IsFiniteNumber(unscaled_d[k]->Nrm2())) {
+          continue;
+        }
+        Number f = NLP_scaling()->apply_obj_scaling(unscaled_f[k]);
+        f_cache_.AddCachedResult1Dep(f, x[k]);
+        if (have_c) {
+          SmartPtr<const Vector> c =
+            NLP_scaling()->apply_vector_scaling_c(ConstPtr(unscaled_c[k]));
+          c_cache_.AddCachedResult1Dep(c, x[k]);
+        }
+        if (have_d) {
+          SmartPtr<const Vector> d =
+            NLP_scaling()->apply_vector_scaling_d(ConstPtr(unscaled_d[k]));
+          d_cache_.AddCachedResult1Dep(d, x[k]);
+        }
+      }
+    }
+    delete [] success;
+
+    return retval;
+  }
+
   SmartPtr<const Matrix> OrigIpoptNLP::jac_c(const Vector& x)
   {
     SmartPtr<const Matrix> retValue;
@@ -980,6 +1074,13 @@ namespace Ipopt
                  h_eval_time_.TotalCpuTime(),
                  h_eval_time_.TotalSysTime(),
                  h_eval_time_.TotalWallclockTime());
+    if (f_c_d_concurrent_eval_time_.TotalWallclockTime() > 0.) {
+      jnlst.Printf(level, category,
+                   " Obj. and constraints (concurrent)..: %10.3f (sys: %10.3f wall: %10.3f)\n",
+                   f_c_d_concurrent_eval_time_.TotalCpuTime(),
+                   f_c_d_concurrent_eval_time_.TotalSysTime(),
+                   f_c_d_concurrent_eval_time_.TotalWallclockTime());
+    }
   }
 
   Number
@@ -991,7 +1092,8 @@ namespace Ipopt
            d_eval_time_.TotalCpuTime()+
            jac_c_eval_time_.TotalCpuTime()+
            jac_d_eval_time_.TotalCpuTime()+
-           h_eval_time_.TotalCpuTime();
+           h_eval_time_.TotalCpuTime()+
+           f_c_d_concurrent_eval_time_.TotalCpuTime();
   }
 
   Number
@@ -1003,7 +1105,8 @@ namespace Ipopt
            d_eval_time_.TotalSysTime()+
            jac_c_eval_time_.TotalSysTime()+
            jac_d_eval_time_.TotalSysTime()+
-           h_eval_time_.TotalSysTime();
+           h_eval_time_.TotalSysTime()+
+           f_c_d_concurrent_eval_time_.TotalSysTime();
   }
 
   Number
@@ -1015,7 +1118,8 @@ namespace Ipopt
            d_eval_time_.TotalWallclockTime()+
            jac_c_eval_time_.TotalWallclockTime()+
            jac_d_eval_time_.TotalWallclockTime()+
-           h_eval_time_.TotalWallclockTime();
+           h_eval_time_.TotalWallclockTime()+
+           f_c_d_concurrent_eval_time_.TotalWallclockTime();
   }
 
   void
@@ -1028,6 +1132,7 @@ namespace Ipopt
     jac_c_eval_time_.Reset();
     jac_d_eval_time_.Reset();
     h_eval_time_.Reset();
+    f_c_d_concurrent_eval_time_.Reset();
   }
 
   SmartPtr<const Vector>
@@ -19,7 +19,8 @@ namespace Ipopt
   /** enumeration for the Hessian information type. */
   enum HessianApproximationType {
     EXACT=0,
-    LIMITED_MEMORY
+    LIMITED_MEMORY,
+    FINDIFF_VALUES
   };
 
   /** enumeration for the Hessian approximation space. */
@@ -109,6 +110,10 @@ namespace Ipopt
                                         const Vector& yd
                                        );
 
+    /** Evaluates f, c, and d at several points concurrently, if
+     *  the NLP supports this */
+    virtual bool EvalConcurrently(Index npoints, const Vector* const* x);
+
     /** Hessian of the Lagrangian (depending in mu) - incorrect
      *  version for OrigIpoptNLP */
     virtual SmartPtr<const SymMatrix> h(const Vector& x,
@@ -301,6 +306,12 @@ namespace Ipopt
     {
       return h_eval_time_;
     }
+    /** Time for the joint evaluations of f, c, and d in
+     *  EvalConcurrently */
+    const TimedTask& f_c_d_concurrent_eval_time() const
+    {
+      return f_c_d_concurrent_eval_time_;
+    }
 
     Number TotalFunctionEvaluationCpuTime() const;
     Number TotalFunctionEvaluationSysTime() const;
@@ -362,6 +373,11 @@ namespace Ipopt
      *  (current iteration) */
     CachedResults<SmartPtr<const SymMatrix> > h_cache_;
 
+    /** Largest number of points evaluated together in
+     *  EvalConcurrently so far.  The caches for f, c, and d have
+     *  been enlarged to hold the results for this many points. */
+    Index max_concurrent_points_;
+
     /** Unscaled version of x vector */
     CachedResults<SmartPtr<const Vector> > unscaled_x_cache_;
 
@@ -475,6 +491,7 @@ namespace Ipopt
     TimedTask d_eval_time_;
     TimedTask jac_d_eval_time_;
     TimedTask h_eval_time_;
+    TimedTask f_c_d_concurrent_eval_time_;
     //@}
   };
 
@@ -8,6 +8,10 @@
 
 #include "IpPDFullSpaceSolver.hpp"
 #include "IpDebug.hpp"
+#include "IpDenseVector.hpp"
+#include "IpExpansionMatrix.hpp"
+#include "IpGenTMatrix.hpp"
+#include "IpScaledMatrix.hpp"
 
 #ifdef HAVE_CMATH
 # include <cmath>
@@ -26,6 +30,124 @@ namespace Ipopt
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Compute Jx = J*x and JTy += J^T*y for the residuals of the
+   *  primal-dual system.  If J is a (possibly scaled) GenTMatrix and
+   *  all vectors are DenseVectors, both products are computed in one
+   *  pass over the nonzeros of J. */
+  static void JacobianProducts(const Matrix& J, const Vector& x,
+                               const Vector& y, Vector& Jx, Vector& JTy)
+  {
+    const GenTMatrix* T = dynamic_cast<const GenTMatrix*>(&J);
+    const DenseVector* rscal = NULL;
+    const DenseVector* cscal = NULL;
+    bool known_scaling = true;
+    if (!T) {
+      const ScaledMatrix* S = dynamic_cast<const ScaledMatrix*>(&J);
+      if (S) {
+        T = dynamic_cast<const GenTMatrix*>(GetRawPtr(S->GetUnscaledMatrix()));
+        if (IsValid(S->RowScaling())) {
+          rscal = dynamic_cast<const DenseVector*>(GetRawPtr(S->RowScaling()));
+          known_scaling = known_scaling && rscal;
+        }
+        if (IsValid(S->ColumnScaling())) {
+          cscal = dynamic_cast<const DenseVector*>(GetRawPtr(S->ColumnScaling()));
+          known_scaling = known_scaling && cscal;
+        }
+      }
+    }
+    const DenseVector* dense_x = dynamic_cast<const DenseVector*>(&x);
+    const DenseVector* dense_y = dynamic_cast<const DenseVector*>(&y);
+    DenseVector* dense_Jx = dynamic_cast<DenseVector*>(&Jx);
+    DenseVector* dense_JTy = dynamic_cast<DenseVector*>(&JTy);
+
+    if (!T || !known_scaling || !dense_x || !dense_y || !dense_Jx ||
+        !dense_JTy) {
+      J.TransMultVector(1., y, 1., JTy);
+      J.MultVector(1., x, 0., Jx);
+      return;
+    }
+
+    const Number* xvals = dense_x->ExpandedValues();
+    const Number* yvals = dense_y->ExpandedValues();
+    const Number* rvals = rscal ? rscal->ExpandedValues() : NULL;
+    const Number* cvals = cscal ? cscal->ExpandedValues() : NULL;
+    Number* Jxvals = dense_Jx->Values();
+    for (Index i=0; i<Jx.Dim(); i++) {
+      Jxvals[i] = 0.;
+    }
+    Number* JTyvals = dense_JTy->Values();
+
+    const Index* irows = T->Irows();
+    const Index* jcols = T->Jcols();
+    const Number* vals = T->Values();
+    const Index nnz = T->Nonzeros();
+    for (Index k=0; k<nnz; k++) {
+      const Index i = irows[k]-1;
+      const Index j = jcols[k]-1;
+      Number val = vals[k];
+      if (rvals) {
+        val *= rvals[i];
+      }
+      if (cvals) {
+        val *= cvals[j];
+      }
+      Jxvals[i] += val*xvals[j];
+      JTyvals[j] += val*yvals[i];
+    }
+  }
+
+  /** Compute the residual of the complementarity row for the bound
+   *  multipliers z with expansion matrix P,
+   *
+   *    resid_z = slack.*res_z + sign*z.*(P^T res_x) - rhs_z,
+   *
+   *  and add the contribution -sign*P*res_z of the bound multipliers
+   *  to the residual resid_x of the row for the primal variables.  If
+   *  P is an ExpansionMatrix and all vectors are DenseVectors, this
+   *  is done in one pass without temporary vectors. */
+  static void BoundResidual(const Matrix& P, Number sign,
+                            const Vector& res_x, const Vector& res_z,
+                            const Vector& slack, const Vector& z,
+                            const Vector& rhs_z, Vector& resid_z,
+                            Vector& resid_x)
+  {
+    const ExpansionMatrix* exp_P = dynamic_cast<const ExpansionMatrix*>(&P);
+    const DenseVector* dense_res_x = dynamic_cast<const DenseVector*>(&res_x);
+    const DenseVector* dense_res_z = dynamic_cast<const DenseVector*>(&res_z);
+    const DenseVector* dense_slack = dynamic_cast<const DenseVector*>(&slack);
+    const DenseVector* dense_z = dynamic_cast<const DenseVector*>(&z);
+    const DenseVector* dense_rhs_z = dynamic_cast<const DenseVector*>(&rhs_z);
+    DenseVector* dense_resid_z = dynamic_cast<DenseVector*>(&resid_z);
+    DenseVector* dense_resid_x = dynamic_cast<DenseVector*>(&resid_x);
+
+    if (!exp_P || !dense_res_x || !dense_res_z || !dense_slack ||
+        !dense_z || !dense_rhs_z || !dense_resid_z || !dense_resid_x) {
+      P.MultVector(-sign, res_z, 1., resid_x);
+      resid_z.Copy(res_z);
+      resid_z.ElementWiseMultiply(slack);
+      SmartPtr<Vector> tmp = z.MakeNew();
+      P.TransMultVector(1., res_x, 0., *tmp);
+      tmp->ElementWiseMultiply(z);
+      resid_z.AddTwoVectors(sign, *tmp, -1., rhs_z, 1.);
+      return;
+    }
+
+    const Index* exp_pos = exp_P->ExpandedPosIndices();
+    const Number* res_xvals = dense_res_x->ExpandedValues();
+    const Number* res_zvals = dense_res_z->ExpandedValues();
+    const Number* slackvals = dense_slack->ExpandedValues();
+    const Number* zvals = dense_z->ExpandedValues();
+    const Number* rhs_zvals = dense_rhs_z->ExpandedValues();
+    Number* resid_zvals = dense_resid_z->Values();
+    Number* resid_xvals = dense_resid_x->Values();
+    for (Index i=0; i<resid_z.Dim(); i++) {
+      const Index j = exp_pos[i];
+      resid_zvals[i] = slackvals[i]*res_zvals[i] + sign*zvals[i]*res_xvals[j]
+                       - rhs_zvals[i];
+      resid_xvals[j] -= sign*res_zvals[i];
+    }
+  }
+
   PDFullSpaceSolver::PDFullSpaceSolver(AugSystemSolver& augSysSolver,
                                        PDPerturbationHandler& perturbHandler)
       :
@@ -364,6 +486,165 @@ namespace Ipopt
     return true;
   }
 
+  bool PDFullSpaceSolver::MultiSolve(Number alpha,
+                                     Number beta,
+                                     const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+                                     std::vector<SmartPtr<IteratesVector> >& resV,
+                                     bool allow_inexact)
+  {
+    DBG_START_METH("PDFullSpaceSolver::MultiSolve",dbg_verbosity);
+
+    const Index nrhs = (Index)rhsV.size();
+    DBG_ASSERT(nrhs==(Index)resV.size());
+    if (nrhs == 0) {
+      return true;
+    }
+    if (nrhs == 1) {
+      return Solve(alpha, beta, *rhsV[0], *resV[0], allow_inexact);
+    }
+
+    IpData().TimingStats().PDSystemSolverTotal().Start();
+
+    // if beta is nonzero, keep a copy of the incoming values in res
+    std::vector<SmartPtr<IteratesVector> > copy_resV(nrhs);
+    if (beta != 0.) {
+      for (Index i=0; i<nrhs; i++) {
+        copy_resV[i] = resV[i]->MakeNewIteratesVectorCopy();
+      }
+    }
+
+    // Receive data about matrix
+    SmartPtr<const SymMatrix> W = IpData().W();
+    SmartPtr<const Matrix> J_c = IpCq().curr_jac_c();
+    SmartPtr<const Matrix> J_d = IpCq().curr_jac_d();
+    SmartPtr<const Matrix> Px_L = IpNLP().Px_L();
+    SmartPtr<const Matrix> Px_U = IpNLP().Px_U();
+    SmartPtr<const Matrix> Pd_L = IpNLP().Pd_L();
+    SmartPtr<const Matrix> Pd_U = IpNLP().Pd_U();
+    SmartPtr<const Vector> z_L = IpData().curr()->z_L();
+    SmartPtr<const Vector> z_U = IpData().curr()->z_U();
+    SmartPtr<const Vector> v_L = IpData().curr()->v_L();
+    SmartPtr<const Vector> v_U = IpData().curr()->v_U();
+    SmartPtr<const Vector> slack_x_L = IpCq().curr_slack_x_L();
+    SmartPtr<const Vector> slack_x_U = IpCq().curr_slack_x_U();
+    SmartPtr<const Vector> slack_s_L = IpCq().curr_slack_s_L();
+    SmartPtr<const Vector> slack_s_U = IpCq().curr_slack_s_U();
+    SmartPtr<const Vector> sigma_x = IpCq().curr_sigma_x();
+    SmartPtr<const Vector> sigma_s = IpCq().curr_sigma_s();
+
+    // One back-solve for all right hand sides
+    bool solve_retval =
+      SolveOnce(false, false,
+                *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U,
+                *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U,
+                *sigma_x, *sigma_s, 1., 0., rhsV, resV);
+    if (!solve_retval) {
+      IpData().TimingStats().PDSystemSolverTotal().End();
+      return false;
+    }
+
+    // Right hand sides for which iterative refinement did not
+    // succeed; for those, Solve takes care of the modifications of
+    // the linear system.
+    std::vector<Index> failed;
+
+    if (!allow_inexact) {
+      // Iterative refinement for all right hand sides in lockstep.
+      // The right hand sides that still need refinement are collected
+      // in active, so that their back-solves are done together.
+      std::vector<SmartPtr<IteratesVector> > residV(nrhs);
+      std::vector<Number> residual_ratio_old(nrhs);
+      std::vector<Index> active;
+      for (Index i=0; i<nrhs; i++) {
+        residV[i] = resV[i]->MakeNewIteratesVector(true);
+        ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U,
+                         *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
+                         *slack_s_L, *slack_s_U, *sigma_x, *sigma_s,
+                         alpha, beta, *rhsV[i], *resV[i], *residV[i]);
+        residual_ratio_old[i] =
+          ComputeResidualRatio(*rhsV[i], *resV[i], *residV[i]);
+        Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                       "residual_ratio[%d] = %e\n", i, residual_ratio_old[i]);
+        if (min_refinement_steps_ > 0 ||
+            residual_ratio_old[i] > residual_ratio_max_) {
+          active.push_back(i);
+        }
+      }
+
+      Index num_iter_ref = 0;
+      while (!active.empty()) {
+        const Index nactive = (Index)active.size();
+        std::vector<SmartPtr<const IteratesVector> > residActiveV(nactive);
+        std::vector<SmartPtr<IteratesVector> > resActiveV(nactive);
+        for (Index k=0; k<nactive; k++) {
+          residActiveV[k] = ConstPtr(residV[active[k]]);
+          resActiveV[k] = resV[active[k]];
+        }
+        solve_retval =
+          SolveOnce(false, false,
+                    *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U,
+                    *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U,
+                    *sigma_x, *sigma_s, -1., 1., residActiveV, resActiveV);
+        ASSERT_EXCEPTION(solve_retval, INTERNAL_ABORT,
+                         "SolveOnce returns false during iterative refinement.");
+        num_iter_ref++;
+
+        std::vector<Index> still_active;
+        for (Index k=0; k<nactive; k++) {
+          const Index i = active[k];
+          ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U,
+                           *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
+                           *slack_s_L, *slack_s_U, *sigma_x, *sigma_s,
+                           alpha, beta, *rhsV[i], *resV[i], *residV[i]);
+          Number residual_ratio =
+            ComputeResidualRatio(*rhsV[i], *resV[i], *residV[i]);
+          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                         "residual_ratio[%d] = %e\n", i, residual_ratio);
+          if (num_iter_ref >= min_refinement_steps_ &&
+              residual_ratio <= residual_ratio_max_) {
+            continue;
+          }
+          // Same test as in Solve for giving up on iterative refinement
+          if (num_iter_ref>min_refinement_steps_ &&
+              (num_iter_ref>max_refinement_steps_ ||
+               residual_ratio>residual_improvement_factor_*residual_ratio_old[i])) {
+            Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                           "Iterative refinement failed for right hand side %d with residual_ratio = %e\n", i, residual_ratio);
+            failed.push_back(i);
+            continue;
+          }
+          residual_ratio_old[i] = residual_ratio;
+          still_active.push_back(i);
+        }
+        active.swap(still_active);
+      }
+    }
+
+    IpData().TimingStats().PDSystemSolverTotal().End();
+
+    // For the right hand sides for which iterative refinement failed,
+    // let Solve improve the current solution, possibly with a
+    // better quality of the linear solver or a modified system
+    for (Index k=0; k<(Index)failed.size(); k++) {
+      const Index i = failed[k];
+      if (!Solve(1., 0., *rhsV[i], *resV[i], false, true)) {
+        return false;
+      }
+    }
+
+    // Finally let's assemble the res result vectors
+    for (Index i=0; i<nrhs; i++) {
+      if (alpha != 0.) {
+        resV[i]->Scal(alpha);
+      }
+      if (beta != 0.) {
+        resV[i]->Axpy(beta, *copy_resV[i]);
+      }
+    }
+
+    return true;
+  }
+
   bool PDFullSpaceSolver::SolveOnce(bool resolve_with_better_quality,
                                     bool pretend_singular,
                                     const SymMatrix& W,
@@ -387,6 +668,40 @@ namespace Ipopt
                                     Number beta,
                                     const IteratesVector& rhs,
                                     IteratesVector& res)
+  {
+    DBG_START_METH("PDFullSpaceSolver::SolveOnce",dbg_verbosity);
+
+    std::vector<SmartPtr<const IteratesVector> > rhsV(1, &rhs);
+    std::vector<SmartPtr<IteratesVector> > resV(1, &res);
+    return SolveOnce(resolve_with_better_quality, pretend_singular,
+                     W, J_c, J_d, Px_L, Px_U, Pd_L, Pd_U, z_L, z_U,
+                     v_L, v_U, slack_x_L, slack_x_U, slack_s_L, slack_s_U,
+                     sigma_x, sigma_s, alpha, beta, rhsV, resV);
+  }
+
+  bool PDFullSpaceSolver::SolveOnce(bool resolve_with_better_quality,
+                                    bool pretend_singular,
+                                    const SymMatrix& W,
+                                    const Matrix& J_c,
+                                    const Matrix& J_d,
+                                    const Matrix& Px_L,
+                                    const Matrix& Px_U,
+                                    const Matrix& Pd_L,
+                                    const Matrix& Pd_U,
+                                    const Vector& z_L,
+                                    const Vector& z_U,
+                                    const Vector& v_L,
+                                    const Vector& v_U,
+                                    const Vector& slack_x_L,
+                                    const Vector& slack_x_U,
+                                    const Vector& slack_s_L,
+                                    const Vector& slack_s_U,
+                                    const Vector& sigma_x,
+                                    const Vector& sigma_s,
+                                    Number alpha,
+                                    Number beta,
+                                    const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+                                    std::vector<SmartPtr<IteratesVector> >& resV)
   {
     // TO DO LIST:
     //
@@ -402,17 +717,43 @@ namespace Ipopt
 
     IpData().TimingStats().PDSystemSolverSolveOnce().Start();
 
-    // Compute the right hand side for the augmented system formulation
-    SmartPtr<Vector> augRhs_x = rhs.x()->MakeNewCopy();
-    Px_L.AddMSinvZ(1.0, slack_x_L, *rhs.z_L(), *augRhs_x);
-    Px_U.AddMSinvZ(-1.0, slack_x_U, *rhs.z_U(), *augRhs_x);
-
-    SmartPtr<Vector> augRhs_s = rhs.s()->MakeNewCopy();
-    Pd_L.AddMSinvZ(1.0, slack_s_L, *rhs.v_L(), *augRhs_s);
-    Pd_U.AddMSinvZ(-1.0, slack_s_U, *rhs.v_U(), *augRhs_s);
-
-    // Get space into which we can put the solution of the augmented system
-    SmartPtr<IteratesVector> sol = res.MakeNewIteratesVector(true);
+    const Index nrhs = (Index)rhsV.size();
+    DBG_ASSERT(nrhs>0);
+    DBG_ASSERT(nrhs==(Index)resV.size());
+
+    // Compute the right hand sides for the augmented system
+    // formulation, and get space into which we can put the solutions
+    // of the augmented system
+    std::vector<SmartPtr<const Vector> > augRhs_xV(nrhs);
+    std::vector<SmartPtr<const Vector> > augRhs_sV(nrhs);
+    std::vector<SmartPtr<const Vector> > rhs_cV(nrhs);
+    std::vector<SmartPtr<const Vector> > rhs_dV(nrhs);
+    std::vector<SmartPtr<IteratesVector> > solV(nrhs);
+    std::vector<SmartPtr<Vector> > sol_xV(nrhs);
+    std::vector<SmartPtr<Vector> > sol_sV(nrhs);
+    std::vector<SmartPtr<Vector> > sol_cV(nrhs);
+    std::vector<SmartPtr<Vector> > sol_dV(nrhs);
+    for (Index i=0; i<nrhs; i++) {
+      const IteratesVector& rhs = *rhsV[i];
+      SmartPtr<Vector> augRhs_x = rhs.x()->MakeNewCopy();
+      Px_L.AddMSinvZ(1.0, slack_x_L, *rhs.z_L(), *augRhs_x);
+      Px_U.AddMSinvZ(-1.0, slack_x_U, *rhs.z_U(), *augRhs_x);
+      augRhs_xV[i] = ConstPtr(augRhs_x);
+
+      SmartPtr<Vector> augRhs_s = rhs.s()->MakeNewCopy();
+      Pd_L.AddMSinvZ(1.0, slack_s_L, *rhs.v_L(), *augRhs_s);
+      Pd_U.AddMSinvZ(-1.0, slack_s_U, *rhs.v_U(), *augRhs_s);
+      augRhs_sV[i] = ConstPtr(augRhs_s);
+
+      rhs_cV[i] = rhs.y_c();
+      rhs_dV[i] = rhs.y_d();
+
+      solV[i] = resV[i]->MakeNewIteratesVector(true);
+      sol_xV[i] = solV[i]->x_NonConst();
+      sol_sV[i] = solV[i]->s_NonConst();
+      sol_cV[i] = solV[i]->y_c_NonConst();
+      sol_dV[i] = solV[i]->y_d_NonConst();
+    }
 
     // Now check whether any data has changed
     std::vector<const TaggedObject*> deps(13);
@@ -457,20 +798,19 @@ namespace Ipopt
       // method has already asked the augSysSolver to increase the
       // quality at the end solve, and we are now getting the solution
       // with that better quality
-      retval = augSysSolver_->Solve(&W, 1.0, &sigma_x, delta_x,
-                                    &sigma_s, delta_s, &J_c, NULL,
-                                    delta_c, &J_d, NULL, delta_d,
-                                    *augRhs_x, *augRhs_s, *rhs.y_c(), *rhs.y_d(),
-                                    *sol->x_NonConst(), *sol->s_NonConst(),
-                                    *sol->y_c_NonConst(), *sol->y_d_NonConst(),
-                                    false, 0);
+      retval = augSysSolver_->MultiSolve(&W, 1.0, &sigma_x, delta_x,
+                                         &sigma_s, delta_s, &J_c, NULL,
+                                         delta_c, &J_d, NULL, delta_d,
+                                         augRhs_xV, augRhs_sV, rhs_cV, rhs_dV,
+                                         sol_xV, sol_sV, sol_cV, sol_dV,
+                                         false, 0);
       if (retval!=SYMSOLVER_SUCCESS) {
         IpData().TimingStats().PDSystemSolverSolveOnce().End();
         return false;
       }
     }
     else {
-      const Index numberOfEVals=rhs.y_c()->Dim()+rhs.y_d()->Dim();
+      const Index numberOfEVals=rhs_cV[0]->Dim()+rhs_dV[0]->Dim();
       // counter for the number of trial evaluations
       // (ToDo is not at the correct place)
       Index count = 0;
@@ -501,16 +841,16 @@ namespace Ipopt
           if (neg_curv_test_tol_ > 0.) {
             check_inertia = false;
           }
-          retval = augSysSolver_->Solve(&W, 1.0, &sigma_x, delta_x,
-                                        &sigma_s, delta_s, &J_c, NULL,
-                                        delta_c, &J_d, NULL, delta_d,
-                                        *augRhs_x, *augRhs_s, *rhs.y_c(), *rhs.y_d(),
-                                        *sol->x_NonConst(), *sol->s_NonConst(),
-                                        *sol->y_c_NonConst(), *sol->y_d_NonConst(),                                     check_inertia, numberOfEVals);
+          retval = augSysSolver_->MultiSolve(&W, 1.0, &sigma_x, delta_x,
+                                             &sigma_s, delta_s, &J_c, NULL,
+                                             delta_c, &J_d, NULL, delta_d,
+                                             augRhs_xV, augRhs_sV, rhs_cV, rhs_dV,
+                                             sol_xV, sol_sV, sol_cV, sol_dV,
+                                             check_inertia, numberOfEVals);
         }
         if (retval==SYMSOLVER_FATAL_ERROR) return false;
         if (retval==SYMSOLVER_SINGULAR &&
-            (rhs.y_c()->Dim()+rhs.y_d()->Dim() > 0) ) {
+            (numberOfEVals > 0) ) {
 
           // Get new perturbation factors from the perturbation
           // handlers for the singular case
@@ -577,6 +917,7 @@ namespace Ipopt
           Index neg_values = augSysSolver_->NumberOfNegEVals();
           if (neg_values != numberOfEVals) {
             // check if we have a direction of sufficient positive curvature
+            const IteratesVector* sol = GetRawPtr(solV[0]);
             SmartPtr<Vector> x_tmp = sol->x()->MakeNew();
             W.MultVector(1., *sol->x(), 0., *x_tmp);
             Number xWx = x_tmp->Dot(*sol->x());
@@ -618,14 +959,18 @@ namespace Ipopt
       IpData().setPDPert(delta_x, delta_s, delta_c, delta_d);
     }
 
-    // Compute the remaining sol Vectors
-    Px_L.SinvBlrmZMTdBr(-1., slack_x_L, *rhs.z_L(), z_L, *sol->x(), *sol->z_L_NonConst());
-    Px_U.SinvBlrmZMTdBr(1., slack_x_U, *rhs.z_U(), z_U, *sol->x(), *sol->z_U_NonConst());
-    Pd_L.SinvBlrmZMTdBr(-1., slack_s_L, *rhs.v_L(), v_L, *sol->s(), *sol->v_L_NonConst());
-    Pd_U.SinvBlrmZMTdBr(1., slack_s_U, *rhs.v_U(), v_U, *sol->s(), *sol->v_U_NonConst());
-
-    // Finally let's assemble the res result vectors
-    res.AddOneVector(alpha, *sol, beta);
+    for (Index i=0; i<nrhs; i++) {
+      const IteratesVector& rhs = *rhsV[i];
+      IteratesVector& sol = *solV[i];
+      // Compute the remaining sol Vectors
+      Px_L.SinvBlrmZMTdBr(-1., slack_x_L, *rhs.z_L(), z_L, *sol.x(), *sol.z_L_NonConst());
+      Px_U.SinvBlrmZMTdBr(1., slack_x_U, *rhs.z_U(), z_U, *sol.x(), *sol.z_U_NonConst());
+      Pd_L.SinvBlrmZMTdBr(-1., slack_s_L, *rhs.v_L(), v_L, *sol.s(), *sol.v_L_NonConst());
+      Pd_U.SinvBlrmZMTdBr(1., slack_s_U, *rhs.v_U(), v_U, *sol.s(), *sol.v_U_NonConst());
+
+      // Finally let's assemble the res result vectors
+      resV[i]->AddOneVector(alpha, sol, beta);
+    }
 
     IpData().TimingStats().PDSystemSolverSolveOnce().End();
 
@@ -668,67 +1013,43 @@ namespace Ipopt
     Number delta_d;
     perturbHandler_->CurrentPerturbation(delta_x, delta_s, delta_c, delta_d);
 
-    SmartPtr<Vector> tmp;
-
-    // x
+    // Products with W and the constraint Jacobians, where J_c and
+    // J_d are each traversed only once for the x row and their own row
     W.MultVector(1., *res.x(), 0., *resid.x_NonConst());
-    J_c.TransMultVector(1., *res.y_c(), 1., *resid.x_NonConst());
-    J_d.TransMultVector(1., *res.y_d(), 1., *resid.x_NonConst());
-    Px_L.MultVector(-1., *res.z_L(), 1., *resid.x_NonConst());
-    Px_U.MultVector(1., *res.z_U(), 1., *resid.x_NonConst());
-    resid.x_NonConst()->AddTwoVectors(delta_x, *res.x(), -1., *rhs.x(), 1.);
+    JacobianProducts(J_c, *res.x(), *res.y_c(), *resid.y_c_NonConst(),
+                     *resid.x_NonConst());
+    JacobianProducts(J_d, *res.x(), *res.y_d(), *resid.y_d_NonConst(),
+                     *resid.x_NonConst());
 
     // s
-    Pd_U.MultVector(1., *res.v_U(), 0., *resid.s_NonConst());
-    Pd_L.MultVector(-1., *res.v_L(), 1., *resid.s_NonConst());
-    resid.s_NonConst()->AddTwoVectors(-1., *res.y_d(), -1., *rhs.s(), 1.);
+    resid.s_NonConst()->AddTwoVectors(-1., *res.y_d(), -1., *rhs.s(), 0.);
     if (delta_s!=0.) {
       resid.s_NonConst()->Axpy(delta_s, *res.s());
     }
 
+    // zL, zU, vL, vU, together with the terms for the bound
+    // multipliers in the x and s rows
+    BoundResidual(Px_L, 1., *res.x(), *res.z_L(), slack_x_L, z_L, *rhs.z_L(),
+                  *resid.z_L_NonConst(), *resid.x_NonConst());
+    BoundResidual(Px_U, -1., *res.x(), *res.z_U(), slack_x_U, z_U, *rhs.z_U(),
+                  *resid.z_U_NonConst(), *resid.x_NonConst());
+    BoundResidual(Pd_L, 1., *res.s(), *res.v_L(), slack_s_L, v_L, *rhs.v_L(),
+                  *resid.v_L_NonConst(), *resid.s_NonConst());
+    BoundResidual(Pd_U, -1., *res.s(), *res.v_U(), slack_s_U, v_U, *rhs.v_U(),
+                  *resid.v_U_NonConst(), *resid.s_NonConst());
+
+    // x
+    resid.x_NonConst()->AddTwoVectors(delta_x, *res.x(), -1., *rhs.x(), 1.);
+
     // c
-    J_c.MultVector(1., *res.x(), 0., *resid.y_c_NonConst());
     resid.y_c_NonConst()->AddTwoVectors(-delta_c, *res.y_c(), -1., *rhs.y_c(), 1.);
 
     // d
-    J_d.MultVector(1., *res.x(), 0., *resid.y_d_NonConst());
     resid.y_d_NonConst()->AddTwoVectors(-1., *res.s(), -1., *rhs.y_d(), 1.);
     if (delta_d!=0.) {
       resid.y_d_NonConst()->Axpy(-delta_d, *res.y_d());
     }
 
-    // zL
-    resid.z_L_NonConst()->Copy(*res.z_L());
-    resid.z_L_NonConst()->ElementWiseMultiply(slack_x_L);
-    tmp = z_L.MakeNew();
-    Px_L.TransMultVector(1., *res.x(), 0., *tmp);
-    tmp->ElementWiseMultiply(z_L);
-    resid.z_L_NonConst()->AddTwoVectors(1., *tmp, -1., *rhs.z_L(), 1.);
-
-    // zU
-    resid.z_U_NonConst()->Copy(*res.z_U());
-    resid.z_U_NonConst()->ElementWiseMultiply(slack_x_U);
-    tmp = z_U.MakeNew();
-    Px_U.TransMultVector(1., *res.x(), 0., *tmp);
-    tmp->ElementWiseMultiply(z_U);
-    resid.z_U_NonConst()->AddTwoVectors(-1., *tmp, -1., *rhs.z_U(), 1.);
-
-    // vL
-    resid.v_L_NonConst()->Copy(*res.v_L());
-    resid.v_L_NonConst()->ElementWiseMultiply(slack_s_L);
-    tmp = v_L.MakeNew();
-    Pd_L.TransMultVector(1., *res.s(), 0., *tmp);
-    tmp->ElementWiseMultiply(v_L);
-    resid.v_L_NonConst()->AddTwoVectors(1., *tmp, -1., *rhs.v_L(), 1.);
-
-    // vU
-    resid.v_U_NonConst()->Copy(*res.v_U());
-    resid.v_U_NonConst()->ElementWiseMultiply(slack_s_U);
-    tmp = v_U.MakeNew();
-    Pd_U.TransMultVector(1., *res.s(), 0., *tmp);
-    tmp->ElementWiseMultiply(v_U);
-    resid.v_U_NonConst()->AddTwoVectors(-1., *tmp, -1., *rhs.v_U(), 1.);
-
     DBG_PRINT_VECTOR(2, "resid", resid);
 
     if (Jnlst().ProduceOutput(J_MOREVECTOR, J_LINEAR_ALGEBRA)) {
@@ -57,6 +57,17 @@ namespace Ipopt
                        bool allow_inexact=false,
                        bool improve_solution=false);
 
+    /** Solve the primal dual system for several right hand sides.
+     *  The back-solves for all right hand sides are done together
+     *  (also within iterative refinement), so that the augmented
+     *  system solver sees the whole block at once.
+     */
+    virtual bool MultiSolve(Number alpha,
+                            Number beta,
+                            const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+                            std::vector<SmartPtr<IteratesVector> >& resV,
+                            bool allow_inexact=false);
+
     /** Methods for IpoptType */
     //@{
     static void RegisterOptions(SmartPtr<RegisteredOptions> roptions);
@@ -144,6 +155,34 @@ namespace Ipopt
                    const IteratesVector& rhs,
                    IteratesVector& res);
 
+    /** Same as SolveOnce above, but for several right hand sides,
+     *  which are given to the augmented system solver together.  If
+     *  the matrix has to be factorized, the inertia heuristic is
+     *  applied to the solution for the first right hand side. */
+    bool SolveOnce(bool resolve_unmodified,
+                   bool pretend_singular,
+                   const SymMatrix& W,
+                   const Matrix& J_c,
+                   const Matrix& J_d,
+                   const Matrix& Px_L,
+                   const Matrix& Px_U,
+                   const Matrix& Pd_L,
+                   const Matrix& Pd_U,
+                   const Vector& z_L,
+                   const Vector& z_U,
+                   const Vector& v_L,
+                   const Vector& v_U,
+                   const Vector& slack_x_L,
+                   const Vector& slack_x_U,
+                   const Vector& slack_s_L,
+                   const Vector& slack_s_U,
+                   const Vector& sigma_x,
+                   const Vector& sigma_s,
+                   Number alpha,
+                   Number beta,
+                   const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+                   std::vector<SmartPtr<IteratesVector> >& resV);
+
     /** Internal function for computing the residual (resid) given the
      * right hand side (rhs) and the solution of the system (res).
      */
@@ -110,6 +110,29 @@ namespace Ipopt
                        bool allow_inexact=false,
                        bool improve_solution=false) =0;
 
+    /** Solve the primal dual system for several right hand sides,
+     *  res[i] = alpha * sol[i] + beta * res[i].  Implementations
+     *  should use the same factorization for all right hand sides
+     *  and do the back-solves together, so that the linear solver can
+     *  work on the block of all right hand sides at once.  The
+     *  default implementation calls Solve for one right hand side
+     *  after the other.  The return value is false, if a solution
+     *  could not be computed for one of the right hand sides. */
+    virtual bool MultiSolve(Number alpha,
+                            Number beta,
+                            const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+                            std::vector<SmartPtr<IteratesVector> >& resV,
+                            bool allow_inexact=false)
+    {
+      DBG_ASSERT(rhsV.size()==resV.size());
+      for (Index i=0; i<(Index)rhsV.size(); i++) {
+        if (!Solve(alpha, beta, *rhsV[i], *resV[i], allow_inexact)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
   private:
     /**@name Default Compiler Generated Methods
      * (Hidden to avoid implicit creation/calling).
@@ -7,6 +7,10 @@
 // Authors:  Carl Laird, Andreas Waechter            IBM    2004-11-12
 
 #include "IpQualityFunctionMuOracle.hpp"
+#include "IpDenseVector.hpp"
+
+#include <limits>
+#include <vector>
 
 #ifdef HAVE_CMATH
 # include <cmath>
@@ -28,12 +32,212 @@
 # endif
 #endif
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 namespace Ipopt
 {
 #if COIN_IPOPT_VERBOSITY > 0
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Minimal number of element and sigma value pairs for which the
+   *  quality function values are computed with several threads. */
+  static const Index qf_parallel_elements = 100000;
+
+  /** Number of bounds that are processed for all values of sigma
+   *  before going to the next bounds.  The loops over one block of
+   *  bounds do not depend on earlier iterations, so that the compiler
+   *  can vectorize them, and the data of a block stays in cache. */
+  static const Index qf_block_size = 256;
+
+  /** Values of the vectors for one type of bounds (x_L, x_U, s_L, or
+   *  s_U) that are needed to evaluate the quality function. */
+  struct QualityFunctionBoundValues
+  {
+    Index dim;
+    const Number* slack;
+    const Number* step_aff_slack;
+    const Number* step_cen_slack;
+    const Number* mult;
+    const Number* step_aff_mult;
+    const Number* step_cen_mult;
+  };
+
+  /** Number of threads used for the evaluation of nsigma values of
+   *  the quality function for dim bounds.  The bounds are
+   *  distributed among the threads. */
+  static Index QualityFunctionNumThreads(Index dim, Index nsigma)
+  {
+#ifdef _OPENMP
+    if ((double)dim*(double)nsigma >= (double)qf_parallel_elements &&
+        !omp_in_parallel()) {
+      return Max(Index(1), Min(Index(omp_get_max_threads()), dim));
+    }
+#endif
+    return 1;
+  }
+
+  /** Computes the primal and dual fraction-to-the-boundary step sizes
+   *  alpha_primal[k] and alpha_dual[k] for the steps step_aff +
+   *  sigmas[k]*step_cen, k=0,...,nsigma-1, in one pass over the
+   *  values of the nbounds types of bounds. */
+  static void GridFracToBound(Index nbounds,
+                              const QualityFunctionBoundValues* bounds,
+                              Index nsigma, const Number* sigmas,
+                              Number tau, Number* alpha_primal,
+                              Number* alpha_dual)
+  {
+    for (Index k=0; k<nsigma; k++) {
+      alpha_primal[k] = 1.;
+      alpha_dual[k] = 1.;
+    }
+    for (Index b=0; b<nbounds; b++) {
+      const QualityFunctionBoundValues& bv = bounds[b];
+      const Index nthreads = QualityFunctionNumThreads(bv.dim, nsigma);
+      std::vector<Number> partial(2*nthreads*nsigma, 1.);
+      const Index blk = bv.dim/nthreads;
+      const Index rem = bv.dim%nthreads;
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index t=0; t<nthreads; t++) {
+        const Index first = t*blk + Min(t, rem);
+        const Index last = first + blk + (t<rem ? 1 : 0);
+        Number* ap = &partial[2*t*nsigma];
+        Number* ad = ap + nsigma;
+        Number rp[qf_block_size];
+        Number rd[qf_block_size];
+        for (Index i0=first; i0<last; i0+=qf_block_size) {
+          const Index n = Min(qf_block_size, last-i0);
+          const Number* slack = bv.slack + i0;
+          const Number* step_aff_slack = bv.step_aff_slack + i0;
+          const Number* step_cen_slack = bv.step_cen_slack + i0;
+          const Number* mult = bv.mult + i0;
+          const Number* step_aff_mult = bv.step_aff_mult + i0;
+          const Number* step_cen_mult = bv.step_cen_mult + i0;
+          for (Index k=0; k<nsigma; k++) {
+            const Number sigma = sigmas[k];
+            for (Index i=0; i<n; i++) {
+              const Number dp = step_aff_slack[i] + sigma*step_cen_slack[i];
+              const Number dd = step_aff_mult[i] + sigma*step_cen_mult[i];
+              const Number qp = -tau/dp * slack[i];
+              const Number qd = -tau/dd * mult[i];
+              rp[i] = (dp<0.) ? qp : 1.;
+              rd[i] = (dd<0.) ? qd : 1.;
+            }
+            Number apk = ap[k];
+            Number adk = ad[k];
+            for (Index i=0; i<n; i++) {
+              apk = Min(apk, rp[i]);
+              adk = Min(adk, rd[i]);
+            }
+            ap[k] = apk;
+            ad[k] = adk;
+          }
+        }
+      }
+      for (Index t=0; t<nthreads; t++) {
+        for (Index k=0; k<nsigma; k++) {
+          alpha_primal[k] = Min(alpha_primal[k], partial[2*t*nsigma+k]);
+          alpha_dual[k] = Min(alpha_dual[k], partial[(2*t+1)*nsigma+k]);
+        }
+      }
+    }
+  }
+
+  /** Computes the sum of absolute values (asum), the sum of squares
+   *  (sumsq), the maximal absolute value (amax) and the minimum
+   *  (cmin) of the complementarities at the trial points for the
+   *  steps step_aff + sigmas[k]*step_cen with step sizes
+   *  alpha_primal[k] and alpha_dual[k], k=0,...,nsigma-1, in one pass
+   *  over the values of the nbounds types of bounds.  cmin is only
+   *  meaningful if there are bounds. */
+  static void GridComplementarity(Index nbounds,
+                                  const QualityFunctionBoundValues* bounds,
+                                  Index nsigma, const Number* sigmas,
+                                  const Number* alpha_primal,
+                                  const Number* alpha_dual,
+                                  Number* asum, Number* sumsq,
+                                  Number* amax, Number* cmin)
+  {
+    for (Index k=0; k<nsigma; k++) {
+      asum[k] = 0.;
+      sumsq[k] = 0.;
+      amax[k] = 0.;
+      cmin[k] = std::numeric_limits<Number>::max();
+    }
+    for (Index b=0; b<nbounds; b++) {
+      const QualityFunctionBoundValues& bv = bounds[b];
+      const Index nthreads = QualityFunctionNumThreads(bv.dim, nsigma);
+      std::vector<Number> partial(4*nthreads*nsigma);
+      const Index blk = bv.dim/nthreads;
+      const Index rem = bv.dim%nthreads;
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index t=0; t<nthreads; t++) {
+        const Index first = t*blk + Min(t, rem);
+        const Index last = first + blk + (t<rem ? 1 : 0);
+        Number* pasum = &partial[4*t*nsigma];
+        Number* psumsq = pasum + nsigma;
+        Number* pamax = psumsq + nsigma;
+        Number* pcmin = pamax + nsigma;
+        for (Index k=0; k<nsigma; k++) {
+          pasum[k] = 0.;
+          psumsq[k] = 0.;
+          pamax[k] = 0.;
+          pcmin[k] = std::numeric_limits<Number>::max();
+        }
+        Number compl_vals[qf_block_size];
+        for (Index i0=first; i0<last; i0+=qf_block_size) {
+          const Index n = Min(qf_block_size, last-i0);
+          const Number* slack = bv.slack + i0;
+          const Number* step_aff_slack = bv.step_aff_slack + i0;
+          const Number* step_cen_slack = bv.step_cen_slack + i0;
+          const Number* mult = bv.mult + i0;
+          const Number* step_aff_mult = bv.step_aff_mult + i0;
+          const Number* step_cen_mult = bv.step_cen_mult + i0;
+          for (Index k=0; k<nsigma; k++) {
+            const Number sigma = sigmas[k];
+            const Number ap = alpha_primal[k];
+            const Number ad = alpha_dual[k];
+            for (Index i=0; i<n; i++) {
+              const Number dp = step_aff_slack[i] + sigma*step_cen_slack[i];
+              const Number dd = step_aff_mult[i] + sigma*step_cen_mult[i];
+              compl_vals[i] = (slack[i] + ap*dp) * (mult[i] + ad*dd);
+            }
+            Number asum_k = pasum[k];
+            Number sumsq_k = psumsq[k];
+            Number amax_k = pamax[k];
+            Number cmin_k = pcmin[k];
+            for (Index i=0; i<n; i++) {
+              const Number abs_compl = fabs(compl_vals[i]);
+              asum_k += abs_compl;
+              sumsq_k += compl_vals[i]*compl_vals[i];
+              amax_k = Max(amax_k, abs_compl);
+              cmin_k = Min(cmin_k, compl_vals[i]);
+            }
+            pasum[k] = asum_k;
+            psumsq[k] = sumsq_k;
+            pamax[k] = amax_k;
+            pcmin[k] = cmin_k;
+          }
+        }
+      }
+      for (Index t=0; t<nthreads; t++) {
+        const Number* pasum = &partial[4*t*nsigma];
+        for (Index k=0; k<nsigma; k++) {
+          asum[k] += pasum[k];
+          sumsq[k] += pasum[nsigma+k];
+          amax[k] = Max(amax[k], pasum[2*nsigma+k]);
+          cmin[k] = Min(cmin[k], pasum[3*nsigma+k]);
+        }
+      }
+    }
+  }
+
   QualityFunctionMuOracle::QualityFunctionMuOracle(const SmartPtr<PDSystemSolver>& pd_solver)
       :
       MuOracle(),
@@ -138,6 +342,19 @@ namespace Ipopt
       "The golden section search is performed for the quality function based mu "
       "oracle. (Only used if option "
       "\"mu_oracle\" is set to \"quality-function\".)");
+    roptions->AddLowerBoundedIntegerOption(
+      "quality_function_grid_points",
+      "Number of values of the centering parameter that are evaluated "
+      "together in each search step.",
+      0, 0,
+      "If this is positive, the golden section search for the centering "
+      "parameter is replaced by a search on a grid with this number of "
+      "points, which is refined around the best point in each step (at most "
+      "\"quality_function_max_section_steps\" times, until the tolerance "
+      "\"quality_function_section_sigma_tol\" is reached).  The quality "
+      "function values for all points of a grid are computed together in one "
+      "pass over the vectors.  If 0, the golden section search is used. "
+      "(Only used if option \"mu_oracle\" is set to \"quality-function\".)");
   }
 
 
@@ -161,6 +378,8 @@ namespace Ipopt
                             quality_function_section_sigma_tol_, prefix);
     options.GetNumericValue("quality_function_section_qf_tol",
                             quality_function_section_qf_tol_, prefix);
+    options.GetIntegerValue("quality_function_grid_points",
+                            quality_function_grid_points_, prefix);
 
     initialized_ = false;
 
@@ -195,13 +414,13 @@ namespace Ipopt
     tmp_v_L_ = IpNLP().d_L()->MakeNew();
     tmp_v_U_ = IpNLP().d_U()->MakeNew();
 
-    /////////////////////////////////////
-    // Compute the affine scaling step //
-    /////////////////////////////////////
+    ////////////////////////////////////////////////////////
+    // Compute the affine scaling and pure centering steps //
+    ////////////////////////////////////////////////////////
 
     Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                   "Solving the Primal Dual System for the affine step\n");
-    // First get the right hand side
+                   "Solving the Primal Dual System for the affine step and the centering step\n");
+    // First get the right hand side for the affine step
     SmartPtr<IteratesVector> rhs_aff = IpData().curr()->MakeNewIteratesVector(false);
     rhs_aff->Set_x(*IpCq().curr_grad_lag_x());
     rhs_aff->Set_s(*IpCq().curr_grad_lag_s());
@@ -215,32 +434,9 @@ namespace Ipopt
     // Get space for the affine scaling step
     SmartPtr<IteratesVector> step_aff = IpData().curr()->MakeNewIteratesVector(true);
 
-    // Now solve the primal-dual system to get the step.  We allow a
-    // somewhat inexact solution, iterative refinement will be done
-    // after mu is known
-    bool allow_inexact = true;
-    bool retval = pd_solver_->Solve(-1.0, 0.0,
-                                    *rhs_aff,
-                                    *step_aff,
-                                    allow_inexact
-                                   );
-    if (!retval) {
-      Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                     "The linear system could not be solved for the affine step!\n");
-      return false;
-    }
-
-    DBG_PRINT_VECTOR(2, "step_aff", *step_aff);
-
-    /////////////////////////////////////
-    // Compute the pure centering step //
-    /////////////////////////////////////
-
+    // Now the right hand side for the centering step
     Number avrg_compl = IpCq().curr_avrg_compl();
 
-    Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                   "Solving the Primal Dual System for the centering step\n");
-    // First get the right hand side
     SmartPtr<IteratesVector> rhs_cen = IpData().curr()->MakeNewIteratesVector(true);
     rhs_cen->x_NonConst()->AddOneVector(-avrg_compl,
                                         *IpCq().grad_kappa_times_damping_x(),
@@ -259,19 +455,28 @@ namespace Ipopt
     // Get space for the centering step
     SmartPtr<IteratesVector> step_cen = IpData().curr()->MakeNewIteratesVector(true);
 
-    // Now solve the primal-dual system to get the step
-    allow_inexact = true;
-    retval = pd_solver_->Solve(1.0, 0.0,
-                               *rhs_cen,
-                               *step_cen,
-                               allow_inexact
-                              );
+    // Now solve the primal-dual system for both right hand sides
+    // together, so that the back-solves are done at once.  We allow a
+    // somewhat inexact solution, iterative refinement will be done
+    // after mu is known
+    std::vector<SmartPtr<const IteratesVector> > rhsV(2);
+    std::vector<SmartPtr<IteratesVector> > stepV(2);
+    rhsV[0] = ConstPtr(rhs_aff);
+    rhsV[1] = ConstPtr(rhs_cen);
+    stepV[0] = step_aff;
+    stepV[1] = step_cen;
+    bool allow_inexact = true;
+    bool retval = pd_solver_->MultiSolve(1.0, 0.0, rhsV, stepV,
+                                         allow_inexact);
     if (!retval) {
       Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                     "The linear system could not be solved for the centering step!\n");
+                     "The linear system could not be solved for the affine step and the centering step!\n");
       return false;
     }
+    // The affine scaling step is the negative solution
+    step_aff->Scal(-1.);
 
+    DBG_PRINT_VECTOR(2, "step_aff", *step_aff);
     DBG_PRINT_VECTOR(2, "step_cen", *step_cen);
 
     // Start the timing for the quality function search here
@@ -458,29 +663,55 @@ namespace Ipopt
       }
       else {
         // ToDo maybe we should use different tolerances for sigma>1
-        sigma = PerformGoldenSection(sigma_up, -100., sigma_lo, qf_1,
-                                     quality_function_section_sigma_tol_,
-                                     quality_function_section_qf_tol_,
-                                     *step_aff_x_L,
-                                     *step_aff_x_U,
-                                     *step_aff_s_L,
-                                     *step_aff_s_U,
-                                     *step_aff->y_c(),
-                                     *step_aff->y_d(),
-                                     *step_aff->z_L(),
-                                     *step_aff->z_U(),
-                                     *step_aff->v_L(),
-                                     *step_aff->v_U(),
-                                     *step_cen_x_L,
-                                     *step_cen_x_U,
-                                     *step_cen_s_L,
-                                     *step_cen_s_U,
-                                     *step_cen->y_c(),
-                                     *step_cen->y_d(),
-                                     *step_cen->z_L(),
-                                     *step_cen->z_U(),
-                                     *step_cen->v_L(),
-                                     *step_cen->v_U());
+        if (quality_function_grid_points_>0) {
+          sigma = PerformGridSearch(sigma_up, sigma_lo,
+                                    quality_function_section_sigma_tol_,
+                                    *step_aff_x_L,
+                                    *step_aff_x_U,
+                                    *step_aff_s_L,
+                                    *step_aff_s_U,
+                                    *step_aff->y_c(),
+                                    *step_aff->y_d(),
+                                    *step_aff->z_L(),
+                                    *step_aff->z_U(),
+                                    *step_aff->v_L(),
+                                    *step_aff->v_U(),
+                                    *step_cen_x_L,
+                                    *step_cen_x_U,
+                                    *step_cen_s_L,
+                                    *step_cen_s_U,
+                                    *step_cen->y_c(),
+                                    *step_cen->y_d(),
+                                    *step_cen->z_L(),
+                                    *step_cen->z_U(),
+                                    *step_cen->v_L(),
+                                    *step_cen->v_U());
+        }
+        else {
+          sigma = PerformGoldenSection(sigma_up, -100., sigma_lo, qf_1,
+                                       quality_function_section_sigma_tol_,
+                                       quality_function_section_qf_tol_,
+                                       *step_aff_x_L,
+                                       *step_aff_x_U,
+                                       *step_aff_s_L,
+                                       *step_aff_s_U,
+                                       *step_aff->y_c(),
+                                       *step_aff->y_d(),
+                                       *step_aff->z_L(),
+                                       *step_aff->z_U(),
+                                       *step_aff->v_L(),
+                                       *step_aff->v_U(),
+                                       *step_cen_x_L,
+                                       *step_cen_x_U,
+                                       *step_cen_s_L,
+                                       *step_cen_s_U,
+                                       *step_cen->y_c(),
+                                       *step_cen->y_d(),
+                                       *step_cen->z_L(),
+                                       *step_cen->z_U(),
+                                       *step_cen->v_L(),
+                                       *step_cen->v_U());
+        }
       }
     }
     else {
@@ -493,29 +724,55 @@ namespace Ipopt
         sigma = sigma_lo;
       }
       else {
-        sigma = PerformGoldenSection(sigma_up, qf_1minus, sigma_lo, -100.,
-                                     quality_function_section_sigma_tol_,
-                                     quality_function_section_qf_tol_,
-                                     *step_aff_x_L,
-                                     *step_aff_x_U,
-                                     *step_aff_s_L,
-                                     *step_aff_s_U,
-                                     *step_aff->y_c(),
-                                     *step_aff->y_d(),
-                                     *step_aff->z_L(),
-                                     *step_aff->z_U(),
-                                     *step_aff->v_L(),
-                                     *step_aff->v_U(),
-                                     *step_cen_x_L,
-                                     *step_cen_x_U,
-                                     *step_cen_s_L,
-                                     *step_cen_s_U,
-                                     *step_cen->y_c(),
-                                     *step_cen->y_d(),
-                                     *step_cen->z_L(),
-                                     *step_cen->z_U(),
-                                     *step_cen->v_L(),
-                                     *step_cen->v_U());
+        if (quality_function_grid_points_>0) {
+          sigma = PerformGridSearch(sigma_up, sigma_lo,
+                                    quality_function_section_sigma_tol_,
+                                    *step_aff_x_L,
+                                    *step_aff_x_U,
+                                    *step_aff_s_L,
+                                    *step_aff_s_U,
+                                    *step_aff->y_c(),
+                                    *step_aff->y_d(),
+                                    *step_aff->z_L(),
+                                    *step_aff->z_U(),
+                                    *step_aff->v_L(),
+                                    *step_aff->v_U(),
+                                    *step_cen_x_L,
+                                    *step_cen_x_U,
+                                    *step_cen_s_L,
+                                    *step_cen_s_U,
+                                    *step_cen->y_c(),
+                                    *step_cen->y_d(),
+                                    *step_cen->z_L(),
+                                    *step_cen->z_U(),
+                                    *step_cen->v_L(),
+                                    *step_cen->v_U());
+        }
+        else {
+          sigma = PerformGoldenSection(sigma_up, qf_1minus, sigma_lo, -100.,
+                                       quality_function_section_sigma_tol_,
+                                       quality_function_section_qf_tol_,
+                                       *step_aff_x_L,
+                                       *step_aff_x_U,
+                                       *step_aff_s_L,
+                                       *step_aff_s_U,
+                                       *step_aff->y_c(),
+                                       *step_aff->y_d(),
+                                       *step_aff->z_L(),
+                                       *step_aff->z_U(),
+                                       *step_aff->v_L(),
+                                       *step_aff->v_U(),
+                                       *step_cen_x_L,
+                                       *step_cen_x_U,
+                                       *step_cen_s_L,
+                                       *step_cen_s_U,
+                                       *step_cen->y_c(),
+                                       *step_cen->y_d(),
+                                       *step_cen->z_L(),
+                                       *step_cen->z_U(),
+                                       *step_cen->v_L(),
+                                       *step_cen->v_U());
+        }
       }
     }
 
@@ -710,11 +967,60 @@ namespace Ipopt
     DBG_PRINT_VECTOR(2, "compl_s_L", *tmp_slack_s_L_);
     DBG_PRINT_VECTOR(2, "compl_s_U", *tmp_slack_s_U_);
 
-    Number dual_inf=-1.;
-    Number primal_inf=-1.;
     Number compl_inf=-1.;
 
     IpData().TimingStats().Task5().Start();
+    switch (quality_function_norm_) {
+    case NM_NORM_1:
+      compl_inf = tmp_slack_x_L_->Asum() + tmp_slack_x_U_->Asum() +
+                  tmp_slack_s_L_->Asum() + tmp_slack_s_U_->Asum();
+      DBG_ASSERT(n_comp_>0);
+      compl_inf /= n_comp_;
+      break;
+    case NM_NORM_2_SQUARED:
+      compl_inf =
+        pow(tmp_slack_x_L_->Nrm2(), 2) + pow(tmp_slack_x_U_->Nrm2(), 2) +
+        pow(tmp_slack_s_L_->Nrm2(), 2) + pow(tmp_slack_s_U_->Nrm2(), 2);
+      DBG_ASSERT(n_comp_>0);
+      compl_inf /= n_comp_;
+      break;
+    case NM_NORM_MAX:
+      compl_inf =
+        Max(tmp_slack_x_L_->Amax(), tmp_slack_x_U_->Amax(),
+            tmp_slack_s_L_->Amax(), tmp_slack_s_U_->Amax());
+      break;
+    case NM_NORM_2:
+      compl_inf =
+        sqrt(pow(tmp_slack_x_L_->Nrm2(), 2) + pow(tmp_slack_x_U_->Nrm2(), 2) +
+             pow(tmp_slack_s_L_->Nrm2(), 2) + pow(tmp_slack_s_U_->Nrm2(), 2));
+      DBG_ASSERT(n_comp_>0);
+      compl_inf /= sqrt((Number)n_comp_);
+      break;
+    default:
+      DBG_ASSERT(false && "Unknown value for quality_function_norm_");
+    }
+    IpData().TimingStats().Task5().End();
+
+    if (quality_function_centrality_!=CEN_NONE) {
+      IpData().TimingStats().Task4().Start();
+      xi = IpCq().CalcCentralityMeasure(*tmp_slack_x_L_, *tmp_slack_x_U_,
+                                        *tmp_slack_s_L_, *tmp_slack_s_U_);
+      IpData().TimingStats().Task4().End();
+    }
+
+    return QualityFunctionValue(sigma, alpha_primal, alpha_dual, compl_inf,
+                                xi);
+  }
+
+  Number QualityFunctionMuOracle::QualityFunctionValue(Number sigma,
+      Number alpha_primal,
+      Number alpha_dual,
+      Number compl_inf,
+      Number xi)
+  {
+    Number dual_inf=-1.;
+    Number primal_inf=-1.;
+
     switch (quality_function_norm_) {
     case NM_NORM_1:
       dual_inf = (1.-alpha_dual)*(curr_grad_lag_x_asum_ +
@@ -723,15 +1029,10 @@ namespace Ipopt
       primal_inf = (1.-alpha_primal)*(curr_c_asum_ +
                                       curr_d_minus_s_asum_);
 
-      compl_inf = tmp_slack_x_L_->Asum() + tmp_slack_x_U_->Asum() +
-                  tmp_slack_s_L_->Asum() + tmp_slack_s_U_->Asum();
-
       dual_inf /= n_dual_;
       if (n_pri_>0) {
         primal_inf /= n_pri_;
       }
-      DBG_ASSERT(n_comp_>0);
-      compl_inf /= n_comp_;
       break;
     case NM_NORM_2_SQUARED:
       dual_inf =
@@ -740,16 +1041,11 @@ namespace Ipopt
       primal_inf =
         pow(1.-alpha_primal, 2)*(pow(curr_c_nrm2_, 2) +
                                  pow(curr_d_minus_s_nrm2_, 2));
-      compl_inf =
-        pow(tmp_slack_x_L_->Nrm2(), 2) + pow(tmp_slack_x_U_->Nrm2(), 2) +
-        pow(tmp_slack_s_L_->Nrm2(), 2) + pow(tmp_slack_s_U_->Nrm2(), 2);
 
       dual_inf /= n_dual_;
       if (n_pri_>0) {
         primal_inf /= n_pri_;
       }
-      DBG_ASSERT(n_comp_>0);
-      compl_inf /= n_comp_;
       break;
     case NM_NORM_MAX:
       dual_inf =
@@ -758,9 +1054,6 @@ namespace Ipopt
       primal_inf =
         (1.-alpha_primal)*Max(curr_c_amax_,
                               curr_d_minus_s_amax_);
-      compl_inf =
-        Max(tmp_slack_x_L_->Amax(), tmp_slack_x_U_->Amax(),
-            tmp_slack_s_L_->Amax(), tmp_slack_s_U_->Amax());
       break;
     case NM_NORM_2:
       dual_inf =
@@ -769,30 +1062,18 @@ namespace Ipopt
       primal_inf =
         (1.-alpha_primal)*sqrt(pow(curr_c_nrm2_, 2) +
                                pow(curr_d_minus_s_nrm2_, 2));
-      compl_inf =
-        sqrt(pow(tmp_slack_x_L_->Nrm2(), 2) + pow(tmp_slack_x_U_->Nrm2(), 2) +
-             pow(tmp_slack_s_L_->Nrm2(), 2) + pow(tmp_slack_s_U_->Nrm2(), 2));
 
       dual_inf /= sqrt((Number)n_dual_);
       if (n_pri_>0) {
         primal_inf /= sqrt((Number)n_pri_);
       }
-      DBG_ASSERT(n_comp_>0);
-      compl_inf /= sqrt((Number)n_comp_);
       break;
     default:
       DBG_ASSERT(false && "Unknown value for quality_function_norm_");
     }
-    IpData().TimingStats().Task5().End();
 
     Number quality_function = dual_inf + primal_inf + compl_inf;
 
-    if (quality_function_centrality_!=CEN_NONE) {
-      IpData().TimingStats().Task4().Start();
-      xi = IpCq().CalcCentralityMeasure(*tmp_slack_x_L_, *tmp_slack_x_U_,
-                                        *tmp_slack_s_L_, *tmp_slack_s_U_);
-      IpData().TimingStats().Task4().End();
-    }
     switch (quality_function_centrality_) {
     case CEN_NONE:
       //Nothing
@@ -828,6 +1109,267 @@ namespace Ipopt
     //return compl_inf;
   }
 
+  void QualityFunctionMuOracle::CalculateQualityFunctions
+  (Index nsigma,
+   const Number* sigmas,
+   Number* qfs,
+   const Vector& step_aff_x_L,
+   const Vector& step_aff_x_U,
+   const Vector& step_aff_s_L,
+   const Vector& step_aff_s_U,
+   const Vector& step_aff_y_c,
+   const Vector& step_aff_y_d,
+   const Vector& step_aff_z_L,
+   const Vector& step_aff_z_U,
+   const Vector& step_aff_v_L,
+   const Vector& step_aff_v_U,
+   const Vector& step_cen_x_L,
+   const Vector& step_cen_x_U,
+   const Vector& step_cen_s_L,
+   const Vector& step_cen_s_U,
+   const Vector& step_cen_y_c,
+   const Vector& step_cen_y_d,
+   const Vector& step_cen_z_L,
+   const Vector& step_cen_z_U,
+   const Vector& step_cen_v_L,
+   const Vector& step_cen_v_U
+  )
+  {
+    DBG_START_METH("QualityFunctionMuOracle::CalculateQualityFunctions",
+                   dbg_verbosity);
+
+    // The step sizes and complementarities for all values of sigma are
+    // computed directly from the values of the vectors, so that the
+    // linear combinations of the steps are not formed explicitly
+    const Vector* vecs[4][6] = {
+      { GetRawPtr(curr_slack_x_L_), &step_aff_x_L, &step_cen_x_L,
+        GetRawPtr(curr_z_L_), &step_aff_z_L, &step_cen_z_L },
+      { GetRawPtr(curr_slack_x_U_), &step_aff_x_U, &step_cen_x_U,
+        GetRawPtr(curr_z_U_), &step_aff_z_U, &step_cen_z_U },
+      { GetRawPtr(curr_slack_s_L_), &step_aff_s_L, &step_cen_s_L,
+        GetRawPtr(curr_v_L_), &step_aff_v_L, &step_cen_v_L },
+      { GetRawPtr(curr_slack_s_U_), &step_aff_s_U, &step_cen_s_U,
+        GetRawPtr(curr_v_U_), &step_aff_v_U, &step_cen_v_U }
+    };
+    QualityFunctionBoundValues bounds[4];
+    bool all_dense = true;
+    for (Index b=0; b<4 && all_dense; b++) {
+      const Number* vals[6];
+      for (Index j=0; j<6; j++) {
+        const DenseVector* dvec = dynamic_cast<const DenseVector*>(vecs[b][j]);
+        if (!dvec) {
+          all_dense = false;
+          break;
+        }
+        vals[j] = dvec->ExpandedValues();
+      }
+      if (all_dense) {
+        bounds[b].dim = vecs[b][0]->Dim();
+        bounds[b].slack = vals[0];
+        bounds[b].step_aff_slack = vals[1];
+        bounds[b].step_cen_slack = vals[2];
+        bounds[b].mult = vals[3];
+        bounds[b].step_aff_mult = vals[4];
+        bounds[b].step_cen_mult = vals[5];
+      }
+    }
+
+    if (!all_dense) {
+      for (Index k=0; k<nsigma; k++) {
+        qfs[k] = CalculateQualityFunction(sigmas[k],
+                                          step_aff_x_L,
+                                          step_aff_x_U,
+                                          step_aff_s_L,
+                                          step_aff_s_U,
+                                          step_aff_y_c,
+                                          step_aff_y_d,
+                                          step_aff_z_L,
+                                          step_aff_z_U,
+                                          step_aff_v_L,
+                                          step_aff_v_U,
+                                          step_cen_x_L,
+                                          step_cen_x_U,
+                                          step_cen_s_L,
+                                          step_cen_s_U,
+                                          step_cen_y_c,
+                                          step_cen_y_d,
+                                          step_cen_z_L,
+                                          step_cen_z_U,
+                                          step_cen_v_L,
+                                          step_cen_v_U);
+      }
+      return;
+    }
+
+    count_qf_evals_ += nsigma;
+
+    std::vector<Number> alpha_primal(nsigma);
+    std::vector<Number> alpha_dual(nsigma);
+    IpData().TimingStats().Task2().Start();
+    GridFracToBound(4, bounds, nsigma, sigmas, IpData().curr_tau(),
+                    &alpha_primal[0], &alpha_dual[0]);
+    IpData().TimingStats().Task2().End();
+
+    std::vector<Number> asum(nsigma);
+    std::vector<Number> sumsq(nsigma);
+    std::vector<Number> amax(nsigma);
+    std::vector<Number> cmin(nsigma);
+    IpData().TimingStats().Task3().Start();
+    GridComplementarity(4, bounds, nsigma, sigmas, &alpha_primal[0],
+                        &alpha_dual[0], &asum[0], &sumsq[0], &amax[0],
+                        &cmin[0]);
+    IpData().TimingStats().Task3().End();
+
+    for (Index k=0; k<nsigma; k++) {
+      Number compl_inf=-1.;
+      switch (quality_function_norm_) {
+      case NM_NORM_1:
+        DBG_ASSERT(n_comp_>0);
+        compl_inf = asum[k]/n_comp_;
+        break;
+      case NM_NORM_2_SQUARED:
+        DBG_ASSERT(n_comp_>0);
+        compl_inf = sumsq[k]/n_comp_;
+        break;
+      case NM_NORM_MAX:
+        compl_inf = amax[k];
+        break;
+      case NM_NORM_2:
+        DBG_ASSERT(n_comp_>0);
+        compl_inf = sqrt(sumsq[k])/sqrt((Number)n_comp_);
+        break;
+      default:
+        DBG_ASSERT(false && "Unknown value for quality_function_norm_");
+      }
+
+      // centrality measure as in IpoptCalculatedQuantities::CalcCentralityMeasure
+      Number xi = 0.;
+      if (quality_function_centrality_!=CEN_NONE && n_comp_>0) {
+        xi = Min(1., cmin[k]/(asum[k]/n_comp_));
+      }
+
+      qfs[k] = QualityFunctionValue(sigmas[k], alpha_primal[k], alpha_dual[k],
+                                    compl_inf, xi);
+    }
+  }
+
+  Number
+  QualityFunctionMuOracle::PerformGridSearch
+  (Number sigma_up,
+   Number sigma_lo,
+   Number sigma_tol,
+   const Vector& step_aff_x_L,
+   const Vector& step_aff_x_U,
+   const Vector& step_aff_s_L,
+   const Vector& step_aff_s_U,
+   const Vector& step_aff_y_c,
+   const Vector& step_aff_y_d,
+   const Vector& step_aff_z_L,
+   const Vector& step_aff_z_U,
+   const Vector& step_aff_v_L,
+   const Vector& step_aff_v_U,
+   const Vector& step_cen_x_L,
+   const Vector& step_cen_x_U,
+   const Vector& step_cen_s_L,
+   const Vector& step_cen_s_U,
+   const Vector& step_cen_y_c,
+   const Vector& step_cen_y_d,
+   const Vector& step_cen_z_L,
+   const Vector& step_cen_z_U,
+   const Vector& step_cen_v_L,
+   const Vector& step_cen_v_U
+  )
+  {
+    DBG_START_METH("QualityFunctionMuOracle::PerformGridSearch",
+                   dbg_verbosity);
+    DBG_ASSERT(quality_function_grid_points_>0);
+
+    const Index npoints = quality_function_grid_points_;
+    std::vector<Number> sigmas(npoints+2);
+    std::vector<Number> qfs(npoints+2);
+
+    // In the first step, the end points of the interval are evaluated
+    // together with the interior grid points
+    Number h = (sigma_up-sigma_lo)/(npoints+1);
+    for (Index i=0; i<npoints+2; i++) {
+      sigmas[i] = sigma_lo + i*h;
+    }
+    sigmas[npoints+1] = sigma_up;
+    CalculateQualityFunctions(npoints+2, &sigmas[0], &qfs[0],
+                              step_aff_x_L,
+                              step_aff_x_U,
+                              step_aff_s_L,
+                              step_aff_s_U,
+                              step_aff_y_c,
+                              step_aff_y_d,
+                              step_aff_z_L,
+                              step_aff_z_U,
+                              step_aff_v_L,
+                              step_aff_v_U,
+                              step_cen_x_L,
+                              step_cen_x_U,
+                              step_cen_s_L,
+                              step_cen_s_U,
+                              step_cen_y_c,
+                              step_cen_y_d,
+                              step_cen_z_L,
+                              step_cen_z_U,
+                              step_cen_v_L,
+                              step_cen_v_U);
+    Number sigma = sigmas[0];
+    Number q = qfs[0];
+    for (Index i=1; i<npoints+2; i++) {
+      if (qfs[i] < q) {
+        sigma = sigmas[i];
+        q = qfs[i];
+      }
+    }
+
+    // Then the grid is refined around the best point
+    Index nsteps = 0;
+    while (nsteps<quality_function_max_section_steps_) {
+      sigma_lo = Max(sigma_lo, sigma-h);
+      sigma_up = Min(sigma_up, sigma+h);
+      if ((sigma_up-sigma_lo)<sigma_tol*sigma_up) {
+        break;
+      }
+      nsteps++;
+      h = (sigma_up-sigma_lo)/(npoints+1);
+      for (Index i=0; i<npoints; i++) {
+        sigmas[i] = sigma_lo + (i+1)*h;
+      }
+      CalculateQualityFunctions(npoints, &sigmas[0], &qfs[0],
+                                step_aff_x_L,
+                                step_aff_x_U,
+                                step_aff_s_L,
+                                step_aff_s_U,
+                                step_aff_y_c,
+                                step_aff_y_d,
+                                step_aff_z_L,
+                                step_aff_z_U,
+                                step_aff_v_L,
+                                step_aff_v_U,
+                                step_cen_x_L,
+                                step_cen_x_U,
+                                step_cen_s_L,
+                                step_cen_s_U,
+                                step_cen_y_c,
+                                step_cen_y_d,
+                                step_cen_z_L,
+                                step_cen_z_U,
+                                step_cen_v_L,
+                                step_cen_v_U);
+      for (Index i=0; i<npoints; i++) {
+        if (qfs[i] < q) {
+          sigma = sigmas[i];
+          q = qfs[i];
+        }
+      }
+    }
+
+    return sigma;
+  }
+
   Number
   QualityFunctionMuOracle::PerformGoldenSection
   (Number sigma_up_in,
@@ -121,6 +121,45 @@ namespace Ipopt
                                     const Vector& step_cen_v_L,
                                     const Vector& step_cen_v_U);
 
+    /** Auxilliary function for computing the quality function for
+     *  the nsigma values of sigma in sigmas at once.  The values are
+     *  returned in qfs.  If all vectors are DenseVectors, the step
+     *  sizes and complementarities for all values of sigma are
+     *  computed together in two passes over the vectors. */
+    void CalculateQualityFunctions(Index nsigma,
+                                   const Number* sigmas,
+                                   Number* qfs,
+                                   const Vector& step_aff_x_L,
+                                   const Vector& step_aff_x_U,
+                                   const Vector& step_aff_s_L,
+                                   const Vector& step_aff_s_U,
+                                   const Vector& step_aff_y_c,
+                                   const Vector& step_aff_y_d,
+                                   const Vector& step_aff_z_L,
+                                   const Vector& step_aff_z_U,
+                                   const Vector& step_aff_v_L,
+                                   const Vector& step_aff_v_U,
+                                   const Vector& step_cen_x_L,
+                                   const Vector& step_cen_x_U,
+                                   const Vector& step_cen_s_L,
+                                   const Vector& step_cen_s_U,
+                                   const Vector& step_cen_y_c,
+                                   const Vector& step_cen_y_d,
+                                   const Vector& step_cen_z_L,
+                                   const Vector& step_cen_z_U,
+                                   const Vector& step_cen_v_L,
+                                   const Vector& step_cen_v_U);
+
+    /** Auxilliary function computing the quality function from the
+     *  step sizes, the complementarity measure compl_inf (in the norm
+     *  given by quality_function_norm_) and the centrality measure xi
+     *  for the trial point. */
+    Number QualityFunctionValue(Number sigma,
+                                Number alpha_primal,
+                                Number alpha_dual,
+                                Number compl_inf,
+                                Number xi);
+
     /** Auxilliary function performing the golden section */
     Number PerformGoldenSection(Number sigma_up,
                                 Number q_up,
@@ -149,6 +188,33 @@ namespace Ipopt
                                 const Vector& step_cen_v_L,
                                 const Vector& step_cen_v_U);
 
+    /** Auxilliary function performing the search for sigma on grids
+     *  of quality_function_grid_points_ values, which are refined
+     *  around the best value found so far. */
+    Number PerformGridSearch(Number sigma_up,
+                             Number sigma_lo,
+                             Number sigma_tol,
+                             const Vector& step_aff_x_L,
+                             const Vector& step_aff_x_U,
+                             const Vector& step_aff_s_L,
+                             const Vector& step_aff_s_U,
+                             const Vector& step_aff_y_c,
+                             const Vector& step_aff_y_d,
+                             const Vector& step_aff_z_L,
+                             const Vector& step_aff_z_U,
+                             const Vector& step_aff_v_L,
+                             const Vector& step_aff_v_U,
+                             const Vector& step_cen_x_L,
+                             const Vector& step_cen_x_U,
+                             const Vector& step_cen_s_L,
+                             const Vector& step_cen_s_U,
+                             const Vector& step_cen_y_c,
+                             const Vector& step_cen_y_d,
+                             const Vector& step_cen_z_L,
+                             const Vector& step_cen_z_U,
+                             const Vector& step_cen_v_L,
+                             const Vector& step_cen_v_U);
+
     /** Auxilliary functions for scaling the sigma axis in the golden
      *  section procedure */
     //@{
@@ -208,6 +274,10 @@ namespace Ipopt
     /** Maximal number of bi-section steps in the golden section
      *  search for sigma. */
     Index quality_function_max_section_steps_;
+    /** Number of values of sigma that are evaluated together in each
+     *  step of the search for sigma.  If 0, the golden section search
+     *  is used. */
+    Index quality_function_grid_points_;
     //@}
 
     /** @name Temporary work space vectors.  We use those to avoid
@@ -20,6 +20,7 @@
 #include "IpMa86SolverInterface.hpp"
 #include "IpMa97SolverInterface.hpp"
 #include "IpMa28TDependencyDetector.hpp"
+#include "IpNativeSolverInterface.hpp"
 #include "IpPardisoSolverInterface.hpp"
 #ifdef COIN_HAS_MUMPS
 # include "IpMumpsSolverInterface.hpp"
@@ -57,6 +58,9 @@ namespace Ipopt
     Ma97SolverInterface::RegisterOptions(roptions);
 #endif
 
+    roptions->SetRegisteringCategory("Native Linear Solver");
+    NativeSolverInterface::RegisterOptions(roptions);
+
 #ifdef COIN_HAS_MUMPS
     roptions->SetRegisteringCategory("Mumps Linear Solver");
     MumpsSolverInterface::RegisterOptions(roptions);
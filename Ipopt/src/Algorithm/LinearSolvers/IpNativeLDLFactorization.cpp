@@ -0,0 +1,712 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpNativeLDLFactorization.hpp"
+#include "IpBlas.hpp"
+
+#include <algorithm>
+
+#ifdef HAVE_CMATH
+# include <cmath>
+#else
+# ifdef HAVE_MATH_H
+#  include <math.h>
+# else
+#  error "don't have header file for math"
+# endif
+#endif
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  /** Number of fully summed columns that are factorized before the
+   *  update of the remaining columns is done by a matrix-matrix
+   *  product. */
+  static const Index native_panel_width = 32;
+
+  /** Width of the column blocks for the update of the contribution
+   *  block. */
+  static const Index native_update_width = 64;
+
+
+  /** Add v to entry (i,j) of the front F with nrow rows and nfs fully
+   *  summed columns.  The fully summed columns are stored completely,
+   *  the remaining part only as lower triangle. */
+  static inline void NativeAddToFront(Number* F, Index nrow, Index nfs,
+                                      Index i, Index j, Number v)
+  {
+    if (i < j) {
+      const Index tmp = i;
+      i = j;
+      j = tmp;
+    }
+    F[i + j*nrow] += v;
+    if (i < nfs && i != j) {
+      F[j + i*nrow] += v;
+    }
+  }
+
+  /** Swap the rows and columns a and b of the front F. */
+  static void NativeSymmetricSwap(Number* F, Index nrow, Index nfs,
+                                  Index a, Index b,
+                                  std::vector<Index>& rows)
+  {
+    if (a == b) {
+      return;
+    }
+    for (Index j=0; j<nfs; j++) {
+      std::swap(F[a + j*nrow], F[b + j*nrow]);
+    }
+    Number* Fa = F + a*nrow;
+    Number* Fb = F + b*nrow;
+    for (Index i=0; i<nrow; i++) {
+      std::swap(Fa[i], Fb[i]);
+    }
+    std::swap(rows[a], rows[b]);
+  }
+
+  /** Compute W = L(row0:row0+nr, p0:p1) * D(p0:p1, p0:p1), where L is
+   *  stored in the columns of the front F.  W has leading dimension
+   *  nr. */
+  static void NativeComputeLD(const Number* F, Index nrow, Index row0,
+                              Index nr, Index p0, Index p1,
+                              const std::vector<Number>& diag,
+                              const std::vector<Number>& offdiag,
+                              const std::vector<char>& pivsize,
+                              Number* W)
+  {
+    for (Index p=p0; p<p1; p++) {
+      const Number* Lp = F + row0 + p*nrow;
+      Number* Wp = W + (p-p0)*nr;
+      if (pivsize[p] == 1) {
+        const Number d = diag[p];
+        for (Index i=0; i<nr; i++) {
+          Wp[i] = Lp[i]*d;
+        }
+      }
+      else {
+        DBG_ASSERT(pivsize[p] == 2 && p+1 < p1);
+        const Number* Lq = Lp + nrow;
+        Number* Wq = Wp + nr;
+        const Number a = diag[p];
+        const Number b = offdiag[p];
+        const Number d = diag[p+1];
+        for (Index i=0; i<nr; i++) {
+          Wp[i] = Lp[i]*a + Lq[i]*b;
+          Wq[i] = Lp[i]*b + Lq[i]*d;
+        }
+        p++;
+      }
+    }
+  }
+
+  NativeLDLFactorization::NativeLDLFactorization(
+    const SmartPtr<const NativeSymbolicFactorization>& symbolic)
+      :
+      symbolic_(symbolic),
+      negevals_(0),
+      ndelayed_(0),
+      max_front_(0)
+  {
+    DBG_START_METH("NativeLDLFactorization::NativeLDLFactorization()",
+                   dbg_verbosity);
+    DBG_ASSERT(IsValid(symbolic_));
+  }
+
+  NativeLDLFactorization::~NativeLDLFactorization()
+  {
+    DBG_START_METH("NativeLDLFactorization::~NativeLDLFactorization()",
+                   dbg_verbosity);
+  }
+
+  Index
+  NativeLDLFactorization::FactorFullySummed(Index k, Index nrow, Index nfs,
+      Number* F, Number pivtol,
+      Number small_pivot,
+      FrontFactor& ff,
+      std::vector<Number>& ld) const
+  {
+    const Index m = nrow;
+    Index blk_start = k;
+    Index blk_end = Min(nfs, k + native_panel_width);
+    while (k < nfs) {
+      // Look for an acceptable pivot among the current columns
+      Index piv_col = -1;
+      Index piv_row = -1;
+      Index piv_size = 0;
+      for (Index c=k; c<blk_end; c++) {
+        const Number* Fc = F + c*m;
+        const Number acc = fabs(Fc[c]);
+        Number colmax = 0.;
+        Number rmax = 0.;
+        Index r = -1;
+        for (Index i=k; i<m; i++) {
+          if (i == c) {
+            continue;
+          }
+          const Number v = fabs(Fc[i]);
+          if (v > colmax) {
+            colmax = v;
+          }
+          if (i < blk_end && v > rmax) {
+            rmax = v;
+            r = i;
+          }
+        }
+        if (acc > small_pivot && acc >= pivtol*colmax) {
+          piv_col = c;
+          piv_size = 1;
+          break;
+        }
+        if (r == -1 || rmax <= small_pivot) {
+          continue;
+        }
+        // Try the 2x2 pivot (c,r) with the largest entry in the
+        // current columns
+        const Number* Fr = F + r*m;
+        const Number a = Fc[c];
+        const Number b = Fc[r];
+        const Number d = Fr[r];
+        const Number adet = fabs(a*d - b*b);
+        Number cmax = 0.;
+        Number rrmax = 0.;
+        for (Index i=k; i<m; i++) {
+          if (i != c && i != r) {
+            cmax = Max(cmax, fabs(Fc[i]));
+            rrmax = Max(rrmax, fabs(Fr[i]));
+          }
+        }
+        if (adet > small_pivot*Max(fabs(a), Max(fabs(b), fabs(d))) &&
+            pivtol*(fabs(d)*cmax + fabs(b)*rrmax) <= adet &&
+            pivtol*(fabs(b)*cmax + fabs(a)*rrmax) <= adet) {
+          piv_col = c;
+          piv_row = r;
+          piv_size = 2;
+          break;
+        }
+      }
+
+      if (piv_size == 1) {
+        NativeSymmetricSwap(F, m, nfs, k, piv_col, ff.rows);
+        Number* Fk = F + k*m;
+        const Number d = Fk[k];
+        ff.diag[k] = d;
+        ff.offdiag[k] = 0.;
+        ff.pivsize[k] = 1;
+        if (d < 0.) {
+          ff.negevals++;
+        }
+        const Index len = m-k-1;
+        for (Index j=k+1; j<blk_end; j++) {
+          const Number coef = Fk[j]/d;
+          if (coef != 0.) {
+            IpBlasDaxpy(len, -coef, Fk+k+1, 1, F+j*m+k+1, 1);
+          }
+        }
+        if (len > 0) {
+          IpBlasDscal(len, 1./d, Fk+k+1, 1);
+        }
+        k++;
+        if (k < blk_end) {
+          continue;
+        }
+      }
+      else if (piv_size == 2) {
+        NativeSymmetricSwap(F, m, nfs, k, piv_col, ff.rows);
+        if (piv_row == k) {
+          piv_row = piv_col;
+        }
+        NativeSymmetricSwap(F, m, nfs, k+1, piv_row, ff.rows);
+        Number* Fk = F + k*m;
+        Number* Fk1 = Fk + m;
+        const Number a = Fk[k];
+        const Number b = Fk[k+1];
+        const Number d = Fk1[k+1];
+        const Number det = a*d - b*b;
+        ff.diag[k] = a;
+        ff.diag[k+1] = d;
+        ff.offdiag[k] = b;
+        ff.offdiag[k+1] = 0.;
+        ff.pivsize[k] = 2;
+        ff.pivsize[k+1] = 0;
+        if (det < 0.) {
+          ff.negevals++;
+        }
+        else if (a < 0.) {
+          ff.negevals += 2;
+        }
+        // Columns of L for the 2x2 block
+        const Index len = m-k-2;
+        ld.resize(2*(len+1));
+        Number* L1 = &ld[0];
+        Number* L2 = L1 + len;
+        for (Index i=0; i<len; i++) {
+          const Number f1 = Fk[k+2+i];
+          const Number f2 = Fk1[k+2+i];
+          L1[i] = (f1*d - f2*b)/det;
+          L2[i] = (f2*a - f1*b)/det;
+        }
+        for (Index j=k+2; j<blk_end; j++) {
+          const Number w1 = Fk[j];
+          const Number w2 = Fk1[j];
+          Number* Fj = F + j*m + k+2;
+          if (w1 != 0.) {
+            IpBlasDaxpy(len, -w1, L1, 1, Fj, 1);
+          }
+          if (w2 != 0.) {
+            IpBlasDaxpy(len, -w2, L2, 1, Fj, 1);
+          }
+        }
+        for (Index i=0; i<len; i++) {
+          Fk[k+2+i] = L1[i];
+          Fk1[k+2+i] = L2[i];
+        }
+        k += 2;
+        if (k < blk_end) {
+          continue;
+        }
+      }
+
+      // All columns in the current block have been eliminated, or
+      // none of the remaining ones is acceptable.  Apply the pending
+      // update of the eliminated columns to the remaining columns.
+      const Index nupd = nfs - blk_end;
+      const Index npiv = k - blk_start;
+      if (nupd > 0 && npiv > 0) {
+        ld.resize(nupd*npiv);
+        NativeComputeLD(F, m, blk_end, nupd, blk_start, k, ff.diag,
+                        ff.offdiag, ff.pivsize, &ld[0]);
+        IpBlasDgemm(false, true, m-k, nupd, npiv, -1., F + k + blk_start*m,
+                    m, &ld[0], nupd, 1., F + k + blk_end*m, m);
+      }
+      blk_start = k;
+      if (blk_end == nfs) {
+        break;
+      }
+      blk_end = Min(nfs, blk_end + native_panel_width);
+    }
+    return k;
+  }
+
+  void NativeLDLFactorization::FactorSupernode(Index s,
+      const Number* values,
+      Number pivtol,
+      Number small_pivot,
+      FrontWorkspace& ws)
+  {
+    const NativeSymbolicFactorization& S = *symbolic_;
+    FrontFactor& ff = factors_[s];
+    const Index ncol = S.sup_start_[s+1]-S.sup_start_[s];
+    const Index nsym = S.sup_row_ptr_[s+1]-S.sup_row_ptr_[s];
+    const Index* srows = &S.sup_rows_[S.sup_row_ptr_[s]];
+
+    // Pivots delayed by the children
+    Index ndel = 0;
+    for (Index q=S.sup_child_ptr_[s]; q<S.sup_child_ptr_[s+1]; q++) {
+      const FrontFactor& fc = factors_[S.sup_child_[q]];
+      ndel += fc.nfs - fc.nelim;
+    }
+    const Index m = nsym + ndel;
+    const Index nfs = ncol + ndel;
+    ff.nrow = m;
+    ff.nfs = nfs;
+    ff.negevals = 0;
+    ff.nzero = 0;
+
+    // Rows of the front: own columns, delayed pivots, the rest
+    ff.rows.resize(m);
+    for (Index i=0; i<ncol; i++) {
+      ff.rows[i] = srows[i];
+    }
+    Index pos = ncol;
+    for (Index q=S.sup_child_ptr_[s]; q<S.sup_child_ptr_[s+1]; q++) {
+      const FrontFactor& fc = factors_[S.sup_child_[q]];
+      for (Index i=fc.nelim; i<fc.nfs; i++) {
+        ff.rows[pos++] = fc.rows[i];
+      }
+    }
+    for (Index i=ncol; i<nsym; i++) {
+      ff.rows[ndel+i] = srows[i];
+    }
+    Index* map = &ws.map[0];
+    for (Index i=0; i<m; i++) {
+      map[ff.rows[i]] = i;
+    }
+
+    // Assemble the original entries and the contribution blocks
+    ws.front.assign((size_t)m*(size_t)m, 0.);
+    Number* F = &ws.front[0];
+    for (Index q=S.amap_ptr_[s]; q<S.amap_ptr_[s+1]; q++) {
+      Index r = S.amap_row_[q];
+      if (r >= ncol) {
+        r += ndel;
+      }
+      NativeAddToFront(F, m, nfs, r, S.amap_col_[q], values[S.amap_pos_[q]]);
+    }
+    for (Index q=S.sup_child_ptr_[s]; q<S.sup_child_ptr_[s+1]; q++) {
+      FrontFactor& fc = factors_[S.sup_child_[q]];
+      const Index nc = fc.nrow - fc.nelim;
+      const Index* crows = nc > 0 ? &fc.rows[fc.nelim] : NULL;
+      for (Index jj=0; jj<nc; jj++) {
+        const Index lj = map[crows[jj]];
+        const Number* cb = &fc.contrib[jj*nc];
+        for (Index ii=jj; ii<nc; ii++) {
+          if (cb[ii] != 0.) {
+            NativeAddToFront(F, m, nfs, map[crows[ii]], lj, cb[ii]);
+          }
+        }
+      }
+      std::vector<Number>().swap(fc.contrib);
+    }
+
+    // Partial factorization of the fully summed part
+    ff.diag.resize(nfs);
+    ff.offdiag.resize(nfs);
+    ff.pivsize.resize(nfs);
+    Index nelim = FactorFullySummed(0, m, nfs, F, pivtol, small_pivot, ff,
+                                    ws.ld);
+    if (nelim < nfs && S.sup_parent_[s] == -1) {
+      // At a root, pivots cannot be delayed any further
+      nelim = FactorFullySummed(nelim, m, nfs, F, 0., small_pivot, ff,
+                                ws.ld);
+      ff.nzero = nfs - nelim;
+    }
+    ff.nelim = nelim;
+
+    // Update of the part that is not fully summed
+    const Index m2 = m - nfs;
+    if (m2 > 0 && nelim > 0) {
+      ws.ld.resize((size_t)m2*(size_t)nelim);
+      NativeComputeLD(F, m, nfs, m2, 0, nelim, ff.diag, ff.offdiag,
+                      ff.pivsize, &ws.ld[0]);
+      for (Index jb=nfs; jb<m; jb+=native_update_width) {
+        const Index w = Min(native_update_width, m-jb);
+        IpBlasDgemm(false, true, m-jb, w, nelim, -1., F + jb, m,
+                    &ws.ld[jb-nfs], m2, 1., F + jb + jb*m, m);
+      }
+    }
+
+    // Contribution block for the parent
+    const Index nc = m - nelim;
+    if (nc > 0 && S.sup_parent_[s] != -1) {
+      ff.contrib.resize((size_t)nc*(size_t)nc);
+      for (Index jj=0; jj<nc; jj++) {
+        const Number* Fj = F + nelim + (nelim+jj)*m;
+        Number* cb = &ff.contrib[jj*nc];
+        for (Index ii=jj; ii<nc; ii++) {
+          cb[ii] = Fj[ii];
+        }
+      }
+    }
+
+    // Columns of L
+    ff.lfact.resize((size_t)m*(size_t)nelim);
+    for (Index jj=0; jj<nelim; jj++) {
+      const Number* Fj = F + jj*m;
+      Number* Lj = &ff.lfact[jj*m];
+      for (Index ii=0; ii<=jj; ii++) {
+        Lj[ii] = 0.;
+      }
+      for (Index ii=jj+1; ii<m; ii++) {
+        Lj[ii] = Fj[ii];
+      }
+      if (ff.pivsize[jj] == 2) {
+        Lj[jj+1] = 0.;
+      }
+    }
+  }
+
+  ESymSolverStatus
+  NativeLDLFactorization::NumericFactorization(const Number* values,
+      Number pivtol,
+      Number small_pivot,
+      Index nthreads)
+  {
+    DBG_START_METH("NativeLDLFactorization::NumericFactorization",
+                   dbg_verbosity);
+    const NativeSymbolicFactorization& S = *symbolic_;
+
+    negevals_ = 0;
+    ndelayed_ = 0;
+    max_front_ = 0;
+    if (S.nsuper_ == 0) {
+      return SYMSOLVER_SUCCESS;
+    }
+    factors_.resize(S.nsuper_);
+
+#ifdef _OPENMP
+    Index nthreads_used = (nthreads > 0) ? nthreads : omp_get_max_threads();
+#else
+    Index nthreads_used = 1;
+#endif
+
+    if (nthreads_used <= 1 || S.nsuper_ < 2) {
+      FrontWorkspace ws;
+      ws.map.resize(S.dim_);
+      for (Index s=0; s<S.nsuper_; s++) {
+        FactorSupernode(s, values, pivtol, small_pivot, ws);
+      }
+    }
+    else {
+      // Split the assembly tree into subtrees that are small enough
+      // to be processed by one thread, and the nodes above them,
+      // which are processed level by level.
+      std::vector<double> subtree_work(S.sup_work_);
+      std::vector<Index> first_desc(S.nsuper_);
+      for (Index s=0; s<S.nsuper_; s++) {
+        first_desc[s] = s;
+      }
+      double total_work = 0.;
+      for (Index s=0; s<S.nsuper_; s++) {
+        const Index p = S.sup_parent_[s];
+        if (p != -1) {
+          subtree_work[p] += subtree_work[s];
+          first_desc[p] = Min(first_desc[p], first_desc[s]);
+        }
+        else {
+          total_work += subtree_work[s];
+        }
+      }
+      const double threshold = total_work/(4.*nthreads_used);
+
+      std::vector<std::pair<double, Index> > leaf_roots;
+      std::vector<Index> level(S.nsuper_, -1);
+      Index nlevels = 0;
+      for (Index s=0; s<S.nsuper_; s++) {
+        const Index p = S.sup_parent_[s];
+        if (subtree_work[s] <= threshold) {
+          if (p == -1 || subtree_work[p] > threshold) {
+            leaf_roots.push_back(std::make_pair(-subtree_work[s], s));
+          }
+        }
+        else {
+          level[s] = Max(level[s], (Index)0);
+          if (p != -1) {
+            level[p] = Max(level[p], level[s]+1);
+          }
+          nlevels = Max(nlevels, level[s]+1);
+        }
+      }
+      // Largest subtrees first for a better load balance
+      std::sort(leaf_roots.begin(), leaf_roots.end());
+      std::vector<Index> level_ptr(nlevels+1, 0);
+      for (Index s=0; s<S.nsuper_; s++) {
+        if (level[s] >= 0) {
+          level_ptr[level[s]+1]++;
+        }
+      }
+      for (Index l=0; l<nlevels; l++) {
+        level_ptr[l+1] += level_ptr[l];
+      }
+      std::vector<Index> level_nodes(level_ptr[nlevels]);
+      {
+        std::vector<Index> pos(level_ptr.begin(), level_ptr.end()-1);
+        for (Index s=0; s<S.nsuper_; s++) {
+          if (level[s] >= 0) {
+            level_nodes[pos[level[s]]++] = s;
+          }
+        }
+      }
+      const Index nleaf = (Index)leaf_roots.size();
+
+#ifdef _OPENMP
+      #pragma omp parallel num_threads(nthreads_used)
+#endif
+      {
+        FrontWorkspace ws;
+        ws.map.resize(S.dim_);
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic,1)
+#endif
+        for (Index t=0; t<nleaf; t++) {
+          const Index root = leaf_roots[t].second;
+          for (Index s=first_desc[root]; s<=root; s++) {
+            FactorSupernode(s, values, pivtol, small_pivot, ws);
+          }
+        }
+        for (Index l=0; l<nlevels; l++) {
+#ifdef _OPENMP
+          #pragma omp for schedule(dynamic,1)
+#endif
+          for (Index q=level_ptr[l]; q<level_ptr[l+1]; q++) {
+            FactorSupernode(level_nodes[q], values, pivtol, small_pivot, ws);
+          }
+        }
+      }
+    }
+
+    Index nzero = 0;
+    for (Index s=0; s<S.nsuper_; s++) {
+      const FrontFactor& ff = factors_[s];
+      negevals_ += ff.negevals;
+      nzero += ff.nzero;
+      if (S.sup_parent_[s] != -1) {
+        ndelayed_ += ff.nfs - ff.nelim;
+      }
+      max_front_ = Max(max_front_, ff.nrow);
+    }
+    if (nzero > 0) {
+      return SYMSOLVER_SINGULAR;
+    }
+    return SYMSOLVER_SUCCESS;
+  }
+
+  void NativeLDLFactorization::Solve(Index nrhs, Number* rhs_vals) const
+  {
+    DBG_START_METH("NativeLDLFactorization::Solve", dbg_verbosity);
+    const NativeSymbolicFactorization& S = *symbolic_;
+
+    const Index n = S.dim_;
+    if (n == 0 || nrhs == 0) {
+      return;
+    }
+
+    std::vector<Number> x((size_t)n*(size_t)nrhs);
+    for (Index r=0; r<nrhs; r++) {
+      const Number* b = rhs_vals + r*n;
+      Number* xr = &x[r*n];
+      for (Index i=0; i<n; i++) {
+        xr[i] = b[S.perm_[i]];
+      }
+    }
+    std::vector<Number> w((size_t)Max(max_front_, (Index)1)*(size_t)nrhs);
+    Number* W = &w[0];
+
+    // Forward substitution with L
+    for (Index s=0; s<S.nsuper_; s++) {
+      const FrontFactor& ff = factors_[s];
+      const Index m = ff.nrow;
+      const Index ne = ff.nelim;
+      if (ne == 0) {
+        continue;
+      }
+      const Index* rows = &ff.rows[0];
+      const Number* L = &ff.lfact[0];
+      for (Index r=0; r<nrhs; r++) {
+        const Number* xr = &x[r*n];
+        Number* Wr = W + r*m;
+        for (Index i=0; i<m; i++) {
+          Wr[i] = xr[rows[i]];
+        }
+        for (Index jj=0; jj<ne; jj++) {
+          const Number wj = Wr[jj];
+          if (wj != 0.) {
+            const Number* Lj = L + jj*m;
+            for (Index ii=jj+1; ii<ne; ii++) {
+              Wr[ii] -= Lj[ii]*wj;
+            }
+          }
+        }
+      }
+      if (m > ne) {
+        if (nrhs == 1) {
+          // IpBlasDgemv expects the number of columns before the
+          // number of rows of the (m-ne) x ne matrix
+          IpBlasDgemv(false, ne, m-ne, -1., L + ne, m, W, 1, 1., W + ne, 1);
+        }
+        else {
+          IpBlasDgemm(false, false, m-ne, nrhs, ne, -1., L + ne, m, W, m, 1.,
+                      W + ne, m);
+        }
+      }
+      for (Index r=0; r<nrhs; r++) {
+        Number* xr = &x[r*n];
+        const Number* Wr = W + r*m;
+        for (Index i=0; i<m; i++) {
+          xr[rows[i]] = Wr[i];
+        }
+      }
+    }
+
+    // Solve with the block diagonal D
+    for (Index s=0; s<S.nsuper_; s++) {
+      const FrontFactor& ff = factors_[s];
+      for (Index jj=0; jj<ff.nelim; jj++) {
+        const Index i1 = ff.rows[jj];
+        if (ff.pivsize[jj] == 1) {
+          const Number d = ff.diag[jj];
+          for (Index r=0; r<nrhs; r++) {
+            x[i1 + r*n] /= d;
+          }
+        }
+        else if (ff.pivsize[jj] == 2) {
+          const Index i2 = ff.rows[jj+1];
+          const Number a = ff.diag[jj];
+          const Number b = ff.offdiag[jj];
+          const Number d = ff.diag[jj+1];
+          const Number det = a*d - b*b;
+          for (Index r=0; r<nrhs; r++) {
+            const Number x1 = x[i1 + r*n];
+            const Number x2 = x[i2 + r*n];
+            x[i1 + r*n] = (d*x1 - b*x2)/det;
+            x[i2 + r*n] = (a*x2 - b*x1)/det;
+          }
+        }
+      }
+    }
+
+    // Backward substitution with L^T
+    for (Index s=S.nsuper_-1; s>=0; s--) {
+      const FrontFactor& ff = factors_[s];
+      const Index m = ff.nrow;
+      const Index ne = ff.nelim;
+      if (ne == 0) {
+        continue;
+      }
+      const Index* rows = &ff.rows[0];
+      const Number* L = &ff.lfact[0];
+      for (Index r=0; r<nrhs; r++) {
+        const Number* xr = &x[r*n];
+        Number* Wr = W + r*m;
+        for (Index i=0; i<m; i++) {
+          Wr[i] = xr[rows[i]];
+        }
+      }
+      if (m > ne) {
+        if (nrhs == 1) {
+          IpBlasDgemv(true, ne, m-ne, -1., L + ne, m, W + ne, 1, 1., W, 1);
+        }
+        else {
+          IpBlasDgemm(true, false, ne, nrhs, m-ne, -1., L + ne, m, W + ne, m,
+                      1., W, m);
+        }
+      }
+      for (Index r=0; r<nrhs; r++) {
+        Number* xr = &x[r*n];
+        Number* Wr = W + r*m;
+        for (Index jj=ne-1; jj>=0; jj--) {
+          const Number* Lj = L + jj*m;
+          Number sum = 0.;
+          for (Index ii=jj+1; ii<ne; ii++) {
+            sum += Lj[ii]*Wr[ii];
+          }
+          Wr[jj] -= sum;
+        }
+        for (Index i=0; i<ne; i++) {
+          xr[rows[i]] = Wr[i];
+        }
+      }
+    }
+
+    for (Index r=0; r<nrhs; r++) {
+      Number* b = rhs_vals + r*n;
+      const Number* xr = &x[r*n];
+      for (Index i=0; i<n; i++) {
+        b[S.perm_[i]] = xr[i];
+      }
+    }
+  }
+
+} // namespace Ipopt
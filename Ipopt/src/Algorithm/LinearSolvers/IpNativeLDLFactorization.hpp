@@ -0,0 +1,192 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPNATIVELDLFACTORIZATION_HPP__
+#define __IPNATIVELDLFACTORIZATION_HPP__
+
+#include "IpUtils.hpp"
+#include "IpReferenced.hpp"
+#include "IpSmartPtr.hpp"
+#include "IpSymLinearSolver.hpp"
+#include "IpNativeSymbolicFactorization.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+  /** Self-contained sparse symmetric indefinite LDL^T factorization.
+   *
+   *  This is a multifrontal (supernodal) implementation of the
+   *  factorization P A P^T = L D L^T, where D is block diagonal with
+   *  1x1 and 2x2 blocks.  Pivots are chosen by threshold
+   *  Bunch-Kaufman pivoting within the fully summed part of each
+   *  frontal matrix; pivots that cannot be chosen stably are delayed
+   *  to the parent front.  Because D is available explicitly, the
+   *  inertia of the matrix is known after the factorization.
+   *
+   *  The matrix is given in the CSR_Format_0_Offset format of
+   *  SparseSymLinearSolverInterface, i.e., row i lists the column
+   *  indices j>=i of the upper triangular part (0-based).
+   *
+   *  The symbolic phase (a fill-reducing ordering, the elimination
+   *  tree, and relaxed supernodes) is given by a
+   *  NativeSymbolicFactorization object, which is not modified and
+   *  can be shared.  The numerical factorization traverses the assembly
+   *  tree of the supernodes; independent subtrees are factorized
+   *  concurrently if Ipopt has been compiled with OpenMP support.
+   *  Frontal matrices are processed by blocks so that most of the
+   *  work is done in level 3 BLAS calls.
+   */
+  class NativeLDLFactorization: public ReferencedObject
+  {
+  public:
+    /** @name Constructor/Destructor */
+    //@{
+    /** Constructor for the factorization of matrices with the
+     *  structure analyzed in symbolic. */
+    NativeLDLFactorization(const SmartPtr<const NativeSymbolicFactorization>& symbolic);
+
+    virtual ~NativeLDLFactorization();
+    //@}
+
+    /** Numerical factorization for the nonzero values (in the order
+     *  of the ja array given to the symbolic analysis).  pivtol is the
+     *  threshold for the pivot choice (between 0 and 0.5), and pivots
+     *  with absolute value not larger than small_pivot are treated as
+     *  zero.  nthreads is the number of threads used for the
+     *  traversal of the assembly tree (0 for the default number).
+     *  Returns SYMSOLVER_SINGULAR if a zero pivot was encountered. */
+    ESymSolverStatus NumericFactorization(const Number* values,
+                                          Number pivtol,
+                                          Number small_pivot,
+                                          Index nthreads);
+
+    /** Solve with the most recent factorization for nrhs right hand
+     *  sides, stored one after the other in rhs_vals.  The solutions
+     *  overwrite the right hand sides. */
+    void Solve(Index nrhs, Number* rhs_vals) const;
+
+    /** @name Information about the factorization */
+    //@{
+    /** Symbolic analysis used by this factorization. */
+    SmartPtr<const NativeSymbolicFactorization> Symbolic() const
+    {
+      return symbolic_;
+    }
+    /** Dimension of the matrix. */
+    Index Dim() const
+    {
+      return symbolic_->Dim();
+    }
+    /** Number of negative eigenvalues of the most recently factorized
+     *  matrix. */
+    Index NumberOfNegEVals() const
+    {
+      return negevals_;
+    }
+    /** Number of pivots that had to be delayed in the most recent
+     *  factorization. */
+    Index NumberOfDelayedPivots() const
+    {
+      return ndelayed_;
+    }
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Copy Constructor */
+    NativeLDLFactorization(const NativeLDLFactorization&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const NativeLDLFactorization&);
+    //@}
+
+    /** Numerical data of one frontal matrix after its partial
+     *  factorization. */
+    struct FrontFactor
+    {
+      /** Number of rows of the front (including delayed pivots). */
+      Index nrow;
+      /** Number of fully summed rows of the front. */
+      Index nfs;
+      /** Number of eliminated pivots. */
+      Index nelim;
+      /** Number of negative eigenvalues among the eliminated pivots */
+      Index negevals;
+      /** Number of zero pivots encountered */
+      Index nzero;
+      /** Global (permuted) indices of the front rows.  The first
+       *  nelim entries are the eliminated pivots in pivot order, the
+       *  next nfs-nelim entries are delayed to the parent. */
+      std::vector<Index> rows;
+      /** Columns of L (nrow x nelim, column-major).  The diagonal
+       *  entries and the entries inside 2x2 pivot blocks are zero. */
+      std::vector<Number> lfact;
+      /** Diagonal entries of D. */
+      std::vector<Number> diag;
+      /** Off-diagonal entries of D; offdiag[j] is nonzero only for
+       *  the first column j of a 2x2 block. */
+      std::vector<Number> offdiag;
+      /** Size of the pivot block starting at each eliminated column
+       *  (1 or 2; 0 for the second column of a 2x2 block) */
+      std::vector<char> pivsize;
+      /** Lower triangle of the contribution block
+       *  (nrow-nelim)x(nrow-nelim), column-major, released after it
+       *  has been assembled into the parent front. */
+      std::vector<Number> contrib;
+    };
+
+    /** Per-thread workspace for the numerical factorization. */
+    struct FrontWorkspace
+    {
+      /** Position of a global index in the current front */
+      std::vector<Index> map;
+      /** Dense frontal matrix */
+      std::vector<Number> front;
+      /** Temporary storage for products L*D */
+      std::vector<Number> ld;
+    };
+
+    /** Assemble and partially factorize the front of supernode s. */
+    void FactorSupernode(Index s, const Number* values, Number pivtol,
+                         Number small_pivot, FrontWorkspace& ws);
+
+    /** Threshold Bunch-Kaufman factorization of the fully summed
+     *  columns [k, nfs) of the dense front F (with nrow rows).
+     *  Returns the new number of eliminated columns. */
+    Index FactorFullySummed(Index k, Index nrow, Index nfs, Number* F,
+                            Number pivtol, Number small_pivot,
+                            FrontFactor& ff, std::vector<Number>& ld) const;
+
+    /** Symbolic analysis of the matrix structure */
+    SmartPtr<const NativeSymbolicFactorization> symbolic_;
+
+    /** @name Numerical factorization */
+    //@{
+    /** Partial factorization of every front */
+    std::vector<FrontFactor> factors_;
+    /** Number of negative eigenvalues */
+    Index negevals_;
+    /** Number of delayed pivots */
+    Index ndelayed_;
+    /** Maximal number of rows in a front (for the solve workspace) */
+    Index max_front_;
+    //@}
+  };
+
+} // namespace Ipopt
+
+#endif
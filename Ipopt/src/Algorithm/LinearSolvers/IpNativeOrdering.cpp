@@ -0,0 +1,764 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpNativeOrdering.hpp"
+
+#include <vector>
+
+#ifdef HAVE_CMATH
+# include <cmath>
+#else
+# ifdef HAVE_MATH_H
+#  include <math.h>
+# else
+#  error "don't have header file for math"
+# endif
+#endif
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  /** Status of a node in the quotient graph during the AMD
+   *  elimination. */
+  enum EAmdNodeStatus {
+    AMD_VARIABLE=0,
+    AMD_ELEMENT,
+    AMD_DEAD_ELEMENT,
+    AMD_ABSORBED
+  };
+
+  /** Remove variable i from the degree bucket lists. */
+  static inline void AmdRemoveFromBucket(Index i, Index deg,
+                                         std::vector<Index>& head,
+                                         std::vector<Index>& next,
+                                         std::vector<Index>& prev)
+  {
+    if (prev[i] != -1) {
+      next[prev[i]] = next[i];
+    }
+    else {
+      head[deg] = next[i];
+    }
+    if (next[i] != -1) {
+      prev[next[i]] = prev[i];
+    }
+    next[i] = -1;
+    prev[i] = -1;
+  }
+
+  /** Insert variable i into the degree bucket list deg. */
+  static inline void AmdInsertIntoBucket(Index i, Index deg,
+                                         std::vector<Index>& head,
+                                         std::vector<Index>& next,
+                                         std::vector<Index>& prev)
+  {
+    prev[i] = -1;
+    next[i] = head[deg];
+    if (head[deg] != -1) {
+      prev[head[deg]] = i;
+    }
+    head[deg] = i;
+  }
+
+  /** Release the memory held by a std::vector. */
+  static inline void AmdFreeList(std::vector<Index>& list)
+  {
+    std::vector<Index> empty;
+    list.swap(empty);
+  }
+
+  void NativeAmdOrdering(Index n, const Index* ptr, const Index* adj,
+                         Index* perm)
+  {
+    DBG_START_FUN("NativeAmdOrdering", dbg_verbosity);
+    if (n<=0) {
+      return;
+    }
+
+    // Adjacency of each variable to other variables (pruned lazily)
+    std::vector<std::vector<Index> > vars(n);
+    // Elements adjacent to each variable
+    std::vector<std::vector<Index> > elems(n);
+    // Variables in each element
+    std::vector<std::vector<Index> > evars(n);
+
+    // Size of each supervariable (0 if the node is not a principal
+    // variable anymore)
+    std::vector<Index> nv(n, 1);
+    // Approximate external degree for variables, weighted size
+    // |Le| for elements
+    std::vector<Index> degree(n, 0);
+    std::vector<char> status(n, AMD_VARIABLE);
+
+    // Degree buckets (doubly linked lists)
+    std::vector<Index> head(n+1, -1);
+    std::vector<Index> next(n, -1);
+    std::vector<Index> prev(n, -1);
+
+    // Workspace for the set differences |Le\Lp|
+    std::vector<Index> wval(n, 0);
+    std::vector<Index> wstamp(n, -1);
+    Index wtag = 0;
+    // Marker for membership in the current pivot element
+    std::vector<Index> mark(n, -1);
+    Index tag = 0;
+    // Marker for the comparison of adjacency lists
+    std::vector<Index> smark(n, -1);
+    Index stag = 0;
+
+    // Hash values and hash buckets for supervariable detection
+    std::vector<Index> hashval(n, 0);
+    std::vector<Index> hhead(n, -1);
+    std::vector<Index> hnext(n, -1);
+
+    // Linked lists of all original nodes represented by a principal
+    // variable, in the order in which they are to be eliminated
+    std::vector<Index> chain_next(n, -1);
+    std::vector<Index> chain_last(n);
+    for (Index i=0; i<n; i++) {
+      chain_last[i] = i;
+    }
+
+    // Copy the graph, removing diagonal entries and duplicates
+    for (Index i=0; i<n; i++) {
+      tag++;
+      mark[i] = tag;
+      vars[i].reserve(ptr[i+1]-ptr[i]);
+      for (Index p=ptr[i]; p<ptr[i+1]; p++) {
+        Index j = adj[p];
+        if (mark[j] != tag) {
+          mark[j] = tag;
+          vars[i].push_back(j);
+        }
+      }
+    }
+
+    // Rows that are almost dense are not considered in the
+    // elimination, and are ordered at the very end.
+    Index dense = Max((Index)16, (Index)(10.*sqrt((double)n)));
+    dense = Min(n-2, dense);
+    std::vector<Index> dense_nodes;
+    for (Index i=0; i<n; i++) {
+      if ((Index)vars[i].size() > dense) {
+        nv[i] = 0;
+        status[i] = AMD_ABSORBED;
+        dense_nodes.push_back(i);
+        AmdFreeList(vars[i]);
+      }
+    }
+
+    Index nel = (Index)dense_nodes.size();
+    for (Index i=0; i<n; i++) {
+      if (status[i] != AMD_VARIABLE) {
+        continue;
+      }
+      Index d = 0;
+      for (std::vector<Index>::const_iterator it = vars[i].begin();
+           it != vars[i].end(); it++) {
+        d += nv[*it];
+      }
+      degree[i] = d;
+      AmdInsertIntoBucket(i, d, head, next, prev);
+    }
+
+    Index nperm = 0;
+    Index mindeg = 0;
+    std::vector<Index> lp;
+    while (nel < n) {
+      // Select a variable of minimum approximate degree
+      while (mindeg < n && head[mindeg] == -1) {
+        mindeg++;
+      }
+      DBG_ASSERT(mindeg < n);
+      const Index p = head[mindeg];
+      AmdRemoveFromBucket(p, mindeg, head, next, prev);
+      Index nvp = nv[p];
+      nel += nvp;
+
+      // Construct the new element Lp as the union of the variables
+      // adjacent to p and the variables in the elements adjacent to p
+      tag++;
+      mark[p] = tag;
+      lp.clear();
+      Index dk = 0;
+      for (std::vector<Index>::const_iterator ite = elems[p].begin();
+           ite != elems[p].end(); ite++) {
+        const Index e = *ite;
+        if (status[e] != AMD_ELEMENT) {
+          continue;
+        }
+        for (std::vector<Index>::const_iterator it = evars[e].begin();
+             it != evars[e].end(); it++) {
+          const Index i = *it;
+          if (nv[i] > 0 && mark[i] != tag) {
+            mark[i] = tag;
+            lp.push_back(i);
+            dk += nv[i];
+            AmdRemoveFromBucket(i, degree[i], head, next, prev);
+          }
+        }
+        // e is absorbed into the new element
+        status[e] = AMD_DEAD_ELEMENT;
+        AmdFreeList(evars[e]);
+      }
+      for (std::vector<Index>::const_iterator it = vars[p].begin();
+           it != vars[p].end(); it++) {
+        const Index i = *it;
+        if (nv[i] > 0 && status[i] == AMD_VARIABLE && mark[i] != tag) {
+          mark[i] = tag;
+          lp.push_back(i);
+          dk += nv[i];
+          AmdRemoveFromBucket(i, degree[i], head, next, prev);
+        }
+      }
+      AmdFreeList(vars[p]);
+      AmdFreeList(elems[p]);
+      status[p] = AMD_ELEMENT;
+
+      // Compute |Le\Lp| for all elements e adjacent to variables in Lp
+      wtag++;
+      for (std::vector<Index>::const_iterator it = lp.begin();
+           it != lp.end(); it++) {
+        const Index i = *it;
+        for (std::vector<Index>::const_iterator ite = elems[i].begin();
+             ite != elems[i].end(); ite++) {
+          const Index e = *ite;
+          if (status[e] != AMD_ELEMENT) {
+            continue;
+          }
+          if (wstamp[e] != wtag) {
+            wstamp[e] = wtag;
+            wval[e] = degree[e] - nv[i];
+          }
+          else {
+            wval[e] -= nv[i];
+          }
+        }
+      }
+
+      // Degree update, element absorption, and mass elimination
+      for (std::vector<Index>::iterator it = lp.begin(); it != lp.end(); it++) {
+        const Index i = *it;
+        Index d = 0;
+        unsigned long h = 0;
+        std::vector<Index>& ei = elems[i];
+        Index ne = 0;
+        for (Index k=0; k<(Index)ei.size(); k++) {
+          const Index e = ei[k];
+          if (status[e] != AMD_ELEMENT) {
+            continue;
+          }
+          const Index dext = wval[e];
+          if (dext > 0) {
+            d += dext;
+            h += (unsigned long)e;
+            ei[ne++] = e;
+          }
+          else {
+            // aggressive absorption: Le is a subset of Lp
+            status[e] = AMD_DEAD_ELEMENT;
+            AmdFreeList(evars[e]);
+          }
+        }
+        ei.resize(ne);
+        ei.push_back(p);
+
+        std::vector<Index>& vi = vars[i];
+        Index nvv = 0;
+        for (Index k=0; k<(Index)vi.size(); k++) {
+          const Index j = vi[k];
+          if (nv[j] <= 0 || status[j] != AMD_VARIABLE || mark[j] == tag) {
+            continue;
+          }
+          d += nv[j];
+          h += (unsigned long)j;
+          vi[nvv++] = j;
+        }
+        vi.resize(nvv);
+
+        if (d == 0) {
+          // mass elimination: i is eliminated together with p
+          dk -= nv[i];
+          nvp += nv[i];
+          nel += nv[i];
+          nv[i] = 0;
+          status[i] = AMD_ABSORBED;
+          AmdFreeList(elems[i]);
+          AmdFreeList(vars[i]);
+          chain_next[chain_last[p]] = i;
+          chain_last[p] = chain_last[i];
+        }
+        else {
+          degree[i] = Min(degree[i], d);
+          hashval[i] = (Index)(h % (unsigned long)n);
+        }
+      }
+
+      // Detect indistinguishable variables in Lp and merge them into
+      // supervariables
+      for (std::vector<Index>::const_iterator it = lp.begin();
+           it != lp.end(); it++) {
+        const Index i = *it;
+        if (nv[i] <= 0) {
+          continue;
+        }
+        hnext[i] = hhead[hashval[i]];
+        hhead[hashval[i]] = i;
+      }
+      for (std::vector<Index>::const_iterator it = lp.begin();
+           it != lp.end(); it++) {
+        if (nv[*it] <= 0) {
+          continue;
+        }
+        const Index h = hashval[*it];
+        Index i = hhead[h];
+        hhead[h] = -1;
+        for (; i != -1; i = hnext[i]) {
+          if (nv[i] <= 0) {
+            continue;
+          }
+          stag++;
+          for (std::vector<Index>::const_iterator itk = elems[i].begin();
+               itk != elems[i].end(); itk++) {
+            smark[*itk] = stag;
+          }
+          for (std::vector<Index>::const_iterator itk = vars[i].begin();
+               itk != vars[i].end(); itk++) {
+            smark[*itk] = stag;
+          }
+          for (Index j = hnext[i]; j != -1; j = hnext[j]) {
+            if (nv[j] <= 0 ||
+                elems[j].size() != elems[i].size() ||
+                vars[j].size() != vars[i].size()) {
+              continue;
+            }
+            bool same = true;
+            for (std::vector<Index>::const_iterator itk = elems[j].begin();
+                 same && itk != elems[j].end(); itk++) {
+              same = (smark[*itk] == stag);
+            }
+            for (std::vector<Index>::const_iterator itk = vars[j].begin();
+                 same && itk != vars[j].end(); itk++) {
+              same = (smark[*itk] == stag);
+            }
+            if (same) {
+              // absorb j into i
+              nv[i] += nv[j];
+              nv[j] = 0;
+              status[j] = AMD_ABSORBED;
+              AmdFreeList(elems[j]);
+              AmdFreeList(vars[j]);
+              chain_next[chain_last[i]] = j;
+              chain_last[i] = chain_last[j];
+            }
+          }
+        }
+      }
+
+      // Finalize the new element and put the variables back into the
+      // degree lists
+      Index nlp = 0;
+      for (Index k=0; k<(Index)lp.size(); k++) {
+        const Index i = lp[k];
+        if (nv[i] <= 0) {
+          continue;
+        }
+        Index d = degree[i] + dk - nv[i];
+        d = Min(d, n - nel - nv[i]);
+        d = Max(d, (Index)0);
+        degree[i] = d;
+        AmdInsertIntoBucket(i, d, head, next, prev);
+        mindeg = Min(mindeg, d);
+        lp[nlp++] = i;
+      }
+      lp.resize(nlp);
+      degree[p] = dk;
+      if (nlp > 0) {
+        evars[p] = lp;
+      }
+      else {
+        status[p] = AMD_DEAD_ELEMENT;
+      }
+
+      // p and everything that has been absorbed into it is eliminated now
+      for (Index i=p; i!=-1; i=chain_next[i]) {
+        perm[nperm++] = i;
+      }
+      nv[p] = 0;
+    }
+
+    for (std::vector<Index>::const_iterator it = dense_nodes.begin();
+         it != dense_nodes.end(); it++) {
+      perm[nperm++] = *it;
+    }
+
+    DBG_ASSERT(nperm == n);
+    if (nperm != n) {
+      // This should not happen; fall back to the natural ordering
+      for (Index i=0; i<n; i++) {
+        perm[i] = i;
+      }
+    }
+  }
+
+  /** Compute the AMD ordering for the subgraph induced by the given
+   *  nodes and store the result in perm.  loc is a workspace of size
+   *  n that is -1 for all nodes on entry and on exit. */
+  static void NDOrderLeaf(const Index* ptr, const Index* adj,
+                          const std::vector<Index>& nodes,
+                          std::vector<Index>& loc, Index* perm)
+  {
+    const Index nloc = (Index)nodes.size();
+    for (Index k=0; k<nloc; k++) {
+      loc[nodes[k]] = k;
+    }
+    std::vector<Index> lptr(nloc+1);
+    std::vector<Index> ladj;
+    lptr[0] = 0;
+    for (Index k=0; k<nloc; k++) {
+      const Index i = nodes[k];
+      for (Index p=ptr[i]; p<ptr[i+1]; p++) {
+        const Index j = loc[adj[p]];
+        if (j >= 0) {
+          ladj.push_back(j);
+        }
+      }
+      lptr[k+1] = (Index)ladj.size();
+    }
+    std::vector<Index> lperm(nloc);
+    NativeAmdOrdering(nloc, &lptr[0], ladj.empty() ? NULL : &ladj[0],
+                      &lperm[0]);
+    for (Index k=0; k<nloc; k++) {
+      perm[k] = nodes[lperm[k]];
+    }
+    for (Index k=0; k<nloc; k++) {
+      loc[nodes[k]] = -1;
+    }
+  }
+
+  /** Breadth-first search in the subgraph marked with label, starting
+   *  at root.  The nodes are returned in level order in order, and
+   *  level_ptr gives the start of each level.  Returns the number of
+   *  nodes reached. */
+  static Index NDLevelStructure(const Index* ptr, const Index* adj,
+                                const std::vector<Index>& where, Index label,
+                                Index root, std::vector<Index>& visited,
+                                Index vtag, std::vector<Index>& order,
+                                std::vector<Index>& level_ptr)
+  {
+    order.clear();
+    level_ptr.clear();
+    order.push_back(root);
+    visited[root] = vtag;
+    level_ptr.push_back(0);
+    Index first = 0;
+    while (first < (Index)order.size()) {
+      const Index last = (Index)order.size();
+      level_ptr.push_back(last);
+      for (Index k=first; k<last; k++) {
+        const Index i = order[k];
+        for (Index p=ptr[i]; p<ptr[i+1]; p++) {
+          const Index j = adj[p];
+          if (where[j] == label && visited[j] != vtag) {
+            visited[j] = vtag;
+            order.push_back(j);
+          }
+        }
+      }
+      first = last;
+    }
+    // level_ptr now has one entry per level plus the final end
+    return (Index)order.size();
+  }
+
+  /** Bisection of the subgraph induced by nodes, which are marked
+   *  with label in where during the call.  Returns 0 if the subgraph
+   *  could not be split (it has too few levels, or the split would
+   *  be too unbalanced), 1 if it is not connected (part_a is then a
+   *  connected component, part_b the remaining nodes, and sep is
+   *  empty), and 2 if it has been split into part_a and part_b by the
+   *  vertex separator sep.  On return, where is 0 for all nodes. */
+  static Index NDBisect(Index n, const Index* ptr, const Index* adj,
+                        const std::vector<Index>& nodes, Index label,
+                        std::vector<Index>& where,
+                        std::vector<Index>& visited, Index& vtag,
+                        std::vector<Index>& order,
+                        std::vector<Index>& level_ptr,
+                        std::vector<Index>& part_a,
+                        std::vector<Index>& part_b,
+                        std::vector<Index>& sep)
+  {
+    const Index nnodes = (Index)nodes.size();
+    for (Index k=0; k<nnodes; k++) {
+      where[nodes[k]] = label;
+    }
+
+    // Find a pseudo-peripheral node of the component containing the
+    // first node
+    Index root = nodes[0];
+    Index nlevels = 0;
+    Index nreached = 0;
+    for (Index iter=0; iter<5; iter++) {
+      vtag++;
+      nreached = NDLevelStructure(ptr, adj, where, label, root, visited,
+                                  vtag, order, level_ptr);
+      const Index nl = (Index)level_ptr.size()-1;
+      if (nl <= nlevels) {
+        break;
+      }
+      nlevels = nl;
+      // pick a node of minimal degree in the last level
+      Index best = -1;
+      Index best_deg = n+1;
+      for (Index k=level_ptr[nl-1]; k<level_ptr[nl]; k++) {
+        const Index i = order[k];
+        const Index d = ptr[i+1]-ptr[i];
+        if (d < best_deg) {
+          best_deg = d;
+          best = i;
+        }
+      }
+      if (best == root) {
+        break;
+      }
+      root = best;
+    }
+    // Recompute the level structure for the final root
+    vtag++;
+    nreached = NDLevelStructure(ptr, adj, where, label, root, visited,
+                                vtag, order, level_ptr);
+    nlevels = (Index)level_ptr.size()-1;
+
+    if (nreached < nnodes) {
+      // The subgraph is not connected.  Split off the component
+      // that has been found; the two pieces are independent and
+      // need no separator.
+      part_a = order;
+      part_b.clear();
+      sep.clear();
+      for (Index k=0; k<nnodes; k++) {
+        if (visited[nodes[k]] != vtag) {
+          part_b.push_back(nodes[k]);
+        }
+      }
+      for (Index k=0; k<nnodes; k++) {
+        where[nodes[k]] = 0;
+      }
+      return 1;
+    }
+
+    if (nlevels < 3) {
+      for (Index k=0; k<nnodes; k++) {
+        where[nodes[k]] = 0;
+      }
+      return 0;
+    }
+
+    // Choose the middle level as separator
+    Index slevel = 1;
+    while (slevel < nlevels-2 && level_ptr[slevel+1] < nnodes/2) {
+      slevel++;
+    }
+
+    // Mark the parts: label for A, label+n for S, label+2n for B is
+    // avoided by using separate marks in visited.
+    const Index atag = ++vtag;
+    const Index stag = ++vtag;
+    const Index btag = ++vtag;
+    for (Index l=0; l<nlevels; l++) {
+      const Index t = (l<slevel) ? atag : ((l==slevel) ? stag : btag);
+      for (Index k=level_ptr[l]; k<level_ptr[l+1]; k++) {
+        visited[order[k]] = t;
+      }
+    }
+
+    // Thin the separator: separator nodes without a neighbor in one
+    // of the parts can be moved into the other part
+    for (Index k=level_ptr[slevel]; k<level_ptr[slevel+1]; k++) {
+      const Index i = order[k];
+      bool touches_b = false;
+      for (Index p=ptr[i]; p<ptr[i+1] && !touches_b; p++) {
+        const Index j = adj[p];
+        touches_b = (where[j] == label && visited[j] == btag);
+      }
+      if (!touches_b) {
+        visited[i] = atag;
+      }
+    }
+    for (Index k=level_ptr[slevel]; k<level_ptr[slevel+1]; k++) {
+      const Index i = order[k];
+      if (visited[i] != stag) {
+        continue;
+      }
+      bool touches_a = false;
+      for (Index p=ptr[i]; p<ptr[i+1] && !touches_a; p++) {
+        const Index j = adj[p];
+        touches_a = (where[j] == label && visited[j] == atag);
+      }
+      if (!touches_a) {
+        visited[i] = btag;
+      }
+    }
+
+    part_a.clear();
+    part_b.clear();
+    sep.clear();
+    for (Index k=0; k<nnodes; k++) {
+      const Index i = nodes[k];
+      if (visited[i] == atag) {
+        part_a.push_back(i);
+      }
+      else if (visited[i] == btag) {
+        part_b.push_back(i);
+      }
+      else {
+        sep.push_back(i);
+      }
+    }
+    for (Index k=0; k<nnodes; k++) {
+      where[nodes[k]] = 0;
+    }
+
+    // Give up on dissection if the partition is too unbalanced
+    const Index nmin = Min((Index)part_a.size(), (Index)part_b.size());
+    if (nmin == 0 || 20*nmin < nnodes) {
+      return 0;
+    }
+    return 2;
+  }
+
+  void NativeNestedDissectionOrdering(Index n, const Index* ptr,
+                                      const Index* adj, Index* perm,
+                                      Index leaf_size /*= 200*/)
+  {
+    DBG_START_FUN("NativeNestedDissectionOrdering", dbg_verbosity);
+    if (n<=0) {
+      return;
+    }
+    leaf_size = Max(leaf_size, (Index)4);
+
+    // Subsets that still need to be ordered, together with the first
+    // position in perm they are assigned to
+    std::vector<std::vector<Index> > job_nodes;
+    std::vector<Index> job_start;
+    std::vector<Index> where(n, 0);
+    std::vector<Index> loc(n, -1);
+    std::vector<Index> visited(n, -1);
+    Index vtag = 0;
+    Index next_label = 1;
+
+    job_nodes.push_back(std::vector<Index>(n));
+    for (Index i=0; i<n; i++) {
+      job_nodes.back()[i] = i;
+    }
+    job_start.push_back(0);
+
+    std::vector<Index> order;
+    std::vector<Index> level_ptr;
+    std::vector<Index> part_a;
+    std::vector<Index> part_b;
+    std::vector<Index> sep;
+    while (!job_nodes.empty()) {
+      std::vector<Index> nodes;
+      nodes.swap(job_nodes.back());
+      job_nodes.pop_back();
+      const Index start = job_start.back();
+      job_start.pop_back();
+      const Index nnodes = (Index)nodes.size();
+
+      if (nnodes <= leaf_size) {
+        NDOrderLeaf(ptr, adj, nodes, loc, perm+start);
+        continue;
+      }
+
+      const Index split = NDBisect(n, ptr, adj, nodes, next_label++, where,
+                                   visited, vtag, order, level_ptr,
+                                   part_a, part_b, sep);
+      if (split == 0) {
+        NDOrderLeaf(ptr, adj, nodes, loc, perm+start);
+        continue;
+      }
+
+      const Index na = (Index)part_a.size();
+      const Index nb = (Index)part_b.size();
+      for (Index k=0; k<(Index)sep.size(); k++) {
+        perm[start+na+nb+k] = sep[k];
+      }
+      job_nodes.push_back(part_a);
+      job_start.push_back(start);
+      job_nodes.push_back(part_b);
+      job_start.push_back(start+na);
+    }
+  }
+
+  Index NativeGraphPartition(Index n, const Index* ptr, const Index* adj,
+                             Index nparts, Index* part)
+  {
+    DBG_START_FUN("NativeGraphPartition", dbg_verbosity);
+    if (n<=0) {
+      return 0;
+    }
+
+    std::vector<std::vector<Index> > pieces;
+    pieces.push_back(std::vector<Index>(n));
+    for (Index i=0; i<n; i++) {
+      pieces.back()[i] = i;
+      part[i] = 0;
+    }
+    // Pieces that could not be split any further
+    std::vector<bool> final_piece(1, false);
+
+    std::vector<Index> where(n, 0);
+    std::vector<Index> visited(n, -1);
+    Index vtag = 0;
+    Index next_label = 1;
+    std::vector<Index> order;
+    std::vector<Index> level_ptr;
+    std::vector<Index> part_a;
+    std::vector<Index> part_b;
+    std::vector<Index> sep;
+    while ((Index)pieces.size() < nparts) {
+      // Always split the largest piece
+      Index largest = -1;
+      for (Index k=0; k<(Index)pieces.size(); k++) {
+        if (!final_piece[k] && pieces[k].size() > 1 &&
+            (largest<0 || pieces[k].size() > pieces[largest].size())) {
+          largest = k;
+        }
+      }
+      if (largest < 0) {
+        break;
+      }
+
+      const Index split = NDBisect(n, ptr, adj, pieces[largest],
+                                   next_label++, where, visited, vtag,
+                                   order, level_ptr, part_a, part_b, sep);
+      if (split == 0) {
+        final_piece[largest] = true;
+        continue;
+      }
+      for (Index k=0; k<(Index)sep.size(); k++) {
+        part[sep[k]] = -1;
+      }
+      pieces[largest] = part_a;
+      pieces.push_back(part_b);
+      final_piece.push_back(false);
+    }
+
+    for (Index k=0; k<(Index)pieces.size(); k++) {
+      for (Index l=0; l<(Index)pieces[k].size(); l++) {
+        part[pieces[k][l]] = k;
+      }
+    }
+    return (Index)pieces.size();
+  }
+
+} // namespace Ipopt
@@ -0,0 +1,59 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPNATIVEORDERING_HPP__
+#define __IPNATIVEORDERING_HPP__
+
+#include "IpUtils.hpp"
+
+namespace Ipopt
+{
+
+  /** @name Fill-reducing orderings for the native sparse LDL^T solver.
+   *
+   *  The graph of the symmetric matrix is given in compressed form:
+   *  the neighbors of node i are adj[ptr[i]],...,adj[ptr[i+1]-1]
+   *  (0-based).  Every off-diagonal edge must be listed in both
+   *  directions, and the diagonal must not be included.  On return,
+   *  perm[k] is the (0-based) node that is eliminated in the k-th
+   *  step.
+   */
+  //@{
+  /** Approximate minimum degree ordering on the quotient graph (with
+   *  mass elimination, supervariable detection, aggressive
+   *  absorption, and postponement of dense rows). */
+  void NativeAmdOrdering(Index n, const Index* ptr, const Index* adj,
+                         Index* perm);
+
+  /** Nested dissection ordering.  The graph is recursively bisected
+   *  by vertex separators obtained from breadth-first level
+   *  structures rooted at pseudo-peripheral nodes.  Separators are
+   *  ordered after the two halves, so that the halves become
+   *  independent subtrees in the elimination tree.  Subgraphs with at
+   *  most leaf_size nodes (or ones that cannot be split in a balanced
+   *  way) are ordered with NativeAmdOrdering. */
+  void NativeNestedDissectionOrdering(Index n, const Index* ptr,
+                                      const Index* adj, Index* perm,
+                                      Index leaf_size = 200);
+
+  /** Partition of the graph into at most nparts subdomains and a
+   *  vertex separator, such that there is no edge between nodes of
+   *  different subdomains.  The largest subdomain is bisected
+   *  repeatedly in the same way as in
+   *  NativeNestedDissectionOrdering.  On return, part[i] is the
+   *  subdomain (between 0 and the return value minus one) of node i,
+   *  or -1 if node i belongs to the separator.  Returns the number of
+   *  subdomains, which is smaller than nparts if the graph could not
+   *  be split further. */
+  Index NativeGraphPartition(Index n, const Index* ptr, const Index* adj,
+                             Index nparts, Index* part);
+  //@}
+
+} // namespace Ipopt
+
+#endif
@@ -0,0 +1,366 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpoptConfig.h"
+#include "IpNativeSolverInterface.hpp"
+
+#include <fstream>
+
+#ifdef HAVE_CMATH
+# include <cmath>
+#else
+# ifdef HAVE_MATH_H
+#  include <math.h>
+# else
+#  error "don't have header file for math"
+# endif
+#endif
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  NativeSolverInterface::NativeSolverInterface()
+      :
+      dim_(0),
+      nonzeros_(0),
+      a_(NULL),
+      negevals_(0),
+      initialized_(false),
+      pivtol_changed_(false),
+      refactorize_(false)
+  {
+    DBG_START_METH("NativeSolverInterface::NativeSolverInterface()",
+                   dbg_verbosity);
+  }
+
+  NativeSolverInterface::~NativeSolverInterface()
+  {
+    DBG_START_METH("NativeSolverInterface::~NativeSolverInterface()",
+                   dbg_verbosity);
+    delete [] a_;
+  }
+
+  void NativeSolverInterface::RegisterOptions(SmartPtr<RegisteredOptions> roptions)
+  {
+    roptions->AddBoundedNumberOption(
+      "native_pivtol",
+      "Pivot tolerance for the built-in linear solver.",
+      0.0, true, 0.5, false, 1e-8,
+      "This is the threshold for the Bunch-Kaufman pivot choice.  A smaller "
+      "number pivots for sparsity, a larger number pivots for stability.");
+    roptions->AddBoundedNumberOption(
+      "native_pivtolmax",
+      "Maximum pivot tolerance for the built-in linear solver.",
+      0.0, true, 0.5, false, 1e-4,
+      "Ipopt may increase pivtol as high as pivtolmax to get a more accurate "
+      "solution to the linear system.");
+    roptions->AddLowerBoundedNumberOption(
+      "native_small",
+      "Zero pivot threshold for the built-in linear solver.",
+      0.0, false, 1e-20,
+      "Any pivot less than or equal to this value is treated as zero, and "
+      "the matrix is reported to be singular.");
+    roptions->AddStringOption2(
+      "native_ordering",
+      "Fill-reducing ordering used by the built-in linear solver.",
+      "amd",
+      "amd", "approximate minimum degree",
+      "nd", "nested dissection",
+      "Nested dissection tends to give more balanced elimination trees, "
+      "which can be factorized more efficiently in parallel.");
+    roptions->AddLowerBoundedIntegerOption(
+      "native_num_threads",
+      "Number of threads used by the built-in linear solver.",
+      0, 0,
+      "Independent subtrees of the elimination tree are factorized "
+      "concurrently.  The value 0 uses the OpenMP default.  This option "
+      "has only an effect if Ipopt has been compiled with OpenMP support.");
+  }
+
+  bool NativeSolverInterface::InitializeImpl(const OptionsList& options,
+      const std::string& prefix)
+  {
+    options.GetNumericValue("native_pivtol", pivtol_, prefix);
+    if (options.GetNumericValue("native_pivtolmax", pivtolmax_, prefix)) {
+      ASSERT_EXCEPTION(pivtolmax_>=pivtol_, OPTION_INVALID,
+                       "Option \"native_pivtolmax\": This value must be between "
+                       "native_pivtol and 0.5.");
+    }
+    else {
+      pivtolmax_ = Max(pivtolmax_, pivtol_);
+    }
+    options.GetNumericValue("native_small", small_pivot_, prefix);
+    Index enum_int;
+    options.GetEnumValue("native_ordering", enum_int, prefix);
+    ordering_ = NativeSymbolicFactorization::EOrdering(enum_int);
+    options.GetIntegerValue("native_num_threads", num_threads_, prefix);
+    // The following option is registered by OrigIpoptNLP
+    options.GetBoolValue("warm_start_same_structure",
+                         warm_start_same_structure_, prefix);
+
+    // Reset all private data
+    initialized_ = false;
+    pivtol_changed_ = false;
+    refactorize_ = false;
+
+    if (!warm_start_same_structure_) {
+      dim_ = 0;
+      nonzeros_ = 0;
+      factorization_ = NULL;
+      cache_entry_ = NULL;
+    }
+    else {
+      ASSERT_EXCEPTION(dim_>0 && nonzeros_>0, INVALID_WARMSTART,
+                       "NativeSolverInterface called with warm_start_same_structure, but the problem is solved for the first time.");
+    }
+
+    return true;
+  }
+
+  ESymSolverStatus NativeSolverInterface::MultiSolve(bool new_matrix,
+      const Index* ia,
+      const Index* ja,
+      Index nrhs,
+      double* rhs_vals,
+      bool check_NegEVals,
+      Index numberOfNegEVals)
+  {
+    DBG_START_METH("NativeSolverInterface::MultiSolve",dbg_verbosity);
+    DBG_ASSERT(!check_NegEVals || ProvidesInertia());
+    DBG_ASSERT(initialized_);
+
+    if (pivtol_changed_) {
+      DBG_PRINT((1,"Pivot tolerance has changed.\n"));
+      pivtol_changed_ = false;
+      // If the pivot tolerance has been changed but the matrix is not
+      // new, we have to request the values for the matrix again to do
+      // the factorization again.
+      if (!new_matrix) {
+        DBG_PRINT((1,"Ask caller to call again.\n"));
+        refactorize_ = true;
+        return SYMSOLVER_CALL_AGAIN;
+      }
+    }
+
+    // check if a factorization has to be done
+    DBG_PRINT((1, "new_matrix = %d\n", new_matrix));
+    if (new_matrix || refactorize_) {
+      ESymSolverStatus retval = Factorization(check_NegEVals,
+                                              numberOfNegEVals);
+      if (retval!=SYMSOLVER_SUCCESS) {
+        DBG_PRINT((1, "FACTORIZATION FAILED!\n"));
+        return retval;  // Matrix singular or error occurred
+      }
+      refactorize_ = false;
+    }
+
+    // do the backsolve
+    if (HaveIpData()) {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+    }
+    factorization_->Solve(nrhs, rhs_vals);
+    if (HaveIpData()) {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+    }
+    return SYMSOLVER_SUCCESS;
+  }
+
+  double* NativeSolverInterface::GetValuesArrayPtr()
+  {
+    DBG_START_METH("NativeSolverInterface::GetValuesArrayPtr",dbg_verbosity);
+    DBG_ASSERT(initialized_);
+    return a_;
+  }
+
+  ESymSolverStatus NativeSolverInterface::InitializeStructure(Index dim,
+      Index nonzeros,
+      const Index* ia,
+      const Index* ja)
+  {
+    DBG_START_METH("NativeSolverInterface::InitializeStructure",dbg_verbosity);
+
+    if (!warm_start_same_structure_) {
+      dim_ = dim;
+      nonzeros_ = nonzeros;
+
+      delete [] a_;
+      a_ = NULL;
+      a_ = new double[nonzeros_];
+
+      if (HaveIpData()) {
+        IpData().TimingStats().LinearSystemSymbolicFactorization().Start();
+      }
+      SmartPtr<const NativeSymbolicFactorization> symbolic;
+      ESymSolverStatus retval = GetSymbolicFactorization(ia, ja, symbolic);
+      if (HaveIpData()) {
+        IpData().TimingStats().LinearSystemSymbolicFactorization().End();
+      }
+      if (retval != SYMSOLVER_SUCCESS) {
+        Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                       "The index of a matrix is out of range.\nPlease check your implementation of the Jacobian and Hessian matrices.\n");
+        return retval;
+      }
+      factorization_ = new NativeLDLFactorization(symbolic);
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Native solver: %d supernodes, predicted nonzeros in factor = %.0f, predicted flops = %.3e\n",
+                     symbolic->NumberOfSupernodes(),
+                     symbolic->PredictedNonzerosInFactor(),
+                     symbolic->PredictedFlops());
+    }
+    else {
+      ASSERT_EXCEPTION(dim_==dim && nonzeros_==nonzeros, INVALID_WARMSTART,
+                       "NativeSolverInterface called with warm_start_same_structure, but the problem size has changed.");
+    }
+
+    initialized_ = true;
+    return SYMSOLVER_SUCCESS;
+  }
+
+  void NativeSolverInterface::SetSymbolicCacheEntry(
+    const SmartPtr<SymbolicCacheEntry>& entry)
+  {
+    cache_entry_ = entry;
+  }
+
+  ESymSolverStatus
+  NativeSolverInterface::GetSymbolicFactorization(const Index* ia,
+      const Index* ja,
+      SmartPtr<const NativeSymbolicFactorization>& symbolic)
+  {
+    DBG_START_METH("NativeSolverInterface::GetSymbolicFactorization",
+                   dbg_verbosity);
+
+    std::string key;
+    if (IsValid(cache_entry_)) {
+      key = (ordering_ == NativeSymbolicFactorization::ND_ORDERING) ?
+            "native-nd" : "native-amd";
+
+      // Analysis done earlier in this process
+      SmartPtr<ReferencedObject> data = cache_entry_->Find(key);
+      if (IsValid(data)) {
+        symbolic = static_cast<const NativeSymbolicFactorization*>(GetRawPtr(data));
+        if (symbolic->Matches(dim_, nonzeros_, ia, ja, ordering_)) {
+          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                         "Native solver: reusing symbolic factorization from the cache.\n");
+          return SYMSOLVER_SUCCESS;
+        }
+      }
+
+      // Analysis stored in a file by an earlier run
+      std::string filename = cache_entry_->FileName(key);
+      if (!filename.empty()) {
+        std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+        if (is) {
+          SmartPtr<NativeSymbolicFactorization> from_file =
+            new NativeSymbolicFactorization();
+          if (from_file->Read(is) &&
+              from_file->Matches(dim_, nonzeros_, ia, ja, ordering_)) {
+            Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                           "Native solver: read symbolic factorization from file %s.\n",
+                           filename.c_str());
+            cache_entry_->Store(key, GetRawPtr(from_file));
+            symbolic = GetRawPtr(from_file);
+            return SYMSOLVER_SUCCESS;
+          }
+        }
+      }
+    }
+
+    SmartPtr<NativeSymbolicFactorization> analysis =
+      new NativeSymbolicFactorization();
+    ESymSolverStatus retval =
+      analysis->Analyze(dim_, nonzeros_, ia, ja, ordering_);
+    if (retval != SYMSOLVER_SUCCESS) {
+      return retval;
+    }
+    symbolic = GetRawPtr(analysis);
+
+    if (IsValid(cache_entry_)) {
+      cache_entry_->Store(key, GetRawPtr(analysis));
+      std::string filename = cache_entry_->FileName(key);
+      if (!filename.empty()) {
+        std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+        if (!os || !analysis->Write(os)) {
+          Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                         "Native solver: could not write symbolic factorization to file %s.\n",
+                         filename.c_str());
+        }
+      }
+    }
+    return SYMSOLVER_SUCCESS;
+  }
+
+  ESymSolverStatus
+  NativeSolverInterface::Factorization(bool check_NegEVals,
+                                       Index numberOfNegEVals)
+  {
+    DBG_START_METH("NativeSolverInterface::Factorization",dbg_verbosity);
+    if (HaveIpData()) {
+      IpData().TimingStats().LinearSystemFactorization().Start();
+    }
+
+    ESymSolverStatus retval =
+      factorization_->NumericFactorization(a_, pivtol_, small_pivot_,
+                                           num_threads_);
+    negevals_ = factorization_->NumberOfNegEVals();
+
+    if (HaveIpData()) {
+      IpData().TimingStats().LinearSystemFactorization().End();
+    }
+    if (retval != SYMSOLVER_SUCCESS) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Native solver: matrix is singular.\n");
+      return retval;
+    }
+
+    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                   "Native solver: %d negative eigenvalues, %d delayed pivots.\n",
+                   negevals_, factorization_->NumberOfDelayedPivots());
+
+    // Check whether the number of negative eigenvalues matches the requested
+    // count
+    if (check_NegEVals && (numberOfNegEVals!=negevals_)) {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "In NativeSolverInterface::Factorization: negevals_ = %d, but numberOfNegEVals = %d\n",
+                     negevals_, numberOfNegEVals);
+      return SYMSOLVER_WRONG_INERTIA;
+    }
+
+    return SYMSOLVER_SUCCESS;
+  }
+
+  Index NativeSolverInterface::NumberOfNegEVals() const
+  {
+    DBG_START_METH("NativeSolverInterface::NumberOfNegEVals",dbg_verbosity);
+    DBG_ASSERT(ProvidesInertia());
+    DBG_ASSERT(initialized_);
+    return negevals_;
+  }
+
+  bool NativeSolverInterface::IncreaseQuality()
+  {
+    DBG_START_METH("NativeSolverInterface::IncreaseQuality",dbg_verbosity);
+    if (pivtol_ == pivtolmax_) {
+      return false;
+    }
+    pivtol_changed_ = true;
+
+    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                   "Increasing pivot tolerance for the native solver from %7.2e ",
+                   pivtol_);
+    pivtol_ = Min(pivtolmax_, pow(pivtol_,0.75));
+    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                   "to %7.2e.\n",
+                   pivtol_);
+    return true;
+  }
+
+} // namespace Ipopt
@@ -0,0 +1,198 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPNATIVESOLVERINTERFACE_HPP__
+#define __IPNATIVESOLVERINTERFACE_HPP__
+
+#include "IpSparseSymLinearSolverInterface.hpp"
+#include "IpNativeLDLFactorization.hpp"
+
+namespace Ipopt
+{
+  /** Interface to Ipopt's built-in sparse symmetric indefinite
+   *  solver (see NativeLDLFactorization), derived from
+   *  SparseSymLinearSolverInterface.  This solver does not require
+   *  any third-party library and provides the inertia of the matrix.
+   */
+  class NativeSolverInterface: public SparseSymLinearSolverInterface
+  {
+  public:
+    /** @name Constructor/Destructor */
+    //@{
+    /** Constructor */
+    NativeSolverInterface();
+
+    /** Destructor */
+    virtual ~NativeSolverInterface();
+    //@}
+
+    /** overloaded from AlgorithmStrategyObject */
+    bool InitializeImpl(const OptionsList& options,
+                        const std::string& prefix);
+
+
+    /** @name Methods for requesting solution of the linear system. */
+    //@{
+    /** Method for initializing internal stuctures.  Here, ndim gives
+     *  the number of rows and columns of the matrix, nonzeros give
+     *  the number of nonzero elements, and ia and ja give the
+     *  positions of the nonzero elements in compressed row format
+     *  (0-based, upper triangular part).
+     */
+    virtual ESymSolverStatus InitializeStructure(Index dim, Index nonzeros,
+        const Index *ia,
+        const Index *ja);
+
+    /** Remember the cache entry for the matrix structure.  The
+     *  symbolic analysis is then taken from the entry (or a file in
+     *  the cache directory) if it has been done before, and stored
+     *  there otherwise. */
+    virtual void SetSymbolicCacheEntry(const SmartPtr<SymbolicCacheEntry>& entry);
+
+    /** Method returing an internal array into which the nonzero
+     *  elements (in the same order as ja) are to be stored by the
+     *  calling routine before a call to MultiSolve with a
+     *  new_matrix=true.  The returned array must have space for at least
+     *  nonzero elements. */
+    virtual double* GetValuesArrayPtr();
+
+    /** Solve operation for multiple right hand sides.  Overloaded
+     *  from SparseSymLinearSolverInterface.
+     */
+    virtual ESymSolverStatus MultiSolve(bool new_matrix,
+                                        const Index* ia,
+                                        const Index* ja,
+                                        Index nrhs,
+                                        double* rhs_vals,
+                                        bool check_NegEVals,
+                                        Index numberOfNegEVals);
+
+    /** Number of negative eigenvalues detected during last
+     *  factorization.  Returns the number of negative eigenvalues of
+     *  the most recent factorized matrix.
+     */
+    virtual Index NumberOfNegEVals() const;
+    //@}
+
+    //* @name Options of Linear solver */
+    //@{
+    /** Request to increase quality of solution for next solve.
+     *  The pivot tolerance is increased, unless the maximal pivot
+     *  tolerance has already been used.
+     */
+    virtual bool IncreaseQuality();
+
+    /** Query whether inertia is computed by linear solver.
+     * Returns true, if linear solver provides inertia.
+     */
+    virtual bool ProvidesInertia() const
+    {
+      return true;
+    }
+    /** Query of requested matrix type that the linear solver
+     *  understands.
+     */
+    EMatrixFormat MatrixFormat() const
+    {
+      return CSR_Format_0_Offset;
+    }
+    //@}
+
+    /** Methods for IpoptType */
+    //@{
+    static void RegisterOptions(SmartPtr<RegisteredOptions> roptions);
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Copy Constructor */
+    NativeSolverInterface(const NativeSolverInterface&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const NativeSolverInterface&);
+    //@}
+
+    /** @name Information about the matrix */
+    //@{
+    /** Number of rows and columns of the matrix */
+    Index dim_;
+
+    /** Number of nonzeros of the matrix */
+    Index nonzeros_;
+
+    /** Array for storing the values of the matrix. */
+    double* a_;
+    //@}
+
+    /** @name Information about most recent factorization/solve */
+    //@{
+    /** Number of negative eigenvalues */
+    Index negevals_;
+    //@}
+
+    /** @name Initialization flags */
+    //@{
+    /** Flag indicating if internal data is initialized.
+     *  For initialization, this object needs to have seen a matrix */
+    bool initialized_;
+    /** Flag indicating if the matrix has to be refactorized because
+     *  the pivot tolerance has been changed. */
+    bool pivtol_changed_;
+    /** Flag that is true if we just requested the values of the
+     *  matrix again (SYMSOLVER_CALL_AGAIN) and have to factorize
+     *  again. */
+    bool refactorize_;
+    //@}
+
+    /** @name Solver specific data/options */
+    //@{
+    /** Pivot tolerance */
+    Number pivtol_;
+    /** Maximal pivot tolerance */
+    Number pivtolmax_;
+    /** Threshold below which pivots are considered to be zero */
+    Number small_pivot_;
+    /** Fill-reducing ordering */
+    NativeSymbolicFactorization::EOrdering ordering_;
+    /** Number of threads for the factorization (0 for the default) */
+    Index num_threads_;
+    /** Flag indicating whether the TNLP with identical structure has
+     *  already been solved before. */
+    bool warm_start_same_structure_;
+    //@}
+
+    /** Factorization object */
+    SmartPtr<NativeLDLFactorization> factorization_;
+
+    /** Entry of the symbolic factorization cache for the current
+     *  structure (NULL if the cache is not used) */
+    SmartPtr<SymbolicCacheEntry> cache_entry_;
+
+    /** @name Internal functions */
+    //@{
+    /** Call the numerical factorization and check the inertia. */
+    ESymSolverStatus Factorization(bool check_NegEVals,
+                                   Index numberOfNegEVals);
+
+    /** Obtain the symbolic analysis for the given structure, either
+     *  from the cache or by computing it. */
+    ESymSolverStatus GetSymbolicFactorization(const Index* ia,
+        const Index* ja,
+        SmartPtr<const NativeSymbolicFactorization>& symbolic);
+    //@}
+  };
+
+} // namespace Ipopt
+#endif
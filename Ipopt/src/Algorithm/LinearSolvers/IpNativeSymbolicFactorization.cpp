@@ -0,0 +1,555 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpNativeSymbolicFactorization.hpp"
+#include "IpNativeOrdering.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  /** Identification of files written by NativeSymbolicFactorization */
+  static const char native_symbolic_magic[] = "IpoptNativeSymbolic1";
+
+  /** Build the graph of the symmetrically permuted matrix. */
+  static void NativePermutedGraph(Index n, const std::vector<Index>& adj_ptr,
+                                  const std::vector<Index>& adj,
+                                  const std::vector<Index>& perm,
+                                  const std::vector<Index>& iperm,
+                                  std::vector<Index>& pptr,
+                                  std::vector<Index>& padj)
+  {
+    pptr.resize(n+1);
+    padj.resize(adj.size());
+    pptr[0] = 0;
+    for (Index k=0; k<n; k++) {
+      const Index old = perm[k];
+      Index pos = pptr[k];
+      for (Index p=adj_ptr[old]; p<adj_ptr[old+1]; p++) {
+        padj[pos++] = iperm[adj[p]];
+      }
+      pptr[k+1] = pos;
+    }
+  }
+
+  /** Write a vector in binary format (length followed by the data) */
+  template <class T>
+  static void NativeWriteVector(std::ostream& os, const std::vector<T>& v)
+  {
+    const Index len = (Index)v.size();
+    os.write((const char*)&len, sizeof(Index));
+    if (len > 0) {
+      os.write((const char*)&v[0], len*sizeof(T));
+    }
+  }
+
+  /** Read a vector written by NativeWriteVector */
+  template <class T>
+  static bool NativeReadVector(std::istream& is, std::vector<T>& v)
+  {
+    Index len;
+    if (!is.read((char*)&len, sizeof(Index)) || len < 0) {
+      return false;
+    }
+    v.resize(len);
+    if (len > 0) {
+      is.read((char*)&v[0], len*sizeof(T));
+    }
+    return !is.fail();
+  }
+
+  NativeSymbolicFactorization::NativeSymbolicFactorization()
+      :
+      dim_(0),
+      nonzeros_(0),
+      ordering_(AMD_ORDERING),
+      nsuper_(0),
+      nnz_factor_(0.),
+      flops_factor_(0.)
+  {
+    DBG_START_METH("NativeSymbolicFactorization::NativeSymbolicFactorization()",
+                   dbg_verbosity);
+  }
+
+  NativeSymbolicFactorization::~NativeSymbolicFactorization()
+  {
+    DBG_START_METH("NativeSymbolicFactorization::~NativeSymbolicFactorization()",
+                   dbg_verbosity);
+  }
+
+  ESymSolverStatus
+  NativeSymbolicFactorization::Analyze(Index dim, Index nonzeros,
+      const Index* ia,
+      const Index* ja,
+      EOrdering ordering)
+  {
+    DBG_START_METH("NativeSymbolicFactorization::Analyze",
+                   dbg_verbosity);
+
+    const Index n = dim;
+    dim_ = dim;
+    nonzeros_ = nonzeros;
+    nsuper_ = 0;
+    ordering_ = ordering;
+    nnz_factor_ = 0.;
+    flops_factor_ = 0.;
+    ia_.assign(1, 0);
+    ja_.clear();
+    perm_.resize(n);
+    sup_start_.assign(1, 0);
+    sup_parent_.clear();
+    sup_child_ptr_.assign(1, 0);
+    sup_child_.clear();
+    sup_row_ptr_.assign(1, 0);
+    sup_rows_.clear();
+    amap_ptr_.assign(1, 0);
+    amap_pos_.clear();
+    amap_row_.clear();
+    amap_col_.clear();
+    sup_work_.clear();
+
+    if (n == 0) {
+      return SYMSOLVER_SUCCESS;
+    }
+    if (ia[0] != 0 || ia[n] != nonzeros) {
+      return SYMSOLVER_FATAL_ERROR;
+    }
+    ia_.assign(ia, ia+n+1);
+    ja_.assign(ja, ja+nonzeros);
+
+    // Graph of the matrix without the diagonal
+    std::vector<Index> adj_ptr(n+1, 0);
+    for (Index i=0; i<n; i++) {
+      for (Index p=ia[i]; p<ia[i+1]; p++) {
+        const Index j = ja[p];
+        if (j < i || j >= n) {
+          return SYMSOLVER_FATAL_ERROR;
+        }
+        if (j != i) {
+          adj_ptr[i+1]++;
+          adj_ptr[j+1]++;
+        }
+      }
+    }
+    for (Index i=0; i<n; i++) {
+      adj_ptr[i+1] += adj_ptr[i];
+    }
+    std::vector<Index> adj(adj_ptr[n]);
+    {
+      std::vector<Index> pos(adj_ptr.begin(), adj_ptr.end()-1);
+      for (Index i=0; i<n; i++) {
+        for (Index p=ia[i]; p<ia[i+1]; p++) {
+          const Index j = ja[p];
+          if (j != i) {
+            adj[pos[i]++] = j;
+            adj[pos[j]++] = i;
+          }
+        }
+      }
+    }
+    const Index* adj_vals = adj.empty() ? NULL : &adj[0];
+
+    // Fill-reducing ordering
+    if (ordering == ND_ORDERING) {
+      NativeNestedDissectionOrdering(n, &adj_ptr[0], adj_vals, &perm_[0]);
+    }
+    else {
+      NativeAmdOrdering(n, &adj_ptr[0], adj_vals, &perm_[0]);
+    }
+    std::vector<Index> iperm(n);
+    for (Index k=0; k<n; k++) {
+      iperm[perm_[k]] = k;
+    }
+    std::vector<Index> pptr;
+    std::vector<Index> padj;
+    NativePermutedGraph(n, adj_ptr, adj, perm_, iperm, pptr, padj);
+
+    // Elimination tree (Liu's algorithm with path compression)
+    std::vector<Index> parent(n, -1);
+    {
+      std::vector<Index> ancestor(n, -1);
+      for (Index k=0; k<n; k++) {
+        for (Index p=pptr[k]; p<pptr[k+1]; p++) {
+          Index inext;
+          for (Index i=padj[p]; i != -1 && i < k; i = inext) {
+            inext = ancestor[i];
+            ancestor[i] = k;
+            if (inext == -1) {
+              parent[i] = k;
+            }
+          }
+        }
+      }
+    }
+
+    // Postorder the elimination tree and combine the permutations so
+    // that every subtree consists of consecutive columns
+    {
+      std::vector<Index> head(n, -1);
+      std::vector<Index> next(n, -1);
+      for (Index j=n-1; j>=0; j--) {
+        if (parent[j] != -1) {
+          next[j] = head[parent[j]];
+          head[parent[j]] = j;
+        }
+      }
+      std::vector<Index> post(n);
+      std::vector<Index> stack;
+      stack.reserve(n);
+      Index npost = 0;
+      for (Index j=0; j<n; j++) {
+        if (parent[j] != -1) {
+          continue;
+        }
+        stack.push_back(j);
+        while (!stack.empty()) {
+          const Index p = stack.back();
+          const Index i = head[p];
+          if (i == -1) {
+            stack.pop_back();
+            post[npost++] = p;
+          }
+          else {
+            head[p] = next[i];
+            stack.push_back(i);
+          }
+        }
+      }
+      DBG_ASSERT(npost == n);
+      std::vector<Index> ipost(n);
+      for (Index k=0; k<n; k++) {
+        ipost[post[k]] = k;
+      }
+      std::vector<Index> new_perm(n);
+      std::vector<Index> new_parent(n);
+      for (Index k=0; k<n; k++) {
+        new_perm[k] = perm_[post[k]];
+        const Index p = parent[post[k]];
+        new_parent[k] = (p == -1) ? -1 : ipost[p];
+      }
+      perm_.swap(new_perm);
+      parent.swap(new_parent);
+      for (Index k=0; k<n; k++) {
+        iperm[perm_[k]] = k;
+      }
+      NativePermutedGraph(n, adj_ptr, adj, perm_, iperm, pptr, padj);
+    }
+
+    // Column counts of L (including the diagonal) from the row subtrees
+    std::vector<Index> colcount(n, 1);
+    {
+      std::vector<Index> mark(n, -1);
+      for (Index i=0; i<n; i++) {
+        mark[i] = i;
+        for (Index p=pptr[i]; p<pptr[i+1]; p++) {
+          Index j = padj[p];
+          if (j > i) {
+            continue;
+          }
+          while (mark[j] != i) {
+            colcount[j]++;
+            mark[j] = i;
+            j = parent[j];
+          }
+        }
+      }
+    }
+
+    // Fundamental supernodes, amalgamated with their parents as long
+    // as not too many explicit zeros are introduced
+    std::vector<Index> nchild(n, 0);
+    for (Index j=0; j<n; j++) {
+      if (parent[j] != -1) {
+        nchild[parent[j]]++;
+      }
+    }
+    std::vector<Index> st_first;
+    std::vector<Index> st_last;
+    std::vector<double> st_nz;
+    Index jcol = 0;
+    while (jcol < n) {
+      Index first = jcol;
+      Index last = jcol;
+      double nz = colcount[jcol];
+      while (last+1 < n && parent[last] == last+1 &&
+             colcount[last] == colcount[last+1]+1 && nchild[last+1] == 1) {
+        last++;
+        nz += colcount[last];
+      }
+      jcol = last+1;
+      Index ncol = last-first+1;
+      const double nbelow = colcount[first]-ncol;
+      while (!st_first.empty()) {
+        const Index top = (Index)st_first.size()-1;
+        if (st_last[top]+1 != first) {
+          break;
+        }
+        const Index p = parent[st_last[top]];
+        if (p < first || p > last) {
+          break;
+        }
+        const Index ncol_new = ncol + st_last[top]-st_first[top]+1;
+        const double stored = 0.5*ncol_new*(ncol_new+1.) + ncol_new*nbelow;
+        const double zeros = stored - nz - st_nz[top];
+        const double frac = zeros/stored;
+        bool merge = ncol_new <= 4 ||
+                     (ncol_new <= 16 && frac < 0.8) ||
+                     (ncol_new <= 48 && frac < 0.1) ||
+                     frac < 0.05;
+        if (!merge) {
+          break;
+        }
+        first = st_first[top];
+        ncol = ncol_new;
+        nz += st_nz[top];
+        st_first.pop_back();
+        st_last.pop_back();
+        st_nz.pop_back();
+      }
+      st_first.push_back(first);
+      st_last.push_back(last);
+      st_nz.push_back(nz);
+    }
+
+    nsuper_ = (Index)st_first.size();
+    sup_start_.resize(nsuper_+1);
+    std::vector<Index> col2sup(n);
+    for (Index s=0; s<nsuper_; s++) {
+      sup_start_[s] = st_first[s];
+      for (Index j=st_first[s]; j<=st_last[s]; j++) {
+        col2sup[j] = s;
+      }
+    }
+    sup_start_[nsuper_] = n;
+
+    // Assembly tree
+    sup_parent_.resize(nsuper_);
+    sup_child_ptr_.assign(nsuper_+1, 0);
+    for (Index s=0; s<nsuper_; s++) {
+      const Index p = parent[sup_start_[s+1]-1];
+      sup_parent_[s] = (p == -1) ? -1 : col2sup[p];
+      DBG_ASSERT(sup_parent_[s] == -1 || sup_parent_[s] > s);
+      if (p != -1) {
+        sup_child_ptr_[sup_parent_[s]+1]++;
+      }
+    }
+    for (Index s=0; s<nsuper_; s++) {
+      sup_child_ptr_[s+1] += sup_child_ptr_[s];
+    }
+    sup_child_.resize(sup_child_ptr_[nsuper_]);
+    {
+      std::vector<Index> pos(sup_child_ptr_.begin(), sup_child_ptr_.end()-1);
+      for (Index s=0; s<nsuper_; s++) {
+        if (sup_parent_[s] != -1) {
+          sup_child_[pos[sup_parent_[s]]++] = s;
+        }
+      }
+    }
+
+    // Row structure of the supernodes
+    sup_row_ptr_.resize(nsuper_+1);
+    sup_work_.resize(nsuper_);
+    {
+      std::vector<Index> smark(n, -1);
+      sup_rows_.reserve(n);
+      for (Index s=0; s<nsuper_; s++) {
+        const Index first = sup_start_[s];
+        const Index last = sup_start_[s+1]-1;
+        for (Index j=first; j<=last; j++) {
+          smark[j] = s;
+          sup_rows_.push_back(j);
+        }
+        const Index ext_begin = (Index)sup_rows_.size();
+        for (Index j=first; j<=last; j++) {
+          for (Index p=pptr[j]; p<pptr[j+1]; p++) {
+            const Index i = padj[p];
+            if (i > last && smark[i] != s) {
+              smark[i] = s;
+              sup_rows_.push_back(i);
+            }
+          }
+        }
+        for (Index q=sup_child_ptr_[s]; q<sup_child_ptr_[s+1]; q++) {
+          const Index c = sup_child_[q];
+          const Index cbegin = sup_row_ptr_[c] + sup_start_[c+1]-sup_start_[c];
+          for (Index r=cbegin; r<sup_row_ptr_[c+1]; r++) {
+            const Index i = sup_rows_[r];
+            if (smark[i] != s) {
+              smark[i] = s;
+              sup_rows_.push_back(i);
+            }
+          }
+        }
+        std::sort(sup_rows_.begin()+ext_begin, sup_rows_.end());
+        sup_row_ptr_[s+1] = (Index)sup_rows_.size();
+
+        const Index ncol = last-first+1;
+        const Index nsym = sup_row_ptr_[s+1]-sup_row_ptr_[s];
+        double work = 0.;
+        for (Index q=0; q<ncol; q++) {
+          work += (double)(nsym-q)*(double)(nsym-q);
+        }
+        sup_work_[s] = work;
+        flops_factor_ += work;
+        nnz_factor_ += 0.5*ncol*(ncol+1.) + (double)ncol*(nsym-ncol);
+      }
+    }
+
+    // Assembly map for the original entries: entry (i,j) with i>=j
+    // (in the permuted numbering) belongs to the supernode of column j
+    amap_ptr_.assign(nsuper_+1, 0);
+    amap_pos_.resize(nonzeros);
+    amap_row_.resize(nonzeros);
+    amap_col_.resize(nonzeros);
+    for (Index i=0; i<n; i++) {
+      for (Index p=ia[i]; p<ia[i+1]; p++) {
+        const Index col = Min(iperm[i], iperm[ja[p]]);
+        amap_ptr_[col2sup[col]+1]++;
+      }
+    }
+    for (Index s=0; s<nsuper_; s++) {
+      amap_ptr_[s+1] += amap_ptr_[s];
+    }
+    {
+      std::vector<Index> pos(amap_ptr_.begin(), amap_ptr_.end()-1);
+      for (Index i=0; i<n; i++) {
+        for (Index p=ia[i]; p<ia[i+1]; p++) {
+          const Index pi = iperm[i];
+          const Index pj = iperm[ja[p]];
+          const Index col = Min(pi, pj);
+          const Index q = pos[col2sup[col]]++;
+          amap_pos_[q] = p;
+          amap_row_[q] = Max(pi, pj);
+          amap_col_[q] = col;
+        }
+      }
+      std::vector<Index> local(n);
+      for (Index s=0; s<nsuper_; s++) {
+        for (Index r=sup_row_ptr_[s]; r<sup_row_ptr_[s+1]; r++) {
+          local[sup_rows_[r]] = r-sup_row_ptr_[s];
+        }
+        for (Index q=amap_ptr_[s]; q<amap_ptr_[s+1]; q++) {
+          amap_row_[q] = local[amap_row_[q]];
+          amap_col_[q] -= sup_start_[s];
+        }
+      }
+    }
+
+    return SYMSOLVER_SUCCESS;
+  }
+
+  bool NativeSymbolicFactorization::Matches(Index dim, Index nonzeros,
+      const Index* ia,
+      const Index* ja,
+      EOrdering ordering) const
+  {
+    if (dim != dim_ || nonzeros != nonzeros_ || ordering != ordering_) {
+      return false;
+    }
+    if (dim == 0) {
+      return true;
+    }
+    return std::equal(ia_.begin(), ia_.end(), ia) &&
+           std::equal(ja_.begin(), ja_.end(), ja);
+  }
+
+  bool NativeSymbolicFactorization::Write(std::ostream& os) const
+  {
+    DBG_START_METH("NativeSymbolicFactorization::Write", dbg_verbosity);
+
+    os.write(native_symbolic_magic, sizeof(native_symbolic_magic));
+    const Index header[5] = {(Index)sizeof(Index), dim_, nonzeros_,
+                             (Index)ordering_, nsuper_
+                            };
+    os.write((const char*)header, sizeof(header));
+    os.write((const char*)&nnz_factor_, sizeof(double));
+    os.write((const char*)&flops_factor_, sizeof(double));
+    NativeWriteVector(os, ia_);
+    NativeWriteVector(os, ja_);
+    NativeWriteVector(os, perm_);
+    NativeWriteVector(os, sup_start_);
+    NativeWriteVector(os, sup_parent_);
+    NativeWriteVector(os, sup_child_ptr_);
+    NativeWriteVector(os, sup_child_);
+    NativeWriteVector(os, sup_row_ptr_);
+    NativeWriteVector(os, sup_rows_);
+    NativeWriteVector(os, amap_ptr_);
+    NativeWriteVector(os, amap_pos_);
+    NativeWriteVector(os, amap_row_);
+    NativeWriteVector(os, amap_col_);
+    NativeWriteVector(os, sup_work_);
+    return !os.fail();
+  }
+
+  bool NativeSymbolicFactorization::Read(std::istream& is)
+  {
+    DBG_START_METH("NativeSymbolicFactorization::Read", dbg_verbosity);
+
+    char magic[sizeof(native_symbolic_magic)];
+    if (!is.read(magic, sizeof(magic)) ||
+        memcmp(magic, native_symbolic_magic, sizeof(magic)) != 0) {
+      return false;
+    }
+    Index header[5];
+    if (!is.read((char*)header, sizeof(header)) ||
+        header[0] != (Index)sizeof(Index) || header[1] < 0 || header[2] < 0 ||
+        (header[3] != AMD_ORDERING && header[3] != ND_ORDERING) ||
+        header[4] < 0) {
+      return false;
+    }
+    dim_ = header[1];
+    nonzeros_ = header[2];
+    ordering_ = EOrdering(header[3]);
+    nsuper_ = header[4];
+    is.read((char*)&nnz_factor_, sizeof(double));
+    is.read((char*)&flops_factor_, sizeof(double));
+    bool ok = !is.fail() &&
+              NativeReadVector(is, ia_) &&
+              NativeReadVector(is, ja_) &&
+              NativeReadVector(is, perm_) &&
+              NativeReadVector(is, sup_start_) &&
+              NativeReadVector(is, sup_parent_) &&
+              NativeReadVector(is, sup_child_ptr_) &&
+              NativeReadVector(is, sup_child_) &&
+              NativeReadVector(is, sup_row_ptr_) &&
+              NativeReadVector(is, sup_rows_) &&
+              NativeReadVector(is, amap_ptr_) &&
+              NativeReadVector(is, amap_pos_) &&
+              NativeReadVector(is, amap_row_) &&
+              NativeReadVector(is, amap_col_) &&
+              NativeReadVector(is, sup_work_);
+
+    // Consistency of the sizes
+    const size_t n = dim_;
+    const size_t ns = nsuper_;
+    ok = ok && ia_.size() == n+1 && ja_.size() == (size_t)nonzeros_ &&
+         perm_.size() == n && sup_start_.size() == ns+1 &&
+         sup_parent_.size() == ns && sup_child_ptr_.size() == ns+1 &&
+         sup_row_ptr_.size() == ns+1 && amap_ptr_.size() == ns+1 &&
+         amap_pos_.size() == (size_t)nonzeros_ &&
+         amap_row_.size() == (size_t)nonzeros_ &&
+         amap_col_.size() == (size_t)nonzeros_ && sup_work_.size() == ns &&
+         (Index)sup_rows_.size() == sup_row_ptr_[ns] &&
+         (Index)sup_child_.size() == sup_child_ptr_[ns];
+    if (!ok) {
+      dim_ = 0;
+      nonzeros_ = 0;
+      nsuper_ = 0;
+      return false;
+    }
+    return true;
+  }
+
+} // namespace Ipopt
@@ -0,0 +1,164 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPNATIVESYMBOLICFACTORIZATION_HPP__
+#define __IPNATIVESYMBOLICFACTORIZATION_HPP__
+
+#include "IpUtils.hpp"
+#include "IpReferenced.hpp"
+#include "IpSymLinearSolver.hpp"
+
+#include <vector>
+#include <iosfwd>
+
+namespace Ipopt
+{
+
+  /** Symbolic analysis for the native sparse LDL^T solver.
+   *
+   *  For a given nonzero structure, this computes a fill-reducing
+   *  ordering, the elimination tree, relaxed supernodes and their row
+   *  structure, and the maps for the assembly of the original entries
+   *  into the frontal matrices.  The result depends only on the
+   *  structure of the matrix.  It is not modified by the numerical
+   *  factorization (see NativeLDLFactorization), so that one object
+   *  can be shared by several factorizations, kept in a
+   *  SymbolicFactorizationCache, and written to a file.
+   *
+   *  The matrix structure is given in the CSR_Format_0_Offset format
+   *  of SparseSymLinearSolverInterface, i.e., row i lists the column
+   *  indices j>=i of the upper triangular part (0-based).
+   */
+  class NativeSymbolicFactorization: public ReferencedObject
+  {
+  public:
+    /** Fill-reducing orderings available for the symbolic phase. */
+    enum EOrdering {
+      /** Approximate minimum degree */
+      AMD_ORDERING=0,
+      /** Nested dissection */
+      ND_ORDERING
+    };
+
+    /** @name Constructor/Destructor */
+    //@{
+    NativeSymbolicFactorization();
+
+    virtual ~NativeSymbolicFactorization();
+    //@}
+
+    /** Symbolic analysis for a matrix with dimension dim and the
+     *  given nonzero structure.  Returns SYMSOLVER_FATAL_ERROR if the
+     *  structure is invalid. */
+    ESymSolverStatus Analyze(Index dim, Index nonzeros,
+                             const Index* ia, const Index* ja,
+                             EOrdering ordering);
+
+    /** Check whether this analysis has been done for the given
+     *  structure and ordering. */
+    bool Matches(Index dim, Index nonzeros, const Index* ia,
+                 const Index* ja, EOrdering ordering) const;
+
+    /** @name Methods for storing the analysis in a file.  The binary
+     *  format is only meant to be read on the same platform. */
+    //@{
+    /** Write the analysis to the stream.  Returns false if writing
+     *  failed. */
+    bool Write(std::ostream& os) const;
+    /** Read an analysis written by Write.  Returns false if the
+     *  stream does not contain a valid analysis. */
+    bool Read(std::istream& is);
+    //@}
+
+    /** @name Information about the analysis */
+    //@{
+    /** Dimension of the matrix. */
+    Index Dim() const
+    {
+      return dim_;
+    }
+    /** Number of supernodes in the assembly tree. */
+    Index NumberOfSupernodes() const
+    {
+      return nsuper_;
+    }
+    /** Number of nonzeros in L predicted by the symbolic analysis
+     *  (including the diagonal). */
+    double PredictedNonzerosInFactor() const
+    {
+      return nnz_factor_;
+    }
+    /** Number of floating point operations for the factorization
+     *  predicted by the symbolic analysis. */
+    double PredictedFlops() const
+    {
+      return flops_factor_;
+    }
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Copy Constructor */
+    NativeSymbolicFactorization(const NativeSymbolicFactorization&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const NativeSymbolicFactorization&);
+    //@}
+
+    /** The numerical factorization works directly on the data */
+    friend class NativeLDLFactorization;
+
+    /** Dimension of the matrix */
+    Index dim_;
+    /** Number of nonzeros in the CSR structure */
+    Index nonzeros_;
+    /** Ordering used for the analysis */
+    EOrdering ordering_;
+    /** Copy of the CSR structure */
+    std::vector<Index> ia_;
+    std::vector<Index> ja_;
+    /** Permutation: perm_[k] is the original index of the k-th pivot */
+    std::vector<Index> perm_;
+    /** Number of supernodes */
+    Index nsuper_;
+    /** First (permuted) column of each supernode (size nsuper_+1) */
+    std::vector<Index> sup_start_;
+    /** Parent of each supernode in the assembly tree (-1 for roots) */
+    std::vector<Index> sup_parent_;
+    /** Children of each supernode: sup_child_[sup_child_ptr_[s]] ... */
+    std::vector<Index> sup_child_ptr_;
+    std::vector<Index> sup_child_;
+    /** Row structure of each supernode (permuted indices; the
+     *  supernode's own columns come first) */
+    std::vector<Index> sup_row_ptr_;
+    std::vector<Index> sup_rows_;
+    /** Assembly map for the original entries of each supernode:
+     *  position in the value array, row in the (undelayed) front, and
+     *  column in the front. */
+    std::vector<Index> amap_ptr_;
+    std::vector<Index> amap_pos_;
+    std::vector<Index> amap_row_;
+    std::vector<Index> amap_col_;
+    /** Estimated work for the factorization of each supernode */
+    std::vector<double> sup_work_;
+    /** Predicted number of nonzeros in L */
+    double nnz_factor_;
+    /** Predicted number of floating point operations */
+    double flops_factor_;
+  };
+
+} // namespace Ipopt
+
+#endif
@@ -12,6 +12,7 @@
 #include "IpUtils.hpp"
 #include "IpAlgStrategy.hpp"
 #include "IpSymLinearSolver.hpp"
+#include "IpSymbolicFactorizationCache.hpp"
 
 namespace Ipopt
 {
@@ -140,6 +141,15 @@ namespace Ipopt
         const Index* ia,
         const Index* ja) = 0;
 
+    /** Give the solver the entry of the SymbolicFactorizationCache
+     *  for the current matrix structure.  This is called (if the
+     *  cache is enabled) before InitializeStructure.  A solver can
+     *  store the result of its symbolic analysis in the entry, or
+     *  reuse the result of an earlier analysis for the same
+     *  structure.  The default implementation ignores the entry. */
+    virtual void SetSymbolicCacheEntry(const SmartPtr<SymbolicCacheEntry>& entry)
+    {}
+
     /** Method returing an internal array into which the nonzero
      *  elements (in the same order as ja) will be stored by the
      *  calling routine before a call to MultiSolve with a
@@ -0,0 +1,211 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpSymbolicFactorizationCache.hpp"
+#include "IpDebug.hpp"
+
+#include <algorithm>
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  SymbolicCacheEntry::SymbolicCacheEntry(unsigned long hash, Index dim,
+                                         Index nonzeros,
+                                         const Index* airn,
+                                         const Index* ajcn,
+                                         const std::string& directory)
+      :
+      hash_(hash),
+      dim_(dim),
+      nonzeros_(nonzeros),
+      airn_(airn, airn+nonzeros),
+      ajcn_(ajcn, ajcn+nonzeros),
+      directory_(directory)
+  {
+    DBG_START_METH("SymbolicCacheEntry::SymbolicCacheEntry()", dbg_verbosity);
+  }
+
+  SymbolicCacheEntry::~SymbolicCacheEntry()
+  {
+    DBG_START_METH("SymbolicCacheEntry::~SymbolicCacheEntry()", dbg_verbosity);
+  }
+
+  bool SymbolicCacheEntry::Matches(unsigned long hash, Index dim,
+                                   Index nonzeros,
+                                   const Index* airn,
+                                   const Index* ajcn) const
+  {
+    if (hash != hash_ || dim != dim_ || nonzeros != nonzeros_) {
+      return false;
+    }
+    return std::equal(airn_.begin(), airn_.end(), airn) &&
+           std::equal(ajcn_.begin(), ajcn_.end(), ajcn);
+  }
+
+  SmartPtr<ReferencedObject>
+  SymbolicCacheEntry::Find(const std::string& key) const
+  {
+    SpinLockGuard guard(lock_);
+    std::map<std::string, SmartPtr<ReferencedObject> >::const_iterator it =
+      data_.find(key);
+    if (it == data_.end()) {
+      return NULL;
+    }
+    return it->second;
+  }
+
+  void SymbolicCacheEntry::Store(const std::string& key,
+                                 const SmartPtr<ReferencedObject>& data)
+  {
+    SpinLockGuard guard(lock_);
+    data_[key] = data;
+  }
+
+  std::string SymbolicCacheEntry::FileName(const std::string& key) const
+  {
+    if (directory_.empty()) {
+      return "";
+    }
+    char buffer[64];
+    Snprintf(buffer, 63, "_%d_%d_%08lx.sym", dim_, nonzeros_, hash_);
+    std::string name = directory_;
+    if (name[name.size()-1] != '/' && name[name.size()-1] != '\\') {
+      name += '/';
+    }
+    name += "ipopt_" + key + buffer;
+    return name;
+  }
+
+  SymbolicFactorizationCache::SymbolicFactorizationCache(const std::string& directory,
+      Index max_entries)
+      :
+      max_entries_(max_entries),
+      directory_(directory),
+      hits_(0),
+      misses_(0)
+  {
+    DBG_START_METH("SymbolicFactorizationCache::SymbolicFactorizationCache()",
+                   dbg_verbosity);
+    DBG_ASSERT(max_entries > 0);
+  }
+
+  SymbolicFactorizationCache::~SymbolicFactorizationCache()
+  {
+    DBG_START_METH("SymbolicFactorizationCache::~SymbolicFactorizationCache()",
+                   dbg_verbosity);
+  }
+
+  /** The caches of the process, by directory and maximal number of
+   *  entries.  The map and its lock are created during the static
+   *  initialization, so that this cannot happen in several threads at
+   *  once. */
+  typedef std::map<std::pair<std::string, Index>,
+  SmartPtr<SymbolicFactorizationCache> > SymbolicCacheMap;
+  static SymbolicCacheMap symbolic_caches;
+  static SpinLock symbolic_caches_lock;
+
+  SmartPtr<SymbolicFactorizationCache>
+  SymbolicFactorizationCache::GetCache(const std::string& directory,
+                                       Index max_entries)
+  {
+    SpinLockGuard guard(symbolic_caches_lock);
+    SmartPtr<SymbolicFactorizationCache>& cache =
+      symbolic_caches[std::make_pair(directory, max_entries)];
+    if (IsNull(cache)) {
+      cache = new SymbolicFactorizationCache(directory, max_entries);
+    }
+    return cache;
+  }
+
+  unsigned long
+  SymbolicFactorizationCache::StructureHash(Index dim, Index nonzeros,
+      const Index* airn,
+      const Index* ajcn)
+  {
+    // FNV-1a on the 32 bit words of the structure
+    unsigned long hash = 2166136261UL;
+    const unsigned long prime = 16777619UL;
+    hash = ((hash ^ (unsigned long)dim) * prime) & 0xffffffffUL;
+    hash = ((hash ^ (unsigned long)nonzeros) * prime) & 0xffffffffUL;
+    for (Index i=0; i<nonzeros; i++) {
+      hash = ((hash ^ (unsigned long)airn[i]) * prime) & 0xffffffffUL;
+      hash = ((hash ^ (unsigned long)ajcn[i]) * prime) & 0xffffffffUL;
+    }
+    return hash;
+  }
+
+  SmartPtr<SymbolicCacheEntry>
+  SymbolicFactorizationCache::GetEntry(Index dim, Index nonzeros,
+                                       const Index* airn,
+                                       const Index* ajcn)
+  {
+    DBG_START_METH("SymbolicFactorizationCache::GetEntry", dbg_verbosity);
+
+    // The structures are hashed and compared without holding the
+    // lock, since this is O(nonzeros).  Under the lock, only the
+    // entries with the same hash are collected, and the matching
+    // entry is moved to the front of the list.
+    const unsigned long hash = StructureHash(dim, nonzeros, airn, ajcn);
+    std::vector<SmartPtr<SymbolicCacheEntry> > candidates;
+    std::list<SmartPtr<SymbolicCacheEntry> >::iterator it;
+    {
+      SpinLockGuard guard(lock_);
+      for (it = entries_.begin(); it != entries_.end(); it++) {
+        if ((*it)->Hash() == hash && (*it)->Dim() == dim &&
+            (*it)->Nonzeros() == nonzeros) {
+          candidates.push_back(*it);
+        }
+      }
+    }
+
+    SmartPtr<SymbolicCacheEntry> entry;
+    for (size_t i=0; i<candidates.size(); i++) {
+      if (candidates[i]->Matches(hash, dim, nonzeros, airn, ajcn)) {
+        entry = candidates[i];
+        break;
+      }
+    }
+
+    if (IsValid(entry)) {
+      SpinLockGuard guard(lock_);
+      hits_++;
+      // Move to the front of the list, unless the entry has been
+      // removed by another thread in the meantime
+      for (it = entries_.begin(); it != entries_.end(); it++) {
+        if (GetRawPtr(*it) == GetRawPtr(entry)) {
+          entries_.erase(it);
+          entries_.push_front(entry);
+          break;
+        }
+      }
+      return entry;
+    }
+
+    // If another thread adds the same structure in the meantime, the
+    // cache holds two entries for it; the older one is eventually
+    // removed as the least recently used entry.
+    entry = new SymbolicCacheEntry(hash, dim, nonzeros, airn, ajcn, directory_);
+    SpinLockGuard guard(lock_);
+    misses_++;
+    entries_.push_front(entry);
+    while ((Index)entries_.size() > max_entries_) {
+      entries_.pop_back();
+    }
+    return entry;
+  }
+
+  void SymbolicFactorizationCache::Clear()
+  {
+    SpinLockGuard guard(lock_);
+    entries_.clear();
+  }
+
+} // namespace Ipopt
@@ -0,0 +1,227 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPSYMBOLICFACTORIZATIONCACHE_HPP__
+#define __IPSYMBOLICFACTORIZATIONCACHE_HPP__
+
+#include "IpUtils.hpp"
+#include "IpReferenced.hpp"
+#include "IpSmartPtr.hpp"
+#include "IpAtomic.hpp"
+
+#include <vector>
+#include <list>
+#include <map>
+#include <string>
+
+namespace Ipopt
+{
+
+  /** Entry of the SymbolicFactorizationCache for one sparsity
+   *  structure of a matrix in triplet format.  Besides the structure
+   *  itself (which is used to verify a match), an entry holds the
+   *  structure-dependent data that has been computed for this
+   *  structure by the linear solvers, identified by a string key
+   *  (e.g., the compressed structure, or the ordering and supernodes
+   *  of a sparse factorization).
+   */
+  class SymbolicCacheEntry: public ReferencedObject
+  {
+  public:
+    /** @name Constructor/Destructor */
+    //@{
+    /** Constructor for the triplet structure airn, ajcn with the
+     *  given dimension and number of nonzeros.  hash is the value of
+     *  SymbolicFactorizationCache::StructureHash for this structure,
+     *  and directory the directory of the files for this entry (empty
+     *  if nothing is written to disk). */
+    SymbolicCacheEntry(unsigned long hash, Index dim, Index nonzeros,
+                       const Index* airn, const Index* ajcn,
+                       const std::string& directory);
+
+    virtual ~SymbolicCacheEntry();
+    //@}
+
+    /** Check whether this entry is for the given structure. */
+    bool Matches(unsigned long hash, Index dim, Index nonzeros,
+                 const Index* airn, const Index* ajcn) const;
+
+    /** Return the data stored for key, or NULL if there is none. */
+    SmartPtr<ReferencedObject> Find(const std::string& key) const;
+
+    /** Store data for key, overwriting previous data for this key. */
+    void Store(const std::string& key, const SmartPtr<ReferencedObject>& data);
+
+    /** Name of the file in which data for key can be stored
+     *  persistently.  Returns an empty string if the cache has no
+     *  directory. */
+    std::string FileName(const std::string& key) const;
+
+    /** @name Accessor methods */
+    //@{
+    unsigned long Hash() const
+    {
+      return hash_;
+    }
+    Index Dim() const
+    {
+      return dim_;
+    }
+    Index Nonzeros() const
+    {
+      return nonzeros_;
+    }
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Default Constructor */
+    SymbolicCacheEntry();
+
+    /** Copy Constructor */
+    SymbolicCacheEntry(const SymbolicCacheEntry&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const SymbolicCacheEntry&);
+    //@}
+
+    /** Hash value of the structure */
+    unsigned long hash_;
+    /** Dimension of the matrix */
+    Index dim_;
+    /** Number of nonzeros in triplet format */
+    Index nonzeros_;
+    /** Copy of the triplet structure */
+    std::vector<Index> airn_;
+    std::vector<Index> ajcn_;
+    /** Directory for the files of this entry */
+    std::string directory_;
+    /** Data stored by the solvers */
+    std::map<std::string, SmartPtr<ReferencedObject> > data_;
+    /** Lock for data_, since the entry can be used by solvers in
+     *  several threads */
+    mutable SpinLock lock_;
+  };
+
+  /** Cache for structure-dependent data of the linear solvers.
+   *
+   *  The symbolic phase of a sparse factorization (conversion to the
+   *  compressed format, fill-reducing ordering, supernode analysis)
+   *  depends only on the sparsity structure of the matrix.  When the
+   *  same problem structure is solved repeatedly, e.g., by several
+   *  calls of IpoptApplication::OptimizeTNLP or ReOptimizeTNLP, this
+   *  work can be reused.  TSymLinearSolver looks up the triplet
+   *  structure of the matrix in this cache (see
+   *  TripletHelper::FillRowCol) and hands the resulting
+   *  SymbolicCacheEntry to the solver interface.
+   *
+   *  The cache keeps the most recently used entries up to a maximal
+   *  number.  If a directory is given, solvers can in addition write
+   *  their data to files in that directory so that it can be reused
+   *  by later runs.  Both are fixed when the cache is created.
+   *
+   *  There is one cache per directory and maximal number of entries,
+   *  shared by all IpoptApplications of the process that use these
+   *  settings (see GetCache), so that the methods of the cache and of
+   *  its entries are protected by a lock.  The data stored in the
+   *  entries must not be changed after it has been stored.
+   */
+  class SymbolicFactorizationCache: public ReferencedObject
+  {
+  public:
+    /** @name Constructor/Destructor */
+    //@{
+    /** Constructor, given the directory for persistent data (empty to
+     *  keep the data only in memory) and the maximal number of
+     *  entries kept in memory. */
+    SymbolicFactorizationCache(const std::string& directory,
+                               Index max_entries);
+
+    virtual ~SymbolicFactorizationCache();
+    //@}
+
+    /** The cache with the given directory and maximal number of
+     *  entries that is shared by all solvers of this process.  It is
+     *  created by the first call with these settings. */
+    static SmartPtr<SymbolicFactorizationCache>
+    GetCache(const std::string& directory, Index max_entries);
+
+    /** Hash value of a triplet structure. */
+    static unsigned long StructureHash(Index dim, Index nonzeros,
+                                       const Index* airn, const Index* ajcn);
+
+    /** Return the entry for the given triplet structure.  If the
+     *  structure is not yet in the cache, a new (empty) entry is
+     *  created, and the least recently used entry is removed if the
+     *  cache is full. */
+    SmartPtr<SymbolicCacheEntry> GetEntry(Index dim, Index nonzeros,
+                                          const Index* airn,
+                                          const Index* ajcn);
+
+    /** Remove all entries. */
+    void Clear();
+
+    /** @name Statistics */
+    //@{
+    Index NumberOfEntries() const
+    {
+      return (Index)entries_.size();
+    }
+    Index NumberOfHits() const
+    {
+      return hits_;
+    }
+    Index NumberOfMisses() const
+    {
+      return misses_;
+    }
+    //@}
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Default Constructor */
+    SymbolicFactorizationCache();
+
+    /** Copy Constructor */
+    SymbolicFactorizationCache(const SymbolicFactorizationCache&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const SymbolicFactorizationCache&);
+    //@}
+
+    /** Entries, most recently used first */
+    std::list<SmartPtr<SymbolicCacheEntry> > entries_;
+    /** Maximal number of entries */
+    const Index max_entries_;
+    /** Directory for persistent data */
+    const std::string directory_;
+    /** Number of successful lookups */
+    Index hits_;
+    /** Number of lookups that created a new entry */
+    Index misses_;
+    /** Lock for entries_ and the statistics */
+    mutable SpinLock lock_;
+  };
+
+} // namespace Ipopt
+
+#endif
@@ -60,6 +60,34 @@ namespace Ipopt
       "Choosing \"yes\" means that the algorithm will start the scaling "
       "method only when the solutions to the linear system seem not good, and "
       "then use it until the end.");
+    roptions->AddStringOption2(
+      "symbolic_cache",
+      "Enables the reuse of the symbolic factorization for identical matrix structures.",
+      "no",
+      "no", "Compute the symbolic factorization for every new problem.",
+      "yes", "Reuse the symbolic factorization of an earlier problem with the same structure.",
+      "If enabled, the structure-dependent data of the linear solver (the "
+      "compressed matrix format and, for the native solver, the "
+      "fill-reducing ordering and supernodes) is kept in a cache and "
+      "reused when a matrix with identical sparsity structure is "
+      "encountered again, e.g., in subsequent calls of OptimizeTNLP or "
+      "ReOptimizeTNLP.");
+    roptions->AddStringOption1(
+      "symbolic_cache_dir",
+      "Directory for storing symbolic factorizations.",
+      "",
+      "*", "Any acceptable directory name",
+      "If given and symbolic_cache is enabled, the symbolic factorizations "
+      "of the native linear solver are also written to files in this "
+      "directory, so that they can be reused in later runs.  The files are "
+      "only meant to be read on the same platform.");
+    roptions->AddLowerBoundedIntegerOption(
+      "symbolic_cache_max_entries",
+      "Maximal number of matrix structures kept in the symbolic factorization cache.",
+      1, 16,
+      "If more structures are encountered, the least recently used one is "
+      "removed from the cache.  Solvers with different values of this option "
+      "or of symbolic_cache_dir use separate caches.");
   }
 
   bool TSymLinearSolver::InitializeImpl(const OptionsList& options,
@@ -75,6 +103,22 @@ namespace Ipopt
     // This option is registered by OrigIpoptNLP
     options.GetBoolValue("warm_start_same_structure",
                          warm_start_same_structure_, prefix);
+    bool use_cache;
+    options.GetBoolValue("symbolic_cache", use_cache, prefix);
+    if (use_cache) {
+      // Solvers with different cache settings use different caches,
+      // so that they do not change each other's settings
+      std::string cache_dir;
+      options.GetStringValue("symbolic_cache_dir", cache_dir, prefix);
+      Index max_entries;
+      options.GetIntegerValue("symbolic_cache_max_entries", max_entries,
+                              prefix);
+      symbolic_cache_ =
+        SymbolicFactorizationCache::GetCache(cache_dir, max_entries);
+    }
+    else {
+      symbolic_cache_ = NULL;
+    }
 
     bool retval;
     if (HaveIpData()) {
@@ -311,6 +355,14 @@ namespace Ipopt
 
       TripletHelper::FillRowCol(nonzeros_triplet_, sym_A, airn_, ajcn_);
 
+      // Look up the structure in the cache of symbolic factorizations
+      SmartPtr<SymbolicCacheEntry> cache_entry;
+      if (IsValid(symbolic_cache_)) {
+        cache_entry = symbolic_cache_->GetEntry(dim_, nonzeros_triplet_,
+                                                airn_, ajcn_);
+        solver_interface_->SetSymbolicCacheEntry(cache_entry);
+      }
+
       // If the solver wants the compressed format, the converter has to
       // be initialized
       const Index *ia;
@@ -326,9 +378,34 @@ namespace Ipopt
           IpData().TimingStats().LinearSystemStructureConverter().Start();
           IpData().TimingStats().LinearSystemStructureConverterInit().Start();
         }
-        nonzeros_compressed_ =
-          triplet_to_csr_converter_->InitializeConverter(dim_, nonzeros_triplet_,
-              airn_, ajcn_);
+        // A converter for the same structure and format can be taken
+        // from the cache, since it is not changed after its
+        // initialization
+        std::string converter_key;
+        SmartPtr<TripletToCSRConverter> cached_converter;
+        if (IsValid(cache_entry)) {
+          char buffer[16];
+          Snprintf(buffer, 15, "csr%d", (int)matrix_format_);
+          converter_key = buffer;
+          SmartPtr<ReferencedObject> data = cache_entry->Find(converter_key);
+          if (IsValid(data)) {
+            cached_converter =
+              static_cast<TripletToCSRConverter*>(GetRawPtr(data));
+          }
+        }
+        if (IsValid(cached_converter)) {
+          triplet_to_csr_converter_ = cached_converter;
+          nonzeros_compressed_ = triplet_to_csr_converter_->NonzerosCompressed();
+        }
+        else {
+          nonzeros_compressed_ =
+            triplet_to_csr_converter_->InitializeConverter(dim_, nonzeros_triplet_,
+                airn_, ajcn_);
+          if (IsValid(cache_entry)) {
+            cache_entry->Store(converter_key,
+                               GetRawPtr(triplet_to_csr_converter_));
+          }
+        }
         if (HaveIpData()) {
           IpData().TimingStats().LinearSystemStructureConverterInit().End();
         }
@@ -424,6 +501,19 @@ namespace Ipopt
     double* pa = solver_interface_->GetValuesArrayPtr();
     double* atriplet;
 
+    if (matrix_format_!=SparseSymLinearSolverInterface::Triplet_Format &&
+        !use_scaling_ && !(DBG_VERBOSITY()>=3) &&
+        triplet_to_csr_converter_->AssemblyPositions()) {
+      // Without scaling, the values can be written directly into the
+      // compressed array of the solver, without the values in triplet
+      // format
+      IpData().TimingStats().LinearSystemStructureConverter().Start();
+      TripletHelper::FillValues(nonzeros_triplet_, sym_A, pa,
+                                triplet_to_csr_converter_->AssemblyPositions());
+      IpData().TimingStats().LinearSystemStructureConverter().End();
+      return;
+    }
+
     if (matrix_format_!=SparseSymLinearSolverInterface::Triplet_Format) {
       atriplet = new double[nonzeros_triplet_];
     }
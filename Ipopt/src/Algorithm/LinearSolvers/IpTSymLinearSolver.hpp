@@ -183,6 +183,9 @@ namespace Ipopt
      *  format.  This is only required if the linear solver works with
      *  the compressed representation. */
     SmartPtr<TripletToCSRConverter> triplet_to_csr_converter_;
+    /** Cache for the symbolic factorizations (NULL if the cache is
+     *  not used). */
+    SmartPtr<SymbolicFactorizationCache> symbolic_cache_;
     /** Flag indicating what matrix data format the solver requires. */
     SparseSymLinearSolverInterface::EMatrixFormat matrix_format_;
     //@}
@@ -7,7 +7,7 @@
 // Authors:  Carl Laird, Andreas Waechter     IBM    2005-03-13
 
 #include "IpTripletToCSRConverter.hpp"
-#include <list>
+#include <vector>
 
 #ifdef HAVE_CSTDDEF
 # include <cstddef>
@@ -19,12 +19,104 @@
 # endif
 #endif
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 namespace Ipopt
 {
 #if COIN_IPOPT_VERBOSITY > 0
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Minimal number of triplet entries for which the conversion is
+   *  done with several threads. */
+  static const Index csr_parallel_nonzeros = 100000;
+
+  /** Number of threads used for a matrix with the given number of
+   *  triplet entries. */
+  static Index CSRNumThreads(Index nonzeros)
+  {
+#ifdef _OPENMP
+    if (nonzeros >= csr_parallel_nonzeros) {
+      return omp_get_max_threads();
+    }
+#endif
+    return 1;
+  }
+
+  /** Stable counting sort of the n positions in perm_in by their keys
+   *  key[perm_in[k]], which are between 0 and nkeys-1.  The sorted
+   *  positions are returned in perm_out, and key_start (of length
+   *  nkeys+1) returns the start of the positions for each key in
+   *  perm_out.  With nthreads>1, perm_in is split into contiguous
+   *  blocks, which are counted and distributed concurrently. */
+  static void CSRCountingSort(Index n, const Index* perm_in, const Index* key,
+                              Index nkeys, Index nthreads,
+                              Index* perm_out, Index* key_start)
+  {
+    // Each thread needs counters for all keys; limit the memory for
+    // them to the size of the arrays
+    nthreads = Max(Index(1), Min(nthreads, n/Max(Index(1), nkeys)));
+
+    if (nthreads == 1) {
+      for (Index j=0; j<=nkeys; j++) {
+        key_start[j] = 0;
+      }
+      for (Index k=0; k<n; k++) {
+        key_start[key[perm_in[k]]+1]++;
+      }
+      for (Index j=0; j<nkeys; j++) {
+        key_start[j+1] += key_start[j];
+      }
+      std::vector<Index> next(key_start, key_start+nkeys);
+      for (Index k=0; k<n; k++) {
+        const Index p = perm_in[k];
+        perm_out[next[key[p]]++] = p;
+      }
+      return;
+    }
+
+    // count[t*nkeys+j] is first the number of entries with key j in
+    // the block of thread t, and then the next position for them
+    std::vector<Index> count((size_t)nthreads*(size_t)nkeys, 0);
+    const Index blk = n/nthreads;
+    const Index rem = n%nthreads;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (Index t=0; t<nthreads; t++) {
+      const Index kbeg = t*blk + Min(t, rem);
+      const Index kend = kbeg + blk + (t<rem ? 1 : 0);
+      Index* cnt = &count[(size_t)t*(size_t)nkeys];
+      for (Index k=kbeg; k<kend; k++) {
+        cnt[key[perm_in[k]]]++;
+      }
+    }
+    Index pos = 0;
+    for (Index j=0; j<nkeys; j++) {
+      key_start[j] = pos;
+      for (Index t=0; t<nthreads; t++) {
+        const Index c = count[(size_t)t*(size_t)nkeys+j];
+        count[(size_t)t*(size_t)nkeys+j] = pos;
+        pos += c;
+      }
+    }
+    key_start[nkeys] = pos;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (Index t=0; t<nthreads; t++) {
+      const Index kbeg = t*blk + Min(t, rem);
+      const Index kend = kbeg + blk + (t<rem ? 1 : 0);
+      Index* next = &count[(size_t)t*(size_t)nkeys];
+      for (Index k=kbeg; k<kend; k++) {
+        const Index p = perm_in[k];
+        perm_out[next[key[p]]++] = p;
+      }
+    }
+  }
+
   TripletToCSRConverter::
   TripletToCSRConverter(Index offset, ETriFull hf /*= Triangular_Format*/)
       :
@@ -35,10 +127,14 @@ namespace Ipopt
       dim_(0),
       nonzeros_triplet_(0),
       nonzeros_compressed_(0),
+      num_doubles_(0),
+      num_double_elements_(0),
       initialized_(false),
       ipos_first_(NULL),
+      ipos_double_compressed_(NULL),
+      ipos_double_start_(NULL),
       ipos_double_triplet_(NULL),
-      ipos_double_compressed_(NULL)
+      ipos_assembly_(NULL)
   {
     DBG_ASSERT(offset==0|| offset==1);
   }
@@ -48,8 +144,10 @@ namespace Ipopt
     delete[] ia_;
     delete[] ja_;
     delete[] ipos_first_;
-    delete[] ipos_double_triplet_;
     delete[] ipos_double_compressed_;
+    delete[] ipos_double_start_;
+    delete[] ipos_double_triplet_;
+    delete[] ipos_assembly_;
   }
 
   Index TripletToCSRConverter::InitializeConverter(Index dim, Index nonzeros,
@@ -65,20 +163,15 @@ namespace Ipopt
     delete[] ia_;
     delete[] ja_;
     delete[] ipos_first_;
-    delete[] ipos_double_triplet_;
     delete[] ipos_double_compressed_;
+    delete[] ipos_double_start_;
+    delete[] ipos_double_triplet_;
+    delete[] ipos_assembly_;
+    ipos_assembly_ = NULL;
 
     dim_ = dim;
     nonzeros_triplet_ = nonzeros;
-
-    // Create a list with all triplet entries
-    std::list<TripletEntry> entry_list(nonzeros);
-    std::list<TripletEntry>::iterator list_iterator = entry_list.begin();
-    for (Index i=0; i<nonzeros; i++) {
-      list_iterator->Set(airn[i], ajcn[i], i);
-      list_iterator++;
-    }
-    DBG_ASSERT(list_iterator == entry_list.end());
+    const Index nthreads = CSRNumThreads(nonzeros);
 
     if (DBG_VERBOSITY()>=2) {
       for (Index i=0; i<nonzeros; i++) {
@@ -86,189 +179,207 @@ namespace Ipopt
       }
     }
 
-    // sort the list
-    entry_list.sort();
-
-    // Now got through the list and compute ipos_ arrays and the
-    // number of elements in the compressed format
-    Index* ja_tmp = new Index[nonzeros];    // overestimate memory requirement
-    Index* rc_tmp = NULL;
-    if (hf_ == Full_Format) {
-      rc_tmp = new Index[dim_+1];
-    }
-    ia_ = new Index[dim_+1];
-    Index* ipos_first_tmp = new Index[nonzeros];  // overestimate memory requirement
-    Index* ipos_double_triplet_tmp = new Index[nonzeros];  // overestimate memory requirement
-    Index* ipos_double_compressed_tmp = new Index[nonzeros];  // overestimate memory requirement
-
-    Index nonzeros_compressed_full = 0;
-    nonzeros_compressed_ = 0;
-    Index cur_row = 1;
-
-    if (hf_ == Full_Format) {
-      // Zero row counts
-      for (Index i=0; i<dim_+1; i++) {
-        rc_tmp[i] = 0;
+    // Row (smaller index) and column (larger index) of each triplet
+    // entry, counting from 0
+    std::vector<Index> row(nonzeros);
+    std::vector<Index> col(nonzeros);
+    std::vector<Index> perm(nonzeros);
+    std::vector<Index> perm_tmp(nonzeros);
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+    for (Index i=0; i<nonzeros; i++) {
+      if (airn[i]>ajcn[i]) {
+        row[i] = ajcn[i]-1;
+        col[i] = airn[i]-1;
       }
-    }
-
-    // Take care of possible emply rows
-    list_iterator = entry_list.begin();
-    while (cur_row < list_iterator->IRow()) {
-      ia_[cur_row-1] = 0;
-      cur_row++;
-    }
-    ia_[cur_row-1] = 0;
-    ja_tmp[0] = list_iterator->JCol();
-    ipos_first_tmp[0] = list_iterator->PosTriplet();
-    if (hf_ == Full_Format) {
-      // Count in both lower and upper triangles. Count diagonal only once.
-      nonzeros_compressed_full++;
-      rc_tmp[cur_row-1]++;
-      if (cur_row!=list_iterator->JCol()) {
-        nonzeros_compressed_full++;
-        rc_tmp[list_iterator->JCol()-1]++;
+      else {
+        row[i] = airn[i]-1;
+        col[i] = ajcn[i]-1;
       }
+      DBG_ASSERT(row[i]>=0 && col[i]<dim);
+      perm[i] = i;
     }
 
-    list_iterator++;
-    Index idouble = 0;
-    Index idouble_full = 0;
-    while (list_iterator != entry_list.end()) {
-      Index irow = list_iterator->IRow();
-      Index jcol = list_iterator->JCol();
-      if (cur_row == irow && ja_tmp[nonzeros_compressed_] == jcol) {
-        // This element appears repeatedly, add to the double list
-        ipos_double_triplet_tmp[idouble] = list_iterator->PosTriplet();
-        ipos_double_compressed_tmp[idouble] = nonzeros_compressed_;
-        idouble++;
-        idouble_full++;
-        if (hf_==Full_Format && irow!=jcol) {
-          idouble_full++;
+    // Sort the positions by column and then (stably) by row.  This
+    // orders them by row, column, and position in the triplet format.
+    std::vector<Index> row_start(dim_+1);
+    CSRCountingSort(nonzeros, &perm[0], &col[0], dim_, nthreads,
+                    &perm_tmp[0], &row_start[0]);
+    CSRCountingSort(nonzeros, &perm_tmp[0], &row[0], dim_, nthreads,
+                    &perm[0], &row_start[0]);
+    perm_tmp.clear();
+
+    // Count the distinct entries in each row.  The first occurence of
+    // an entry in the sorted order defines the element of the
+    // compressed format, and the others are added to it.
+    std::vector<Index> cstart(dim_+1);
+    cstart[0] = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) if(nthreads>1) schedule(dynamic,256)
+#endif
+    for (Index r=0; r<dim_; r++) {
+      Index cnt = 0;
+      for (Index k=row_start[r]; k<row_start[r+1]; k++) {
+        if (k==row_start[r] || col[perm[k]]!=col[perm[k-1]]) {
+          cnt++;
         }
       }
-      else {
-        // This is a new element
-        if (hf_==Full_Format) {
-          // Count in both lower and upper triangles. Count diagonal only once.
-          nonzeros_compressed_full++;
-          rc_tmp[jcol-1]++;
-          if (irow!=jcol) {
-            nonzeros_compressed_full++;
-            rc_tmp[irow-1]++;
-          }
+      cstart[r+1] = cnt;
+    }
+    for (Index r=0; r<dim_; r++) {
+      cstart[r+1] += cstart[r];
+    }
+    const Index nonzeros_tri = cstart[dim_];
+    const Index ndoubles_tri = nonzeros - nonzeros_tri;
+
+    // Compressed structure of the triangular part, counting from 0.
+    // The repeated entries for element q are
+    // double_tri[dstart_tri[q]],...,double_tri[dstart_tri[q+1]-1].
+    std::vector<Index> ja_tri(nonzeros_tri);
+    std::vector<Index> first_tri(nonzeros_tri);
+    std::vector<Index> dstart_tri(nonzeros_tri+1);
+    std::vector<Index> double_tri(ndoubles_tri);
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) if(nthreads>1) schedule(dynamic,256)
+#endif
+    for (Index r=0; r<dim_; r++) {
+      Index q = cstart[r];
+      for (Index k=row_start[r]; k<row_start[r+1]; k++) {
+        const Index p = perm[k];
+        if (k==row_start[r] || col[p]!=col[perm[k-1]]) {
+          ja_tri[q] = col[p];
+          first_tri[q] = p;
+          // k-q entries before position k are repeated ones
+          dstart_tri[q] = k-q;
+          q++;
         }
-        nonzeros_compressed_++;
-        ja_tmp[nonzeros_compressed_] = jcol;
-        ipos_first_tmp[nonzeros_compressed_] = list_iterator->PosTriplet();
-        if (cur_row != irow) {
-          // this is in a new row
-
-          ia_[cur_row] = nonzeros_compressed_;
-          cur_row++;
+        else {
+          double_tri[k-q] = p;
         }
       }
-
-      list_iterator++;
     }
-    nonzeros_compressed_++;
-    for (Index i=cur_row; i<=dim_; i++) {
-      ia_[i] = nonzeros_compressed_;
-    }
-    DBG_ASSERT(idouble == nonzeros_triplet_-nonzeros_compressed_);
+    dstart_tri[nonzeros_tri] = ndoubles_tri;
+    DBG_ASSERT(ndoubles_tri>=0);
 
-    // Now copy the ja_tmp array to the (shorter) final one and make
-    // sure that the correct offset is used
+    // src[f] is the element of the triangular part that defines the
+    // f-th element of the requested format
+    std::vector<Index> src;
+    ia_ = new Index[dim_+1];
     if (hf_==Triangular_Format) {
+      nonzeros_compressed_ = nonzeros_tri;
       ja_ = new Index[nonzeros_compressed_];
-      if (offset_==0) {
-        for (Index i=0; i<nonzeros_compressed_; i++) {
-          ja_[i] = ja_tmp[i] - 1;
-        }
+      for (Index i=0; i<=dim_; i++) {
+        ia_[i] = cstart[i];
       }
-      else {
-        for (Index i=0; i<nonzeros_compressed_; i++) {
-          ja_[i] = ja_tmp[i];
+      src.resize(nonzeros_compressed_);
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index q=0; q<nonzeros_compressed_; q++) {
+        src[q] = q;
+        ja_[q] = ja_tri[q];
+      }
+      // Here, the element q of the triangular part is the element q of
+      // the compressed format
+      ipos_assembly_ = new Index[nonzeros_triplet_];
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index q=0; q<nonzeros_compressed_; q++) {
+        ipos_assembly_[first_tri[q]] = q;
+        for (Index k=dstart_tri[q]; k<dstart_tri[q+1]; k++) {
+          ipos_assembly_[double_tri[k]] = -q-1;
         }
-        for (Index i=0; i<=dim_; i++) {
-          ia_[i] = ia_[i] + 1;
+      }
+    }
+    else { // hf_==Full_Format
+      // Row r of the full matrix consists of the entries (i,r) with i<r
+      // of the triangular part, followed by the triangular row r
+      std::vector<Index> nlower(dim_, 0);
+      for (Index q=0; q<nonzeros_tri; q++) {
+        nlower[ja_tri[q]]++;
+      }
+      ia_[0] = 0;
+      for (Index r=0; r<dim_; r++) {
+        // The diagonal element has been counted in nlower
+        if (cstart[r+1]>cstart[r] && ja_tri[cstart[r]]==r) {
+          nlower[r]--;
         }
+        ia_[r+1] = ia_[r] + nlower[r] + cstart[r+1] - cstart[r];
       }
-      delete[] ja_tmp;
+      nonzeros_compressed_ = ia_[dim_];
 
-      // Reallocate memory for the "first" array
-      ipos_first_ = new Index[nonzeros_compressed_];
-      for (Index i=0; i<nonzeros_compressed_; i++) {
-        ipos_first_[i] = ipos_first_tmp[i];
+      src.resize(nonzeros_compressed_);
+      ja_ = new Index[nonzeros_compressed_];
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1) schedule(dynamic,256)
+#endif
+      for (Index r=0; r<dim_; r++) {
+        Index f = ia_[r] + nlower[r];
+        for (Index q=cstart[r]; q<cstart[r+1]; q++) {
+          src[f] = q;
+          ja_[f] = ja_tri[q];
+          f++;
+        }
       }
-      delete[] ipos_first_tmp;
-
-      // Reallocate memory for the "double" arrays
-      ipos_double_triplet_ = new Index[idouble];
-      ipos_double_compressed_ = new Index[idouble];
-      for (Index i=0; i<idouble; i++) {
-        ipos_double_triplet_[i] = ipos_double_triplet_tmp[i];
-        ipos_double_compressed_[i] = ipos_double_compressed_tmp[i];
+      // The lower parts are filled in the order of the rows of the
+      // triangular part, so that the columns are sorted
+      std::vector<Index> next_lower(ia_, ia_+dim_);
+      for (Index r=0; r<dim_; r++) {
+        for (Index q=cstart[r]; q<cstart[r+1]; q++) {
+          const Index j = ja_tri[q];
+          if (j!=r) {
+            const Index f = next_lower[j]++;
+            src[f] = q;
+            ja_[f] = r;
+          }
+        }
       }
-      delete[] ipos_double_triplet_tmp;
-      delete[] ipos_double_compressed_tmp;
-      num_doubles_ = nonzeros_triplet_ - nonzeros_compressed_;
     }
-    else { // hf_==Full_Format
 
-      // Setup ia_tmp to contain insert position for column i as ia_tmp[i+1]
-      Index *ia_tmp = new Index[dim_+1];
-      ia_tmp[0] = 0;
-      ia_tmp[1] = 0;
-      for (Index i=1; i<dim_; i++) {
-        ia_tmp[i+1] = ia_tmp[i] + rc_tmp[i-1];
+    ipos_first_ = new Index[nonzeros_compressed_];
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+    for (Index f=0; f<nonzeros_compressed_; f++) {
+      ipos_first_[f] = first_tri[src[f]];
+      ja_[f] += offset_;
+    }
+    for (Index i=0; i<=dim_; i++) {
+      ia_[i] += offset_;
+    }
+
+    // Collect the elements with repeated entries
+    num_double_elements_ = 0;
+    num_doubles_ = 0;
+    if (ndoubles_tri > 0) {
+      for (Index f=0; f<nonzeros_compressed_; f++) {
+        const Index q = src[f];
+        if (dstart_tri[q+1] > dstart_tri[q]) {
+          num_double_elements_++;
+          num_doubles_ += dstart_tri[q+1] - dstart_tri[q];
+        }
       }
-      delete[] rc_tmp;
-
-      // Loop over elements of matrix, copying them and duplicating as required
-      ja_ = new Index[nonzeros_compressed_full];
-      ipos_first_ = new Index[nonzeros_compressed_full];
-      ipos_double_triplet_ = new Index[idouble_full];
-      ipos_double_compressed_ = new Index[idouble_full];
-      Index jd1=0; // Entry into ipos_double_compressed_tmp
-      Index jd2=0; // Entry into ipos_double_compressed_
-      for (Index i=0; i<dim_; i++) {
-        for (Index j=ia_[i]; j<ia_[i+1]; j++) {
-          Index jrow = ja_tmp[j]-1;
-          ja_[ia_tmp[i+1]] = jrow + offset_;
-          ipos_first_[ia_tmp[i+1]] = ipos_first_tmp[j];
-          while (jd1<idouble && j==ipos_double_compressed_tmp[jd1]) {
-            ipos_double_triplet_[jd2] = ipos_double_triplet_tmp[jd1];
-            ipos_double_compressed_[jd2] = ia_tmp[i+1];
-            jd2++;
-            if (jrow!=i) {
-              ipos_double_triplet_[jd2] = ipos_double_triplet_tmp[jd1];
-              ipos_double_compressed_[jd2] = ia_tmp[jrow+1];
-            }
-            jd1++;
-          }
-          ia_tmp[i+1]++;
-          if (jrow!=i) {
-            ja_[ia_tmp[jrow+1]] = i + offset_;
-            ipos_first_[ia_tmp[jrow+1]] = ipos_first_tmp[j];
-            ia_tmp[jrow+1]++;
+    }
+    ipos_double_compressed_ = new Index[num_double_elements_];
+    ipos_double_start_ = new Index[num_double_elements_+1];
+    ipos_double_triplet_ = new Index[num_doubles_];
+    ipos_double_start_[0] = 0;
+    if (num_doubles_ > 0) {
+      Index e = 0;
+      Index d = 0;
+      for (Index f=0; f<nonzeros_compressed_; f++) {
+        const Index q = src[f];
+        if (dstart_tri[q+1] > dstart_tri[q]) {
+          ipos_double_compressed_[e] = f;
+          for (Index k=dstart_tri[q]; k<dstart_tri[q+1]; k++) {
+            ipos_double_triplet_[d++] = double_tri[k];
           }
+          e++;
+          ipos_double_start_[e] = d;
         }
       }
-      delete[] ja_tmp;
-      delete[] ipos_first_tmp;
-      delete[] ipos_double_triplet_tmp;
-      delete[] ipos_double_compressed_tmp;
-
-      // Copy ia_tmp to ia_ with offset_ adjustment
-      for (Index i=0; i<dim_+1; i++) {
-        ia_[i] = ia_tmp[i] + offset_;
-      }
-      delete[] ia_tmp;
-
-      // Set nonzeros_compressed_ to correct size
-      nonzeros_compressed_ = nonzeros_compressed_full;
-      num_doubles_ = idouble_full;
     }
 
     initialized_ = true;
@@ -280,8 +391,10 @@ namespace Ipopt
       for (Index i=0; i<nonzeros_compressed_; i++) {
         DBG_PRINT((2, "ja[%5d] = %5d ipos_first[%5d] = %5d\n", i, ja_[i], i, ipos_first_[i]));
       }
-      for (Index i=0; i<nonzeros_triplet_-nonzeros_compressed_; i++) {
-        DBG_PRINT((2, "ipos_double_triplet[%5d] = %5d ipos_double_compressed[%5d] = %5d\n", i, ipos_double_triplet_[i], i, ipos_double_compressed_[i]));
+      for (Index i=0; i<num_double_elements_; i++) {
+        for (Index k=ipos_double_start_[i]; k<ipos_double_start_[i+1]; k++) {
+          DBG_PRINT((2, "ipos_double_triplet[%5d] = %5d ipos_double_compressed[%5d] = %5d\n", k, ipos_double_triplet_[k], i, ipos_double_compressed_[i]));
+        }
       }
     }
 
@@ -301,12 +414,29 @@ namespace Ipopt
     DBG_ASSERT(nonzeros_triplet_==nonzeros_triplet);
     DBG_ASSERT(nonzeros_compressed_==nonzeros_compressed);
 
-    for (Index i=0; i<nonzeros_compressed_; i++) {
-      a_compressed[i] = a_triplet[ipos_first_[i]];
-    }
-    for (Index i=0; i<num_doubles_; i++) {
-      a_compressed[ipos_double_compressed_[i]] +=
-        a_triplet[ipos_double_triplet_[i]];
+    // The elements of the compressed format are computed
+    // independently, so that they can be distributed among threads
+#ifdef _OPENMP
+    const Index nthreads = CSRNumThreads(nonzeros_triplet_);
+    #pragma omp parallel num_threads(nthreads) if(nthreads>1)
+#endif
+    {
+#ifdef _OPENMP
+      #pragma omp for
+#endif
+      for (Index i=0; i<nonzeros_compressed_; i++) {
+        a_compressed[i] = a_triplet[ipos_first_[i]];
+      }
+#ifdef _OPENMP
+      #pragma omp for
+#endif
+      for (Index e=0; e<num_double_elements_; e++) {
+        Number val = a_compressed[ipos_double_compressed_[e]];
+        for (Index k=ipos_double_start_[e]; k<ipos_double_start_[e+1]; k++) {
+          val += a_triplet[ipos_double_triplet_[k]];
+        }
+        a_compressed[ipos_double_compressed_[e]] = val;
+      }
     }
 
     if (DBG_VERBOSITY()>=2) {
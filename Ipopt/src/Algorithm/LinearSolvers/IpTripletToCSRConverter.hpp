@@ -19,109 +19,16 @@ namespace Ipopt
    *  triangual part (or, equivalently, compressed sparse column (CSC)
    *  format for the lower triangular part).  In the description for
    *  this class, we assume that we discuss the CSR format.
+   *
+   *  The structure is computed by two stable counting sorts of the
+   *  triplet positions (by column, then by row), so that the work is
+   *  linear in the number of nonzeros and the dimension.  If Ipopt is
+   *  compiled with OpenMP support, the sorts, the compression of the
+   *  rows, and the conversion of the values are done in parallel for
+   *  large matrices.
    */
   class TripletToCSRConverter: public ReferencedObject
   {
-    /** Class for one triplet position entry. */
-    class TripletEntry
-    {
-    public:
-      /** @name Constructor/Destructor */
-      //@{
-      /** Constructor. */
-      TripletEntry()
-      {}
-
-      /** Destructor */
-      ~TripletEntry()
-      {}
-
-      /** Copy constructor, required for std::list */
-      TripletEntry(const TripletEntry& rhs)
-      {
-        i_row_ = rhs.i_row_;
-        j_col_ = rhs.j_col_;
-        i_pos_triplet_ = rhs.i_pos_triplet_;
-      }
-
-      /** Equals Operator, required for std::list */
-      TripletEntry& operator=(const TripletEntry& rhs)
-      {
-        if (this!=&rhs) {
-          i_row_ = rhs.i_row_;
-          j_col_ = rhs.j_col_;
-          i_pos_triplet_ = rhs.i_pos_triplet_;
-        }
-        return *this;
-      }
-      //@}
-
-      /** Set the values of an entry */
-      void Set(Index i_row, Index j_col, Index i_pos_triplet)
-      {
-        if (i_row>j_col) {
-          i_row_ = j_col;
-          j_col_ = i_row;
-        }
-        else {
-          i_row_ = i_row;
-          j_col_ = j_col;
-        }
-        i_pos_triplet_ = i_pos_triplet;
-      }
-
-      /** @name Accessor methods. */
-      //@{
-      /** Row position. */
-      Index IRow() const
-      {
-        return i_row_;
-      }
-      /** Column position. */
-      Index JCol() const
-      {
-        return j_col_;
-      }
-      /** Index in original triplet matrix. */
-      Index PosTriplet() const
-      {
-        return i_pos_triplet_;
-      }
-      //@}
-
-      /** Comparison operator.  This is required for the sort function. */
-      bool operator< (const TripletEntry& Tentry) const
-      {
-        return ((i_row_ < Tentry.i_row_) ||
-                (i_row_==Tentry.i_row_ && j_col_<Tentry.j_col_));
-      }
-
-    private:
-      /**@name Default Compiler Generated Methods
-       * (Hidden to avoid implicit creation/calling).
-       * These methods are not implemented and 
-       * we do not want the compiler to implement
-       * them for us, so we declare them private
-       * and do not define them. This ensures that
-       * they will not be implicitly created/called. */
-      //@{
-      /** Default Constructor */
-      //TripletEntry();
-
-      /** Copy Constructor */
-      /*
-      TripletEntry(const TripletEntry&);
-      */
-      //@}
-
-      /** @name Entry content. */
-      //@{
-      Index i_row_;
-      Index j_col_;
-      Index i_pos_triplet_;
-      //@}
-    };
-
   public:
     /** Enum to specifiy half or full matrix storage */
     enum ETriFull {
@@ -172,11 +79,32 @@ namespace Ipopt
       DBG_ASSERT(initialized_);
       return ja_;
     }
+    /** Return the number of nonzeros in the condensed format. */
+    Index NonzerosCompressed() const
+    {
+      DBG_ASSERT(initialized_);
+      return nonzeros_compressed_;
+    }
     const Index* iPosFirst() const
     {
       DBG_ASSERT(initialized_);
       return ipos_first_;
     }
+    /** Return the position in the compressed value array for each
+     *  element of the triplet format, or NULL for the full format.
+     *  If the i-th value is the first entry for its element in the
+     *  triplet format, it is stored at position AssemblyPositions()[i];
+     *  otherwise, it has to be added to position
+     *  -AssemblyPositions()[i]-1.  Since the triplet elements are
+     *  visited in increasing order, filling the compressed values in
+     *  this way gives the same result as ConvertValues, without the
+     *  need for the values in triplet format (see
+     *  TripletHelper::FillValues). */
+    const Index* AssemblyPositions() const
+    {
+      DBG_ASSERT(initialized_);
+      return ipos_assembly_;
+    }
     //@}
 
     /** Convert the values of the nonzero elements.  Given the values
@@ -230,6 +158,10 @@ namespace Ipopt
     /** Number of repeated entries */
     Index num_doubles_;
 
+    /** Number of elements in the compressed format with repeated
+     *  entries */
+    Index num_double_elements_;
+
     /** Flag indicating if initialize method had been called. */
     bool initialized_;
 
@@ -240,14 +172,20 @@ namespace Ipopt
      *  format is obtained from copying the ipos_filter_[i]-th element
      *  from the triplet format.  */
     Index* ipos_first_;
-    /** Position of multiple elements in triplet matrix.  For i =
-     *  0,..,nonzeros_triplet_-nonzeros_compressed_, the
-     *  ipos_double_triplet_[i]-th element in the triplet matrix has
-     *  to be added to the ipos_double_compressed_[i]-th element in
-     *  the compressed matrix. */
-    Index* ipos_double_triplet_;
-    /** Position of multiple elements in compressed matrix. */
+    /** Elements of the compressed format that are the sum of several
+     *  elements in the triplet format. */
     Index* ipos_double_compressed_;
+    /** Position of the repeated elements for each element in
+     *  ipos_double_compressed_.  The ipos_double_triplet_[k]-th
+     *  element in the triplet matrix has to be added to the
+     *  ipos_double_compressed_[i]-th element in the compressed matrix
+     *  for ipos_double_start_[i] <= k < ipos_double_start_[i+1]. */
+    Index* ipos_double_start_;
+    /** Position of multiple elements in triplet matrix. */
+    Index* ipos_double_triplet_;
+    /** Position in the compressed format for each element in the
+     *  triplet format (only for the triangular format). */
+    Index* ipos_assembly_;
     //@}
   };
 
@@ -0,0 +1,1298 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpoptConfig.h"
+
+#include "NlTNLP.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#ifdef HAVE_CSTRING
+# include <cstring>
+#else
+# ifdef HAVE_STRING_H
+#  include <string.h>
+# else
+#  error "don't have header file for string"
+# endif
+#endif
+
+#ifdef HAVE_CSTDLIB
+# include <cstdlib>
+#else
+# ifdef HAVE_STDLIB_H
+#  include <stdlib.h>
+# else
+#  error "don't have header file for stdlib"
+# endif
+#endif
+
+#ifdef HAVE_CSTDIO
+# include <cstdio>
+#else
+# ifdef HAVE_STDIO_H
+#  include <stdio.h>
+# else
+#  error "don't have header file for stdio"
+# endif
+#endif
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace Ipopt
+{
+#if COIN_IPOPT_VERBOSITY > 0
+  static const Index dbg_verbosity = 0;
+#endif
+
+  /** Operation of a node of the expression graph that refers to a
+   *  defined variable (not used on the tapes) */
+  static const Index nl_defvar = -1;
+
+  /** Number of operands of an operation in the .nl file: 1, 2, 3, or
+   *  -1 if the number of operands is given in the file.  Returns 0
+   *  for an unsupported operation. */
+  static Index NlNumOperands(Index op)
+  {
+    switch (op) {
+    case NL_FLOOR:
+    case NL_CEIL:
+    case NL_ABS:
+    case NL_NEG:
+    case NL_NOT:
+    case NL_TANH:
+    case NL_TAN:
+    case NL_SQRT:
+    case NL_SINH:
+    case NL_SIN:
+    case NL_LOG10:
+    case NL_LOG:
+    case NL_EXP:
+    case NL_COSH:
+    case NL_COS:
+    case NL_ATANH:
+    case NL_ATAN:
+    case NL_ASINH:
+    case NL_ASIN:
+    case NL_ACOSH:
+    case NL_ACOS:
+    case NL_SQUARE:
+      return 1;
+    case NL_PLUS:
+    case NL_MINUS:
+    case NL_MULT:
+    case NL_DIV:
+    case NL_REM:
+    case NL_POW:
+    case NL_LESS:
+    case NL_OR:
+    case NL_AND:
+    case NL_LT:
+    case NL_LE:
+    case NL_EQ:
+    case NL_GE:
+    case NL_GT:
+    case NL_NE:
+    case NL_ATAN2:
+    case NL_INTDIV:
+    case NL_ROUND:
+    case NL_TRUNC:
+    case NL_POW_CONST:
+    case NL_CONST_POW:
+      return 2;
+    case NL_IF:
+      return 3;
+    case NL_MIN:
+    case NL_MAX:
+    case NL_SUM:
+    case NL_ANDLIST:
+    case NL_ORLIST:
+      return -1;
+    }
+    return 0;
+  }
+
+  /** Expression graph of the functions in a .nl file.  The operands
+   *  of node k are args[arg_start[k]] to args[arg_start[k+1]-1]; for
+   *  a variable (or defined variable) node, the only "operand" is the
+   *  index of the variable. */
+  class NlExprGraph
+  {
+  public:
+    NlExprGraph()
+    {
+      arg_start.push_back(0);
+    }
+
+    Index AddNode(Index node_op, Number node_value,
+                  Index nargs, const Index* node_args)
+    {
+      op.push_back(node_op);
+      value.push_back(node_value);
+      args.insert(args.end(), node_args, node_args+nargs);
+      arg_start.push_back((Index)args.size());
+      return (Index)op.size()-1;
+    }
+
+    std::vector<Index> op;
+    std::vector<Number> value;
+    std::vector<Index> arg_start;
+    std::vector<Index> args;
+  };
+
+  /** A defined variable (common expression): the sum of a linear part
+   *  and the value of an expression. */
+  struct NlDefinedVar
+  {
+    Index expr;
+    std::vector<std::pair<Index, Number> > lin;
+  };
+
+  /** Reader for the tokens of a .nl file in the text or binary
+   *  format.  The header (the first ten lines) is text in both
+   *  formats. */
+  class NlFileReader
+  {
+  public:
+    NlFileReader(const std::string& filename)
+        :
+        filename_(filename),
+        pos_(0),
+        binary_(false)
+    {
+      std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!is) {
+        THROW_EXCEPTION(NlTNLP::INVALID_NL_FILE,
+                        "Cannot open file " + filename + ".");
+      }
+      std::ostringstream os;
+      os << is.rdbuf();
+      data_ = os.str();
+    }
+
+    /** Throw an exception for an error at the current position */
+    void Error(const std::string& msg) const
+    {
+      std::ostringstream os;
+      os << filename_ << " (at byte " << pos_ << "): " << msg;
+      THROW_EXCEPTION(NlTNLP::INVALID_NL_FILE, os.str());
+    }
+
+    /** Read a line of the header and return the numbers in it (up to
+     *  a comment).  The first character of the line is returned in
+     *  key if it is not part of a number. */
+    void ReadHeaderLine(std::vector<Number>& values, char& key)
+    {
+      if (pos_ >= data_.size()) {
+        Error("Unexpected end of the header.");
+      }
+      std::string::size_type end = data_.find('\n', pos_);
+      if (end == std::string::npos) {
+        end = data_.size();
+      }
+      std::string line = data_.substr(pos_, end-pos_);
+      pos_ = end+1;
+      std::string::size_type comment = line.find('#');
+      if (comment != std::string::npos) {
+        line.erase(comment);
+      }
+      key = 0;
+      if (!line.empty() && isalpha(line[0])) {
+        key = line[0];
+        line.erase(0, 1);
+      }
+      values.clear();
+      std::istringstream is(line);
+      Number val;
+      while (is >> val) {
+        values.push_back(val);
+      }
+    }
+
+    void SetBinary(bool binary)
+    {
+      binary_ = binary;
+    }
+
+    bool Binary() const
+    {
+      return binary_;
+    }
+
+    /** Returns true if all input has been read */
+    bool AtEnd()
+    {
+      if (!binary_) {
+        SkipSpace();
+      }
+      return pos_ >= data_.size();
+    }
+
+    /** Read the key character of a segment or of an expression node */
+    char ReadKey()
+    {
+      if (AtEnd()) {
+        Error("Unexpected end of file.");
+      }
+      return data_[pos_++];
+    }
+
+    Index ReadInt()
+    {
+      if (binary_) {
+        int val;
+        ReadBytes(&val, sizeof(val));
+        return (Index)val;
+      }
+      SkipSpace();
+      const char* start = data_.c_str() + pos_;
+      char* end;
+      long val = strtol(start, &end, 10);
+      if (end == start) {
+        Error("Integer expected.");
+      }
+      pos_ += end-start;
+      return (Index)val;
+    }
+
+    Number ReadDouble()
+    {
+      if (binary_) {
+        double val;
+        ReadBytes(&val, sizeof(val));
+        return val;
+      }
+      SkipSpace();
+      const char* start = data_.c_str() + pos_;
+      char* end;
+      double val = strtod(start, &end);
+      if (end == start) {
+        Error("Number expected.");
+      }
+      pos_ += end-start;
+      return val;
+    }
+
+    /** Read a constant stored as a short integer ('s' nodes) */
+    Number ReadShort()
+    {
+      if (binary_) {
+        short val;
+        ReadBytes(&val, sizeof(val));
+        return val;
+      }
+      return ReadDouble();
+    }
+
+    /** Read a name (of a suffix) */
+    std::string ReadName()
+    {
+      if (binary_) {
+        Index len = ReadInt();
+        if (len < 0 || pos_+len > data_.size()) {
+          Error("Invalid name.");
+        }
+        std::string name = data_.substr(pos_, len);
+        pos_ += len;
+        return name;
+      }
+      SkipSpace();
+      std::string::size_type start = pos_;
+      while (pos_ < data_.size() && !isspace(data_[pos_])) {
+        pos_++;
+      }
+      return data_.substr(start, pos_-start);
+    }
+
+  private:
+    /** Skip white space and comments in the text format */
+    void SkipSpace()
+    {
+      while (pos_ < data_.size()) {
+        if (data_[pos_] == '#') {
+          while (pos_ < data_.size() && data_[pos_] != '\n') {
+            pos_++;
+          }
+        }
+        else if (isspace(data_[pos_])) {
+          pos_++;
+        }
+        else {
+          break;
+        }
+      }
+    }
+
+    void ReadBytes(void* dest, std::string::size_type nbytes)
+    {
+      if (pos_+nbytes > data_.size()) {
+        Error("Unexpected end of file.");
+      }
+      memcpy(dest, data_.data()+pos_, nbytes);
+      pos_ += nbytes;
+    }
+
+    std::string filename_;
+    std::string data_;
+    std::string::size_type pos_;
+    bool binary_;
+  };
+
+  /** Read an expression in prefix notation and add it to the graph.
+   *  Returns the position of its root. */
+  static Index NlReadExpr(NlFileReader& reader, Index n_var, Index n_defvar,
+                          NlExprGraph& graph)
+  {
+    const char key = reader.ReadKey();
+    switch (key) {
+    case 'n':
+      return graph.AddNode(NL_NUM, reader.ReadDouble(), 0, NULL);
+    case 's':
+      return graph.AddNode(NL_NUM, reader.ReadShort(), 0, NULL);
+    case 'l':
+      return graph.AddNode(NL_NUM, reader.Binary() ? reader.ReadInt() :
+                           reader.ReadDouble(), 0, NULL);
+    case 'v': {
+      const Index var = reader.ReadInt();
+      if (var < 0 || var >= n_var+n_defvar) {
+        reader.Error("Invalid variable index.");
+      }
+      if (var < n_var) {
+        return graph.AddNode(NL_VAR, 0., 1, &var);
+      }
+      const Index defvar = var-n_var;
+      return graph.AddNode(nl_defvar, 0., 1, &defvar);
+    }
+    case 'o': {
+      const Index op = reader.ReadInt();
+      Index nargs = NlNumOperands(op);
+      if (nargs == 0) {
+        std::ostringstream os;
+        os << "Operation " << op << " is not supported.";
+        reader.Error(os.str());
+      }
+      if (nargs < 0) {
+        nargs = reader.ReadInt();
+        if (nargs < 1) {
+          reader.Error("Invalid number of operands.");
+        }
+      }
+      std::vector<Index> args(nargs);
+      for (Index i=0; i<nargs; i++) {
+        args[i] = NlReadExpr(reader, n_var, n_defvar, graph);
+      }
+      return graph.AddNode(op, 0., nargs, &args[0]);
+    }
+    case 'f':
+      reader.Error("Imported functions are not supported.");
+      break;
+    case 'h':
+      reader.Error("String expressions are not supported.");
+    }
+    reader.Error(std::string("Unknown expression node '") + key + "'.");
+    return -1;
+  }
+
+  /** Data for splitting a function into a constant, a linear part and
+   *  elements. */
+  struct NlFunctionParts
+  {
+    Number constant;
+    std::map<Index, Number> lin;
+    std::vector<std::pair<Index, Number> > elems;
+  };
+
+  /** Split coef times the expression at node into parts.  Sums,
+   *  differences, negations, and multiplications and divisions by
+   *  constants are resolved, defined variables on this level are
+   *  expanded, and any other expression becomes an element. */
+  static void NlSplitFunction(const NlExprGraph& graph,
+                              const std::vector<NlDefinedVar>& defvars,
+                              Index node, Number coef,
+                              NlFunctionParts& parts)
+  {
+    const Index* a = &graph.args[0] + graph.arg_start[node];
+    const Index nargs = graph.arg_start[node+1] - graph.arg_start[node];
+    switch (graph.op[node]) {
+    case NL_NUM:
+      parts.constant += coef*graph.value[node];
+      return;
+    case NL_VAR:
+      parts.lin[a[0]] += coef;
+      return;
+    case nl_defvar: {
+      const NlDefinedVar& defvar = defvars[a[0]];
+      for (Index i=0; i<(Index)defvar.lin.size(); i++) {
+        parts.lin[defvar.lin[i].first] += coef*defvar.lin[i].second;
+      }
+      NlSplitFunction(graph, defvars, defvar.expr, coef, parts);
+      return;
+    }
+    case NL_PLUS:
+    case NL_SUM:
+      for (Index i=0; i<nargs; i++) {
+        NlSplitFunction(graph, defvars, a[i], coef, parts);
+      }
+      return;
+    case NL_MINUS:
+      NlSplitFunction(graph, defvars, a[0], coef, parts);
+      NlSplitFunction(graph, defvars, a[1], -coef, parts);
+      return;
+    case NL_NEG:
+      NlSplitFunction(graph, defvars, a[0], -coef, parts);
+      return;
+    case NL_MULT:
+      if (graph.op[a[0]] == NL_NUM) {
+        NlSplitFunction(graph, defvars, a[1], coef*graph.value[a[0]], parts);
+        return;
+      }
+      if (graph.op[a[1]] == NL_NUM) {
+        NlSplitFunction(graph, defvars, a[0], coef*graph.value[a[1]], parts);
+        return;
+      }
+      break;
+    case NL_DIV:
+      if (graph.op[a[1]] == NL_NUM) {
+        NlSplitFunction(graph, defvars, a[0], coef/graph.value[a[1]], parts);
+        return;
+      }
+      break;
+    }
+    parts.elems.push_back(std::make_pair(node, coef));
+  }
+
+  /** Compile the expression at node into tape.  defvar_node is the
+   *  position of each defined variable on the tape (or -1), so that
+   *  each one is computed only once.  Returns the position of the
+   *  value on the tape. */
+  static Index NlCompile(const NlExprGraph& graph,
+                         const std::vector<NlDefinedVar>& defvars,
+                         Index node, NlTape& tape,
+                         std::map<Index, Index>& defvar_node)
+  {
+    const Index* a = &graph.args[0] + graph.arg_start[node];
+    const Index nargs = graph.arg_start[node+1] - graph.arg_start[node];
+    const Index op = graph.op[node];
+    switch (op) {
+    case NL_NUM:
+      return tape.AddConstant(graph.value[node]);
+    case NL_VAR:
+      return tape.AddVariable(a[0]);
+    case nl_defvar: {
+      std::map<Index, Index>::iterator it = defvar_node.find(a[0]);
+      if (it != defvar_node.end()) {
+        return it->second;
+      }
+      const NlDefinedVar& defvar = defvars[a[0]];
+      Index pos = NlCompile(graph, defvars, defvar.expr, tape, defvar_node);
+      if (!defvar.lin.empty()) {
+        std::vector<Index> terms(1, pos);
+        for (Index i=0; i<(Index)defvar.lin.size(); i++) {
+          Index factors[2];
+          factors[0] = tape.AddConstant(defvar.lin[i].second);
+          factors[1] = tape.AddVariable(defvar.lin[i].first);
+          terms.push_back(tape.AddOperation(NL_MULT, 2, factors));
+        }
+        pos = tape.AddOperation(NL_SUM, (Index)terms.size(), &terms[0]);
+      }
+      defvar_node[a[0]] = pos;
+      return pos;
+    }
+    }
+    std::vector<Index> args(nargs);
+    for (Index i=0; i<nargs; i++) {
+      args[i] = NlCompile(graph, defvars, a[i], tape, defvar_node);
+    }
+    return tape.AddOperation(op, nargs, &args[0]);
+  }
+
+  /** Read the bounds segment ('r' or 'b') for n entries. */
+  static void NlReadBounds(NlFileReader& reader, Index n,
+                           std::vector<Number>& lower,
+                           std::vector<Number>& upper)
+  {
+    const Number inf = std::numeric_limits<Number>::infinity();
+    for (Index i=0; i<n; i++) {
+      const char type = reader.ReadKey();
+      switch (type) {
+      case '0':
+        lower[i] = reader.ReadDouble();
+        upper[i] = reader.ReadDouble();
+        break;
+      case '1':
+        lower[i] = -inf;
+        upper[i] = reader.ReadDouble();
+        break;
+      case '2':
+        lower[i] = reader.ReadDouble();
+        upper[i] = inf;
+        break;
+      case '3':
+        lower[i] = -inf;
+        upper[i] = inf;
+        break;
+      case '4':
+        lower[i] = upper[i] = reader.ReadDouble();
+        break;
+      case '5':
+        reader.Error("Complementarity constraints are not supported.");
+        break;
+      default:
+        reader.Error("Invalid bound type.");
+      }
+    }
+  }
+
+  NlTNLP::NlTNLP(const SmartPtr<const Journalist>& jnlst,
+                 const std::string& stub,
+                 bool write_sol /* = false */,
+                 Index num_threads /* = 0 */)
+      :
+      TNLP(),
+      jnlst_(jnlst),
+      write_sol_(write_sol),
+      num_threads_(num_threads),
+      ampl_vbtol_(0.),
+      n_var_(0),
+      n_con_(0),
+      n_obj_(0),
+      obj_sign_(1.),
+      max_work_(0),
+      solve_result_num_(-1)
+  {
+    DBG_START_METH("NlTNLP::NlTNLP", dbg_verbosity);
+
+    std::string filename = stub;
+    if (filename.size() > 3 &&
+        filename.compare(filename.size()-3, 3, ".nl") == 0) {
+      stub_ = filename.substr(0, filename.size()-3);
+    }
+    else {
+      stub_ = filename;
+      filename += ".nl";
+    }
+    ReadNlFile(filename);
+  }
+
+  NlTNLP::~NlTNLP()
+  {}
+
+  void NlTNLP::ReadNlFile(const std::string& filename)
+  {
+    DBG_START_METH("NlTNLP::ReadNlFile", dbg_verbosity);
+
+    NlFileReader reader(filename);
+
+    // Header
+    std::vector<Number> values;
+    char key;
+    reader.ReadHeaderLine(values, key);
+    if (key != 'g' && key != 'b') {
+      reader.Error("This is not a .nl file.");
+    }
+    reader.SetBinary(key == 'b');
+    ampl_options_.clear();
+    if (!values.empty()) {
+      const Index nopts = (Index)values[0];
+      for (Index i=0; i<=nopts && i<(Index)values.size(); i++) {
+        ampl_options_.push_back((Index)values[i]);
+      }
+      if (nopts >= 2 && ampl_options_.size() > 2 && ampl_options_[2] == 3 &&
+          (Index)values.size() > nopts+1) {
+        ampl_vbtol_ = values[nopts+1];
+      }
+    }
+    std::vector<std::vector<Number> > header(9);
+    for (Index i=0; i<9; i++) {
+      reader.ReadHeaderLine(header[i], key);
+    }
+    if (header[0].size() < 3 || header[8].size() < 5) {
+      reader.Error("Invalid header.");
+    }
+    n_var_ = (Index)header[0][0];
+    n_con_ = (Index)header[0][1];
+    n_obj_ = (Index)header[0][2];
+    if (header[0].size() > 5 && header[0][5] > 0) {
+      reader.Error("Logical constraints are not supported.");
+    }
+    if (header[2].size() > 1 && (header[2][0] > 0 || header[2][1] > 0)) {
+      reader.Error("Network constraints are not supported.");
+    }
+    Index n_defvar = 0;
+    for (Index i=0; i<5; i++) {
+      n_defvar += (Index)header[8][i];
+    }
+    if (header[5].size() > 1 && header[5][0]+header[5][1] > 0) {
+      jnlst_->Printf(J_WARNING, J_MAIN,
+                     "Warning: The integrality of %d variables is ignored.\n",
+                     (Index)(header[5][0]+header[5][1]));
+    }
+
+    // Segments
+    const Number inf = std::numeric_limits<Number>::infinity();
+    x_l_.assign(n_var_, -inf);
+    x_u_.assign(n_var_, inf);
+    g_l_.assign(n_con_, -inf);
+    g_u_.assign(n_con_, inf);
+    x_init_.assign(n_var_, 0.);
+    y_init_.assign(n_con_, 0.);
+    have_y_init_.assign(n_con_, false);
+
+    NlExprGraph graph;
+    std::vector<NlDefinedVar> defvars(n_defvar);
+    for (Index i=0; i<n_defvar; i++) {
+      defvars[i].expr = -1;
+    }
+    // Roots of the nonlinear parts of the functions (-1 if none) and
+    // linear parts
+    std::vector<Index> func_root(n_con_+1, -1);
+    std::vector<std::vector<std::pair<Index, Number> > > func_lin(n_con_+1);
+    while (!reader.AtEnd()) {
+      const char segment = reader.ReadKey();
+      switch (segment) {
+      case 'F':
+        reader.Error("Imported functions are not supported.");
+        break;
+      case 'L':
+        reader.Error("Logical constraints are not supported.");
+        break;
+      case 'S': {
+        // Suffixes are ignored
+        const Index kind = reader.ReadInt();
+        const Index n = reader.ReadInt();
+        reader.ReadName();
+        for (Index i=0; i<n; i++) {
+          reader.ReadInt();
+          if (kind & 4) {
+            reader.ReadDouble();
+          }
+          else {
+            reader.ReadInt();
+          }
+        }
+        break;
+      }
+      case 'V': {
+        const Index i = reader.ReadInt() - n_var_;
+        const Index nlin = reader.ReadInt();
+        reader.ReadInt();
+        if (i < 0 || i >= n_defvar) {
+          reader.Error("Invalid defined variable.");
+        }
+        for (Index k=0; k<nlin; k++) {
+          const Index var = reader.ReadInt();
+          const Number coef = reader.ReadDouble();
+          defvars[i].lin.push_back(std::make_pair(var, coef));
+        }
+        // Defined variables only refer to the ones defined before
+        defvars[i].expr = NlReadExpr(reader, n_var_, i, graph);
+        break;
+      }
+      case 'C': {
+        const Index i = reader.ReadInt();
+        if (i < 0 || i >= n_con_) {
+          reader.Error("Invalid constraint index.");
+        }
+        func_root[i] = NlReadExpr(reader, n_var_, n_defvar, graph);
+        break;
+      }
+      case 'O': {
+        const Index i = reader.ReadInt();
+        const Index sigma = reader.ReadInt();
+        const Index root = NlReadExpr(reader, n_var_, n_defvar, graph);
+        if (i == 0) {
+          obj_sign_ = (sigma != 0) ? -1. : 1.;
+          func_root[n_con_] = root;
+        }
+        break;
+      }
+      case 'd':
+      case 'x': {
+        const Index n = reader.ReadInt();
+        for (Index k=0; k<n; k++) {
+          const Index i = reader.ReadInt();
+          const Number val = reader.ReadDouble();
+          if (segment == 'x' && i >= 0 && i < n_var_) {
+            x_init_[i] = val;
+          }
+          else if (segment == 'd' && i >= 0 && i < n_con_) {
+            y_init_[i] = val;
+            have_y_init_[i] = true;
+          }
+        }
+        break;
+      }
+      case 'r':
+        NlReadBounds(reader, n_con_, g_l_, g_u_);
+        break;
+      case 'b':
+        NlReadBounds(reader, n_var_, x_l_, x_u_);
+        break;
+      case 'k': {
+        const Index n = reader.ReadInt();
+        for (Index k=0; k<n; k++) {
+          reader.ReadInt();
+        }
+        break;
+      }
+      case 'J':
+      case 'G': {
+        Index i = reader.ReadInt();
+        const Index n = reader.ReadInt();
+        if (segment == 'J' && (i < 0 || i >= n_con_)) {
+          reader.Error("Invalid constraint index.");
+        }
+        if (segment == 'G') {
+          i = (i == 0) ? n_con_ : -1;
+        }
+        for (Index k=0; k<n; k++) {
+          const Index var = reader.ReadInt();
+          const Number coef = reader.ReadDouble();
+          if (var < 0 || var >= n_var_) {
+            reader.Error("Invalid variable index.");
+          }
+          if (i >= 0) {
+            func_lin[i].push_back(std::make_pair(var, coef));
+          }
+        }
+        break;
+      }
+      default:
+        reader.Error(std::string("Unknown segment '") + segment + "'.");
+      }
+    }
+    for (Index i=0; i<n_defvar; i++) {
+      if (defvars[i].expr < 0) {
+        reader.Error("Missing defined variable.");
+      }
+    }
+
+    // Split the functions into elements and compile them
+    const Index nfuncs = n_con_+1;
+    func_const_.assign(nfuncs, 0.);
+    func_elem_start_.assign(1, 0);
+    row_start_.assign(1, 0);
+    row_var_.clear();
+    row_lin_.clear();
+    elem_tape_.clear();
+    elem_coef_.clear();
+    elem_func_.clear();
+    for (Index f=0; f<nfuncs; f++) {
+      NlFunctionParts parts;
+      parts.constant = 0.;
+      for (Index k=0; k<(Index)func_lin[f].size(); k++) {
+        parts.lin[func_lin[f][k].first] += func_lin[f][k].second;
+      }
+      if (func_root[f] >= 0) {
+        NlSplitFunction(graph, defvars, func_root[f], 1., parts);
+      }
+      func_const_[f] = parts.constant;
+      std::map<Index, Number> row = parts.lin;
+      for (Index e=0; e<(Index)parts.elems.size(); e++) {
+        SmartPtr<NlTape> tape = new NlTape();
+        std::map<Index, Index> defvar_node;
+        NlCompile(graph, defvars, parts.elems[e].first, *tape, defvar_node);
+        for (Index j=0; j<tape->NumVariables(); j++) {
+          row.insert(std::make_pair(tape->Variables()[j], 0.));
+        }
+        elem_tape_.push_back(tape);
+        elem_coef_.push_back(parts.elems[e].second);
+        elem_func_.push_back(f);
+        max_work_ = Max(max_work_, tape->WorkSize());
+      }
+      func_elem_start_.push_back((Index)elem_tape_.size());
+      for (std::map<Index, Number>::iterator it = row.begin();
+           it != row.end(); it++) {
+        row_var_.push_back(it->first);
+        row_lin_.push_back(it->second);
+      }
+      row_start_.push_back((Index)row_var_.size());
+    }
+    const Index nelems = (Index)elem_tape_.size();
+
+    // Positions of the element gradients in the rows
+    elem_grad_start_.assign(1, 0);
+    std::vector<std::pair<Index, Index> > contribs;
+    for (Index e=0; e<nelems; e++) {
+      const Index f = elem_func_[e];
+      const std::vector<Index>& vars = elem_tape_[e]->Variables();
+      for (Index j=0; j<(Index)vars.size(); j++) {
+        const Index k = (Index)(std::lower_bound(&row_var_[0]+row_start_[f],
+                                &row_var_[0]+row_start_[f+1], vars[j]) -
+                                &row_var_[0]);
+        contribs.push_back(std::make_pair(k, elem_grad_start_[e]+j));
+      }
+      elem_grad_start_.push_back(elem_grad_start_[e] + (Index)vars.size());
+    }
+    std::sort(contribs.begin(), contribs.end());
+    row_contrib_start_.assign(row_var_.size()+1, 0);
+    row_contrib_pos_.resize(contribs.size());
+    for (Index l=0; l<(Index)contribs.size(); l++) {
+      row_contrib_start_[contribs[l].first+1]++;
+      row_contrib_pos_[l] = contribs[l].second;
+    }
+    for (Index k=0; k<(Index)row_var_.size(); k++) {
+      row_contrib_start_[k+1] += row_contrib_start_[k];
+    }
+
+    // Structure of the Hessian of the Lagrangian
+    elem_hess_start_.assign(1, 0);
+    std::vector<std::pair<std::pair<Index, Index>, Index> > hess_entries;
+    for (Index e=0; e<nelems; e++) {
+      Index pos = elem_hess_start_[e];
+      if (!elem_tape_[e]->IsLinear()) {
+        const std::vector<Index>& vars = elem_tape_[e]->Variables();
+        const Index nv = (Index)vars.size();
+        for (Index j=0; j<nv; j++) {
+          for (Index i=j; i<nv; i++) {
+            hess_entries.push_back(std::make_pair(
+                                     std::make_pair(Max(vars[i], vars[j]),
+                                                    Min(vars[i], vars[j])),
+                                     pos++));
+          }
+        }
+      }
+      elem_hess_start_.push_back(pos);
+    }
+    std::sort(hess_entries.begin(), hess_entries.end());
+    hess_row_.clear();
+    hess_col_.clear();
+    hess_contrib_start_.clear();
+    hess_contrib_pos_.resize(hess_entries.size());
+    for (Index l=0; l<(Index)hess_entries.size(); l++) {
+      if (l == 0 || hess_entries[l].first != hess_entries[l-1].first) {
+        hess_row_.push_back(hess_entries[l].first.first);
+        hess_col_.push_back(hess_entries[l].first.second);
+        hess_contrib_start_.push_back(l);
+      }
+      hess_contrib_pos_[l] = hess_entries[l].second;
+    }
+    hess_contrib_start_.push_back((Index)hess_entries.size());
+
+    Index n_nonlin_elems = 0;
+    for (Index e=0; e<nelems; e++) {
+      if (elem_hess_start_[e+1] > elem_hess_start_[e]) {
+        n_nonlin_elems++;
+      }
+    }
+    jnlst_->Printf(J_DETAILED, J_MAIN,
+                   "Read %s: %d variables, %d constraints, %d defined variables,\n"
+                   "  %d elements (%d nonlinear), %d Jacobian and %d Hessian nonzeros.\n",
+                   filename.c_str(), n_var_, n_con_, n_defvar, nelems,
+                   n_nonlin_elems, row_start_[n_con_], (Index)hess_row_.size());
+  }
+
+  Index NlTNLP::NumThreads(Index nitems) const
+  {
+#ifdef _OPENMP
+    const Index nthreads = (num_threads_ > 0) ? num_threads_ :
+                           omp_get_max_threads();
+    return Max(Index(1), Min(nthreads, nitems));
+#else
+    return 1;
+#endif
+  }
+
+  bool NlTNLP::EvalElements(const Number* x, Index first_elem,
+                            Index last_elem, Number* elem_val) const
+  {
+    Index nfailed = 0;
+#ifdef _OPENMP
+    const Index nthreads = NumThreads(last_elem-first_elem);
+    #pragma omp parallel num_threads(nthreads) if(nthreads>1) reduction(+:nfailed)
+#endif
+    {
+      std::vector<Number> work(Max(Index(1), max_work_));
+#ifdef _OPENMP
+      #pragma omp for schedule(dynamic,64)
+#endif
+      for (Index e=first_elem; e<last_elem; e++) {
+        Number value;
+        if (elem_tape_[e]->Evaluate(x, &work[0], value)) {
+          elem_val[e-first_elem] = elem_coef_[e]*value;
+        }
+        else {
+          nfailed++;
+        }
+      }
+    }
+    return nfailed == 0;
+  }
+
+  bool NlTNLP::EvalElementGradients(const Number* x, Index first_elem,
+                                    Index last_elem, Number* grad_buf) const
+  {
+    const Index base = elem_grad_start_[first_elem];
+    for (Index l=base; l<elem_grad_start_[last_elem]; l++) {
+      grad_buf[l-base] = 0.;
+    }
+    Index nfailed = 0;
+#ifdef _OPENMP
+    const Index nthreads = NumThreads(last_elem-first_elem);
+    #pragma omp parallel num_threads(nthreads) if(nthreads>1) reduction(+:nfailed)
+#endif
+    {
+      std::vector<Number> work(Max(Index(1), max_work_));
+#ifdef _OPENMP
+      #pragma omp for schedule(dynamic,64)
+#endif
+      for (Index e=first_elem; e<last_elem; e++) {
+        Number value;
+        if (!elem_tape_[e]->Gradient(x, elem_coef_[e], &work[0], value,
+                                     grad_buf + elem_grad_start_[e]-base)) {
+          nfailed++;
+        }
+      }
+    }
+    return nfailed == 0;
+  }
+
+  bool NlTNLP::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
+                            Index& nnz_h_lag, IndexStyleEnum& index_style)
+  {
+    n = n_var_;
+    m = n_con_;
+    nnz_jac_g = row_start_[n_con_];
+    nnz_h_lag = (Index)hess_row_.size();
+    index_style = C_STYLE;
+    return true;
+  }
+
+  bool NlTNLP::get_bounds_info(Index n, Number* x_l, Number* x_u,
+                               Index m, Number* g_l, Number* g_u)
+  {
+    DBG_ASSERT(n == n_var_);
+    DBG_ASSERT(m == n_con_);
+    for (Index i=0; i<n; i++) {
+      x_l[i] = x_l_[i];
+      x_u[i] = x_u_[i];
+    }
+    for (Index i=0; i<m; i++) {
+      g_l[i] = g_l_[i];
+      g_u[i] = g_u_[i];
+    }
+    return true;
+  }
+
+  bool NlTNLP::get_constraints_linearity(Index m, LinearityType* const_types)
+  {
+    DBG_ASSERT(m == n_con_);
+    for (Index i=0; i<m; i++) {
+      const_types[i] = LINEAR;
+      for (Index e=func_elem_start_[i]; e<func_elem_start_[i+1]; e++) {
+        if (elem_hess_start_[e+1] > elem_hess_start_[e]) {
+          const_types[i] = NON_LINEAR;
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool NlTNLP::get_starting_point(Index n, bool init_x, Number* x,
+                                  bool init_z, Number* z_L, Number* z_U,
+                                  Index m, bool init_lambda, Number* lambda)
+  {
+    DBG_ASSERT(n == n_var_);
+    DBG_ASSERT(m == n_con_);
+    if (init_x) {
+      for (Index i=0; i<n; i++) {
+        x[i] = x_init_[i];
+      }
+    }
+    if (init_z) {
+      for (Index i=0; i<n; i++) {
+        z_L[i] = 1.;
+        z_U[i] = 1.;
+      }
+    }
+    if (init_lambda) {
+      for (Index i=0; i<m; i++) {
+        lambda[i] = have_y_init_[i] ? -obj_sign_*y_init_[i] : 0.;
+      }
+    }
+    return true;
+  }
+
+  bool NlTNLP::eval_f(Index n, const Number* x, bool new_x,
+                      Number& obj_value)
+  {
+    DBG_START_METH("NlTNLP::eval_f", dbg_verbosity);
+
+    const Index first = func_elem_start_[n_con_];
+    const Index last = func_elem_start_[n_con_+1];
+    std::vector<Number> elem_val(last-first);
+    if (!EvalElements(x, first, last, elem_val.empty() ? NULL : &elem_val[0])) {
+      return false;
+    }
+    Number f = func_const_[n_con_];
+    for (Index k=row_start_[n_con_]; k<row_start_[n_con_+1]; k++) {
+      f += row_lin_[k]*x[row_var_[k]];
+    }
+    for (Index e=0; e<last-first; e++) {
+      f += elem_val[e];
+    }
+    obj_value = obj_sign_*f;
+    return IsFiniteNumber(obj_value);
+  }
+
+  bool NlTNLP::eval_grad_f(Index n, const Number* x, bool new_x,
+                           Number* grad_f)
+  {
+    DBG_START_METH("NlTNLP::eval_grad_f", dbg_verbosity);
+
+    const Index first = func_elem_start_[n_con_];
+    const Index last = func_elem_start_[n_con_+1];
+    const Index base = elem_grad_start_[first];
+    std::vector<Number> grad_buf(elem_grad_start_[last]-base);
+    if (!EvalElementGradients(x, first, last,
+                              grad_buf.empty() ? NULL : &grad_buf[0])) {
+      return false;
+    }
+    for (Index i=0; i<n; i++) {
+      grad_f[i] = 0.;
+    }
+    for (Index k=row_start_[n_con_]; k<row_start_[n_con_+1]; k++) {
+      Number g = row_lin_[k];
+      for (Index l=row_contrib_start_[k]; l<row_contrib_start_[k+1]; l++) {
+        g += grad_buf[row_contrib_pos_[l]-base];
+      }
+      grad_f[row_var_[k]] = obj_sign_*g;
+    }
+    return true;
+  }
+
+  bool NlTNLP::eval_g(Index n, const Number* x, bool new_x,
+                      Index m, Number* g)
+  {
+    DBG_START_METH("NlTNLP::eval_g", dbg_verbosity);
+
+    const Index nelems = func_elem_start_[n_con_];
+    std::vector<Number> elem_val(nelems);
+    if (!EvalElements(x, 0, nelems, elem_val.empty() ? NULL : &elem_val[0])) {
+      return false;
+    }
+#ifdef _OPENMP
+    const Index nthreads = NumThreads(m/1000);
+    #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+    for (Index i=0; i<m; i++) {
+      Number val = func_const_[i];
+      for (Index k=row_start_[i]; k<row_start_[i+1]; k++) {
+        val += row_lin_[k]*x[row_var_[k]];
+      }
+      for (Index e=func_elem_start_[i]; e<func_elem_start_[i+1]; e++) {
+        val += elem_val[e];
+      }
+      g[i] = val;
+    }
+    return true;
+  }
+
+  bool NlTNLP::eval_jac_g(Index n, const Number* x, bool new_x,
+                          Index m, Index nele_jac, Index* iRow,
+                          Index *jCol, Number* values)
+  {
+    DBG_START_METH("NlTNLP::eval_jac_g", dbg_verbosity);
+
+    if (iRow && jCol && !values) {
+      for (Index i=0; i<m; i++) {
+        for (Index k=row_start_[i]; k<row_start_[i+1]; k++) {
+          iRow[k] = i;
+          jCol[k] = row_var_[k];
+        }
+      }
+      return true;
+    }
+    if (!iRow && !jCol && values) {
+      const Index nelems = func_elem_start_[n_con_];
+      std::vector<Number> grad_buf(elem_grad_start_[nelems]);
+      if (!EvalElementGradients(x, 0, nelems,
+                                grad_buf.empty() ? NULL : &grad_buf[0])) {
+        return false;
+      }
+#ifdef _OPENMP
+      const Index nthreads = NumThreads(nele_jac/10000);
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index k=0; k<nele_jac; k++) {
+        Number val = row_lin_[k];
+        for (Index l=row_contrib_start_[k]; l<row_contrib_start_[k+1]; l++) {
+          val += grad_buf[row_contrib_pos_[l]];
+        }
+        values[k] = val;
+      }
+      return true;
+    }
+    DBG_ASSERT(false && "Invalid combination of iRow, jCol, and values pointers");
+    return false;
+  }
+
+  bool NlTNLP::eval_h(Index n, const Number* x, bool new_x,
+                      Number obj_factor, Index m, const Number* lambda,
+                      bool new_lambda, Index nele_hess, Index* iRow,
+                      Index* jCol, Number* values)
+  {
+    DBG_START_METH("NlTNLP::eval_h", dbg_verbosity);
+
+    if (iRow && jCol && !values) {
+      for (Index k=0; k<nele_hess; k++) {
+        iRow[k] = hess_row_[k];
+        jCol[k] = hess_col_[k];
+      }
+      return true;
+    }
+    if (!iRow && !jCol && values) {
+      // The Hessians of the elements are computed with the multipliers
+      // of their functions, and added up for each entry afterwards
+      const Index nelems = (Index)elem_tape_.size();
+      std::vector<Number> hess_buf(elem_hess_start_[nelems], 0.);
+      Index nfailed = 0;
+#ifdef _OPENMP
+      const Index nthreads = NumThreads(nelems);
+      #pragma omp parallel num_threads(nthreads) if(nthreads>1) reduction(+:nfailed)
+#endif
+      {
+        std::vector<Number> work(Max(Index(1), max_work_));
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic,64)
+#endif
+        for (Index e=0; e<nelems; e++) {
+          if (elem_hess_start_[e+1] == elem_hess_start_[e]) {
+            continue;
+          }
+          const Index f = elem_func_[e];
+          const Number mult = (f == n_con_) ? obj_sign_*obj_factor : lambda[f];
+          if (mult == 0.) {
+            continue;
+          }
+          if (!elem_tape_[e]->Hessian(x, mult*elem_coef_[e], &work[0],
+                                      &hess_buf[elem_hess_start_[e]])) {
+            nfailed++;
+          }
+        }
+      }
+      if (nfailed > 0) {
+        return false;
+      }
+#ifdef _OPENMP
+      const Index nthreads_sum = NumThreads(nele_hess/10000);
+      #pragma omp parallel for num_threads(nthreads_sum) if(nthreads_sum>1)
+#endif
+      for (Index k=0; k<nele_hess; k++) {
+        Number val = 0.;
+        for (Index l=hess_contrib_start_[k]; l<hess_contrib_start_[k+1]; l++) {
+          val += hess_buf[hess_contrib_pos_[l]];
+        }
+        values[k] = val;
+      }
+      return true;
+    }
+    DBG_ASSERT(false && "Invalid combination of iRow, jCol, and values pointers");
+    return false;
+  }
+
+  void NlTNLP::finalize_solution(SolverReturn status,
+                                 Index n, const Number* x, const Number* z_L, const Number* z_U,
+                                 Index m, const Number* g, const Number* lambda,
+                                 Number obj_value,
+                                 const IpoptData* ip_data,
+                                 IpoptCalculatedQuantities* ip_cq)
+  {
+    x_sol_.assign(x, x+n);
+    lambda_sol_.resize(m);
+    for (Index i=0; i<m; i++) {
+      lambda_sol_[i] = -obj_sign_*lambda[i];
+    }
+
+    std::string message;
+    if (status == SUCCESS) {
+      message = "Optimal Solution Found";
+      solve_result_num_ = 0;
+    }
+    else if (status == MAXITER_EXCEEDED) {
+      message = "Maximum Number of Iterations Exceeded.";
+      solve_result_num_ = 400;
+    }
+    else if (status == CPUTIME_EXCEEDED) {
+      message = "Maximum CPU Time Exceeded.";
+      solve_result_num_ = 401;
+    }
+    else if (status == STOP_AT_TINY_STEP) {
+      message = "Search Direction becomes Too Small.";
+      solve_result_num_ = 500;
+    }
+    else if (status == STOP_AT_ACCEPTABLE_POINT) {
+      message = "Solved To Acceptable Level.";
+      solve_result_num_ = 1;
+    }
+    else if (status == FEASIBLE_POINT_FOUND) {
+      message = "Found feasible point for square problem.";
+      solve_result_num_ = 2;
+    }
+    else if (status == LOCAL_INFEASIBILITY) {
+      message = "Converged to a locally infeasible point. Problem may be infeasible.";
+      solve_result_num_ = 200;
+    }
+    else if (status == RESTORATION_FAILURE) {
+      message = "Restoration Phase Failed.";
+      solve_result_num_ = 501;
+    }
+    else if (status == DIVERGING_ITERATES) {
+      message = "Iterates diverging; problem might be unbounded.";
+      solve_result_num_ = 300;
+    }
+    else {
+      message = "Unknown Error";
+      solve_result_num_ = 502;
+    }
+
+    if (write_sol_) {
+      write_solution_file("Ipopt " IPOPT_VERSION ": " + message);
+    }
+  }
+
+  void NlTNLP::write_solution_file(const std::string& message) const
+  {
+    const std::string filename = stub_ + ".sol";
+    FILE* fp = fopen(filename.c_str(), "w");
+    if (!fp) {
+      jnlst_->Printf(J_ERROR, J_MAIN,
+                     "Cannot open solution file %s.\n", filename.c_str());
+      return;
+    }
+    fprintf(fp, "%s\n\n", message.c_str());
+    if (!ampl_options_.empty() && ampl_options_[0] > 0) {
+      fprintf(fp, "Options\n");
+      for (Index i=0; i<(Index)ampl_options_.size(); i++) {
+        fprintf(fp, "%d\n", ampl_options_[i]);
+      }
+      if (ampl_options_.size() > 2 && ampl_options_[2] == 3) {
+        fprintf(fp, "%.17g\n", ampl_vbtol_);
+      }
+    }
+    const Index nduals = (Index)lambda_sol_.size();
+    const Index nprimals = (Index)x_sol_.size();
+    fprintf(fp, "%d\n%d\n%d\n%d\n", n_con_, nduals, n_var_, nprimals);
+    for (Index i=0; i<nduals; i++) {
+      fprintf(fp, "%.17g\n", lambda_sol_[i]);
+    }
+    for (Index i=0; i<nprimals; i++) {
+      fprintf(fp, "%.17g\n", x_sol_[i]);
+    }
+    fprintf(fp, "objno 0 %d\n", solve_result_num_);
+    fclose(fp);
+  }
+
+} // namespace Ipopt
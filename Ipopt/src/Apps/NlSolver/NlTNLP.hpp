@@ -0,0 +1,279 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __NLTNLP_HPP__
+#define __NLTNLP_HPP__
+
+#include "IpTNLP.hpp"
+#include "IpJournalist.hpp"
+#include "IpException.hpp"
+#include "IpSmartPtr.hpp"
+#include "NlTape.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Ipopt
+{
+  /** TNLP for a problem in an AMPL .nl file (text or binary format),
+   *  which does not require the AMPL Solver Library.
+   *
+   *  The nonlinear parts of the objective and the constraints are
+   *  split at the top-level sums into elements, and each element is
+   *  compiled into an NlTape.  Defined variables (common expressions)
+   *  are evaluated only once within an element.  The Hessian of the
+   *  Lagrangian is assembled from the dense Hessians of the nonlinear
+   *  elements with respect to their variables.
+   *
+   *  The elements are evaluated concurrently (if Ipopt has been
+   *  compiled with OpenMP support), and the evaluation methods do not
+   *  change the state of the object, so that they can also be called
+   *  concurrently at different points.
+   *
+   *  Imported functions, logical and complementarity constraints, and
+   *  network constraints are not supported.  Integer variables are
+   *  relaxed to continuous variables.  Only the first objective is
+   *  used.
+   */
+  class NlTNLP : public TNLP
+  {
+  public:
+    /**@name Constructors/Destructors */
+    //@{
+    /** Constructor.  Reads the problem from the file stub (".nl" is
+     *  appended if stub does not end with it).  If write_sol is true,
+     *  the solution is written to the AMPL solution file (with the
+     *  extension ".sol") in finalize_solution.  num_threads is the
+     *  number of threads for the evaluations, 0 for the OpenMP
+     *  default. */
+    NlTNLP(const SmartPtr<const Journalist>& jnlst,
+           const std::string& stub,
+           bool write_sol = false,
+           Index num_threads = 0);
+
+    /** Default destructor */
+    virtual ~NlTNLP();
+    //@}
+
+    /** Exceptions */
+    //@{
+    DECLARE_STD_EXCEPTION(INVALID_NL_FILE);
+    //@}
+
+    /**@name methods to gather information about the NLP. These
+     * methods are overloaded from TNLP. See TNLP for their more
+     * detailed documentation. */
+    //@{
+    /** returns dimensions of the nlp. Overloaded from TNLP */
+    virtual bool get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
+                              Index& nnz_h_lag, IndexStyleEnum& index_style);
+
+    /** returns bounds of the nlp. Overloaded from TNLP */
+    virtual bool get_bounds_info(Index n, Number* x_l, Number* x_u,
+                                 Index m, Number* g_l, Number* g_u);
+
+    /** Returns the constraint linearity.  Overloaded from TNLP */
+    virtual bool get_constraints_linearity(Index m,
+                                           LinearityType* const_types);
+
+    /** provides a starting point for the nlp variables. Overloaded
+    from TNLP */
+    virtual bool get_starting_point(Index n, bool init_x, Number* x,
+                                    bool init_z, Number* z_L, Number* z_U,
+                                    Index m, bool init_lambda, Number* lambda);
+
+    /** evaluates the objective value for the nlp. Overloaded from TNLP */
+    virtual bool eval_f(Index n, const Number* x, bool new_x,
+                        Number& obj_value);
+
+    /** evaluates the gradient of the objective for the
+    nlp. Overloaded from TNLP */
+    virtual bool eval_grad_f(Index n, const Number* x, bool new_x,
+                             Number* grad_f);
+
+    /** evaluates the constraint residuals for the nlp. Overloaded from TNLP */
+    virtual bool eval_g(Index n, const Number* x, bool new_x,
+                        Index m, Number* g);
+
+    /** specifies the jacobian structure (if values is NULL) and
+     *  evaluates the jacobian values (if values is not NULL) for the
+     *  nlp. Overloaded from TNLP */
+    virtual bool eval_jac_g(Index n, const Number* x, bool new_x,
+                            Index m, Index nele_jac, Index* iRow,
+                            Index *jCol, Number* values);
+
+    /** specifies the structure of the hessian of the lagrangian (if
+     *  values is NULL) and evaluates the values (if values is not
+     *  NULL). Overloaded from TNLP */
+    virtual bool eval_h(Index n, const Number* x, bool new_x,
+                        Number obj_factor, Index m, const Number* lambda,
+                        bool new_lambda, Index nele_hess, Index* iRow,
+                        Index* jCol, Number* values);
+
+    /** The evaluations do not change the state of this object.
+     *  Overloaded from TNLP */
+    virtual bool thread_safe_evaluation()
+    {
+      return true;
+    }
+    //@}
+
+    /** @name Solution Methods */
+    //@{
+    virtual void finalize_solution(SolverReturn status,
+                                   Index n, const Number* x, const Number* z_L, const Number* z_U,
+                                   Index m, const Number* g, const Number* lambda,
+                                   Number obj_value,
+                                   const IpoptData* ip_data,
+                                   IpoptCalculatedQuantities* ip_cq);
+    //@}
+
+    /** Write the solution file in the AMPL format with the given
+     *  message. */
+    void write_solution_file(const std::string& message) const;
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Default Constructor */
+    NlTNLP();
+
+    /** Copy Constructor */
+    NlTNLP(const NlTNLP&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const NlTNLP&);
+    //@}
+
+    /** Read the .nl file and set up the functions. */
+    void ReadNlFile(const std::string& filename);
+
+    /** Evaluate the elements first_elem to last_elem-1 at x.  The
+     *  values (times the coefficients of the elements) are stored in
+     *  elem_val. */
+    bool EvalElements(const Number* x, Index first_elem, Index last_elem,
+                      Number* elem_val) const;
+
+    /** Evaluate the gradients of the elements first_elem to
+     *  last_elem-1 at x (times the coefficients of the elements) into
+     *  grad_buf (at the positions elem_grad_start_). */
+    bool EvalElementGradients(const Number* x, Index first_elem,
+                              Index last_elem, Number* grad_buf) const;
+
+    /** Number of threads for an evaluation of nitems items */
+    Index NumThreads(Index nitems) const;
+
+    /** Journalist */
+    SmartPtr<const Journalist> jnlst_;
+
+    /** Name of the problem (the stub without ".nl") */
+    std::string stub_;
+
+    /** Flag indicating whether the solution file is written */
+    bool write_sol_;
+
+    /** Number of threads for the evaluations (0 for the OpenMP
+     *  default) */
+    Index num_threads_;
+
+    /** Options from the first line of the .nl file, which are written
+     *  back to the solution file */
+    std::vector<Index> ampl_options_;
+    Number ampl_vbtol_;
+
+    /**@name Problem Size Data*/
+    //@{
+    Index n_var_;
+    Index n_con_;
+    Index n_obj_;
+    //@}
+
+    /** Sign of the objective (1 for min, -1 for max) */
+    Number obj_sign_;
+
+    /**@name Bounds and starting point */
+    //@{
+    std::vector<Number> x_l_;
+    std::vector<Number> x_u_;
+    std::vector<Number> g_l_;
+    std::vector<Number> g_u_;
+    std::vector<Number> x_init_;
+    std::vector<Number> y_init_;
+    std::vector<bool> have_y_init_;
+    //@}
+
+    /**@name Functions.  Function i<n_con_ is constraint i, function
+     *  n_con_ is the objective.  Each function is the sum of a
+     *  constant, a linear part, and coefficients times elements. */
+    //@{
+    /** Constant part of each function */
+    std::vector<Number> func_const_;
+    /** Elements of function f are func_elem_start_[f] to
+     *  func_elem_start_[f+1]-1 */
+    std::vector<Index> func_elem_start_;
+    /** Sparsity structure of the gradients of the functions: the
+     *  variables of function f are row_var_[row_start_[f]] to
+     *  row_var_[row_start_[f+1]-1], with the linear coefficients
+     *  row_lin_.  For the constraints, this is the Jacobian. */
+    std::vector<Index> row_start_;
+    std::vector<Index> row_var_;
+    std::vector<Number> row_lin_;
+    /** The gradient of element e (local variable j) is stored at
+     *  position elem_grad_start_[e]+j of the gradient buffer.  The
+     *  positions in the gradient buffer that contribute to entry k of
+     *  row_var_ are row_contrib_pos_[row_contrib_start_[k]] to
+     *  row_contrib_pos_[row_contrib_start_[k+1]-1]. */
+    std::vector<Index> elem_grad_start_;
+    std::vector<Index> row_contrib_start_;
+    std::vector<Index> row_contrib_pos_;
+    //@}
+
+    /**@name Elements */
+    //@{
+    /** Tape of each element */
+    std::vector<SmartPtr<NlTape> > elem_tape_;
+    /** Coefficient of each element */
+    std::vector<Number> elem_coef_;
+    /** Function of each element */
+    std::vector<Index> elem_func_;
+    /** Size of the work array for the evaluation of any element */
+    Index max_work_;
+    //@}
+
+    /**@name Hessian of the Lagrangian.  The lower triangle of the
+     *  Hessian of nonlinear element e is stored from position
+     *  elem_hess_start_[e] of the Hessian buffer (for linear elements,
+     *  elem_hess_start_[e]==elem_hess_start_[e+1]).  The positions that
+     *  contribute to the Hessian entry k are
+     *  hess_contrib_pos_[hess_contrib_start_[k]] to
+     *  hess_contrib_pos_[hess_contrib_start_[k+1]-1]. */
+    //@{
+    std::vector<Index> hess_row_;
+    std::vector<Index> hess_col_;
+    std::vector<Index> elem_hess_start_;
+    std::vector<Index> hess_contrib_start_;
+    std::vector<Index> hess_contrib_pos_;
+    //@}
+
+    /**@name Solution */
+    //@{
+    std::vector<Number> x_sol_;
+    std::vector<Number> lambda_sol_;
+    Index solve_result_num_;
+    //@}
+  };
+
+} // namespace Ipopt
+
+#endif
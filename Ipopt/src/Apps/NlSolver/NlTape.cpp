@@ -0,0 +1,628 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "NlTape.hpp"
+
+#ifdef HAVE_CMATH
+# include <cmath>
+#else
+# ifdef HAVE_MATH_H
+#  include <math.h>
+# else
+#  error "don't have header file for math"
+# endif
+#endif
+
+namespace Ipopt
+{
+
+  /** Value of an expression that is used as a logical value */
+  static inline bool NlTrue(Number value)
+  {
+    return value != 0.;
+  }
+
+  /** Truncation towards zero */
+  static inline Number NlTrunc(Number value)
+  {
+    return (value < 0.) ? ceil(value) : floor(value);
+  }
+
+  /** Value of the unary operation op for the operand a. */
+  static Number NlUnaryValue(Index op, Number a)
+  {
+    switch (op) {
+    case NL_FLOOR:
+      return floor(a);
+    case NL_CEIL:
+      return ceil(a);
+    case NL_ABS:
+      return fabs(a);
+    case NL_NEG:
+      return -a;
+    case NL_NOT:
+      return NlTrue(a) ? 0. : 1.;
+    case NL_TANH:
+      return tanh(a);
+    case NL_TAN:
+      return tan(a);
+    case NL_SQRT:
+      return sqrt(a);
+    case NL_SINH:
+      return sinh(a);
+    case NL_SIN:
+      return sin(a);
+    case NL_LOG10:
+      return log10(a);
+    case NL_LOG:
+      return log(a);
+    case NL_EXP:
+      return exp(a);
+    case NL_COSH:
+      return cosh(a);
+    case NL_COS:
+      return cos(a);
+    case NL_ATANH:
+      return 0.5*log((1.+a)/(1.-a));
+    case NL_ATAN:
+      return atan(a);
+    case NL_ASINH:
+      return log(a + sqrt(a*a+1.));
+    case NL_ASIN:
+      return asin(a);
+    case NL_ACOSH:
+      return log(a + sqrt(a*a-1.));
+    case NL_ACOS:
+      return acos(a);
+    case NL_SQUARE:
+      return a*a;
+    }
+    DBG_ASSERT(false && "unknown unary operation");
+    return 0.;
+  }
+
+  /** First (d1) and second (d2) derivative of the unary operation op
+   *  for the operand a and the value y. */
+  static void NlUnaryPartials(Index op, Number a, Number y,
+                              Number& d1, Number& d2)
+  {
+    switch (op) {
+    case NL_ABS:
+      d1 = (a >= 0.) ? 1. : -1.;
+      d2 = 0.;
+      return;
+    case NL_NEG:
+      d1 = -1.;
+      d2 = 0.;
+      return;
+    case NL_TANH:
+      d1 = 1. - y*y;
+      d2 = -2.*y*d1;
+      return;
+    case NL_TAN:
+      d1 = 1. + y*y;
+      d2 = 2.*y*d1;
+      return;
+    case NL_SQRT:
+      d1 = 0.5/y;
+      d2 = -0.5*d1/a;
+      return;
+    case NL_SINH:
+      d1 = cosh(a);
+      d2 = y;
+      return;
+    case NL_SIN:
+      d1 = cos(a);
+      d2 = -y;
+      return;
+    case NL_LOG10:
+      d1 = 1./(a*log(10.));
+      d2 = -d1/a;
+      return;
+    case NL_LOG:
+      d1 = 1./a;
+      d2 = -d1*d1;
+      return;
+    case NL_EXP:
+      d1 = y;
+      d2 = y;
+      return;
+    case NL_COSH:
+      d1 = sinh(a);
+      d2 = y;
+      return;
+    case NL_COS:
+      d1 = -sin(a);
+      d2 = -y;
+      return;
+    case NL_ATANH:
+      d1 = 1./(1.-a*a);
+      d2 = 2.*a*d1*d1;
+      return;
+    case NL_ATAN:
+      d1 = 1./(1.+a*a);
+      d2 = -2.*a*d1*d1;
+      return;
+    case NL_ASINH:
+      d1 = 1./sqrt(1.+a*a);
+      d2 = -a*d1*d1*d1;
+      return;
+    case NL_ASIN:
+      d1 = 1./sqrt(1.-a*a);
+      d2 = a*d1*d1*d1;
+      return;
+    case NL_ACOSH:
+      d1 = 1./sqrt(a*a-1.);
+      d2 = -a*d1*d1*d1;
+      return;
+    case NL_ACOS:
+      d1 = -1./sqrt(1.-a*a);
+      d2 = a*d1*d1*d1;
+      return;
+    case NL_SQUARE:
+      d1 = 2.*a;
+      d2 = 2.;
+      return;
+    }
+    // Piecewise constant operations
+    d1 = 0.;
+    d2 = 0.;
+  }
+
+  /** Value of the binary operation op for the operands a and b. */
+  static Number NlBinaryValue(Index op, Number a, Number b)
+  {
+    switch (op) {
+    case NL_PLUS:
+      return a + b;
+    case NL_MINUS:
+      return a - b;
+    case NL_MULT:
+      return a*b;
+    case NL_DIV:
+      return a/b;
+    case NL_REM:
+      return a - b*NlTrunc(a/b);
+    case NL_POW:
+    case NL_POW_CONST:
+    case NL_CONST_POW:
+      return pow(a, b);
+    case NL_LESS:
+      return (a > b) ? a - b : 0.;
+    case NL_OR:
+      return (NlTrue(a) || NlTrue(b)) ? 1. : 0.;
+    case NL_AND:
+      return (NlTrue(a) && NlTrue(b)) ? 1. : 0.;
+    case NL_LT:
+      return (a < b) ? 1. : 0.;
+    case NL_LE:
+      return (a <= b) ? 1. : 0.;
+    case NL_EQ:
+      return (a == b) ? 1. : 0.;
+    case NL_GE:
+      return (a >= b) ? 1. : 0.;
+    case NL_GT:
+      return (a > b) ? 1. : 0.;
+    case NL_NE:
+      return (a != b) ? 1. : 0.;
+    case NL_ATAN2:
+      return atan2(a, b);
+    case NL_INTDIV:
+      return NlTrunc(a/b);
+    case NL_ROUND: {
+      const Number scale = pow(10., b);
+      return floor(a*scale + 0.5)/scale;
+    }
+    case NL_TRUNC: {
+      const Number scale = pow(10., b);
+      return NlTrunc(a*scale)/scale;
+    }
+    }
+    DBG_ASSERT(false && "unknown binary operation");
+    return 0.;
+  }
+
+  /** First (fa, fb) and second (faa, fab, fbb) derivatives of the
+   *  binary operation op for the operands a and b and the value y. */
+  static void NlBinaryPartials(Index op, Number a, Number b, Number y,
+                               Number& fa, Number& fb,
+                               Number& faa, Number& fab, Number& fbb)
+  {
+    fa = fb = faa = fab = fbb = 0.;
+    switch (op) {
+    case NL_PLUS:
+      fa = 1.;
+      fb = 1.;
+      return;
+    case NL_MINUS:
+      fa = 1.;
+      fb = -1.;
+      return;
+    case NL_MULT:
+      fa = b;
+      fb = a;
+      fab = 1.;
+      return;
+    case NL_DIV:
+      fa = 1./b;
+      fb = -y/b;
+      fab = -fa*fa;
+      fbb = -2.*fb/b;
+      return;
+    case NL_REM:
+      fa = 1.;
+      fb = -NlTrunc(a/b);
+      return;
+    case NL_POW:
+    case NL_POW_CONST:
+      // The exponent is constant for NL_POW_CONST; the cases b==0 and
+      // b==1 are treated separately to avoid 0*inf for a==0
+      if (b != 0.) {
+        fa = b*pow(a, b-1.);
+        if (b != 1.) {
+          faa = b*(b-1.)*pow(a, b-2.);
+        }
+      }
+      if (op == NL_POW && a > 0.) {
+        const Number loga = log(a);
+        fb = y*loga;
+        fab = pow(a, b-1.)*(1. + b*loga);
+        fbb = fb*loga;
+      }
+      return;
+    case NL_CONST_POW:
+      if (a > 0.) {
+        const Number loga = log(a);
+        fb = y*loga;
+        fbb = fb*loga;
+      }
+      return;
+    case NL_LESS:
+      if (a > b) {
+        fa = 1.;
+        fb = -1.;
+      }
+      return;
+    case NL_ATAN2: {
+      const Number r = a*a + b*b;
+      fa = b/r;
+      fb = -a/r;
+      faa = -2.*a*b/(r*r);
+      fab = (a*a - b*b)/(r*r);
+      fbb = -faa;
+      return;
+    }
+    }
+    // Logical, relational and piecewise constant operations
+  }
+
+  /** Position of the operand of a minimum, maximum, or if-then-else
+   *  node that determines its value. */
+  static inline Index NlSelectedArg(Index op, Index nargs, const Index* args,
+                                    const Number* val, Number y)
+  {
+    if (op == NL_IF) {
+      return NlTrue(val[args[0]]) ? args[1] : args[2];
+    }
+    for (Index i=0; i<nargs; i++) {
+      if (val[args[i]] == y) {
+        return args[i];
+      }
+    }
+    return args[0];
+  }
+
+  NlTape::NlTape()
+  {
+    arg_start_.push_back(0);
+  }
+
+  NlTape::~NlTape()
+  {}
+
+  Index NlTape::AddConstant(Number value)
+  {
+    op_.push_back(NL_NUM);
+    value_.push_back(value);
+    arg_start_.push_back((Index)args_.size());
+    return NumNodes()-1;
+  }
+
+  Index NlTape::AddVariable(Index var)
+  {
+    std::map<Index, Index>::iterator it = var_pos_.find(var);
+    if (it != var_pos_.end()) {
+      return var_node_[it->second];
+    }
+    const Index pos = (Index)vars_.size();
+    var_pos_[var] = pos;
+    vars_.push_back(var);
+    var_node_.push_back(NumNodes());
+    op_.push_back(NL_VAR);
+    value_.push_back(0.);
+    args_.push_back(pos);
+    arg_start_.push_back((Index)args_.size());
+    return NumNodes()-1;
+  }
+
+  Index NlTape::AddOperation(Index op, Index nargs, const Index* args)
+  {
+    op_.push_back(op);
+    value_.push_back(0.);
+    for (Index i=0; i<nargs; i++) {
+      DBG_ASSERT(args[i] < NumNodes()-1);
+      args_.push_back(args[i]);
+    }
+    arg_start_.push_back((Index)args_.size());
+    return NumNodes()-1;
+  }
+
+  bool NlTape::IsLinear() const
+  {
+    for (Index k=0; k<NumNodes(); k++) {
+      switch (op_[k]) {
+      case NL_NUM:
+      case NL_VAR:
+      case NL_PLUS:
+      case NL_MINUS:
+      case NL_NEG:
+      case NL_SUM:
+        break;
+      default:
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool NlTape::Forward(const Number* x, Number* val) const
+  {
+    const Index nnodes = NumNodes();
+    for (Index k=0; k<nnodes; k++) {
+      const Index* a = &args_[0] + arg_start_[k];
+      const Index nargs = arg_start_[k+1] - arg_start_[k];
+      const Index op = op_[k];
+      switch (op) {
+      case NL_NUM:
+        val[k] = value_[k];
+        break;
+      case NL_VAR:
+        val[k] = x[vars_[a[0]]];
+        break;
+      case NL_SUM: {
+        Number sum = 0.;
+        for (Index i=0; i<nargs; i++) {
+          sum += val[a[i]];
+        }
+        val[k] = sum;
+        break;
+      }
+      case NL_MIN:
+      case NL_MAX: {
+        Number y = val[a[0]];
+        for (Index i=1; i<nargs; i++) {
+          y = (op == NL_MIN) ? Min(y, val[a[i]]) : Max(y, val[a[i]]);
+        }
+        val[k] = y;
+        break;
+      }
+      case NL_ANDLIST:
+      case NL_ORLIST: {
+        bool y = (op == NL_ANDLIST);
+        for (Index i=0; i<nargs; i++) {
+          if (op == NL_ANDLIST) {
+            y = y && NlTrue(val[a[i]]);
+          }
+          else {
+            y = y || NlTrue(val[a[i]]);
+          }
+        }
+        val[k] = y ? 1. : 0.;
+        break;
+      }
+      case NL_IF:
+        val[k] = NlTrue(val[a[0]]) ? val[a[1]] : val[a[2]];
+        break;
+      default:
+        if (nargs == 1) {
+          val[k] = NlUnaryValue(op, val[a[0]]);
+        }
+        else {
+          val[k] = NlBinaryValue(op, val[a[0]], val[a[1]]);
+        }
+      }
+    }
+    return IsFiniteNumber(val[nnodes-1]);
+  }
+
+  void NlTape::Reverse(const Number* val, Number factor, Number* bar) const
+  {
+    const Index nnodes = NumNodes();
+    for (Index k=0; k<nnodes-1; k++) {
+      bar[k] = 0.;
+    }
+    bar[nnodes-1] = factor;
+    for (Index k=nnodes-1; k>=0; k--) {
+      const Number yb = bar[k];
+      if (yb == 0.) {
+        continue;
+      }
+      const Index* a = &args_[0] + arg_start_[k];
+      const Index nargs = arg_start_[k+1] - arg_start_[k];
+      const Index op = op_[k];
+      switch (op) {
+      case NL_NUM:
+      case NL_VAR:
+      case NL_ANDLIST:
+      case NL_ORLIST:
+        break;
+      case NL_SUM:
+        for (Index i=0; i<nargs; i++) {
+          bar[a[i]] += yb;
+        }
+        break;
+      case NL_MIN:
+      case NL_MAX:
+      case NL_IF:
+        bar[NlSelectedArg(op, nargs, a, val, val[k])] += yb;
+        break;
+      default:
+        if (nargs == 1) {
+          Number d1, d2;
+          NlUnaryPartials(op, val[a[0]], val[k], d1, d2);
+          bar[a[0]] += d1*yb;
+        }
+        else {
+          Number fa, fb, faa, fab, fbb;
+          NlBinaryPartials(op, val[a[0]], val[a[1]], val[k],
+                           fa, fb, faa, fab, fbb);
+          bar[a[0]] += fa*yb;
+          bar[a[1]] += fb*yb;
+        }
+      }
+    }
+  }
+
+  bool NlTape::Evaluate(const Number* x, Number* work, Number& value) const
+  {
+    bool retval = Forward(x, work);
+    value = work[NumNodes()-1];
+    return retval;
+  }
+
+  bool NlTape::Gradient(const Number* x, Number factor, Number* work,
+                        Number& value, Number* grad) const
+  {
+    Number* val = work;
+    Number* bar = work + NumNodes();
+    if (!Forward(x, val)) {
+      return false;
+    }
+    value = val[NumNodes()-1];
+    Reverse(val, factor, bar);
+    for (Index j=0; j<NumVariables(); j++) {
+      grad[j] += bar[var_node_[j]];
+    }
+    return true;
+  }
+
+  bool NlTape::Hessian(const Number* x, Number factor, Number* work,
+                       Number* hess) const
+  {
+    const Index nnodes = NumNodes();
+    const Index nvars = NumVariables();
+    Number* val = work;
+    Number* bar = work + nnodes;
+    Number* dot = work + 2*nnodes;
+    Number* bardot = work + 3*nnodes;
+    if (!Forward(x, val)) {
+      return false;
+    }
+    // The adjoints do not depend on the direction
+    Reverse(val, factor, bar);
+
+    for (Index j=0; j<nvars; j++) {
+      // Forward tangent sweep in the direction of variable j
+      for (Index k=0; k<nnodes; k++) {
+        const Index* a = &args_[0] + arg_start_[k];
+        const Index nargs = arg_start_[k+1] - arg_start_[k];
+        const Index op = op_[k];
+        switch (op) {
+        case NL_NUM:
+        case NL_ANDLIST:
+        case NL_ORLIST:
+          dot[k] = 0.;
+          break;
+        case NL_VAR:
+          dot[k] = (a[0] == j) ? 1. : 0.;
+          break;
+        case NL_SUM: {
+          Number sum = 0.;
+          for (Index i=0; i<nargs; i++) {
+            sum += dot[a[i]];
+          }
+          dot[k] = sum;
+          break;
+        }
+        case NL_MIN:
+        case NL_MAX:
+        case NL_IF:
+          dot[k] = dot[NlSelectedArg(op, nargs, a, val, val[k])];
+          break;
+        default:
+          if (nargs == 1) {
+            Number d1, d2;
+            NlUnaryPartials(op, val[a[0]], val[k], d1, d2);
+            dot[k] = d1*dot[a[0]];
+          }
+          else {
+            Number fa, fb, faa, fab, fbb;
+            NlBinaryPartials(op, val[a[0]], val[a[1]], val[k],
+                             fa, fb, faa, fab, fbb);
+            dot[k] = fa*dot[a[0]] + fb*dot[a[1]];
+          }
+        }
+      }
+
+      // Reverse sweep for the derivatives of the adjoints
+      for (Index k=0; k<nnodes; k++) {
+        bardot[k] = 0.;
+      }
+      for (Index k=nnodes-1; k>=0; k--) {
+        const Number yb = bar[k];
+        const Number ybd = bardot[k];
+        if (yb == 0. && ybd == 0.) {
+          continue;
+        }
+        const Index* a = &args_[0] + arg_start_[k];
+        const Index nargs = arg_start_[k+1] - arg_start_[k];
+        const Index op = op_[k];
+        switch (op) {
+        case NL_NUM:
+        case NL_VAR:
+        case NL_ANDLIST:
+        case NL_ORLIST:
+          break;
+        case NL_SUM:
+          for (Index i=0; i<nargs; i++) {
+            bardot[a[i]] += ybd;
+          }
+          break;
+        case NL_MIN:
+        case NL_MAX:
+        case NL_IF:
+          bardot[NlSelectedArg(op, nargs, a, val, val[k])] += ybd;
+          break;
+        default:
+          if (nargs == 1) {
+            Number d1, d2;
+            NlUnaryPartials(op, val[a[0]], val[k], d1, d2);
+            bardot[a[0]] += d1*ybd + yb*d2*dot[a[0]];
+          }
+          else {
+            Number fa, fb, faa, fab, fbb;
+            NlBinaryPartials(op, val[a[0]], val[a[1]], val[k],
+                             fa, fb, faa, fab, fbb);
+            const Number da = dot[a[0]];
+            const Number db = dot[a[1]];
+            bardot[a[0]] += fa*ybd + yb*(faa*da + fab*db);
+            bardot[a[1]] += fb*ybd + yb*(fab*da + fbb*db);
+          }
+        }
+      }
+
+      // Column j of the Hessian
+      Number* col = hess + j*nvars - (j*(j-1))/2 - j;
+      for (Index i=j; i<nvars; i++) {
+        col[i] += bardot[var_node_[i]];
+      }
+    }
+    return true;
+  }
+
+} // namespace Ipopt
@@ -0,0 +1,215 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __NLTAPE_HPP__
+#define __NLTAPE_HPP__
+
+#include "IpUtils.hpp"
+#include "IpReferenced.hpp"
+
+#include <map>
+#include <vector>
+
+namespace Ipopt
+{
+  /** Operation codes of the nodes of an NlTape.  The codes of the
+   *  operators are the ones used in the .nl file format (opcode.hd
+   *  in the AMPL Solver Library), so that they can be stored without
+   *  translation. */
+  enum NlOpCode
+  {
+    NL_PLUS = 0,
+    NL_MINUS = 1,
+    NL_MULT = 2,
+    NL_DIV = 3,
+    NL_REM = 4,
+    NL_POW = 5,
+    NL_LESS = 6,
+    NL_MIN = 11,
+    NL_MAX = 12,
+    NL_FLOOR = 13,
+    NL_CEIL = 14,
+    NL_ABS = 15,
+    NL_NEG = 16,
+    NL_OR = 20,
+    NL_AND = 21,
+    NL_LT = 22,
+    NL_LE = 23,
+    NL_EQ = 24,
+    NL_GE = 28,
+    NL_GT = 29,
+    NL_NE = 30,
+    NL_NOT = 34,
+    NL_IF = 35,
+    NL_TANH = 37,
+    NL_TAN = 38,
+    NL_SQRT = 39,
+    NL_SINH = 40,
+    NL_SIN = 41,
+    NL_LOG10 = 42,
+    NL_LOG = 43,
+    NL_EXP = 44,
+    NL_COSH = 45,
+    NL_COS = 46,
+    NL_ATANH = 47,
+    NL_ATAN2 = 48,
+    NL_ATAN = 49,
+    NL_ASINH = 50,
+    NL_ASIN = 51,
+    NL_ACOSH = 52,
+    NL_ACOS = 53,
+    NL_SUM = 54,
+    NL_INTDIV = 55,
+    NL_ROUND = 57,
+    NL_TRUNC = 58,
+    NL_ANDLIST = 70,
+    NL_ORLIST = 71,
+    NL_POW_CONST = 76,
+    NL_SQUARE = 77,
+    NL_CONST_POW = 78,
+    NL_NUM = 80,
+    NL_VAR = 82
+  };
+
+  /** Flat representation of an expression (a directed acyclic graph)
+   *  for evaluation and algorithmic differentiation.
+   *
+   *  The nodes are stored in topological order, i.e., the operands
+   *  of a node precede it, and the last node is the value of the
+   *  expression.  The operands of all nodes are stored consecutively
+   *  in one array, so that the sweeps over the tape run through
+   *  contiguous memory.  A variable node refers to a position in the
+   *  list of variables of the tape, which maps to the global variable
+   *  indices.
+   *
+   *  First derivatives are computed by a reverse sweep, second
+   *  derivatives by one forward tangent sweep and one reverse sweep
+   *  for each variable of the tape (forward-over-reverse).  The tape
+   *  itself is not changed during the evaluations, the values of the
+   *  nodes are kept in a work array provided by the caller, so that
+   *  the same tape can be evaluated by several threads.
+   */
+  class NlTape : public ReferencedObject
+  {
+  public:
+    /**@name Constructors/Destructors */
+    //@{
+    /** Constructor for an empty tape */
+    NlTape();
+
+    /** Default destructor */
+    virtual ~NlTape();
+    //@}
+
+    /**@name Methods for building the tape */
+    //@{
+    /** Add a constant node and return its position. */
+    Index AddConstant(Number value);
+
+    /** Add a node for the global variable var and return its
+     *  position.  Each variable is added only once. */
+    Index AddVariable(Index var);
+
+    /** Add an operation node with the nargs operands at the positions
+     *  in args and return its position. */
+    Index AddOperation(Index op, Index nargs, const Index* args);
+    //@}
+
+    /** Number of nodes */
+    Index NumNodes() const
+    {
+      return (Index)op_.size();
+    }
+
+    /** Number of variables */
+    Index NumVariables() const
+    {
+      return (Index)vars_.size();
+    }
+
+    /** Global indices of the variables, in the order of the local
+     *  positions used for the derivatives */
+    const std::vector<Index>& Variables() const
+    {
+      return vars_;
+    }
+
+    /** Returns true if the expression is linear in the variables,
+     *  i.e., it only consists of sums and differences. */
+    bool IsLinear() const;
+
+    /** Size of the work array (in Numbers) that is required by
+     *  Hessian; the other evaluation methods require less. */
+    Index WorkSize() const
+    {
+      return 4*NumNodes();
+    }
+
+    /** Evaluate the expression at the (global) point x.  The values
+     *  of the nodes are stored in work.  Returns false if the value
+     *  is not finite. */
+    bool Evaluate(const Number* x, Number* work, Number& value) const;
+
+    /** Evaluate the expression and its gradient.  factor times the
+     *  gradient with respect to the variables of the tape is added to
+     *  grad (with the local positions). */
+    bool Gradient(const Number* x, Number factor, Number* work,
+                  Number& value, Number* grad) const;
+
+    /** Compute factor times the Hessian of the expression.  The lower
+     *  triangle of the (dense) Hessian with respect to the variables
+     *  of the tape is added to hess column by column, i.e., the
+     *  element (i,j) with i>=j is at position j*nv - j*(j-1)/2 + i - j
+     *  for nv variables. */
+    bool Hessian(const Number* x, Number factor, Number* work,
+                 Number* hess) const;
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Copy Constructor */
+    NlTape(const NlTape&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const NlTape&);
+    //@}
+
+    /** Forward sweep, computing the values of all nodes. */
+    bool Forward(const Number* x, Number* val) const;
+
+    /** Reverse sweep, computing the adjoints bar of all nodes for the
+     *  adjoint factor of the last node. */
+    void Reverse(const Number* val, Number factor, Number* bar) const;
+
+    /** Operation of each node */
+    std::vector<Index> op_;
+    /** Start of the operands of each node in args_ (one more entry
+     *  than nodes) */
+    std::vector<Index> arg_start_;
+    /** Operand positions; for a variable node, this is the local
+     *  position of the variable */
+    std::vector<Index> args_;
+    /** Value of a constant node */
+    std::vector<Number> value_;
+    /** Global indices of the variables */
+    std::vector<Index> vars_;
+    /** Node of each variable */
+    std::vector<Index> var_node_;
+    /** Local position of each global variable that has been added */
+    std::map<Index, Index> var_pos_;
+  };
+
+} // namespace Ipopt
+
+#endif
@@ -0,0 +1,188 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "NlTNLP.hpp"
+#include "IpIpoptApplication.hpp"
+
+#include "IpoptConfig.h"
+#ifdef HAVE_CSTRING
+# include <cstring>
+#else
+# ifdef HAVE_STRING_H
+#  include <string.h>
+# else
+#  error "don't have header file for string"
+# endif
+#endif
+
+#ifdef HAVE_CSTDLIB
+# include <cstdlib>
+#else
+# ifdef HAVE_STDLIB_H
+#  include <stdlib.h>
+# else
+#  error "don't have header file for stdlib"
+# endif
+#endif
+
+// for printf
+#ifdef HAVE_CSTDIO
+# include <cstdio>
+#else
+# ifdef HAVE_STDIO_H
+#  include <stdio.h>
+# else
+#  error "don't have header file for stdio"
+# endif
+#endif
+
+#include <sstream>
+
+using namespace Ipopt;
+
+/** Set an Ipopt option given as "name=value" (or "name value"
+ *  tokens from the ipopt_options environment variable).  Returns
+ *  false if the option is unknown or the value is invalid. */
+static bool SetOption(SmartPtr<IpoptApplication> app,
+                      const std::string& name, const std::string& value)
+{
+  SmartPtr<const RegisteredOption> option =
+    app->RegOptions()->GetOption(name);
+  if (IsNull(option)) {
+    printf("Unknown option \"%s\".\n", name.c_str());
+    return false;
+  }
+  bool ok;
+  switch (option->Type()) {
+  case OT_Number: {
+    char* end;
+    Number val = strtod(value.c_str(), &end);
+    ok = (*end == '\0') && app->Options()->SetNumericValue(name, val);
+    break;
+  }
+  case OT_Integer: {
+    char* end;
+    Index val = (Index)strtol(value.c_str(), &end, 10);
+    ok = (*end == '\0') && app->Options()->SetIntegerValue(name, val);
+    break;
+  }
+  default:
+    ok = app->Options()->SetStringValue(name, value);
+  }
+  if (!ok) {
+    printf("Invalid value \"%s\" for option \"%s\".\n",
+           value.c_str(), name.c_str());
+  }
+  return ok;
+}
+
+int main(int argc, char**args)
+{
+  SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+
+  // Check if executable is run only to print out options documentation
+  if (argc == 2) {
+    bool print_options = false;
+    bool print_latex_options = false;
+    if (!strcmp(args[1],"--print-options")) {
+      print_options = true;
+    }
+    else if (!strcmp(args[1],"--print-latex-options")) {
+      print_options = true;
+      print_latex_options = true;
+    }
+    if (print_options) {
+      SmartPtr<OptionsList> options = app->Options();
+      options->SetStringValue("print_options_documentation", "yes");
+      if (print_latex_options) {
+        options->SetStringValue("print_options_latex_mode", "yes");
+      }
+      app->Initialize("");
+      return 0;
+    }
+  }
+
+  if (argc < 2) {
+    printf("Usage: %s stub[.nl] [-AMPL] [option=value ...]\n"
+           "\n"
+           "Solves the problem in the AMPL .nl file without the AMPL Solver Library.\n"
+           "With -AMPL, the solution is written to stub.sol.  Options can also be\n"
+           "given in the environment variable ipopt_options.\n", args[0]);
+    return -1;
+  }
+
+  // Call Initialize the first time to create a journalist, but ignore
+  // any options file
+  ApplicationReturnStatus retval;
+  retval = app->Initialize("");
+  if (retval != Solve_Succeeded) {
+    printf("nl_ipopt.cpp: Error in first Initialize!!!!\n");
+    exit(-100);
+  }
+
+  // Options from the environment, then from the command line
+  const char* env_options = getenv("ipopt_options");
+  if (env_options) {
+    std::istringstream is(env_options);
+    std::string token;
+    while (is >> token) {
+      std::string::size_type eq = token.find('=');
+      std::string name = token.substr(0, eq);
+      std::string value;
+      if (eq != std::string::npos) {
+        value = token.substr(eq+1);
+      }
+      else if (!(is >> value)) {
+        printf("Missing value for option \"%s\".\n", name.c_str());
+        exit(-102);
+      }
+      if (!SetOption(app, name, value)) {
+        exit(-102);
+      }
+    }
+  }
+  bool write_sol = false;
+  for (int i=2; i<argc; i++) {
+    std::string arg = args[i];
+    std::string::size_type eq = arg.find('=');
+    if (arg == "-AMPL") {
+      write_sol = true;
+    }
+    else if (eq != std::string::npos && eq > 0) {
+      if (!SetOption(app, arg.substr(0, eq), arg.substr(eq+1))) {
+        exit(-102);
+      }
+    }
+    else {
+      printf("Invalid argument \"%s\".\n", arg.c_str());
+      exit(-102);
+    }
+  }
+
+  SmartPtr<TNLP> nl_tnlp;
+  try {
+    nl_tnlp = new NlTNLP(ConstPtr(app->Jnlst()), args[1], write_sol);
+  }
+  catch (IpoptException& exc) {
+    exc.ReportException(*app->Jnlst(), J_ERROR);
+    exit(-103);
+  }
+
+  // Call Initialize again to process output related options
+  retval = app->Initialize();
+  if (retval != Solve_Succeeded) {
+    printf("nl_ipopt.cpp: Error in second Initialize!!!!\n");
+    exit(-101);
+  }
+
+  retval = app->OptimizeTNLP(nl_tnlp);
+
+  // finalize_solution method in NlTNLP writes the solution file
+
+  return 0;
+}
@@ -0,0 +1,204 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#ifndef __IPATOMIC_HPP__
+#define __IPATOMIC_HPP__
+
+#include "IpTypes.hpp"
+
+/* Atomic operations are only used if several threads may run Ipopt
+ * at the same time, i.e., if Ipopt is compiled with OpenMP, or if
+ * IPOPT_THREADSAFE is defined (for applications that start the
+ * threads themselves).  Code that includes the Ipopt headers has to
+ * be compiled with the same setting as the Ipopt library. */
+#if defined(_OPENMP) || defined(IPOPT_THREADSAFE)
+# if defined(_MSC_VER)
+#  include <intrin.h>
+#  define IP_HAS_ATOMICS
+# elif defined(__GNUC__) || defined(__INTEL_COMPILER)
+#  define IP_HAS_ATOMICS
+# endif
+#endif
+
+/* Storage class of variables that have a separate instance in every
+ * thread (only used with IP_HAS_ATOMICS) */
+#if defined(IP_HAS_ATOMICS) && defined(_MSC_VER)
+# define IP_THREAD_LOCAL __declspec(thread)
+#elif defined(IP_HAS_ATOMICS)
+# define IP_THREAD_LOCAL __thread
+#else
+# define IP_THREAD_LOCAL
+#endif
+
+namespace Ipopt
+{
+  /** @name Atomic operations.
+   *
+   *  These functions are used for the few counters that are shared by
+   *  objects of different IpoptApplications (such as the reference
+   *  counts of objects handed from one application to the other, and
+   *  the counter for the tags of TaggedObjects), so that several
+   *  IpoptApplications can run in different threads at the same
+   *  time.  They are implemented with the builtin atomic functions of
+   *  the compiler.  In a serial build, or if those functions are not
+   *  known (IP_HAS_ATOMICS is not defined), plain increments are
+   *  used, and only one thread may run Ipopt at a time.
+   */
+  //@{
+#ifdef IP_HAS_ATOMICS
+  /** Type of the counters that are changed by atomic operations */
+  typedef volatile Index AtomicIndex;
+#else
+  typedef Index AtomicIndex;
+#endif
+
+  /** Increment x by one and return the new value. */
+  inline Index AtomicIncrement(AtomicIndex* x)
+  {
+#if defined(IP_HAS_ATOMICS) && defined(_MSC_VER)
+    return (Index)_InterlockedIncrement((volatile long*)x);
+#elif defined(IP_HAS_ATOMICS)
+    return __sync_add_and_fetch(x, 1);
+#else
+    return ++(*x);
+#endif
+  }
+
+  /** Decrement x by one and return the new value. */
+  inline Index AtomicDecrement(AtomicIndex* x)
+  {
+#if defined(IP_HAS_ATOMICS) && defined(_MSC_VER)
+    return (Index)_InterlockedDecrement((volatile long*)x);
+#elif defined(IP_HAS_ATOMICS)
+    return __sync_sub_and_fetch(x, 1);
+#else
+    return --(*x);
+#endif
+  }
+
+  /** Unsigned integer type with 64 bits */
+#if defined(_MSC_VER)
+  typedef unsigned __int64 UInt64;
+#else
+  typedef unsigned long long UInt64;
+#endif
+
+  /** Add n to x and return the new value. */
+  inline UInt64 AtomicAdd(volatile UInt64* x, UInt64 n)
+  {
+#if defined(IP_HAS_ATOMICS) && defined(_MSC_VER)
+    return (UInt64)_InterlockedExchangeAdd64((volatile __int64*)x,
+             (__int64)n) + n;
+#elif defined(IP_HAS_ATOMICS)
+    return __sync_add_and_fetch(x, n);
+#else
+    return (*x) += n;
+#endif
+  }
+  //@}
+
+  /** Simple lock for short critical sections (such as the lookup in
+   *  a cache that is shared by all IpoptApplications).  A thread
+   *  waiting for the lock spins, so that no operating system
+   *  primitives are required.  Without atomic operations, the lock
+   *  does nothing. */
+  class SpinLock
+  {
+  public:
+    SpinLock()
+        :
+        flag_(0)
+    {}
+
+    /** Wait until the lock is available and acquire it */
+    void Lock()
+    {
+#if defined(IP_HAS_ATOMICS) && defined(_MSC_VER)
+      while (_InterlockedExchange(&flag_, 1L) != 0) {
+        while (flag_ != 0) {}
+      }
+#elif defined(IP_HAS_ATOMICS)
+      while (__sync_lock_test_and_set(&flag_, 1L) != 0) {
+        while (flag_ != 0) {}
+      }
+#endif
+    }
+
+    /** Release the lock */
+    void Unlock()
+    {
+#if defined(IP_HAS_ATOMICS) && defined(_MSC_VER)
+      _InterlockedExchange(&flag_, 0L);
+#elif defined(IP_HAS_ATOMICS)
+      __sync_lock_release(&flag_);
+#endif
+    }
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Copy Constructor */
+    SpinLock(const SpinLock&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const SpinLock&);
+    //@}
+
+    /** 1 if the lock is held, 0 otherwise */
+    volatile long flag_;
+  };
+
+  /** Acquires a SpinLock for the lifetime of this object, so that the
+   *  lock is also released if an exception is thrown. */
+  class SpinLockGuard
+  {
+  public:
+    SpinLockGuard(SpinLock& lock)
+        :
+        lock_(lock)
+    {
+      lock_.Lock();
+    }
+
+    ~SpinLockGuard()
+    {
+      lock_.Unlock();
+    }
+
+  private:
+    /**@name Default Compiler Generated Methods
+     * (Hidden to avoid implicit creation/calling).
+     * These methods are not implemented and
+     * we do not want the compiler to implement
+     * them for us, so we declare them private
+     * and do not define them. This ensures that
+     * they will not be implicitly created/called. */
+    //@{
+    /** Default Constructor */
+    SpinLockGuard();
+
+    /** Copy Constructor */
+    SpinLockGuard(const SpinLockGuard&);
+
+    /** Overloaded Equals Operator */
+    void operator=(const SpinLockGuard&);
+    //@}
+
+    /** The lock held by this object */
+    SpinLock& lock_;
+  };
+
+} // namespace Ipopt
+
+#endif
@@ -23,6 +23,27 @@ namespace Ipopt
 #endif
 #ifdef IP_DEBUG_CACHE
 # include "IpDebug.hpp"
+#endif
+
+  /* If IP_INLINE_CACHE is defined (e.g., by adding -DIP_INLINE_CACHE
+   * to CXXFLAGS), CachedResults stores its results in a flat array
+   * of entries that hold the tags and scalar dependencies in place,
+   * instead of a list of DependentResult objects that observe their
+   * dependencies.  Lookups and additions then do not allocate memory
+   * and do not attach Observers to the TaggedObjects.  Since stale
+   * results are not detected before they are replaced, results can
+   * be kept alive a bit longer than with the default
+   * implementation. */
+#ifdef IP_INLINE_CACHE
+  /** Maximal number of TaggedObject and of Number dependencies of a
+   *  result.  Results with more dependencies are not cached. */
+# ifndef IP_INLINE_CACHE_MAX_DEPENDENTS
+#  define IP_INLINE_CACHE_MAX_DEPENDENTS 16
+# endif
+  /** Number of entries used for a cache of unlimited size */
+# ifndef IP_INLINE_CACHE_UNLIMITED_SIZE
+#  define IP_INLINE_CACHE_UNLIMITED_SIZE 16
+# endif
 #endif
 
   // Forward Declarations
@@ -235,6 +256,46 @@ namespace Ipopt
     /** maximum number of cached results */
     Int max_cache_size_;
 
+#ifdef IP_INLINE_CACHE
+    /** Entry of the cache with inline storage of the dependencies.
+     *  The tags are stored together with the addresses of the
+     *  objects.  Tag() stands for a NULL dependency. */
+    struct InlineEntry
+    {
+      /** The cached result */
+      T result;
+      /** Number of TaggedObject dependencies, or -1 if the entry is
+       *  not used */
+      Index ntags;
+      /** Number of Number dependencies */
+      Index nscalars;
+      /** Tags of the TaggedObject dependencies */
+      TaggedObject::Tag tags[IP_INLINE_CACHE_MAX_DEPENDENTS];
+      /** Number dependencies */
+      Number scalars[IP_INLINE_CACHE_MAX_DEPENDENTS];
+    };
+
+    /** Array of the entries, allocated when the first result is
+     *  added */
+    InlineEntry* entries_;
+
+    /** Number of entries in entries_ */
+    Int num_entries_;
+
+    /** Position of the most recently added entry */
+    Int newest_;
+
+    /** Add a result, given the dependencies as arrays */
+    void AddInlineResult(const T& result,
+                         const TaggedObject* const* dependents, Index ndeps,
+                         const Number* scalar_dependents, Index nscalars);
+
+    /** Find the entry for the dependencies given as arrays.  Returns
+     *  -1 if there is none. */
+    Int FindInlineEntry(const TaggedObject* const* dependents, Index ndeps,
+                        const Number* scalar_dependents,
+                        Index nscalars) const;
+#else
     /** list of currently cached results. */
     mutable std::list<DependentResult<T>*>* cached_results_;
 
@@ -243,6 +304,7 @@ namespace Ipopt
      *  GetDependentResult method.
      */
     void CleanupInvalidatedResults() const;
+#endif
 
     /** Print list of currently cached results */
     void DebugPrintCachedResults() const;
@@ -476,7 +538,13 @@ namespace Ipopt
   CachedResults<T>::CachedResults(Int max_cache_size)
       :
       max_cache_size_(max_cache_size),
+#ifdef IP_INLINE_CACHE
+      entries_(NULL),
+      num_entries_(0),
+      newest_(0)
+#else
       cached_results_(NULL)
+#endif
   {
 #ifdef IP_DEBUG_CACHE
     DBG_START_METH("CachedResults<T>::CachedResults", dbg_verbosity);
@@ -491,6 +559,9 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::!CachedResults()", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    delete [] entries_;
+#else
     if (cached_results_) {
       for (typename std::list< DependentResult<T>* >::iterator iter = cached_results_->
            begin();
@@ -507,6 +578,7 @@ namespace Ipopt
       delete result;
     }
     */
+#endif
   }
 
   template <class T>
@@ -518,6 +590,13 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::AddCachedResult", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    AddInlineResult(result,
+                    dependents.empty() ? NULL : &dependents[0],
+                    (Index)dependents.size(),
+                    scalar_dependents.empty() ? NULL : &scalar_dependents[0],
+                    (Index)scalar_dependents.size());
+#else
     CleanupInvalidatedResults();
 
     // insert the new one here
@@ -539,6 +618,7 @@ namespace Ipopt
 
 #ifdef IP_DEBUG_CACHE
     DBG_EXEC(2, DebugPrintCachedResults());
+#endif
 #endif
 
   }
@@ -559,6 +639,17 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::GetCachedResult", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    Int pos = FindInlineEntry(dependents.empty() ? NULL : &dependents[0],
+                              (Index)dependents.size(),
+                              scalar_dependents.empty() ? NULL : &scalar_dependents[0],
+                              (Index)scalar_dependents.size());
+    if (pos < 0) {
+      return false;
+    }
+    retResult = entries_[pos].result;
+    return true;
+#else
     if (!cached_results_)
       return false;
 
@@ -579,6 +670,7 @@ namespace Ipopt
 #endif
 
     return retValue;
+#endif
   }
 
   template <class T>
@@ -597,10 +689,14 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::AddCachedResult1Dep", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    AddInlineResult(result, &dependent1, 1, NULL, 0);
+#else
     std::vector<const TaggedObject*> dependents(1);
     dependents[0] = dependent1;
 
     AddCachedResult(result, dependents);
+#endif
   }
 
   template <class T>
@@ -610,10 +706,19 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::GetCachedResult1Dep", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    Int pos = FindInlineEntry(&dependent1, 1, NULL, 0);
+    if (pos < 0) {
+      return false;
+    }
+    retResult = entries_[pos].result;
+    return true;
+#else
     std::vector<const TaggedObject*> dependents(1);
     dependents[0] = dependent1;
 
     return GetCachedResult(retResult, dependents);
+#endif
   }
 
   template <class T>
@@ -625,11 +730,16 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::AddCachedResult2dDep", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    const TaggedObject* dependents[2] = {dependent1, dependent2};
+    AddInlineResult(result, dependents, 2, NULL, 0);
+#else
     std::vector<const TaggedObject*> dependents(2);
     dependents[0] = dependent1;
     dependents[1] = dependent2;
 
     AddCachedResult(result, dependents);
+#endif
   }
 
   template <class T>
@@ -639,11 +749,21 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::GetCachedResult2Dep", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    const TaggedObject* dependents[2] = {dependent1, dependent2};
+    Int pos = FindInlineEntry(dependents, 2, NULL, 0);
+    if (pos < 0) {
+      return false;
+    }
+    retResult = entries_[pos].result;
+    return true;
+#else
     std::vector<const TaggedObject*> dependents(2);
     dependents[0] = dependent1;
     dependents[1] = dependent2;
 
     return GetCachedResult(retResult, dependents);
+#endif
   }
 
   template <class T>
@@ -656,12 +776,17 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::AddCachedResult2dDep", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    const TaggedObject* dependents[3] = {dependent1, dependent2, dependent3};
+    AddInlineResult(result, dependents, 3, NULL, 0);
+#else
     std::vector<const TaggedObject*> dependents(3);
     dependents[0] = dependent1;
     dependents[1] = dependent2;
     dependents[2] = dependent3;
 
     AddCachedResult(result, dependents);
+#endif
   }
 
   template <class T>
@@ -673,18 +798,40 @@ namespace Ipopt
     DBG_START_METH("CachedResults<T>::GetCachedResult2Dep", dbg_verbosity);
 #endif
 
+#ifdef IP_INLINE_CACHE
+    const TaggedObject* dependents[3] = {dependent1, dependent2, dependent3};
+    Int pos = FindInlineEntry(dependents, 3, NULL, 0);
+    if (pos < 0) {
+      return false;
+    }
+    retResult = entries_[pos].result;
+    return true;
+#else
     std::vector<const TaggedObject*> dependents(3);
     dependents[0] = dependent1;
     dependents[1] = dependent2;
     dependents[2] = dependent3;
 
     return GetCachedResult(retResult, dependents);
+#endif
   }
 
   template <class T>
   bool CachedResults<T>::InvalidateResult(const std::vector<const TaggedObject*>& dependents,
                                           const std::vector<Number>& scalar_dependents)
   {
+#ifdef IP_INLINE_CACHE
+    Int pos = FindInlineEntry(dependents.empty() ? NULL : &dependents[0],
+                              (Index)dependents.size(),
+                              scalar_dependents.empty() ? NULL : &scalar_dependents[0],
+                              (Index)scalar_dependents.size());
+    if (pos < 0) {
+      return false;
+    }
+    entries_[pos].ntags = -1;
+    entries_[pos].result = T();
+    return true;
+#else
     if (!cached_results_)
       return false;
 
@@ -702,11 +849,18 @@ namespace Ipopt
     }
 
     return retValue;
+#endif
   }
 
   template <class T>
   void CachedResults<T>::Clear()
   {
+#ifdef IP_INLINE_CACHE
+    for (Int i=0; i<num_entries_; i++) {
+      entries_[i].ntags = -1;
+      entries_[i].result = T();
+    }
+#else
     if (!cached_results_)
       return;
 
@@ -717,6 +871,7 @@ namespace Ipopt
     }
 
     CleanupInvalidatedResults();
+#endif
   }
 
   template <class T>
@@ -724,8 +879,84 @@ namespace Ipopt
   {
     Clear();
     max_cache_size_ = max_cache_size;
+#ifdef IP_INLINE_CACHE
+    // The entries are allocated again for the new size
+    delete [] entries_;
+    entries_ = NULL;
+    num_entries_ = 0;
+    newest_ = 0;
+#endif
+  }
+
+#ifdef IP_INLINE_CACHE
+  template <class T>
+  void CachedResults<T>::AddInlineResult(const T& result,
+                                         const TaggedObject* const* dependents,
+                                         Index ndeps,
+                                         const Number* scalar_dependents,
+                                         Index nscalars)
+  {
+    if (max_cache_size_ == 0 || ndeps > IP_INLINE_CACHE_MAX_DEPENDENTS ||
+        nscalars > IP_INLINE_CACHE_MAX_DEPENDENTS) {
+      return;
+    }
+    if (!entries_) {
+      num_entries_ = max_cache_size_ > 0 ? max_cache_size_ :
+                     IP_INLINE_CACHE_UNLIMITED_SIZE;
+      entries_ = new InlineEntry[num_entries_];
+      for (Int i=0; i<num_entries_; i++) {
+        entries_[i].ntags = -1;
+      }
+      newest_ = num_entries_ - 1;
+    }
+
+    // Replace the oldest entry
+    newest_ = (newest_ + 1) % num_entries_;
+    InlineEntry& entry = entries_[newest_];
+    entry.result = result;
+    entry.ntags = ndeps;
+    entry.nscalars = nscalars;
+    for (Index i=0; i<ndeps; i++) {
+      entry.tags[i] = dependents[i] ? dependents[i]->GetTag() : TaggedObject::Tag();
+    }
+    for (Index i=0; i<nscalars; i++) {
+      entry.scalars[i] = scalar_dependents[i];
+    }
   }
 
+  template <class T>
+  Int CachedResults<T>::FindInlineEntry(const TaggedObject* const* dependents,
+                                        Index ndeps,
+                                        const Number* scalar_dependents,
+                                        Index nscalars) const
+  {
+    // Search from the most recently added entry to the oldest one
+    Int pos = newest_;
+    for (Int k=0; k<num_entries_; k++) {
+      const InlineEntry& entry = entries_[pos];
+      if (entry.ntags == ndeps && entry.nscalars == nscalars) {
+        bool identical = true;
+        for (Index i=0; i<ndeps; i++) {
+          if (entry.tags[i] !=
+              (dependents[i] ? dependents[i]->GetTag() : TaggedObject::Tag())) {
+            identical = false;
+            break;
+          }
+        }
+        for (Index i=0; identical && i<nscalars; i++) {
+          if (entry.scalars[i] != scalar_dependents[i]) {
+            identical = false;
+          }
+        }
+        if (identical) {
+          return pos;
+        }
+      }
+      pos = (pos == 0) ? num_entries_ - 1 : pos - 1;
+    }
+    return -1;
+  }
+#else
   template <class T>
   void CachedResults<T>::CleanupInvalidatedResults() const
   {
@@ -752,12 +983,14 @@ namespace Ipopt
       }
     }
   }
+#endif
 
   template <class T>
   void CachedResults<T>::DebugPrintCachedResults() const
   {
 #ifdef IP_DEBUG_CACHE
     DBG_START_METH("CachedResults<T>::DebugPrintCachedResults", dbg_verbosity);
+#ifndef IP_INLINE_CACHE
     if (DBG_VERBOSITY()>=2 ) {
       if (!cached_results_) {
         DBG_PRINT((2,"Currentlt no cached results:\n"));
@@ -770,6 +1003,7 @@ namespace Ipopt
         }
       }
     }
+#endif
 #endif
 
   }
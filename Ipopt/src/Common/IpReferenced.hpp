@@ -11,6 +11,7 @@
 
 #include "IpTypes.hpp"
 #include "IpDebug.hpp"
+#include "IpAtomic.hpp"
 
 #include <list>
 
@@ -170,6 +171,10 @@ namespace Ipopt
    * counts. To avoid this pitfall, we use an intrusive reference counting
    * technique where the reference count is stored in the object being
    * referenced. 
+   *
+   * The reference count is changed with atomic operations, so that
+   * objects can be shared by SmartPtrs in different threads.  (This
+   * does not make the referenced object itself thread-safe.)
    */
   class ReferencedObject
   {
@@ -190,11 +195,13 @@ namespace Ipopt
     inline
     void AddRef(const Referencer* referencer) const;
 
+    /** Decrease the reference count and return the new value.  The
+     *  object must be deleted by the caller if this is 0. */
     inline
-    void ReleaseRef(const Referencer* referencer) const;
+    Index ReleaseRef(const Referencer* referencer) const;
 
   private:
-    mutable Index reference_count_;
+    mutable AtomicIndex reference_count_;
 
 #   ifdef IP_DEBUG_REFERENCED
     mutable std::list<const Referencer*> referencers_;
@@ -215,7 +222,7 @@ namespace Ipopt
   void ReferencedObject::AddRef(const Referencer* referencer) const
   {
     //    DBG_START_METH("ReferencedObject::AddRef(const Referencer* referencer)", 0);
-    reference_count_++;
+    AtomicIncrement(&reference_count_);
     //    DBG_PRINT((1, "New reference_count_ = %d\n", reference_count_));
 #   ifdef IP_DEBUG_REFERENCED
     referencers_.push_back(referencer);
@@ -224,11 +231,11 @@ namespace Ipopt
   }
 
   inline
-  void ReferencedObject::ReleaseRef(const Referencer* referencer) const
+  Index ReferencedObject::ReleaseRef(const Referencer* referencer) const
   {
     //    DBG_START_METH("ReferencedObject::ReleaseRef(const Referencer* referencer)",
     //                   0);
-    reference_count_--;
+    Index new_count = AtomicDecrement(&reference_count_);
     //    DBG_PRINT((1, "New reference_count_ = %d\n", reference_count_));
 
 #   ifdef IP_DEBUG_REFERENCED
@@ -250,6 +257,7 @@ namespace Ipopt
     }
 #   endif
 
+    return new_count;
   }
 
 
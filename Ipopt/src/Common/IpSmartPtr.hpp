@@ -549,8 +549,9 @@ namespace Ipopt
 #endif
 
     if (ptr_) {
-      ptr_->ReleaseRef(this);
-      if (ptr_->ReferenceCount() == 0)
+      // Use the count returned by ReleaseRef, since another thread
+      // might release its reference to the object at the same time
+      if (ptr_->ReleaseRef(this) == 0)
         delete ptr_;
     }
   }
@@ -0,0 +1,42 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-16
+
+#include "IpTaggedObject.hpp"
+
+namespace Ipopt
+{
+  // The first tag is 1, so that no tag has the value of Tag()
+  volatile TaggedObject::Tag::second_type TaggedObject::unique_tag_ = 0;
+
+  /** Number of counter values that a thread takes at once */
+  static const TaggedObject::Tag::second_type tag_block_size = 1024;
+
+  /** The last counter value handed out by this thread, and the last
+   *  value of its current block */
+  static IP_THREAD_LOCAL TaggedObject::Tag::second_type last_tag = 0;
+  static IP_THREAD_LOCAL TaggedObject::Tag::second_type tag_block_end = 0;
+
+  TaggedObject::Tag::second_type TaggedObject::NewTag()
+  {
+    if (last_tag == tag_block_end) {
+      const Tag::second_type block_end =
+        AtomicAdd(&unique_tag_, tag_block_size);
+      // A counter that wrapped around would repeat tags that might
+      // still be stored by the users of the objects.  The limit
+      // leaves room for the blocks taken by other threads after the
+      // first thread noticed the overflow.
+      ASSERT_EXCEPTION(block_end >= tag_block_size &&
+                       block_end <= std::numeric_limits<Tag::second_type>::max()/2,
+                       TAG_COUNTER_OVERFLOW,
+                       "The counter for the tags of TaggedObjects overflowed.");
+      last_tag = block_end - tag_block_size;
+      tag_block_end = block_end;
+    }
+    return ++last_tag;
+  }
+} // namespace Ipopt
@@ -13,12 +13,18 @@
 #include "IpDebug.hpp"
 #include "IpReferenced.hpp"
 #include "IpObserver.hpp"
+#include "IpException.hpp"
 #include <limits>
 #include <utility> // for std::pair
 
 namespace Ipopt
 {
 
+  /** @name Exceptions */
+  //@{
+  DECLARE_STD_EXCEPTION(TAG_COUNTER_OVERFLOW);
+  //@}
+
   /** TaggedObject class.
    * Often, certain calculations or operations are expensive,
    * and it can be very inefficient to perform these calculations
@@ -65,9 +71,10 @@ namespace Ipopt
      *
      * To make the tag unique among all objects, we
      * include the memory address of the object into the
-     * tag value.
+     * tag value.  The counter has 64 bits, so that it does not
+     * overflow in practice (see NewTag).
      */
-    typedef std::pair<const TaggedObject*, unsigned int> Tag;
+    typedef std::pair<const TaggedObject*, UInt64> Tag;
 
     /** Constructor. */
     TaggedObject()
@@ -110,8 +117,7 @@ namespace Ipopt
     void ObjectChanged()
     {
       DBG_START_METH("TaggedObject::ObjectChanged()", 0);
-      tagcount_++;
-      DBG_ASSERT(tagcount_ < std::numeric_limits<Tag::second_type>::max());
+      tagcount_ = NewTag();
       // The Notify method from the Subject base class notifies all
       // registered Observers that this subject has changed.
       Notify(Observer::NT_Changed);
@@ -137,6 +143,19 @@ namespace Ipopt
      */
     Tag::second_type tagcount_;
 
+    /** Return a counter value that has not been given to any
+     *  TaggedObject before, so that a Tag is never repeated, even if
+     *  a new object is created at the address of an object that has
+     *  been deleted.  Every thread takes a block of values from the
+     *  shared counter unique_tag_ at once and hands them out one by
+     *  one, so that the threads do not contend for the counter with
+     *  every change of an object. */
+    static Tag::second_type NewTag();
+
+    /** The end of the last block of counter values taken by any
+     *  thread */
+    static volatile Tag::second_type unique_tag_;
+
     /** The index indicating the cache priority for this
      * TaggedObject. If a result that depended on this 
      * TaggedObject is cached, it will be cached with this
@@ -199,6 +199,41 @@ namespace Ipopt
   }
 
 
+  Number IpRandom01(unsigned short state[3])
+  {
+    // Linear congruential generator x <- (a*x + c) mod 2^48 of
+    // drand48, computed in 16 bit pieces
+    const unsigned long a0 = 0xE66D;
+    const unsigned long a1 = 0xDEEC;
+    const unsigned long a2 = 0x0005;
+    const unsigned long c = 0x000B;
+    const unsigned long x0 = state[0];
+    const unsigned long x1 = state[1];
+    const unsigned long x2 = state[2];
+
+    unsigned long t = a0*x0 + c;
+    state[0] = (unsigned short)(t & 0xFFFF);
+    unsigned long carry = t >> 16;
+    const unsigned long p01 = a0*x1;
+    const unsigned long p10 = a1*x0;
+    t = carry + (p01 & 0xFFFF) + (p10 & 0xFFFF);
+    state[1] = (unsigned short)(t & 0xFFFF);
+    carry = (t >> 16) + (p01 >> 16) + (p10 >> 16);
+    t = carry + a0*x2 + a1*x1 + a2*x0;
+    state[2] = (unsigned short)(t & 0xFFFF);
+
+    return (Number(state[2]) + (Number(state[1]) +
+                                Number(state[0])/65536.)/65536.)/65536.;
+  }
+
+  void IpResetRandom01(unsigned short state[3])
+  {
+    // Same as srand48(1)
+    state[0] = 0x330E;
+    state[1] = 1;
+    state[2] = 0;
+  }
+
   static double Wallclock_firstCall_ = -1.;
 
   // The following function were taken from CoinTime.hpp in COIN/Coin
@@ -104,6 +104,18 @@ namespace Ipopt
   /** Function resetting the random number generator */
   void IpResetRandom01();
 
+  /** Function returning a random number between 0 and 1, where the
+   *  state of the generator is given by the caller (as for erand48).
+   *  In contrast to IpRandom01, this can be used by several threads
+   *  at the same time.  The numbers are the same as those of drand48
+   *  after srand48(1) if the state has been reset by
+   *  IpResetRandom01(state). */
+  Number IpRandom01(unsigned short state[3]);
+
+  /** Function resetting the state of a random number generator for
+   *  IpRandom01(state) */
+  void IpResetRandom01(unsigned short state[3]);
+
   /** method determining CPU time */
   Number CpuTime();
 
@@ -42,6 +42,10 @@
 
 #include <fstream>
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 // Factory to facilitate creating IpoptApplication objects from within a DLL
 
 Ipopt::IpoptApplication * IpoptApplicationFactory()
@@ -307,6 +311,7 @@ namespace Ipopt
           options_to_print.push_back("mu_strategy");
           options_to_print.push_back("mu_oracle");
           options_to_print.push_back("quality_function_max_section_steps");
+          options_to_print.push_back("quality_function_grid_points");
           options_to_print.push_back("fixed_mu_oracle");
           options_to_print.push_back("adaptive_mu_globalization");
           options_to_print.push_back("mu_init");
@@ -329,6 +334,7 @@ namespace Ipopt
           options_to_print.push_back("watchdog_shortened_iter_trigger");
           options_to_print.push_back("watchdog_trial_iter_max");
           options_to_print.push_back("accept_every_trial_step");
+          options_to_print.push_back("concurrent_trial_points");
           options_to_print.push_back("corrector_type");
 
           options_to_print.push_back("#Warm Start");
@@ -353,6 +359,9 @@ namespace Ipopt
 
           options_to_print.push_back("#Linear Solver");
           options_to_print.push_back("linear_solver");
+          options_to_print.push_back("aug_system_solver");
+          options_to_print.push_back("schur_num_subdomains");
+          options_to_print.push_back("schur_num_threads");
           options_to_print.push_back("linear_system_scaling");
           options_to_print.push_back("linear_scaling_on_demand");
           options_to_print.push_back("max_refinement_steps");
@@ -656,6 +665,16 @@ namespace Ipopt
       "will cause the IpoptApplication object to suppress the default call to "
       "that method.");
 
+    roptions->SetRegisteringCategory("Main Algorithm");
+    roptions->AddLowerBoundedIntegerOption(
+      "batch_num_threads",
+      "Number of threads for the solution of a batch of problems.",
+      0, 0,
+      "This determines the number of threads in which the problems given "
+      "to IpoptApplication::OptimizeTNLPs are solved, if Ipopt has been "
+      "compiled with OpenMP support.  If this is 0, the OpenMP default "
+      "is used.");
+
     roptions->SetRegisteringCategory("Undocumented");
     roptions->AddStringOption2(
       "print_options_latex_mode",
@@ -701,6 +720,125 @@ namespace Ipopt
     return ReOptimizeNLP(nlp_adapter_);
   }
 
+  ApplicationReturnStatus
+  IpoptApplication::OptimizeTNLPs(const std::vector<SmartPtr<TNLP> >& tnlps,
+                                  std::vector<ApplicationReturnStatus>& status,
+                                  std::vector<SmartPtr<SolveStatistics> >& statistics)
+  {
+    DBG_START_METH("IpoptApplication::OptimizeTNLPs", dbg_verbosity);
+
+    const Index nproblems = (Index)tnlps.size();
+    status.assign(nproblems, Internal_Error);
+    statistics.assign(nproblems, SmartPtr<SolveStatistics>());
+    if (nproblems == 0) {
+      return Solve_Succeeded;
+    }
+
+    Index num_threads = 1;
+#ifdef _OPENMP
+    options_->GetIntegerValue("batch_num_threads", num_threads, "");
+    if (num_threads == 0) {
+      num_threads = omp_get_max_threads();
+    }
+#endif
+    num_threads = Min(num_threads, nproblems);
+
+    // The copies of the application are created here, since the
+    // options of this application must not be read by several
+    // threads at once
+    std::vector<SmartPtr<IpoptApplication> > workers(num_threads);
+    try {
+      for (Index t=0; t<num_threads; t++) {
+        workers[t] = CreateBatchWorker();
+      }
+    }
+    catch (const std::bad_alloc&) {
+      jnlst_->Printf(J_SUMMARY, J_MAIN, "\nEXIT: Not enough memory.\n");
+      status.assign(nproblems, Insufficient_Memory);
+      return Insufficient_Memory;
+    }
+
+    // Every thread takes the next problem that has not been taken
+    // yet, so that the work is balanced even if the solution times
+    // of the problems are very different
+    AtomicIndex next_problem = 0;
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(num_threads) if(num_threads>1)
+#endif
+    {
+#ifdef _OPENMP
+      IpoptApplication& worker = *workers[omp_get_thread_num()];
+#else
+      IpoptApplication& worker = *workers[0];
+#endif
+      while (true) {
+        const Index i = AtomicIncrement(&next_problem) - 1;
+        if (i >= nproblems) {
+          break;
+        }
+        status[i] = worker.OptimizeBatchTNLP(tnlps[i]);
+        statistics[i] = worker.Statistics();
+      }
+    }
+
+    for (Index i=0; i<nproblems; i++) {
+      if (status[i] != Solve_Succeeded) {
+        return status[i];
+      }
+    }
+    return Solve_Succeeded;
+  }
+
+  SmartPtr<IpoptApplication> IpoptApplication::CreateBatchWorker()
+  {
+    SmartPtr<Journalist> jnlst = new Journalist();
+    SmartPtr<OptionsList> options = new OptionsList();
+    *options = *options_;
+    options->SetJournalist(jnlst);
+    // Problems of a batch often have the same structure
+    options->SetStringValueIfUnset("symbolic_cache", "yes");
+
+    SmartPtr<IpoptApplication> worker =
+      new IpoptApplication(reg_options_, options, jnlst);
+    worker->read_params_dat_ = false;
+    worker->inexact_algorithm_ = inexact_algorithm_;
+    worker->replace_bounds_ = replace_bounds_;
+    return worker;
+  }
+
+  ApplicationReturnStatus
+  IpoptApplication::OptimizeBatchTNLP(const SmartPtr<TNLP>& tnlp)
+  {
+    // The objects can only be kept if the previous optimization has
+    // created them for the current TNLPAdapter
+    if (IsValid(alg_) && IsValid(ip_nlp_) && IsValid(nlp_adapter_) &&
+        !replace_bounds_) {
+      OrigIpoptNLP* orig_nlp =
+        static_cast<OrigIpoptNLP*> (GetRawPtr(ip_nlp_));
+      DBG_ASSERT(dynamic_cast<OrigIpoptNLP*> (GetRawPtr(ip_nlp_)));
+      TNLPAdapter* adapter =
+        static_cast<TNLPAdapter*> (GetRawPtr(nlp_adapter_));
+      DBG_ASSERT(dynamic_cast<TNLPAdapter*> (GetRawPtr(nlp_adapter_)));
+      bool same_structure = false;
+      if (orig_nlp->nlp() == nlp_adapter_) {
+        try {
+          same_structure = adapter->ReplaceTNLP(tnlp);
+        }
+        catch (...) {
+          // OptimizeTNLP reports the error
+        }
+      }
+      if (same_structure) {
+        return ReOptimizeNLP(nlp_adapter_);
+      }
+    }
+
+    // Do not keep the algorithm of the previous problem if the new
+    // objects cannot be built
+    alg_ = NULL;
+    return OptimizeTNLP(tnlp);
+  }
+
   ApplicationReturnStatus
   IpoptApplication::OptimizeNLP(const SmartPtr<NLP>& nlp)
   {
@@ -925,6 +1063,15 @@ namespace Ipopt
       jnlst_->Printf(J_SUMMARY, J_STATISTICS,
                      "Number of Lagrangian Hessian evaluations             = %d\n",
                      p2ip_nlp->h_evals());
+      if (p2ip_data->lowrank_correction_solves() > 0 ||
+          p2ip_data->lowrank_saved_solves() > 0) {
+        jnlst_->Printf(J_SUMMARY, J_STATISTICS,
+                       "Number of back-solves for low-rank corrections       = %d\n",
+                       p2ip_data->lowrank_correction_solves());
+        jnlst_->Printf(J_SUMMARY, J_STATISTICS,
+                       "Number of saved back-solves for low-rank corrections = %d\n",
+                       p2ip_data->lowrank_saved_solves());
+      }
       Number cpu_time_overall_alg = p2ip_data->TimingStats().OverallAlgorithm().TotalCpuTime();
       Number cpu_time_funcs = p2ip_nlp->TotalFunctionEvaluationCpuTime();
       jnlst_->Printf(J_SUMMARY, J_STATISTICS,
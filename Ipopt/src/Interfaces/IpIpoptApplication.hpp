@@ -22,6 +22,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 #include "IpJournalist.hpp"
 #include "IpTNLP.hpp"
@@ -91,6 +92,28 @@ namespace Ipopt
      *  and Hessian must be the same). */
     virtual ApplicationReturnStatus ReOptimizeTNLP(const SmartPtr<TNLP>& tnlp);
 
+    /** Solve a batch of problems, e.g., many small problems with the
+     *  same structure but different data.  The problems are handed
+     *  out one by one to the threads given by the option
+     *  "batch_num_threads" (if Ipopt is compiled with OpenMP
+     *  support).  Each thread solves its problems with its own copy
+     *  of this application, so that the options are processed only
+     *  once per thread, and the symbolic factorizations are shared by
+     *  all problems with the same structure (the option
+     *  "symbolic_cache" is enabled for the batch unless it has been
+     *  set by the user).  The solves of the batch do not produce any
+     *  output.
+     *
+     *  On return, status and statistics contain the return status
+     *  and the statistics (NULL if not available) for each problem.
+     *  The return value is Solve_Succeeded if this is the status of
+     *  all problems, and otherwise the status of the first problem
+     *  for which it is not.  The TNLPs must be different objects. */
+    virtual ApplicationReturnStatus OptimizeTNLPs(
+      const std::vector<SmartPtr<TNLP> >& tnlps,
+      std::vector<ApplicationReturnStatus>& status,
+      std::vector<SmartPtr<SolveStatistics> >& statistics);
+
     /** Solve a problem (that inherits from NLP) for a repeated time.
      *  The OptimizeNLP method must have been called before.  The
      *  NLP must be the same object, and the structure (number of
@@ -185,6 +208,17 @@ namespace Ipopt
      *  This is used both for Optimize and ReOptimize */
     ApplicationReturnStatus call_optimize();
 
+    /** Create a copy of this application for the solves of a batch
+     *  in one thread (see OptimizeTNLPs).  It has its own options
+     *  and a Journalist without output. */
+    SmartPtr<IpoptApplication> CreateBatchWorker();
+
+    /** Solve one problem of a batch (see OptimizeTNLPs).  If the
+     *  previous problem of this application has the same structure,
+     *  the algorithm objects, the spaces of the TNLPAdapter and the
+     *  linear solver are kept, and only the TNLP is replaced. */
+    ApplicationReturnStatus OptimizeBatchTNLP(const SmartPtr<TNLP>& tnlp);
+
     /**@name Variables that customize the application behavior */
     //@{
     /** Decide whether or not the ipopt.opt file should be read */
@@ -132,6 +132,22 @@ namespace Ipopt
                         const Vector& yc,
                         const Vector& yd,
                         SymMatrix& h) = 0;
+
+    /** Evaluates the objective function and the equality and
+     *  inequality constraints at the npoints points x[i]
+     *  concurrently.  success[i] is set to false if the evaluation
+     *  at x[i] failed.  Returns false if concurrent evaluations are
+     *  not supported, in which case nothing is computed.  The
+     *  default implementation returns false. */
+    virtual bool Eval_f_c_d_Concurrently(Index npoints,
+                                         const Vector* const* x,
+                                         Number* f,
+                                         Vector* const* c,
+                                         Vector* const* d,
+                                         bool* success)
+    {
+      return false;
+    }
     //@}
 
     /** @name NLP solution routines. Have default dummy
@@ -28,6 +28,8 @@ namespace Ipopt
       num_obj_grad_evals_(ip_nlp->grad_f_evals()),
       num_constr_jac_evals_(Max(ip_nlp->jac_c_evals(),ip_nlp->jac_d_evals())),
       num_hess_evals_(ip_nlp->h_evals()),
+      num_lowrank_solves_(ip_data->lowrank_correction_solves()),
+      num_saved_lowrank_solves_(ip_data->lowrank_saved_solves()),
 
       scaled_obj_val_(ip_cq->curr_f()),
       obj_val_(ip_cq->unscaled_curr_f()),
@@ -75,6 +77,14 @@ namespace Ipopt
     num_hess_evals = num_hess_evals_;
   }
 
+  void SolveStatistics::NumberOfLowRankSolves(
+    Index& num_lowrank_solves,
+    Index& num_saved_lowrank_solves) const
+  {
+    num_lowrank_solves = num_lowrank_solves_;
+    num_saved_lowrank_solves = num_saved_lowrank_solves_;
+  }
+
   void SolveStatistics::Infeasibilities(Number& dual_inf,
                                         Number& constr_viol,
                                         Number& complementarity,
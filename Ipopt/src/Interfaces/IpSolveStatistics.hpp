@@ -65,6 +65,12 @@ namespace Ipopt
                                      Index& num_obj_grad_evals,
                                      Index& num_constr_jac_evals,
                                      Index& num_hess_evals) const;
+    /** Number of back-solves for the low-rank corrections of a
+     *  limited-memory Hessian approximation, and number of such
+     *  back-solves that were saved because the corrections could be
+     *  reused. */
+    virtual void NumberOfLowRankSolves(Index& num_lowrank_solves,
+                                       Index& num_saved_lowrank_solves) const;
     /** Unscaled solution infeasibilities */
     virtual void Infeasibilities(Number& dual_inf,
                                  Number& constr_viol,
@@ -121,6 +127,10 @@ namespace Ipopt
     Index num_constr_jac_evals_;
     /** Number of Lagrangian Hessian evaluations. */
     Index num_hess_evals_;
+    /** Number of back-solves for the low-rank corrections. */
+    Index num_lowrank_solves_;
+    /** Number of saved back-solves for the low-rank corrections. */
+    Index num_saved_lowrank_solves_;
 
     /** Final scaled value of objective function */
     Number scaled_obj_val_;
@@ -200,6 +200,20 @@ namespace Ipopt
     {
       return false;
     }
+
+    /** overload this method to return true if the evaluation methods
+     *  may be called concurrently from several threads at different
+     *  points.  In such calls new_x is always true.  This is used for
+     *  eval_f and eval_g if the line search evaluates several trial
+     *  points at once (option "concurrent_trial_points"), and for
+     *  eval_g in the finite difference Jacobian and eval_grad_f and
+     *  eval_jac_g in the finite difference Hessian with
+     *  "findiff_num_threads" larger than 1.  The default
+     *  implementation returns false. */
+    virtual bool thread_safe_evaluation()
+    {
+      return false;
+    }
     //@}
 
     /** @name Solution Methods */
@@ -19,6 +19,9 @@
 #include "IpTSymDependencyDetector.hpp"
 #include "IpTripletToCSRConverter.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #ifdef COIN_HAS_HSL
 #include "CoinHslConfig.h"
 #endif
@@ -75,8 +78,22 @@ namespace Ipopt
       findiff_jac_ia_(NULL),
       findiff_jac_ja_(NULL),
       findiff_jac_postriplet_(NULL),
+      findiff_jac_ncolors_(0),
+      findiff_jac_color_start_(NULL),
+      findiff_jac_color_cols_(NULL),
+      findiff_hess_ncolors_(0),
+      findiff_hess_color_start_(NULL),
+      findiff_hess_color_cols_(NULL),
+      findiff_hess_entry_start_(NULL),
+      findiff_hess_entry_pos_(NULL),
+      findiff_hess_entry_row_(NULL),
+      findiff_hess_entry_col_(NULL),
+      findiff_hess_jac_irow_(NULL),
+      findiff_hess_jac_jcol_(NULL),
       findiff_x_l_(NULL),
-      findiff_x_u_(NULL)
+      findiff_x_u_(NULL),
+      structure_complete_(false),
+      reuse_structure_(false)
   {
     ASSERT_EXCEPTION(IsValid(tnlp_), INVALID_TNLP,
                      "The TNLP passed to TNLPAdapter is NULL. This MUST be a valid TNLP!");
@@ -95,6 +112,16 @@ namespace Ipopt
     delete [] findiff_jac_ia_;
     delete [] findiff_jac_ja_;
     delete [] findiff_jac_postriplet_;
+    delete [] findiff_jac_color_start_;
+    delete [] findiff_jac_color_cols_;
+    delete [] findiff_hess_color_start_;
+    delete [] findiff_hess_color_cols_;
+    delete [] findiff_hess_entry_start_;
+    delete [] findiff_hess_entry_pos_;
+    delete [] findiff_hess_entry_row_;
+    delete [] findiff_hess_entry_col_;
+    delete [] findiff_hess_jac_irow_;
+    delete [] findiff_hess_jac_jcol_;
     delete [] findiff_x_l_;
     delete [] findiff_x_u_;
   }
@@ -207,6 +234,33 @@ namespace Ipopt
       0., true,
       1e-7,
       "This determines the relative perturbation of the variable entries.");
+    roptions->AddStringOption2(
+      "findiff_coloring",
+      "Indicates whether variables are perturbed together in the finite difference approximation.",
+      "yes",
+      "no", "perturb one variable at a time",
+      "yes", "perturb structurally orthogonal variables together",
+      "If enabled, the columns of the Jacobian structure are colored such "
+      "that no two columns of the same color have a nonzero in the same row "
+      "(Curtis-Powell-Reid).  All variables of one color are perturbed in "
+      "the same evaluation of the constraints, so that the number of "
+      "evaluations per Jacobian is the number of colors instead of the "
+      "number of variables.  For the Hessian, a star coloring of the "
+      "symmetric structure is used in the same way, so that every entry "
+      "can be computed from the gradients for one of the colors of its "
+      "row and column.  This requires that the sparsity structures "
+      "provided by the user are correct.");
+    roptions->AddLowerBoundedIntegerOption(
+      "findiff_num_threads",
+      "Number of threads for the finite difference approximation.",
+      1, 1,
+      "If larger than 1 and Ipopt has been compiled with OpenMP support, the "
+      "perturbed functions for the different colors (see "
+      "\"findiff_coloring\") are evaluated concurrently.  This is only "
+      "done if the TNLP declares in thread_safe_evaluation that its methods "
+      "eval_g (for the Jacobian), and eval_grad_f and eval_jac_g (for the "
+      "Hessian) can be called from several threads at the same time; "
+      "otherwise the colors are evaluated one after the other.");
     roptions->AddLowerBoundedNumberOption(
       "point_perturbation_radius",
       "Maximal perturbation of an evaluation point.",
@@ -259,10 +313,24 @@ namespace Ipopt
     jacobian_approximation_ = JacobianApproxEnum(enum_int);
     options.GetNumericValue("findiff_perturbation",
                             findiff_perturbation_, prefix);
+    ASSERT_EXCEPTION(hessian_approximation_ != FINDIFF_VALUES ||
+                     jacobian_approximation_ == JAC_EXACT,
+                     OPTION_INVALID,
+                     "Option \"hessian_approximation\" can only be \"finite-difference-values\" if \"jacobian_approximation\" is \"exact\".");
+    options.GetBoolValue("findiff_coloring", findiff_coloring_, prefix);
+    options.GetIntegerValue("findiff_num_threads", findiff_num_threads_,
+                            prefix);
 
     options.GetNumericValue("point_perturbation_radius",
                             point_perturbation_radius_, prefix);
 
+    // The following are registered in IpoptAlgorithm
+    options.GetIntegerValue("vector_num_threads", vector_num_threads_, prefix);
+    options.GetIntegerValue("vector_parallel_min_dim",
+                            vector_parallel_min_dim_, prefix);
+    options.GetNumericValue("vector_pool_max_memory",
+                            vector_pool_max_memory_, prefix);
+
     options.GetNumericValue("tol", tol_, prefix);
 
     options.GetBoolValue("dependency_detection_with_rhs",
@@ -357,7 +425,12 @@ namespace Ipopt
       }
     }
 
-    if (warm_start_same_structure_) {
+    // The spaces are also kept if the TNLP has been replaced by one
+    // with the same structure (see ReplaceTNLP)
+    const bool same_structure = warm_start_same_structure_ || reuse_structure_;
+    reuse_structure_ = false;
+
+    if (same_structure) {
       ASSERT_EXCEPTION(full_x_, INVALID_WARMSTART,
                        "warm_start_same_structure chosen, but TNLPAdapter is called for the first time.");
       if (IsValid(jnlst_)) {
@@ -385,6 +458,8 @@ namespace Ipopt
       h_idx_map_ = NULL;
       delete [] x_fixed_map_;
       x_fixed_map_ = NULL;
+      structure_signature_.clear();
+      structure_complete_ = false;
     }
 
     // Get the full dimensions of the problem
@@ -392,7 +467,7 @@ namespace Ipopt
     bool retval = tnlp_->get_nlp_info(n_full_x, n_full_g, nz_full_jac_g,
                                       nz_full_h, index_style_);
     ASSERT_EXCEPTION(retval, INVALID_TNLP, "get_nlp_info returned false");
-    ASSERT_EXCEPTION(!warm_start_same_structure_ ||
+    ASSERT_EXCEPTION(!same_structure ||
                      (n_full_x == n_full_x_ &&
                       n_full_g == n_full_g_ &&
                       nz_full_jac_g == nz_full_jac_g_ &&
@@ -404,7 +479,7 @@ namespace Ipopt
     nz_full_jac_g_ = nz_full_jac_g;
     nz_full_h_ = nz_full_h;
 
-    if (!warm_start_same_structure_) {
+    if (!same_structure) {
       // create space to store vectors that are the full length of x
       full_x_ = new Number[n_full_x_];
 
@@ -949,6 +1024,16 @@ namespace Ipopt
       delete [] d_u_map;
       d_u_map = NULL;
 
+      // the vectors of the problem are handled according to the
+      // options of this application
+      SetVectorSpaceParameters(*dv_x_space);
+      SetVectorSpaceParameters(*dv_x_l_space);
+      SetVectorSpaceParameters(*dv_x_u_space);
+      SetVectorSpaceParameters(*dc_space);
+      SetVectorSpaceParameters(*dv_d_space);
+      SetVectorSpaceParameters(*dv_d_l_space);
+      SetVectorSpaceParameters(*dv_d_u_space);
+
       delete [] g_l;
       g_l = NULL;
       delete [] g_u;
@@ -1082,6 +1167,18 @@ namespace Ipopt
           jacobian_approximation_ == JAC_FINDIFF_VALUES) {
         initialize_findiff_jac(g_iRow, g_jCol);
       }
+      if (hessian_approximation_ == FINDIFF_VALUES) {
+        // Keep the structure of the Jacobian for the gradient of the
+        // Lagrangian
+        delete [] findiff_hess_jac_irow_;
+        delete [] findiff_hess_jac_jcol_;
+        findiff_hess_jac_irow_ = new Index[nz_full_jac_g_];
+        findiff_hess_jac_jcol_ = new Index[nz_full_jac_g_];
+        for (Index i=0; i<nz_full_jac_g_; i++) {
+          findiff_hess_jac_irow_[i] = g_iRow[i]-1;
+          findiff_hess_jac_jcol_[i] = g_jCol[i]-1;
+        }
+      }
 
       // ... build the non-zero structure for jac_c
       // ... (the permutation from rows in jac_g to jac_c is
@@ -1191,7 +1288,8 @@ namespace Ipopt
       delete [] g_jCol;
       g_jCol = NULL;
 
-      if (hessian_approximation_==EXACT) {
+      if (hessian_approximation_==EXACT ||
+          hessian_approximation_==FINDIFF_VALUES) {
         /** Create the matrix space for the hessian of the lagrangian */
         Index* full_h_iRow = new Index[nz_full_h_];
         Index* full_h_jCol = new Index[nz_full_h_];
@@ -1217,6 +1315,10 @@ namespace Ipopt
           }
         }
 
+        if (hessian_approximation_==FINDIFF_VALUES) {
+          initialize_findiff_hess(full_h_iRow, full_h_jCol);
+        }
+
         current_nz = 0;
         if (IsValid(P_x_full_x_)) {
           h_idx_map_ = new Index[nz_full_h_];
@@ -1258,7 +1360,8 @@ namespace Ipopt
         nz_h_ = 0;
         Hess_lagrangian_space_ = NULL;
       }
-    } /* if (warm_start_same_structure_) { */
+      structure_complete_ = true;
+    } /* if (!same_structure) { */
 
     // Assign the spaces to the returned pointers
     x_space = x_space_;
@@ -1288,6 +1391,134 @@ namespace Ipopt
     return true;
   }
 
+  void TNLPAdapter::SetVectorSpaceParameters(DenseVectorSpace& space) const
+  {
+    space.SetParallelParameters(vector_num_threads_, vector_parallel_min_dim_);
+    space.SetMaxPoolMemory(vector_pool_max_memory_);
+  }
+
+  bool TNLPAdapter::ReplaceTNLP(const SmartPtr<TNLP>& tnlp)
+  {
+    DBG_START_METH("TNLPAdapter::ReplaceTNLP", dbg_verbosity);
+
+    // The spaces depend on the values of the problem if dependent
+    // constraints are removed, and the fixed variables might have
+    // been relaxed because of too few degrees of freedom, which is
+    // not remembered when the options are processed again
+    if (!structure_complete_ || IsNull(tnlp) ||
+        IsValid(dependency_detector_) ||
+        fixed_variable_treatment_ == RELAX_BOUNDS) {
+      return false;
+    }
+
+    if (structure_signature_.empty() &&
+        !GetStructureSignature(*tnlp_, structure_signature_)) {
+      structure_signature_.clear();
+      return false;
+    }
+    std::vector<Index> signature;
+    if (!GetStructureSignature(*tnlp, signature) ||
+        signature != structure_signature_) {
+      return false;
+    }
+
+    tnlp_ = tnlp;
+    reuse_structure_ = true;
+
+    // The local copies belong to the previous problem
+    x_tag_for_iterates_ = TaggedObject::Tag();
+    y_c_tag_for_iterates_ = TaggedObject::Tag();
+    y_d_tag_for_iterates_ = TaggedObject::Tag();
+    x_tag_for_g_ = TaggedObject::Tag();
+    x_tag_for_jac_g_ = TaggedObject::Tag();
+
+    return true;
+  }
+
+  bool TNLPAdapter::GetStructureSignature(TNLP& tnlp,
+                                          std::vector<Index>& signature) const
+  {
+    Index n, m, nnz_jac_g, nnz_h;
+    TNLP::IndexStyleEnum index_style;
+    if (!tnlp.get_nlp_info(n, m, nnz_jac_g, nnz_h, index_style) || n <= 0) {
+      return false;
+    }
+
+    // Meta data is stored in the spaces
+    StringMetaDataMapType var_string_md;
+    IntegerMetaDataMapType var_integer_md;
+    NumericMetaDataMapType var_numeric_md;
+    StringMetaDataMapType con_string_md;
+    IntegerMetaDataMapType con_integer_md;
+    NumericMetaDataMapType con_numeric_md;
+    if (tnlp.get_var_con_metadata(n, var_string_md, var_integer_md, var_numeric_md,
+                                  m, con_string_md, con_integer_md, con_numeric_md) &&
+        (!var_string_md.empty() || !var_integer_md.empty() ||
+         !var_numeric_md.empty() || !con_string_md.empty() ||
+         !con_integer_md.empty() || !con_numeric_md.empty())) {
+      return false;
+    }
+
+    std::vector<Number> bounds(2*(n+m));
+    Number* x_l = &bounds[0];
+    Number* x_u = x_l + n;
+    Number* g_l = x_u + n;
+    Number* g_u = g_l + m;
+    if (!tnlp.get_bounds_info(n, x_l, x_u, m, g_l, g_u)) {
+      return false;
+    }
+
+    signature.clear();
+    signature.reserve(5 + n + m + 2*(nnz_jac_g + nnz_h));
+    signature.push_back(n);
+    signature.push_back(m);
+    signature.push_back(nnz_jac_g);
+    signature.push_back(nnz_h);
+    signature.push_back((Index)index_style);
+
+    // Which bounds exist, as classified in GetSpaces (4 for fixed
+    // variables and equality constraints)
+    for (Index i=0; i<n+m; i++) {
+      const Number lower_bound = (i<n) ? x_l[i] : g_l[i-n];
+      const Number upper_bound = (i<n) ? x_u[i] : g_u[i-n];
+      if (lower_bound > upper_bound) {
+        return false;
+      }
+      Index bounds_type = 4;
+      if (lower_bound < upper_bound) {
+        bounds_type = 0;
+        if (lower_bound > nlp_lower_bound_inf_) {
+          bounds_type += 1;
+        }
+        if (upper_bound < nlp_upper_bound_inf_) {
+          bounds_type += 2;
+        }
+      }
+      signature.push_back(bounds_type);
+    }
+
+    // Sparsity structures of the derivatives
+    if (nnz_jac_g > 0) {
+      const size_t start = signature.size();
+      signature.resize(start + 2*nnz_jac_g);
+      if (!tnlp.eval_jac_g(n, NULL, false, m, nnz_jac_g, &signature[start],
+                           &signature[start+nnz_jac_g], NULL)) {
+        return false;
+      }
+    }
+    if (nnz_h > 0 && (hessian_approximation_==EXACT ||
+                      hessian_approximation_==FINDIFF_VALUES)) {
+      const size_t start = signature.size();
+      signature.resize(start + 2*nnz_h);
+      if (!tnlp.eval_h(n, NULL, false, 0, m, NULL, false, nnz_h,
+                       &signature[start], &signature[start+nnz_h], NULL)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   bool TNLPAdapter::GetBoundsInformation(const Matrix& Px_L,
                                          Vector& x_L,
                                          const Matrix& Px_U,
@@ -1417,13 +1648,23 @@ namespace Ipopt
     }
 
     // In case we are doing finite differences, keep a copy of the bounds
-    if (jacobian_approximation_ != JAC_EXACT) {
+    if (jacobian_approximation_ != JAC_EXACT ||
+        hessian_approximation_ == FINDIFF_VALUES) {
       delete [] findiff_x_l_;
       delete [] findiff_x_u_;
       findiff_x_l_ = x_l;
       findiff_x_u_ = x_u;
       x_l = NULL;
       x_u = NULL;
+      if (fixed_variable_treatment_==MAKE_CONSTRAINT) {
+        // Fixed variables are free variables of the algorithm, so that
+        // they are perturbed like the others; otherwise their entries
+        // of the Jacobian and the Hessian would be left at zero
+        for (Index i=0; i<n_x_fixed_; i++) {
+          findiff_x_l_[x_fixed_map_[i]] = nlp_lower_bound_inf_;
+          findiff_x_u_[x_fixed_map_[i]] = nlp_upper_bound_inf_;
+        }
+      }
     }
 
     delete [] x_l;
@@ -1685,6 +1926,75 @@ namespace Ipopt
     return false;
   }
 
+  bool TNLPAdapter::Eval_f_c_d_Concurrently(Index npoints,
+      const Vector* const* x,
+      Number* f,
+      Vector* const* c,
+      Vector* const* d,
+      bool* success)
+  {
+    if (!tnlp_->thread_safe_evaluation()) {
+      return false;
+    }
+
+    // The points are copied into the full space first; ResortX takes
+    // the values of the fixed variables from full_x_, which is not
+    // changed during the concurrent evaluations
+    Number* full_x_points = new Number[npoints*n_full_x_];
+    Number* full_g_points = new Number[npoints*n_full_g_];
+    for (Index k=0; k<npoints; k++) {
+      ResortX(*x[k], full_x_points + k*n_full_x_);
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(npoints) if(npoints>1) schedule(dynamic)
+#endif
+    for (Index k=0; k<npoints; k++) {
+      const Number* full_x_k = full_x_points + k*n_full_x_;
+      Number* full_g_k = full_g_points + k*n_full_g_;
+      success[k] = tnlp_->eval_f(n_full_x_, full_x_k, true, f[k]) &&
+                   tnlp_->eval_g(n_full_x_, full_x_k, true, n_full_g_,
+                                 full_g_k);
+    }
+
+    const Index* c_pos = P_c_g_->ExpandedPosIndices();
+    const Index* d_pos = P_d_g_->ExpandedPosIndices();
+    Index n_c_no_fixed = P_c_g_->NCols();
+    for (Index k=0; k<npoints; k++) {
+      if (!success[k]) {
+        continue;
+      }
+      const Number* full_x_k = full_x_points + k*n_full_x_;
+      const Number* full_g_k = full_g_points + k*n_full_g_;
+      DenseVector* dc = static_cast<DenseVector*>(c[k]);
+      DBG_ASSERT(dynamic_cast<DenseVector*>(c[k]));
+      Number* c_values = dc->Values();
+      for (Index i=0; i<n_c_no_fixed; i++) {
+        c_values[i] = full_g_k[c_pos[i]] - c_rhs_[i];
+      }
+      if (fixed_variable_treatment_==MAKE_CONSTRAINT) {
+        for (Index i=0; i<n_x_fixed_; i++) {
+          c_values[n_c_no_fixed+i] =
+            full_x_k[x_fixed_map_[i]] - c_rhs_[n_c_no_fixed+i];
+        }
+      }
+      DenseVector* dd = static_cast<DenseVector*>(d[k]);
+      DBG_ASSERT(dynamic_cast<DenseVector*>(d[k]));
+      Number* d_values = dd->Values();
+      for (Index i=0; i<d[k]->Dim(); i++) {
+        d_values[i] = full_g_k[d_pos[i]];
+      }
+    }
+
+    delete [] full_x_points;
+    delete [] full_g_points;
+
+    // The TNLP has last been called at one of the points
+    x_tag_for_iterates_ = TaggedObject::Tag();
+
+    return true;
+  }
+
   bool TNLPAdapter::Eval_jac_d(const Vector& x, Matrix& jac_d)
   {
     bool new_x = false;
@@ -1740,7 +2050,22 @@ namespace Ipopt
     DBG_ASSERT(dynamic_cast<SymTMatrix*>(&h));
     Number* values = st_h->Values();
 
-    if (h_idx_map_) {
+    if (hessian_approximation_ == FINDIFF_VALUES) {
+      Number* full_h = values;
+      if (h_idx_map_) {
+        full_h = new Number[nz_full_h_];
+      }
+      retval = internal_eval_findiff_h(new_x, obj_factor, full_h);
+      if (h_idx_map_) {
+        if (retval) {
+          for (Index i=0; i<nz_h_; i++) {
+            values[i] = full_h[h_idx_map_[i]];
+          }
+        }
+        delete [] full_h;
+      }
+    }
+    else if (h_idx_map_) {
       Number* full_h = new Number[nz_full_h_];
 
       if (tnlp_->eval_h(n_full_x_, full_x_, new_x, obj_factor, n_full_g_,
@@ -1854,6 +2179,47 @@ namespace Ipopt
   }
 
 
+  /** Name of the numeric metadata that holds several vectors one
+   *  after the other (the solutions of all steps of sIPOPT with
+   *  sens_scenario_batch).  Each of the vectors is resorted
+   *  separately.  All other metadata must have exactly the dimension
+   *  of the vector. */
+  static const std::string stacked_meta_data_name = "sens_sol_states";
+
+  /** Number of vectors in the numeric metadata values with the given
+   *  name of a vector of dimension dim (or of a pair of vectors of
+   *  dimensions dim and dim2).  Only the metadata
+   *  stacked_meta_data_name may hold more than one vector.  Returns 0
+   *  if the size of the metadata does not fit. */
+  static Index NumMetaDataBlocks(const std::string& name,
+                                 const std::vector<Number>& values, Index dim,
+                                 const std::vector<Number>& values2 = std::vector<Number>(),
+                                 Index dim2 = 0)
+  {
+    const Index size[2] = {(Index)values.size(), (Index)values2.size()};
+    const Index dims[2] = {dim, dim2};
+    if (name!=stacked_meta_data_name) {
+      return (size[0]==dims[0] && size[1]==dims[1]) ? 1 : 0;
+    }
+    Index n_blocks[2];
+    for (Index i=0; i<2; i++) {
+      if (dims[i]==0) {
+        // an empty vector fits with any number of vectors
+        n_blocks[i] = (size[i]==0) ? -1 : 0;
+      }
+      else {
+        n_blocks[i] = (size[i]%dims[i]==0) ? size[i]/dims[i] : 0;
+      }
+    }
+    if (n_blocks[0]<0) {
+      return (n_blocks[1]<0) ? 1 : n_blocks[1];
+    }
+    if (n_blocks[1]<0 || n_blocks[1]==n_blocks[0]) {
+      return n_blocks[0];
+    }
+    return 0;
+  }
+
   void TNLPAdapter::FinalizeSolution(SolverReturn status,
                                      const Vector& x, const Vector& z_L, const Vector& z_U,
                                      const Vector& c, const Vector& d,
@@ -1881,12 +2247,21 @@ namespace Ipopt
     const NumericMetaDataMapType x_meta = x_space->GetNumericMetaData();
     NumericMetaDataMapType::const_iterator x_meta_iter;
     for (x_meta_iter=x_meta.begin(); x_meta_iter!=x_meta.end(); ++x_meta_iter) {
-      if ((Index)x_meta_iter->second.size()==x.Dim()) {
+      const Index n_blocks = NumMetaDataBlocks(x_meta_iter->first,
+                                               x_meta_iter->second, x.Dim());
+      if (n_blocks>0) {
         std::vector<Number> new_meta_data;
-        new_meta_data.resize(n_full_x_);
+        new_meta_data.resize(n_full_x_*n_blocks);
         SmartPtr<DenseVector> x_meta_vector = x_space->MakeNewDenseVector();
-        x_meta_vector->SetValues(&(x_meta_iter->second)[0]);
-        ResortX(*x_meta_vector, &new_meta_data[0]);
+        for (Index k=0; k<n_blocks; k++) {
+          if (x.Dim()>0) {
+            x_meta_vector->SetValues(&(x_meta_iter->second)[k*x.Dim()]);
+          }
+          else {
+            x_meta_vector->Set(0.);
+          }
+          ResortX(*x_meta_vector, &new_meta_data[k*n_full_x_]);
+        }
         var_numeric_md[x_meta_iter->first] = new_meta_data;
       }
     }
@@ -1901,20 +2276,36 @@ namespace Ipopt
     const NumericMetaDataMapType y_d_meta = y_d_space->GetNumericMetaData();
     NumericMetaDataMapType::const_iterator y_c_meta_iter;
     for (y_c_meta_iter=y_c_meta.begin(); y_c_meta_iter!=y_c_meta.end(); ++y_c_meta_iter) {
-      if ((Index)y_c_meta_iter->second.size()==y_c.Dim()) {
-        if (y_d_space->HasNumericMetaData(y_c_meta_iter->first.c_str())           // There exists a corresponding y_d metadata
-            && ((Index)(y_d_meta.find(y_c_meta_iter->first)->second).size())==y_d.Dim()) { // and y_d metadata vector has size y_d.Dim()
-          std::vector<Number> y_d_second =
-            y_d_space->GetNumericMetaData(y_c_meta_iter->first);
+      if (y_d_space->HasNumericMetaData(y_c_meta_iter->first.c_str())) { // There exists a corresponding y_d metadata
+        const std::vector<Number>& y_d_second =
+          y_d_meta.find(y_c_meta_iter->first)->second;
+        // and both have the size of y_c and y_d (or of the same
+        // number of them)
+        const Index n_blocks = NumMetaDataBlocks(y_c_meta_iter->first,
+                                                 y_c_meta_iter->second, y_c.Dim(),
+                                                 y_d_second, y_d.Dim());
+        if (n_blocks>0) {
           std::vector<Number> new_g_meta_data;
-          new_g_meta_data.resize(n_full_g_);
+          new_g_meta_data.resize(n_full_g_*n_blocks);
           SmartPtr<DenseVector> y_c_meta_vector =
             y_c_space->MakeNewDenseVector();
           SmartPtr<DenseVector> y_d_meta_vector =
             y_d_space->MakeNewDenseVector();
-          y_c_meta_vector->SetValues(&(y_c_meta_iter->second)[0]);
-          y_d_meta_vector->SetValues(&y_d_second[0]);
-          ResortG(*y_c_meta_vector, *y_d_meta_vector, &new_g_meta_data[0]);
+          for (Index k=0; k<n_blocks; k++) {
+            if (y_c.Dim()>0) {
+              y_c_meta_vector->SetValues(&(y_c_meta_iter->second)[k*y_c.Dim()]);
+            }
+            else {
+              y_c_meta_vector->Set(0.);
+            }
+            if (y_d.Dim()>0) {
+              y_d_meta_vector->SetValues(&y_d_second[k*y_d.Dim()]);
+            }
+            else {
+              y_d_meta_vector->Set(0.);
+            }
+            ResortG(*y_c_meta_vector, *y_d_meta_vector, &new_g_meta_data[k*n_full_g_]);
+          }
           con_numeric_md[y_c_meta_iter->first] = new_g_meta_data;
         }
       }
@@ -1952,20 +2343,35 @@ namespace Ipopt
     NumericMetaDataMapType::const_iterator z_L_meta_iter;
     for (z_L_meta_iter=z_L_meta.begin();
          z_L_meta_iter!=z_L_meta.end(); ++z_L_meta_iter) {
-      if ((Index)z_L_meta_iter->second.size()==z_L.Dim()) {
-        if (z_U_space->HasNumericMetaData(z_L_meta_iter->first.c_str())
-           && (Index)z_U_meta.find(z_L_meta_iter->first.c_str())->second.size()==z_U.Dim()) {
-          std::vector<Number> z_U_second = z_U_space->GetNumericMetaData(z_L_meta_iter->first);
+      if (z_U_space->HasNumericMetaData(z_L_meta_iter->first.c_str())) {
+        const std::vector<Number>& z_U_second =
+          z_U_meta.find(z_L_meta_iter->first)->second;
+        const Index n_blocks = NumMetaDataBlocks(z_L_meta_iter->first,
+                                                 z_L_meta_iter->second, z_L.Dim(),
+                                                 z_U_second, z_U.Dim());
+        if (n_blocks>0) {
           SmartPtr<DenseVector> z_L_meta_vector =
             z_L_space->MakeNewDenseVector();
           SmartPtr<DenseVector> z_U_meta_vector =
             z_U_space->MakeNewDenseVector();
-          z_L_meta_vector->SetValues(&(z_L_meta_iter->second)[0]);
-          z_U_meta_vector->SetValues(&z_U_second[0]);
-          std::vector<Number> new_z_L_meta_data(n_full_x_, 0.0);
-          std::vector<Number> new_z_U_meta_data(n_full_x_, 0.0);
-          ResortBnds(*z_L_meta_vector, &new_z_L_meta_data[0],
-                     *z_U_meta_vector, &new_z_U_meta_data[0]);
+          std::vector<Number> new_z_L_meta_data(n_full_x_*n_blocks, 0.0);
+          std::vector<Number> new_z_U_meta_data(n_full_x_*n_blocks, 0.0);
+          for (Index k=0; k<n_blocks; k++) {
+            if (z_L.Dim()>0) {
+              z_L_meta_vector->SetValues(&(z_L_meta_iter->second)[k*z_L.Dim()]);
+            }
+            else {
+              z_L_meta_vector->Set(0.);
+            }
+            if (z_U.Dim()>0) {
+              z_U_meta_vector->SetValues(&z_U_second[k*z_U.Dim()]);
+            }
+            else {
+              z_U_meta_vector->Set(0.);
+            }
+            ResortBnds(*z_L_meta_vector, &new_z_L_meta_data[k*n_full_x_],
+                       *z_U_meta_vector, &new_z_U_meta_data[k*n_full_x_]);
+          }
           std::string z_L_meta_data_tag = z_L_meta_iter->first;
           std::string z_U_meta_data_tag = z_L_meta_iter->first;
           z_L_meta_data_tag += "_z_L";
@@ -2375,33 +2781,80 @@ namespace Ipopt
       // make sure we have the value of the constraints at the point
       retval = internal_eval_g(new_x);
       if (retval) {
-        Number* full_g_pert = new Number[n_full_g_];
-        Number* full_x_pert = new Number[n_full_x_];
-        IpBlasDcopy(n_full_x_, full_x_, 1, full_x_pert, 1);
-        // Compute the finite difference Jacobian
-        for (Index ivar = 0; ivar<n_full_x_; ivar++) {
-          if (findiff_x_l_[ivar] < findiff_x_u_[ivar]) {
-            const Number xorig = full_x_pert[ivar];
-            Number this_perturbation =
-              findiff_perturbation_*Max(1., fabs(full_x_[ivar]));
-            full_x_pert[ivar] += this_perturbation;
-            if (full_x_pert[ivar] > findiff_x_u_[ivar]) {
-              full_x_pert[ivar] = xorig - this_perturbation;
+        // Compute the finite difference Jacobian.  All variables of
+        // one color are perturbed at the same time; since they do not
+        // appear in the same constraints, the difference in each
+        // constraint is caused by only one of them.  The colors write
+        // to different entries of jac_g_, so that they can be
+        // computed by several threads.
+        Index nfailed = 0;
+#ifdef _OPENMP
+        // eval_g is only called from several threads if the TNLP
+        // declares its evaluation methods thread-safe
+        Index nthreads = 1;
+        if (findiff_num_threads_ > 1 && tnlp_->thread_safe_evaluation()) {
+          nthreads = Min(findiff_num_threads_, findiff_jac_ncolors_);
+        }
+        #pragma omp parallel num_threads(nthreads) if(nthreads>1) reduction(+:nfailed)
+#endif
+        {
+          Number* full_g_pert = new Number[n_full_g_];
+          Number* full_x_pert = new Number[n_full_x_];
+          IpBlasDcopy(n_full_x_, full_x_, 1, full_x_pert, 1);
+#ifdef _OPENMP
+          #pragma omp for schedule(dynamic)
+#endif
+          for (Index icolor=0; icolor<findiff_jac_ncolors_; icolor++) {
+            if (nfailed > 0) {
+              continue;
+            }
+            const Index* cols_begin =
+              findiff_jac_color_cols_ + findiff_jac_color_start_[icolor];
+            const Index* cols_end =
+              findiff_jac_color_cols_ + findiff_jac_color_start_[icolor+1];
+            bool perturbed = false;
+            for (const Index* ivar = cols_begin; ivar<cols_end; ivar++) {
+              if (findiff_x_l_[*ivar] < findiff_x_u_[*ivar]) {
+                const Number this_perturbation =
+                  findiff_perturbation_*Max(1., fabs(full_x_[*ivar]));
+                full_x_pert[*ivar] += this_perturbation;
+                if (full_x_pert[*ivar] > findiff_x_u_[*ivar]) {
+                  full_x_pert[*ivar] = full_x_[*ivar] - this_perturbation;
+                }
+                perturbed = true;
+              }
+            }
+            if (!perturbed) {
+              continue;
+            }
+            if (!tnlp_->eval_g(n_full_x_, full_x_pert, true, n_full_g_,
+                               full_g_pert)) {
+              nfailed++;
+              continue;
             }
-            retval = tnlp_->eval_g(n_full_x_, full_x_pert, true, n_full_g_,
-                                   full_g_pert);
-            if (!retval) break;
-            for (Index i=findiff_jac_ia_[ivar]; i<findiff_jac_ia_[ivar+1]; i++) {
-              const Index& icon = findiff_jac_ja_[i];
-              const Index& ipos = findiff_jac_postriplet_[i];
-              jac_g_[ipos] =
-                (full_g_pert[icon]-full_g_[icon])/this_perturbation;
+            for (const Index* ivar = cols_begin; ivar<cols_end; ivar++) {
+              if (findiff_x_l_[*ivar] < findiff_x_u_[*ivar]) {
+                Number this_perturbation =
+                  findiff_perturbation_*Max(1., fabs(full_x_[*ivar]));
+                if (full_x_pert[*ivar] < full_x_[*ivar]) {
+                  this_perturbation = -this_perturbation;
+                }
+                for (Index i=findiff_jac_ia_[*ivar]; i<findiff_jac_ia_[*ivar+1]; i++) {
+                  const Index& icon = findiff_jac_ja_[i];
+                  const Index& ipos = findiff_jac_postriplet_[i];
+                  jac_g_[ipos] =
+                    (full_g_pert[icon]-full_g_[icon])/this_perturbation;
+                }
+                full_x_pert[*ivar] = full_x_[*ivar];
+              }
             }
-            full_x_pert[ivar] = xorig;
           }
+          delete [] full_g_pert;
+          delete [] full_x_pert;
         }
-        delete [] full_g_pert;
-        delete [] full_x_pert;
+        retval = (nfailed == 0);
+        // The TNLP has last been called at a perturbed point
+        x_tag_for_iterates_ = TaggedObject::Tag();
       }
     }
 
@@ -2412,6 +2865,140 @@ namespace Ipopt
     return retval;
   }
 
+  bool TNLPAdapter::internal_eval_findiff_h(bool new_x, Number obj_factor,
+      Number* full_h)
+  {
+    // Gradient of the Lagrangian at the current point
+    if (nz_full_jac_g_ > 0 && !internal_eval_jac_g(new_x)) {
+      return false;
+    }
+    Number* grad_lag = new Number[n_full_x_];
+    if (obj_factor != 0.) {
+      if (!tnlp_->eval_grad_f(n_full_x_, full_x_, new_x, grad_lag)) {
+        delete [] grad_lag;
+        return false;
+      }
+      IpBlasDscal(n_full_x_, obj_factor, grad_lag, 1);
+    }
+    else {
+      for (Index i=0; i<n_full_x_; i++) {
+        grad_lag[i] = 0.;
+      }
+    }
+    for (Index i=0; i<nz_full_jac_g_; i++) {
+      grad_lag[findiff_hess_jac_jcol_[i]] +=
+        jac_g_[i]*full_lambda_[findiff_hess_jac_irow_[i]];
+    }
+
+    // Entries that are not computed (repeated positions, and entries
+    // for fixed variables, which the algorithm does not use unless
+    // they are perturbed with fixed_variable_treatment=make_constraint)
+    // are zero
+    for (Index i=0; i<nz_full_h_; i++) {
+      full_h[i] = 0.;
+    }
+
+    // Perturb all variables of one color at a time.  Each entry is
+    // computed from the color of its row or its column, depending on
+    // which of them has only one variable of that color among its
+    // neighbors.  As for the Jacobian, the colors write to different
+    // entries and can be computed by several threads.
+    Index nfailed = 0;
+#ifdef _OPENMP
+    // eval_grad_f and eval_jac_g are only called from several threads
+    // if the TNLP declares its evaluation methods thread-safe
+    Index nthreads = 1;
+    if (findiff_num_threads_ > 1 && tnlp_->thread_safe_evaluation()) {
+      nthreads = Min(findiff_num_threads_, findiff_hess_ncolors_);
+    }
+    #pragma omp parallel num_threads(nthreads) if(nthreads>1) reduction(+:nfailed)
+#endif
+    {
+      Number* full_x_pert = new Number[n_full_x_];
+      Number* grad_pert = new Number[n_full_x_];
+      Number* jac_pert = new Number[nz_full_jac_g_];
+      Number* perturbation = new Number[n_full_x_];
+      IpBlasDcopy(n_full_x_, full_x_, 1, full_x_pert, 1);
+#ifdef _OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (Index icolor=0; icolor<findiff_hess_ncolors_; icolor++) {
+        if (nfailed > 0) {
+          continue;
+        }
+        const Index* cols_begin =
+          findiff_hess_color_cols_ + findiff_hess_color_start_[icolor];
+        const Index* cols_end =
+          findiff_hess_color_cols_ + findiff_hess_color_start_[icolor+1];
+        bool perturbed = false;
+        for (const Index* ivar = cols_begin; ivar<cols_end; ivar++) {
+          perturbation[*ivar] = 0.;
+          if (findiff_x_l_[*ivar] < findiff_x_u_[*ivar]) {
+            Number this_perturbation =
+              findiff_perturbation_*Max(1., fabs(full_x_[*ivar]));
+            if (full_x_[*ivar] + this_perturbation > findiff_x_u_[*ivar]) {
+              this_perturbation = -this_perturbation;
+            }
+            full_x_pert[*ivar] = full_x_[*ivar] + this_perturbation;
+            perturbation[*ivar] = this_perturbation;
+            perturbed = true;
+          }
+        }
+        if (!perturbed) {
+          continue;
+        }
+
+        bool retval = true;
+        if (obj_factor != 0.) {
+          retval = tnlp_->eval_grad_f(n_full_x_, full_x_pert, true,
+                                      grad_pert);
+          IpBlasDscal(n_full_x_, obj_factor, grad_pert, 1);
+        }
+        else {
+          for (Index i=0; i<n_full_x_; i++) {
+            grad_pert[i] = 0.;
+          }
+        }
+        if (retval && nz_full_jac_g_ > 0) {
+          retval = tnlp_->eval_jac_g(n_full_x_, full_x_pert, true, n_full_g_,
+                                     nz_full_jac_g_, NULL, NULL, jac_pert);
+          for (Index i=0; retval && i<nz_full_jac_g_; i++) {
+            grad_pert[findiff_hess_jac_jcol_[i]] +=
+              jac_pert[i]*full_lambda_[findiff_hess_jac_irow_[i]];
+          }
+        }
+        if (retval) {
+          for (Index i=findiff_hess_entry_start_[icolor];
+               i<findiff_hess_entry_start_[icolor+1]; i++) {
+            const Index& irow = findiff_hess_entry_row_[i];
+            const Index& ivar = findiff_hess_entry_col_[i];
+            if (perturbation[ivar] != 0.) {
+              full_h[findiff_hess_entry_pos_[i]] =
+                (grad_pert[irow]-grad_lag[irow])/perturbation[ivar];
+            }
+          }
+        }
+        else {
+          nfailed++;
+        }
+        for (const Index* ivar = cols_begin; ivar<cols_end; ivar++) {
+          full_x_pert[*ivar] = full_x_[*ivar];
+        }
+      }
+      delete [] full_x_pert;
+      delete [] grad_pert;
+      delete [] jac_pert;
+      delete [] perturbation;
+    }
+    delete [] grad_lag;
+
+    // The TNLP has last been called at a perturbed point, so that the
+    // next evaluation at full_x_ must be done with new_x=true
+    x_tag_for_iterates_ = TaggedObject::Tag();
+
+    return (nfailed == 0);
+  }
+
   void
   TNLPAdapter::initialize_findiff_jac(const Index* iRow, const Index* jCol)
   {
@@ -2461,6 +3048,340 @@ namespace Ipopt
       findiff_jac_postriplet_[i] = postrip[i];
     }
 
+    // Color the columns such that no two columns of the same color
+    // have a nonzero in the same row.  Columns without nonzeros are
+    // not colored (color -1), since their perturbation does not
+    // change the constraints.
+    Index* color = new Index[n_full_x_];
+    findiff_jac_ncolors_ = 0;
+    if (findiff_coloring_) {
+      // Row-wise structure of the Jacobian
+      Index* row_start = new Index[n_full_g_+1];
+      Index* row_cols = new Index[findiff_jac_nnz_];
+      for (Index i=0; i<=n_full_g_; i++) {
+        row_start[i] = 0;
+      }
+      for (Index i=0; i<findiff_jac_nnz_; i++) {
+        row_start[findiff_jac_ja_[i]+1]++;
+      }
+      for (Index i=0; i<n_full_g_; i++) {
+        row_start[i+1] += row_start[i];
+      }
+      for (Index j=0; j<n_full_x_; j++) {
+        for (Index k=findiff_jac_ia_[j]; k<findiff_jac_ia_[j+1]; k++) {
+          row_cols[row_start[findiff_jac_ja_[k]]++] = j;
+        }
+      }
+      for (Index i=n_full_g_; i>0; i--) {
+        row_start[i] = row_start[i-1];
+      }
+      row_start[0] = 0;
+
+      // Greedy coloring in the order of the variables: each column
+      // gets the smallest color that is not used by a column sharing
+      // a row with it.  forbidden[c]==j marks color c as used by a
+      // neighbor of column j.
+      Index* forbidden = new Index[n_full_x_];
+      for (Index j=0; j<n_full_x_; j++) {
+        color[j] = -1;
+        forbidden[j] = -1;
+      }
+      for (Index j=0; j<n_full_x_; j++) {
+        if (findiff_jac_ia_[j] == findiff_jac_ia_[j+1]) {
+          continue;
+        }
+        for (Index k=findiff_jac_ia_[j]; k<findiff_jac_ia_[j+1]; k++) {
+          const Index irow = findiff_jac_ja_[k];
+          for (Index l=row_start[irow]; l<row_start[irow+1]; l++) {
+            if (color[row_cols[l]] >= 0) {
+              forbidden[color[row_cols[l]]] = j;
+            }
+          }
+        }
+        Index c = 0;
+        while (c < findiff_jac_ncolors_ && forbidden[c] == j) {
+          c++;
+        }
+        color[j] = c;
+        if (c == findiff_jac_ncolors_) {
+          findiff_jac_ncolors_++;
+        }
+      }
+      delete [] forbidden;
+      delete [] row_start;
+      delete [] row_cols;
+    }
+    else {
+      // One variable at a time
+      for (Index j=0; j<n_full_x_; j++) {
+        if (findiff_jac_ia_[j] < findiff_jac_ia_[j+1]) {
+          color[j] = findiff_jac_ncolors_++;
+        }
+        else {
+          color[j] = -1;
+        }
+      }
+    }
+
+    // Sort the columns by colors
+    delete [] findiff_jac_color_start_;
+    delete [] findiff_jac_color_cols_;
+    findiff_jac_color_start_ = new Index[findiff_jac_ncolors_+1];
+    for (Index c=0; c<=findiff_jac_ncolors_; c++) {
+      findiff_jac_color_start_[c] = 0;
+    }
+    for (Index j=0; j<n_full_x_; j++) {
+      if (color[j] >= 0) {
+        findiff_jac_color_start_[color[j]+1]++;
+      }
+    }
+    for (Index c=0; c<findiff_jac_ncolors_; c++) {
+      findiff_jac_color_start_[c+1] += findiff_jac_color_start_[c];
+    }
+    findiff_jac_color_cols_ =
+      new Index[findiff_jac_color_start_[findiff_jac_ncolors_]];
+    for (Index j=0; j<n_full_x_; j++) {
+      if (color[j] >= 0) {
+        findiff_jac_color_cols_[findiff_jac_color_start_[color[j]]++] = j;
+      }
+    }
+    for (Index c=findiff_jac_ncolors_; c>0; c--) {
+      findiff_jac_color_start_[c] = findiff_jac_color_start_[c-1];
+    }
+    findiff_jac_color_start_[0] = 0;
+    delete [] color;
+
+    jnlst_->Printf(J_DETAILED, J_INITIALIZATION,
+                   "Finite difference Jacobian requires %d constraint evaluations for %d variables.\n",
+                   findiff_jac_ncolors_, n_full_x_);
+  }
+
+  void
+  TNLPAdapter::initialize_findiff_hess(const Index* iRow, const Index* jCol)
+  {
+    // Symmetric adjacency structure of the Hessian without the
+    // diagonal, with the neighbors of each variable sorted
+    std::vector<Index> adj_start(n_full_x_+1, 0);
+    std::vector<bool> has_entry(n_full_x_, false);
+    for (Index p=0; p<nz_full_h_; p++) {
+      const Index i = iRow[p]-1;
+      const Index j = jCol[p]-1;
+      has_entry[i] = true;
+      has_entry[j] = true;
+      if (i != j) {
+        adj_start[i+1]++;
+        adj_start[j+1]++;
+      }
+    }
+    for (Index i=0; i<n_full_x_; i++) {
+      adj_start[i+1] += adj_start[i];
+    }
+    std::vector<Index> adj(adj_start[n_full_x_]);
+    {
+      std::vector<Index> next(adj_start.begin(), adj_start.end()-1);
+      for (Index p=0; p<nz_full_h_; p++) {
+        const Index i = iRow[p]-1;
+        const Index j = jCol[p]-1;
+        if (i != j) {
+          adj[next[i]++] = j;
+          adj[next[j]++] = i;
+        }
+      }
+    }
+    // Remove repeated neighbors
+    Index nadj = 0;
+    for (Index i=0; i<n_full_x_; i++) {
+      std::vector<Index>::iterator first = adj.begin()+adj_start[i];
+      std::vector<Index>::iterator last = adj.begin()+adj_start[i+1];
+      std::sort(first, last);
+      last = std::unique(first, last);
+      adj_start[i] = nadj;
+      for (; first!=last; first++) {
+        adj[nadj++] = *first;
+      }
+    }
+    adj_start[n_full_x_] = nadj;
+
+    // Star coloring: a distance-1 coloring in which every path of
+    // four variables has at least three colors.  This is the greedy
+    // algorithm 4.1 of Gebremedhin, Manne, Pothen, "What color is
+    // your Jacobian?", SIAM Review 47 (2005).  forbidden[c]==v marks
+    // color c as not allowed for variable v.
+    std::vector<Index> color(n_full_x_, -1);
+    findiff_hess_ncolors_ = 0;
+    if (findiff_coloring_) {
+      std::vector<Index> forbidden(n_full_x_, -1);
+      for (Index v=0; v<n_full_x_; v++) {
+        if (!has_entry[v]) {
+          continue;
+        }
+        for (Index k=adj_start[v]; k<adj_start[v+1]; k++) {
+          const Index w = adj[k];
+          if (color[w] >= 0) {
+            forbidden[color[w]] = v;
+          }
+        }
+        for (Index k=adj_start[v]; k<adj_start[v+1]; k++) {
+          const Index w = adj[k];
+          for (Index l=adj_start[w]; l<adj_start[w+1]; l++) {
+            const Index x = adj[l];
+            if (x == v || color[x] < 0) {
+              continue;
+            }
+            if (color[w] < 0) {
+              forbidden[color[x]] = v;
+            }
+            else {
+              for (Index m=adj_start[x]; m<adj_start[x+1]; m++) {
+                const Index y = adj[m];
+                if (y != w && color[y] == color[w]) {
+                  forbidden[color[x]] = v;
+                  break;
+                }
+              }
+            }
+          }
+        }
+        Index c = 0;
+        while (c < findiff_hess_ncolors_ && forbidden[c] == v) {
+          c++;
+        }
+        color[v] = c;
+        if (c == findiff_hess_ncolors_) {
+          findiff_hess_ncolors_++;
+        }
+      }
+    }
+    else {
+      // One variable at a time
+      for (Index v=0; v<n_full_x_; v++) {
+        if (has_entry[v]) {
+          color[v] = findiff_hess_ncolors_++;
+        }
+      }
+    }
+
+    // unique[k] is true if neighbor adj[k] of variable i is the only
+    // neighbor of i with its color.  Then the difference of the
+    // gradient component i for the color of adj[k] is caused only by
+    // the perturbation of adj[k].
+    std::vector<bool> unique(nadj);
+    {
+      std::vector<Index> count(findiff_hess_ncolors_, 0);
+      for (Index i=0; i<n_full_x_; i++) {
+        for (Index k=adj_start[i]; k<adj_start[i+1]; k++) {
+          count[color[adj[k]]]++;
+        }
+        for (Index k=adj_start[i]; k<adj_start[i+1]; k++) {
+          unique[k] = (count[color[adj[k]]] == 1);
+        }
+        for (Index k=adj_start[i]; k<adj_start[i+1]; k++) {
+          count[color[adj[k]]] = 0;
+        }
+      }
+    }
+
+    // Decide for every position of the user's structure from which
+    // color, gradient component, and perturbation it is computed.
+    // Positions that repeat an entry are left out.
+    std::vector<Index> entry_color(nz_full_h_, -1);
+    std::vector<Index> entry_row(nz_full_h_);
+    std::vector<Index> entry_col(nz_full_h_);
+    std::vector<bool> diag_done(n_full_x_, false);
+    std::vector<bool> adj_done(nadj, false);
+    for (Index p=0; p<nz_full_h_; p++) {
+      const Index i = Min(iRow[p], jCol[p])-1;
+      const Index j = Max(iRow[p], jCol[p])-1;
+      if (i == j) {
+        if (!diag_done[i]) {
+          diag_done[i] = true;
+          entry_color[p] = color[i];
+          entry_row[p] = i;
+          entry_col[p] = i;
+        }
+        continue;
+      }
+      const Index kij =
+        Index(std::lower_bound(adj.begin()+adj_start[i],
+                               adj.begin()+adj_start[i+1], j) - adj.begin());
+      if (adj_done[kij]) {
+        continue;
+      }
+      adj_done[kij] = true;
+      if (unique[kij]) {
+        entry_color[p] = color[j];
+        entry_row[p] = i;
+        entry_col[p] = j;
+      }
+      else {
+        DBG_DO(const Index kji =
+                 Index(std::lower_bound(adj.begin()+adj_start[j],
+                                        adj.begin()+adj_start[j+1], i) - adj.begin()));
+        DBG_ASSERT(unique[kji]);
+        entry_color[p] = color[i];
+        entry_row[p] = j;
+        entry_col[p] = i;
+      }
+    }
+
+    // Sort the variables and the entries by colors
+    delete [] findiff_hess_color_start_;
+    delete [] findiff_hess_color_cols_;
+    delete [] findiff_hess_entry_start_;
+    delete [] findiff_hess_entry_pos_;
+    delete [] findiff_hess_entry_row_;
+    delete [] findiff_hess_entry_col_;
+    findiff_hess_color_start_ = new Index[findiff_hess_ncolors_+1];
+    findiff_hess_entry_start_ = new Index[findiff_hess_ncolors_+1];
+    for (Index c=0; c<=findiff_hess_ncolors_; c++) {
+      findiff_hess_color_start_[c] = 0;
+      findiff_hess_entry_start_[c] = 0;
+    }
+    for (Index v=0; v<n_full_x_; v++) {
+      if (color[v] >= 0) {
+        findiff_hess_color_start_[color[v]+1]++;
+      }
+    }
+    for (Index p=0; p<nz_full_h_; p++) {
+      if (entry_color[p] >= 0) {
+        findiff_hess_entry_start_[entry_color[p]+1]++;
+      }
+    }
+    for (Index c=0; c<findiff_hess_ncolors_; c++) {
+      findiff_hess_color_start_[c+1] += findiff_hess_color_start_[c];
+      findiff_hess_entry_start_[c+1] += findiff_hess_entry_start_[c];
+    }
+    findiff_hess_color_cols_ =
+      new Index[findiff_hess_color_start_[findiff_hess_ncolors_]];
+    const Index nentries = findiff_hess_entry_start_[findiff_hess_ncolors_];
+    findiff_hess_entry_pos_ = new Index[nentries];
+    findiff_hess_entry_row_ = new Index[nentries];
+    findiff_hess_entry_col_ = new Index[nentries];
+    {
+      std::vector<Index> next(findiff_hess_color_start_,
+                              findiff_hess_color_start_+findiff_hess_ncolors_);
+      for (Index v=0; v<n_full_x_; v++) {
+        if (color[v] >= 0) {
+          findiff_hess_color_cols_[next[color[v]]++] = v;
+        }
+      }
+    }
+    {
+      std::vector<Index> next(findiff_hess_entry_start_,
+                              findiff_hess_entry_start_+findiff_hess_ncolors_);
+      for (Index p=0; p<nz_full_h_; p++) {
+        if (entry_color[p] >= 0) {
+          const Index e = next[entry_color[p]]++;
+          findiff_hess_entry_pos_[e] = p;
+          findiff_hess_entry_row_[e] = entry_row[p];
+          findiff_hess_entry_col_[e] = entry_col[p];
+        }
+      }
+    }
+
+    jnlst_->Printf(J_DETAILED, J_INITIALIZATION,
+                   "Finite difference Hessian requires %d gradient evaluations for %d variables.\n",
+                   findiff_hess_ncolors_, n_full_x_);
   }
 
   bool TNLPAdapter::CheckDerivatives(TNLPAdapter::DerivativeTestEnum deriv_test,
@@ -2502,12 +3423,13 @@ namespace Ipopt
     Number* g_u = new Number[ng];
     retval = tnlp_->get_bounds_info(nx, x_l, x_u, ng, g_l, g_u);
     ASSERT_EXCEPTION(retval, INVALID_TNLP, "get_bounds_info returned false in derivative checker");
-    IpResetRandom01();
+    unsigned short random_state[3];
+    IpResetRandom01(random_state);
     for (Index i=0; i<nx; i++) {
       const Number lower = Max(x_l[i], xref[i]-point_perturbation_radius_);
       const Number upper = Min(x_u[i], xref[i]+point_perturbation_radius_);
       const Number interval = upper - lower;
-      const Number random_number = IpRandom01();
+      const Number random_number = IpRandom01(random_state);
       xref[i] = lower + random_number*interval;
     }
     delete [] x_l;
@@ -2898,12 +3820,13 @@ namespace Ipopt
       return false;
     }
     // Here we reset the random number generator
-    IpResetRandom01();
+    unsigned short random_state[3];
+    IpResetRandom01(random_state);
     for (Index i=0; i<n_full_x_; i++) {
       const Number lower = Max(x_l[i], full_x_[i]-point_perturbation_radius_);
       const Number upper = Min(x_u[i], full_x_[i]+point_perturbation_radius_);
       const Number interval = upper - lower;
-      const Number random_number = IpRandom01();
+      const Number random_number = IpRandom01(random_state);
       full_x_[i] = lower + random_number*interval;
     }
     Number* g_vals = NULL;
@@ -13,11 +13,13 @@
 #include "IpTNLP.hpp"
 #include "IpOrigIpoptNLP.hpp"
 #include <list>
+#include <vector>
 
 namespace Ipopt
 {
 
   // forward declarations
+  class DenseVectorSpace;
   class ExpansionMatrix;
   class ExpansionMatrixSpace;
   class IteratesVector;
@@ -118,6 +120,13 @@ namespace Ipopt
                         const Vector& yd,
                         SymMatrix& h);
 
+    virtual bool Eval_f_c_d_Concurrently(Index npoints,
+                                         const Vector* const* x,
+                                         Number* f,
+                                         Vector* const* c,
+                                         Vector* const* d,
+                                         bool* success);
+
     virtual void GetScalingParameters(
       const SmartPtr<const VectorSpace> x_space,
       const SmartPtr<const VectorSpace> c_space,
@@ -194,6 +203,14 @@ namespace Ipopt
       return tnlp_;
     }
 
+    /** Replace the TNLP by one with the same structure, so that the
+     *  next optimization keeps the spaces created for the current
+     *  TNLP.  The dimensions, the sparsity structures of the
+     *  derivatives and the existence of the bounds must be the same,
+     *  and the problems must not provide meta data.  Returns false,
+     *  and leaves the TNLP unchanged, if this is not the case. */
+    bool ReplaceTNLP(const SmartPtr<TNLP>& tnlp);
+
     /** @name Methods for translating data for IpoptNLP into the TNLP
      *  data.  These methods are used to obtain the current (or
      *  final) data for the TNLP formulation from the IpoptNLP
@@ -281,8 +298,21 @@ namespace Ipopt
     JacobianApproxEnum jacobian_approximation_;
     /** Size of the perturbation for the derivative approximation */
     Number findiff_perturbation_;
+    /** Flag indicating whether structurally orthogonal variables
+     *  are perturbed together for the finite difference derivatives */
+    bool findiff_coloring_;
+    /** Number of threads for the finite difference derivatives */
+    Index findiff_num_threads_;
     /** Maximal perturbation of the initial point */
     Number point_perturbation_radius_;
+    /** @name Settings for the vector spaces of the problem (see
+     *  DenseVectorSpace::SetParallelParameters and
+     *  DenseVectorSpace::SetMaxPoolMemory) */
+    //@{
+    Index vector_num_threads_;
+    Index vector_parallel_min_dim_;
+    Number vector_pool_max_memory_;
+    //@}
     /** Flag indicating if rhs should be considered during dependency
      *  detection */
     bool dependency_detection_with_rhs_;
@@ -359,6 +389,10 @@ namespace Ipopt
     bool update_local_lambda(const Vector& y_c, const Vector& y_d);
     //@}
 
+    /** Apply the settings of the vector options to a space of the
+     *  problem */
+    void SetVectorSpaceParameters(DenseVectorSpace& space) const;
+
     /**@name Internal routines for evaluating g and jac_g (values stored since
      * they are used in both c and d routines */
     //@{
@@ -366,11 +400,23 @@ namespace Ipopt
     bool internal_eval_jac_g(bool new_x);
     //@}
 
+    /** Compute the values of the Hessian of the Lagrangian (in the
+     *  order of the user's structure) by finite differences of the
+     *  gradient of the Lagrangian at full_x_ for the multipliers in
+     *  full_lambda_. */
+    bool internal_eval_findiff_h(bool new_x, Number obj_factor,
+                                 Number* full_h);
+
     /** @name Internal methods for dealing with finite difference
     approxation */
     //@{
-    /** Initialize sparsity structure for finite difference Jacobian */
+    /** Initialize sparsity structure for finite difference Jacobian,
+     *  and the groups of variables that are perturbed together */
     void initialize_findiff_jac(const Index* iRow, const Index* jCol);
+    /** Initialize the groups of variables that are perturbed
+     *  together for the finite difference Hessian (star coloring),
+     *  and from which group each entry of the Hessian is computed */
+    void initialize_findiff_hess(const Index* iRow, const Index* jCol);
     //@}
 
     /**@name Internal Permutation Spaces and matrices
@@ -415,11 +461,59 @@ namespace Ipopt
     Index* findiff_jac_ja_;
     /** Position of entry in original triplet matrix */
     Index* findiff_jac_postriplet_;
+    /** Number of groups of variables that are perturbed together
+     *  (colors of the columns of the Jacobian) */
+    Index findiff_jac_ncolors_;
+    /** Start position in findiff_jac_color_cols_ for each color */
+    Index* findiff_jac_color_start_;
+    /** Ordered by colors, the columns of each color.  Columns
+     *  without nonzeros are not included. */
+    Index* findiff_jac_color_cols_;
+    /** Number of groups of variables that are perturbed together
+     *  for the Hessian */
+    Index findiff_hess_ncolors_;
+    /** Start position in findiff_hess_color_cols_ for each color */
+    Index* findiff_hess_color_start_;
+    /** Ordered by colors, the variables of each color */
+    Index* findiff_hess_color_cols_;
+    /** Start position in the findiff_hess_entry arrays for the
+     *  entries computed from each color */
+    Index* findiff_hess_entry_start_;
+    /** Position of the entry in the user's Hessian structure */
+    Index* findiff_hess_entry_pos_;
+    /** Component of the gradient of the Lagrangian whose difference
+     *  gives the entry */
+    Index* findiff_hess_entry_row_;
+    /** Variable by whose perturbation the difference is divided */
+    Index* findiff_hess_entry_col_;
+    /** Row indices of the Jacobian structure (counting from 0) */
+    Index* findiff_hess_jac_irow_;
+    /** Column indices of the Jacobian structure (counting from 0) */
+    Index* findiff_hess_jac_jcol_;
     /** Copy of the lower bounds */
     Number* findiff_x_l_;
     /** Copy of the upper bounds */
     Number* findiff_x_u_;
     //@}
+
+    /** @name Reuse of the spaces for a TNLP with the same structure
+     *  (see ReplaceTNLP) */
+    //@{
+    /** Compute the structure of a TNLP that determines the spaces
+     *  created in GetSpaces: the dimensions, which bounds exist and
+     *  the sparsity structures of the derivatives.  Returns false if
+     *  the spaces also depend on other data of the TNLP. */
+    bool GetStructureSignature(TNLP& tnlp,
+                               std::vector<Index>& signature) const;
+    /** Structure of the TNLP for which the spaces have been created.
+     *  This is computed the first time it is needed. */
+    std::vector<Index> structure_signature_;
+    /** Flag indicating that GetSpaces has created all spaces */
+    bool structure_complete_;
+    /** Flag indicating that the next call of GetSpaces keeps the
+     *  spaces for the TNLP given to ReplaceTNLP */
+    bool reuse_structure_;
+    //@}
   };
 
 } // namespace Ipopt
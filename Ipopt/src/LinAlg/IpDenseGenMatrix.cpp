@@ -116,7 +116,10 @@ namespace Ipopt
     DBG_ASSERT(NCols()==V2.NCols());
     DBG_ASSERT(beta==0. || initialized_);
 
-    if (beta==0.) {
+    if (V1.TransMultMultiVectorMatrix(alpha, V2, beta, values_, NRows())) {
+      // done with one matrix-matrix product
+    }
+    else if (beta==0.) {
       for (Index j=0; j<NCols(); j++) {
         for (Index i=0; i<NRows(); i++) {
           values_[i+j*NRows()] = alpha*V1.GetVector(i)->Dot(*V2.GetVector(j));
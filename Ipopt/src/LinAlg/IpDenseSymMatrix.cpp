@@ -118,7 +118,22 @@ namespace Ipopt
     DBG_ASSERT(beta==0. || initialized_);
 
     const Index dim = Dim();
-    if (beta==0.) {
+    std::vector<Number> prod((size_t)dim*(size_t)dim);
+    if (dim>0 && V1.TransMultMultiVectorMatrix(alpha, V2, 0., &prod[0], dim)) {
+      // The full product has been computed with one matrix-matrix
+      // product; only its lower triangle is used
+      for (Index j=0; j<dim; j++) {
+        for (Index i=j; i<dim; i++) {
+          if (beta==0.) {
+            values_[i+j*dim] = prod[i+j*dim];
+          }
+          else {
+            values_[i+j*dim] = prod[i+j*dim] + beta*values_[i+j*dim];
+          }
+        }
+      }
+    }
+    else if (beta==0.) {
       for (Index j=0; j<dim; j++) {
         for (Index i=j; i<dim; i++) {
           values_[i+j*dim] = alpha*V1.GetVector(i)->Dot(*V2.GetVector(j));
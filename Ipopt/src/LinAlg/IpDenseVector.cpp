@@ -22,6 +22,12 @@
 #endif
 
 #include <limits>
+#include <new>
+#include <cstdlib>
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 namespace Ipopt
 {
@@ -30,6 +36,41 @@ namespace Ipopt
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Number of threads for an operation on vectors of the given
+   *  space */
+  static inline Index DenseVectorNumThreads(const DenseVectorSpace& space)
+  {
+#ifdef _OPENMP
+    // Do not start threads for small vectors, or if we are already
+    // inside of a parallel region
+    if (space.Dim() < space.ParallelMinDim() || omp_in_parallel()) {
+      return 1;
+    }
+    Index nthreads = space.NumThreads();
+    if (nthreads <= 0) {
+      nthreads = omp_get_max_threads();
+    }
+    return Ipopt::Max(nthreads, 1);
+#else
+    return 1;
+#endif
+  }
+
+  /** Number of blocks for the reductions on large vectors.  The
+   *  partial results of the blocks are kept in an array on the stack
+   *  and are combined in the order of the blocks.  Sums over vectors
+   *  with at least ParallelMinDim elements are always computed in
+   *  these blocks, also by one thread or without OpenMP, so that the
+   *  rounding does not depend on the number of threads. */
+  static const Index dense_vector_num_blocks = 64;
+
+  /** First element of block k in a blocked reduction over dim
+   *  elements */
+  static inline Index DenseVectorBlockStart(Index dim, Index k)
+  {
+    return (Index)(((double)dim*k)/dense_vector_num_blocks);
+  }
+
   DenseVector::DenseVector(const DenseVectorSpace* owner_space)
       :
       Vector(owner_space),
@@ -231,6 +272,10 @@ namespace Ipopt
 
   void DenseVector::ElementWiseDivideImpl(const Vector& x)
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
     DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
@@ -245,19 +290,28 @@ namespace Ipopt
       else {
         homogeneous_ = false;
         Number* vals = values_allocated();
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           vals[i] = scalar_/values_x[i];
         }
       }
     }
     else {
       if (dense_x->homogeneous_) {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] /= dense_x->scalar_;
         }
       }
       else {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] /= values_x[i];
         }
       }
@@ -266,6 +320,10 @@ namespace Ipopt
 
   void DenseVector::ElementWiseMultiplyImpl(const Vector& x)
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
     DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
@@ -280,7 +338,10 @@ namespace Ipopt
       else {
         homogeneous_ = false;
         Number* vals = values_allocated();
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           vals[i] = scalar_*values_x[i];
         }
       }
@@ -288,13 +349,19 @@ namespace Ipopt
     else {
       if (dense_x->homogeneous_) {
         if (dense_x->scalar_ != 1.0) {
-          for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+          #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+          for (Index i=0; i<dim; i++) {
             values_[i] *= dense_x->scalar_;
           }
         }
       }
       else {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] *= values_x[i];
         }
       }
@@ -303,6 +370,10 @@ namespace Ipopt
 
   void DenseVector::ElementWiseMaxImpl(const Vector& x)
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
     DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
@@ -317,19 +388,28 @@ namespace Ipopt
       else {
         homogeneous_ = false;
         Number* vals = values_allocated();
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           vals[i] = Ipopt::Max(scalar_, values_x[i]);
         }
       }
     }
     else {
       if (dense_x->homogeneous_) {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = Ipopt::Max(values_[i], dense_x->scalar_);
         }
       }
       else {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = Ipopt::Max(values_[i], values_x[i]);
         }
       }
@@ -338,6 +418,10 @@ namespace Ipopt
 
   void DenseVector::ElementWiseMinImpl(const Vector& x)
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
     DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
@@ -352,19 +436,28 @@ namespace Ipopt
       else {
         homogeneous_ = false;
         Number* vals = values_allocated();
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           vals[i] = Ipopt::Min(scalar_, values_x[i]);
         }
       }
     }
     else {
       if (dense_x->homogeneous_) {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = Ipopt::Min(values_[i], dense_x->scalar_);
         }
       }
       else {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = Ipopt::Min(values_[i], values_x[i]);
         }
       }
@@ -373,12 +466,19 @@ namespace Ipopt
 
   void DenseVector::ElementWiseReciprocalImpl()
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     if (homogeneous_) {
       scalar_ = 1.0/scalar_;
     }
     else {
-      for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index i=0; i<dim; i++) {
         values_[i] = 1.0/values_[i];
       }
     }
@@ -386,12 +486,19 @@ namespace Ipopt
 
   void DenseVector::ElementWiseAbsImpl()
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     if (homogeneous_) {
       scalar_ = fabs(scalar_);
     }
     else {
-      for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index i=0; i<dim; i++) {
         values_[i] = fabs(values_[i]);
       }
     }
@@ -399,12 +506,19 @@ namespace Ipopt
 
   void DenseVector::ElementWiseSqrtImpl()
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     if (homogeneous_) {
       scalar_ = sqrt(scalar_);
     }
     else {
-      for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index i=0; i<dim; i++) {
         values_[i] = sqrt(values_[i]);
       }
     }
@@ -433,8 +547,29 @@ namespace Ipopt
       max = scalar_;
     }
     else {
+      const Index dim = Dim();
+#ifdef _OPENMP
+      const Index nthreads = DenseVectorNumThreads(*owner_space_);
+      if (nthreads>1) {
+        Number partial[dense_vector_num_blocks];
+        #pragma omp parallel for num_threads(nthreads)
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          const Index last = DenseVectorBlockStart(dim, k+1);
+          Number max_k = -std::numeric_limits<Number>::max();
+          for (Index i=DenseVectorBlockStart(dim, k); i<last; i++) {
+            max_k = Ipopt::Max(values_[i], max_k);
+          }
+          partial[k] = max_k;
+        }
+        max = partial[0];
+        for (Index k=1; k<dense_vector_num_blocks; k++) {
+          max = Ipopt::Max(partial[k], max);
+        }
+        return max;
+      }
+#endif
       max = values_[0];
-      for (Index i=1; i<Dim(); i++) {
+      for (Index i=1; i<dim; i++) {
         max = Ipopt::Max(values_[i], max);
       }
     }
@@ -453,8 +588,29 @@ namespace Ipopt
       min = scalar_;
     }
     else {
+      const Index dim = Dim();
+#ifdef _OPENMP
+      const Index nthreads = DenseVectorNumThreads(*owner_space_);
+      if (nthreads>1) {
+        Number partial[dense_vector_num_blocks];
+        #pragma omp parallel for num_threads(nthreads)
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          const Index last = DenseVectorBlockStart(dim, k+1);
+          Number min_k = std::numeric_limits<Number>::max();
+          for (Index i=DenseVectorBlockStart(dim, k); i<last; i++) {
+            min_k = Ipopt::Min(values_[i], min_k);
+          }
+          partial[k] = min_k;
+        }
+        min = partial[0];
+        for (Index k=1; k<dense_vector_num_blocks; k++) {
+          min = Ipopt::Min(partial[k], min);
+        }
+        return min;
+      }
+#endif
       min = values_[0];
-      for (Index i=1; i<Dim(); i++) {
+      for (Index i=1; i<dim; i++) {
         min = Ipopt::Min(values_[i], min);
       }
     }
@@ -469,8 +625,30 @@ namespace Ipopt
       sum = Dim()*scalar_;
     }
     else {
+      const Index dim = Dim();
+      if (dim >= owner_space_->ParallelMinDim()) {
+        // The summation order only depends on the dimension
+        Number partial[dense_vector_num_blocks];
+#ifdef _OPENMP
+        const Index nthreads = DenseVectorNumThreads(*owner_space_);
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          const Index last = DenseVectorBlockStart(dim, k+1);
+          Number sum_k = 0.;
+          for (Index i=DenseVectorBlockStart(dim, k); i<last; i++) {
+            sum_k += values_[i];
+          }
+          partial[k] = sum_k;
+        }
+        sum = 0.;
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          sum += partial[k];
+        }
+        return sum;
+      }
       sum = 0.;
-      for (Index i=0; i<Dim(); i++) {
+      for (Index i=0; i<dim; i++) {
         sum += values_[i];
       }
     }
@@ -485,8 +663,30 @@ namespace Ipopt
       sum = Dim() * log(scalar_);
     }
     else {
+      const Index dim = Dim();
+      if (dim >= owner_space_->ParallelMinDim()) {
+        // The summation order only depends on the dimension
+        Number partial[dense_vector_num_blocks];
+#ifdef _OPENMP
+        const Index nthreads = DenseVectorNumThreads(*owner_space_);
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          const Index last = DenseVectorBlockStart(dim, k+1);
+          Number sum_k = 0.;
+          for (Index i=DenseVectorBlockStart(dim, k); i<last; i++) {
+            sum_k += log(values_[i]);
+          }
+          partial[k] = sum_k;
+        }
+        sum = 0.;
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          sum += partial[k];
+        }
+        return sum;
+      }
       sum = 0.0;
-      for (Index i=0; i<Dim(); i++) {
+      for (Index i=0; i<dim; i++) {
         sum += log(values_[i]);
       }
     }
@@ -495,6 +695,10 @@ namespace Ipopt
 
   void DenseVector::ElementWiseSgnImpl()
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(initialized_);
     if (homogeneous_) {
       if (scalar_ > 0.) {
@@ -508,7 +712,10 @@ namespace Ipopt
       }
     }
     else {
-      for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index i=0; i<dim; i++) {
         if (values_[i] > 0.) {
           values_[i] = 1.;
         }
@@ -522,147 +729,96 @@ namespace Ipopt
     }
   }
 
-  // Specialized Functions
-  void DenseVector::AddTwoVectorsImpl(Number a, const Vector& v1,
-                                      Number b, const Vector& v2, Number c)
+  /** Compute values = a*values_v1 + b*values_v2 + c*values for n
+   *  elements (values_v1 is not used if a is zero, and values_v2 is
+   *  not used if b is zero). */
+  static void AddTwoVectorsKernel(Index n, Number a, const Number* values_v1,
+                                  Number b, const Number* values_v2,
+                                  Number c, Number* values)
   {
-    const Number* values_v1=NULL;
-    bool homogeneous_v1=false;
-    Number scalar_v1 = 0;
-    if (a!=0.) {
-      const DenseVector* dense_v1 = static_cast<const DenseVector*>(&v1);
-      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v1));
-
-      DBG_ASSERT(dense_v1->initialized_);
-      DBG_ASSERT(Dim() == dense_v1->Dim());
-      values_v1=dense_v1->values_;
-      homogeneous_v1=dense_v1->homogeneous_;
-      if (homogeneous_v1)
-        scalar_v1 = dense_v1->scalar_;
-    }
-    const Number* values_v2=NULL;
-    bool homogeneous_v2=false;
-    Number scalar_v2 = 0;
-    if (b!=0.) {
-      const DenseVector* dense_v2 = static_cast<const DenseVector*>(&v2);
-      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v2));
-
-      DBG_ASSERT(dense_v2->initialized_);
-      DBG_ASSERT(Dim() == dense_v2->Dim());
-      values_v2=dense_v2->values_;
-      homogeneous_v2=dense_v2->homogeneous_;
-      if (homogeneous_v2)
-        scalar_v2 = dense_v2->scalar_;
-    }
-    DBG_ASSERT(c==0. || initialized_);
-    if ((c==0. || homogeneous_) && homogeneous_v1 && homogeneous_v2 ) {
-      homogeneous_ = true;
-      Number val = 0;
-      if (c!=0.) {
-        val = c*scalar_;
-      }
-      scalar_ = val + a*scalar_v1 + b*scalar_v2;
-      initialized_ = true;
-      return;
-    }
-    if (c==0.) {
-      // make sure we have memory allocated for this vector
-      values_allocated();
-      homogeneous_ = false;
-    }
-
-    // If any of the vectors is homogeneous, call the default implementation
-    if ( homogeneous_ || homogeneous_v1 || homogeneous_v2) {
-      // ToDo:Should we implement specialized methods here too?
-      Vector::AddTwoVectorsImpl(a, v1, b, v2, c);
-      return;
-    }
-
     // I guess I'm going over board here, but it might be best to
     // capture all cases for a, b, and c separately...
     if (c==0 ) {
       if (a==1.) {
         if (b==0.) {
-          IpBlasDcopy(Dim(), values_v1, 1, values_, 1);
+          IpBlasDcopy(n, values_v1, 1, values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + values_v2[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] - values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] - values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + b*values_v2[i];
           }
         }
       }
       else if (a==-1.) {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + values_v2[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] - values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] - values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + b*values_v2[i];
           }
         }
       }
       else if (a==0.) {
         if (b==0.) {
           Number zero = 0.;
-          IpBlasDcopy(Dim(), &zero, 0, values_, 1);
+          IpBlasDcopy(n, &zero, 0, values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            IpBlasDcopy(Dim(), values_v2, 1, values_, 1);
-          }
+          IpBlasDcopy(n, values_v2, 1, values, 1);
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = b*values_v2[i];
           }
         }
       }
       else {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + values_v2[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] - values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] - values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + b*values_v2[i];
           }
         }
       }
@@ -670,41 +826,41 @@ namespace Ipopt
     else if (c==1.) {
       if (a==1.) {
         if (b==0.) {
-          IpBlasDaxpy(Dim(), 1., values_v1, 1, values_, 1);
+          IpBlasDaxpy(n, 1., values_v1, 1, values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += values_v1[i] + values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += values_v1[i] + values_v2[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += values_v1[i] - values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += values_v1[i] - values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += values_v1[i] + b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += values_v1[i] + b*values_v2[i];
           }
         }
       }
       else if (a==-1.) {
         if (b==0.) {
-          IpBlasDaxpy(Dim(), -1., values_v1, 1, values_, 1);
+          IpBlasDaxpy(n, -1., values_v1, 1, values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += -values_v1[i] + values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += -values_v1[i] + values_v2[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += -values_v1[i] - values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += -values_v1[i] - values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += -values_v1[i] + b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += -values_v1[i] + b*values_v2[i];
           }
         }
       }
@@ -713,34 +869,32 @@ namespace Ipopt
           /* Nothing */
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            IpBlasDaxpy(Dim(), 1., values_v2, 1, values_, 1);
-          }
+          IpBlasDaxpy(n, 1., values_v2, 1, values, 1);
         }
         else if (b==-1.) {
-          IpBlasDaxpy(Dim(), -1., values_v2, 1, values_, 1);
+          IpBlasDaxpy(n, -1., values_v2, 1, values, 1);
         }
         else {
-          IpBlasDaxpy(Dim(), b, values_v2, 1, values_, 1);
+          IpBlasDaxpy(n, b, values_v2, 1, values, 1);
         }
       }
       else {
         if (b==0.) {
-          IpBlasDaxpy(Dim(), a, values_v1, 1, values_, 1);
+          IpBlasDaxpy(n, a, values_v1, 1, values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += a*values_v1[i] + values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += a*values_v1[i] + values_v2[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += a*values_v1[i] - values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += a*values_v1[i] - values_v2[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] += a*values_v1[i] + b*values_v2[i];
+          for (Index i=0; i<n; i++) {
+            values[i] += a*values_v1[i] + b*values_v2[i];
           }
         }
       }
@@ -748,87 +902,87 @@ namespace Ipopt
     else if (c==-1.) {
       if (a==1.) {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] - values[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + values_v2[i] - values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] - values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] - values_v2[i] - values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + b*values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + b*values_v2[i] - values[i];
           }
         }
       }
       else if (a==-1.) {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] - values[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + values_v2[i] - values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] - values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] - values_v2[i] - values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + b*values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + b*values_v2[i] - values[i];
           }
         }
       }
       else if (a==0.) {
         if (b==0.) {
-          IpBlasDscal(Dim(), -1., values_, 1);
+          IpBlasDscal(n, -1., values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v2[i] - values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v2[i] - values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = b*values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = b*values_v2[i] - values[i];
           }
         }
       }
       else {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] - values[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + values_v2[i] - values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] - values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] - values_v2[i] - values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + b*values_v2[i] - values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + b*values_v2[i] - values[i];
           }
         }
       }
@@ -836,133 +990,241 @@ namespace Ipopt
     else {
       if (a==1.) {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + c*values[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + values_v2[i] + c*values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] - values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] - values_v2[i] + c*values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v1[i] + b*values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v1[i] + b*values_v2[i] + c*values[i];
           }
         }
       }
       else if (a==-1.) {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + c*values[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + values_v2[i] + c*values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] - values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] - values_v2[i] + c*values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v1[i] + b*values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v1[i] + b*values_v2[i] + c*values[i];
           }
         }
       }
       else if (a==0.) {
         if (b==0.) {
-          IpBlasDscal(Dim(), c, values_, 1);
+          IpBlasDscal(n, c, values, 1);
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = values_v2[i] + c*values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = -values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = -values_v2[i] + c*values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = b*values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = b*values_v2[i] + c*values[i];
           }
         }
       }
       else {
         if (b==0.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + c*values[i];
           }
         }
         else if (b==1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + values_v2[i] + c*values[i];
           }
         }
         else if (b==-1.) {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] - values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] - values_v2[i] + c*values[i];
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
-            values_[i] = a*values_v1[i] + b*values_v2[i] + c*values_[i];
+          for (Index i=0; i<n; i++) {
+            values[i] = a*values_v1[i] + b*values_v2[i] + c*values[i];
           }
         }
       }
     }
-    initialized_=true;
   }
 
-  Number
-  DenseVector::FracToBoundImpl(const Vector& delta, Number tau) const
+  // Specialized Functions
+  void DenseVector::AddTwoVectorsImpl(Number a, const Vector& v1,
+                                      Number b, const Vector& v2, Number c)
   {
-    DBG_ASSERT(Dim()==delta.Dim());
-    DBG_ASSERT(tau>=0.);
-    const DenseVector* dense_delta = static_cast<const DenseVector*>(&delta);
-    DBG_ASSERT(dynamic_cast<const DenseVector*>(&delta));
+    const Number* values_v1=NULL;
+    bool homogeneous_v1=false;
+    Number scalar_v1 = 0;
+    if (a!=0.) {
+      const DenseVector* dense_v1 = static_cast<const DenseVector*>(&v1);
+      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v1));
+
+      DBG_ASSERT(dense_v1->initialized_);
+      DBG_ASSERT(Dim() == dense_v1->Dim());
+      values_v1=dense_v1->values_;
+      homogeneous_v1=dense_v1->homogeneous_;
+      if (homogeneous_v1)
+        scalar_v1 = dense_v1->scalar_;
+    }
+    const Number* values_v2=NULL;
+    bool homogeneous_v2=false;
+    Number scalar_v2 = 0;
+    if (b!=0.) {
+      const DenseVector* dense_v2 = static_cast<const DenseVector*>(&v2);
+      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v2));
+
+      DBG_ASSERT(dense_v2->initialized_);
+      DBG_ASSERT(Dim() == dense_v2->Dim());
+      values_v2=dense_v2->values_;
+      homogeneous_v2=dense_v2->homogeneous_;
+      if (homogeneous_v2)
+        scalar_v2 = dense_v2->scalar_;
+    }
+    DBG_ASSERT(c==0. || initialized_);
+    if ((c==0. || homogeneous_) && homogeneous_v1 && homogeneous_v2 ) {
+      homogeneous_ = true;
+      Number val = 0;
+      if (c!=0.) {
+        val = c*scalar_;
+      }
+      scalar_ = val + a*scalar_v1 + b*scalar_v2;
+      initialized_ = true;
+      return;
+    }
+    if (c==0.) {
+      // make sure we have memory allocated for this vector
+      values_allocated();
+      homogeneous_ = false;
+    }
+
+    // If any of the vectors is homogeneous, call the default implementation
+    if ( homogeneous_ || homogeneous_v1 || homogeneous_v2) {
+      // ToDo:Should we implement specialized methods here too?
+      Vector::AddTwoVectorsImpl(a, v1, b, v2, c);
+      return;
+    }
+
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+    if (nthreads>1) {
+      // Each thread works on a contiguous part of the vectors
+      #pragma omp parallel for num_threads(nthreads)
+      for (Index t=0; t<nthreads; t++) {
+        const Index first = (Index)(((double)dim*t)/nthreads);
+        const Index last = (Index)(((double)dim*(t+1))/nthreads);
+        AddTwoVectorsKernel(last-first, a, values_v1 ? values_v1+first : NULL,
+                            b, values_v2 ? values_v2+first : NULL,
+                            c, values_+first);
+      }
+      initialized_=true;
+      return;
+    }
+#endif
+    AddTwoVectorsKernel(dim, a, values_v1, b, values_v2, c, values_);
+    initialized_=true;
+  }
 
+  /** Compute the fraction-to-the-boundary step size for the elements
+   *  first to last-1, where values_x (or scalar_x if values_x is
+   *  NULL) are the values of the vector and values_delta (or
+   *  scalar_delta if values_delta is NULL) those of the step. */
+  static Number FracToBoundKernel(Index first, Index last, Number tau,
+                                  const Number* values_x, Number scalar_x,
+                                  const Number* values_delta,
+                                  Number scalar_delta)
+  {
     Number alpha = 1.;
-    Number* values_x = values_;
-    Number* values_delta = dense_delta->values_;
-    if (homogeneous_) {
-      if (dense_delta->homogeneous_) {
-        if (dense_delta->scalar_<0.) {
-          alpha = Ipopt::Min(alpha, -tau/dense_delta->scalar_ * scalar_);
+    if (!values_x) {
+      for (Index i=first; i<last; i++) {
+        if (values_delta[i]<0.) {
+          alpha = Ipopt::Min(alpha, -tau/values_delta[i] * scalar_x);
         }
       }
-      else {
-        for (Index i=0; i<Dim(); i++) {
-          if (values_delta[i]<0.) {
-            alpha = Ipopt::Min(alpha, -tau/values_delta[i] * scalar_);
-          }
-        }
+    }
+    else if (!values_delta) {
+      for (Index i=first; i<last; i++) {
+        alpha = Ipopt::Min(alpha, -tau/scalar_delta * values_x[i]);
       }
     }
     else {
-      if (dense_delta->homogeneous_) {
-        if (dense_delta->scalar_<0.) {
-          for (Index i=0; i<Dim(); i++) {
-            alpha = Ipopt::Min(alpha, -tau/dense_delta->scalar_ * values_x[i]);
-          }
+      for (Index i=first; i<last; i++) {
+        if (values_delta[i]<0.) {
+          alpha = Ipopt::Min(alpha, -tau/values_delta[i] * values_x[i]);
         }
       }
-      else {
-        for (Index i=0; i<Dim(); i++) {
-          if (values_delta[i]<0.) {
-            alpha = Ipopt::Min(alpha, -tau/values_delta[i] * values_x[i]);
-          }
-        }
+    }
+    return alpha;
+  }
+
+  Number
+  DenseVector::FracToBoundImpl(const Vector& delta, Number tau) const
+  {
+    DBG_ASSERT(Dim()==delta.Dim());
+    DBG_ASSERT(tau>=0.);
+    const DenseVector* dense_delta = static_cast<const DenseVector*>(&delta);
+    DBG_ASSERT(dynamic_cast<const DenseVector*>(&delta));
+
+    Number alpha = 1.;
+    if (homogeneous_ && dense_delta->homogeneous_) {
+      if (dense_delta->scalar_<0.) {
+        alpha = Ipopt::Min(alpha, -tau/dense_delta->scalar_ * scalar_);
+      }
+    }
+    else if (!dense_delta->homogeneous_ || dense_delta->scalar_<0.) {
+      const Index dim = Dim();
+      const Number* vals_x = homogeneous_ ? NULL : values_;
+      const Number* vals_delta =
+        dense_delta->homogeneous_ ? NULL : dense_delta->values_;
+#ifdef _OPENMP
+      const Index nthreads = DenseVectorNumThreads(*owner_space_);
+      if (nthreads>1) {
+        Number partial[dense_vector_num_blocks];
+        #pragma omp parallel for num_threads(nthreads)
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          partial[k] = FracToBoundKernel(DenseVectorBlockStart(dim, k),
+                                         DenseVectorBlockStart(dim, k+1),
+                                         tau, vals_x, scalar_, vals_delta,
+                                         dense_delta->scalar_);
+        }
+        for (Index k=0; k<dense_vector_num_blocks; k++) {
+          alpha = Ipopt::Min(alpha, partial[k]);
+        }
+      }
+      else
+#endif
+      {
+        alpha = FracToBoundKernel(0, dim, tau, vals_x, scalar_, vals_delta,
+                                  dense_delta->scalar_);
       }
     }
 
@@ -973,6 +1235,10 @@ namespace Ipopt
   void DenseVector::AddVectorQuotientImpl(Number a, const Vector& z,
                                           const Vector& s, Number c)
   {
+    const Index dim = Dim();
+#ifdef _OPENMP
+    const Index nthreads = DenseVectorNumThreads(*owner_space_);
+#endif
     DBG_ASSERT(Dim()==z.Dim());
     DBG_ASSERT(Dim()==s.Dim());
     const DenseVector* dense_z = static_cast<const DenseVector*>(&z);
@@ -1013,18 +1279,27 @@ namespace Ipopt
     if (c==0.) {
       if (homogeneous_z) {
         // then s is not homogeneous
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = a * dense_z->scalar_ / values_s[i];
         }
       }
       else if (homogeneous_s) {
         // then z is not homogeneous
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = values_z[i] * a / dense_s->scalar_;
         }
       }
       else {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = a * values_z[i] / values_s[i];
         }
       }
@@ -1033,18 +1308,27 @@ namespace Ipopt
       Number val = c*scalar_;
       if (homogeneous_z) {
         // then s is not homogeneous
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = val + a * dense_z->scalar_ / values_s[i];
         }
       }
       else if (homogeneous_s) {
         // then z is not homogeneous
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = val + values_z[i] * a / dense_s->scalar_;
         }
       }
       else {
-        for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+        for (Index i=0; i<dim; i++) {
           values_[i] = val + a * values_z[i] / values_s[i];
         }
       }
@@ -1053,24 +1337,36 @@ namespace Ipopt
       // ToDo could distinguish c = 1
       if (homogeneous_z) {
         if (homogeneous_s) {
-          for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+          #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+          for (Index i=0; i<dim; i++) {
             values_[i] = c*values_[i] + a * dense_z->scalar_/dense_s->scalar_;
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+          #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+          for (Index i=0; i<dim; i++) {
             values_[i] = c*values_[i] + a * dense_z->scalar_/values_s[i];
           }
         }
       }
       else {
         if (homogeneous_s) {
-          for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+          #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+          for (Index i=0; i<dim; i++) {
             values_[i] = c*values_[i] + values_z[i] * a /dense_s->scalar_;
           }
         }
         else {
-          for (Index i=0; i<Dim(); i++) {
+#ifdef _OPENMP
+          #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+          for (Index i=0; i<dim; i++) {
             values_[i] = c*values_[i] + a * values_z[i]/values_s[i];
           }
         }
@@ -1160,4 +1456,79 @@ namespace Ipopt
                            prefix.c_str());
     }
   }
+  /** Alignment of the arrays for the vector values (in bytes) */
+  static const size_t dense_vector_alignment = 64;
+
+  /** Allocate an array of n Numbers aligned to dense_vector_alignment
+   *  bytes.  The pointer returned by malloc is stored right before
+   *  the aligned array. */
+  static Number* AllocateAlignedNumbers(Index n)
+  {
+    const size_t size = n*sizeof(Number) + dense_vector_alignment + sizeof(void*);
+    void* raw = malloc(size);
+    if (!raw) {
+      throw std::bad_alloc();
+    }
+    size_t addr = (size_t)raw + sizeof(void*);
+    addr = (addr + dense_vector_alignment - 1) & ~(dense_vector_alignment - 1);
+    ((void**)addr)[-1] = raw;
+    return (Number*)addr;
+  }
+
+  /** Free an array allocated by AllocateAlignedNumbers */
+  static void FreeAlignedNumbers(Number* values)
+  {
+    free(((void**)values)[-1]);
+  }
+
+  DenseVectorSpace::~DenseVectorSpace()
+  {
+    for (size_t i=0; i<pool_.size(); i++) {
+      FreeAlignedNumbers(pool_[i]);
+    }
+  }
+
+  Number* DenseVectorSpace::AllocateInternalStorage() const
+  {
+    if (Dim()==0) {
+      return NULL;
+    }
+    if (!pool_.empty()) {
+      Number* values = pool_.back();
+      pool_.pop_back();
+      pool_hits_++;
+      return values;
+    }
+    pool_misses_++;
+    return AllocateAlignedNumbers(Dim());
+  }
+
+  void DenseVectorSpace::FreeInternalStorage(Number* values) const
+  {
+    if (!values) {
+      return;
+    }
+    if ((double)(pool_.size()+1)*Dim()*sizeof(Number) <=
+        pool_max_bytes_) {
+      pool_.push_back(values);
+    }
+    else {
+      FreeAlignedNumbers(values);
+    }
+  }
+
+  void DenseVectorSpace::SetParallelParameters(Index num_threads,
+      Index min_dim)
+  {
+    DBG_ASSERT(num_threads>=0);
+    num_threads_ = num_threads;
+    parallel_min_dim_ = min_dim;
+  }
+
+  void DenseVectorSpace::SetMaxPoolMemory(Number max_megabytes)
+  {
+    DBG_ASSERT(max_megabytes>=0.);
+    pool_max_bytes_ = max_megabytes*1024.*1024.;
+  }
+
 } // namespace Ipopt
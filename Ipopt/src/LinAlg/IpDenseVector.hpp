@@ -12,6 +12,7 @@
 #include "IpUtils.hpp"
 #include "IpVector.hpp"
 #include <map>
+#include <vector>
 
 namespace Ipopt
 {
@@ -292,12 +293,16 @@ namespace Ipopt
      */
     DenseVectorSpace(Index dim)
         :
-        VectorSpace(dim)
+        VectorSpace(dim),
+        num_threads_(0),
+        parallel_min_dim_(100000),
+        pool_max_bytes_(100.*1024.*1024.),
+        pool_hits_(0),
+        pool_misses_(0)
     {}
 
     /** Destructor */
-    ~DenseVectorSpace()
-    {}
+    ~DenseVectorSpace();
     //@}
 
     /** Method for creating a new vector of this specific type. */
@@ -316,17 +321,64 @@ namespace Ipopt
     }
 
     /**@name Methods called by DenseVector for memory management.
-     * This could allow to have sophisticated memory management in the
-     * VectorSpace.
+     * The arrays are aligned to 64 bytes.  Freed arrays are kept in a
+     * pool of the vector space (up to the limit set by
+     * SetMaxPoolMemory) and handed out again by the next allocation,
+     * so that in the steady state of the algorithm no memory has to
+     * be allocated for the vector values.  This is not thread-safe,
+     * i.e., a vector space must not be used by several threads at the
+     * same time.
      */
     //@{
     /** Allocate internal storage for the DenseVector */
-    inline
     Number* AllocateInternalStorage() const;
 
     /** Deallocate internal storage for the DenseVector */
-    inline
     void FreeInternalStorage(Number* values) const;
+
+    /** Number of allocations served from the pool */
+    Index PoolHits() const
+    {
+      return pool_hits_;
+    }
+
+    /** Number of allocations that required new memory */
+    Index PoolMisses() const
+    {
+      return pool_misses_;
+    }
+
+    /** Set the maximal amount of memory (in MB) that this vector
+     *  space keeps in its pool (100 MB by default).  If this is zero,
+     *  freed memory is released immediately. */
+    void SetMaxPoolMemory(Number max_megabytes);
+    //@}
+
+    /** @name Parallel execution of the element-wise operations */
+    //@{
+    /** Set the number of threads used for the element-wise
+     *  operations and reductions of the vectors in this space, if
+     *  Ipopt is compiled with OpenMP support and the dimension is at
+     *  least min_dim.  If num_threads is 0 (the default), the OpenMP
+     *  default is used.  Reductions (e.g., Sum, SumLogs, FracToBound)
+     *  on vectors with at least min_dim elements always combine
+     *  partial results of a fixed number of blocks in a fixed order,
+     *  also with one thread, so that the results do not depend on the
+     *  number of threads. */
+    void SetParallelParameters(Index num_threads, Index min_dim);
+
+    /** Number of threads for the operations on the vectors */
+    Index NumThreads() const
+    {
+      return num_threads_;
+    }
+
+    /** Minimal dimension for which the operations are done in
+     *  parallel */
+    Index ParallelMinDim() const
+    {
+      return parallel_min_dim_;
+    }
     //@}
 
     /**@name Methods for dealing with meta data on the vector
@@ -387,6 +439,24 @@ namespace Ipopt
     IntegerMetaDataMapType integer_meta_data_;
     NumericMetaDataMapType numeric_meta_data_;
 
+    /** @name Settings for the parallel operations */
+    //@{
+    Index num_threads_;
+    Index parallel_min_dim_;
+    //@}
+
+    /** @name Pool of freed arrays for the vector values */
+    //@{
+    /** Maximal number of bytes kept in the pool */
+    double pool_max_bytes_;
+    /** Arrays available for allocation, most recently freed last */
+    mutable std::vector<Number*> pool_;
+    /** Number of allocations served from the pool */
+    mutable Index pool_hits_;
+    /** Number of allocations that required new memory */
+    mutable Index pool_misses_;
+    //@}
+
   };
 
   // inline functions
@@ -421,23 +491,6 @@ namespace Ipopt
     return values_;
   }
 
-  inline
-  Number* DenseVectorSpace::AllocateInternalStorage() const
-  {
-    if (Dim()>0) {
-      return new Number[Dim()];
-    }
-    else {
-      return NULL;
-    }
-  }
-
-  inline
-  void DenseVectorSpace::FreeInternalStorage(Number* values) const
-  {
-    delete [] values;
-  }
-
   inline
   SmartPtr<DenseVector> DenseVector::MakeNewDenseVector() const
   {
@@ -7,6 +7,11 @@
 // Authors:  Andreas Waechter                IBM    2005-12-25
 
 #include "IpLowRankUpdateSymMatrix.hpp"
+#include "IpDenseVector.hpp"
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 namespace Ipopt
 {
@@ -15,6 +20,51 @@ namespace Ipopt
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Minimal dimension for which the diagonal part of the product is
+   *  computed with several threads. */
+  static const Index lowrank_parallel_dim = 100000;
+
+  /** Computes y = alpha*D*x + beta*y for DenseVectors, with the
+   *  elements distributed among threads for large vectors.  Returns
+   *  false if not all Vectors are DenseVectors. */
+  static bool DenseDiagMultVector(Number alpha, const Vector& D,
+                                  const Vector& x, Number beta, Vector& y)
+  {
+    const DenseVector* dense_D = dynamic_cast<const DenseVector*>(&D);
+    const DenseVector* dense_x = dynamic_cast<const DenseVector*>(&x);
+    DenseVector* dense_y = dynamic_cast<DenseVector*>(&y);
+    if (!dense_D || !dense_x || !dense_y) {
+      return false;
+    }
+    const Index dim = y.Dim();
+    const Number* dvals = dense_D->ExpandedValues();
+    const Number* xvals = dense_x->ExpandedValues();
+    Number* yvals = dense_y->Values();
+#ifdef _OPENMP
+    Index nthreads = 1;
+    if (dim >= lowrank_parallel_dim) {
+      nthreads = omp_get_max_threads();
+    }
+#endif
+    if (beta != 0.) {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index i=0; i<dim; i++) {
+        yvals[i] = alpha*dvals[i]*xvals[i] + beta*yvals[i];
+      }
+    }
+    else {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+      for (Index i=0; i<dim; i++) {
+        yvals[i] = alpha*dvals[i]*xvals[i];
+      }
+    }
+    return true;
+  }
+
   LowRankUpdateSymMatrix::LowRankUpdateSymMatrix(const LowRankUpdateSymMatrixSpace* owner_space)
       :
       SymMatrix(owner_space),
@@ -38,7 +88,10 @@ namespace Ipopt
     if (IsNull(P_LR)) {
 
       // Diagonal part
-      if ( beta!=0.0 ) {
+      if (DenseDiagMultVector(alpha, *D_, x, beta, y)) {
+        // done without temporary vectors
+      }
+      else if ( beta!=0.0 ) {
         SmartPtr<Vector> tmp_vec = x.MakeNewCopy();
         tmp_vec->ElementWiseMultiply(*D_);
         y.AddOneVector(alpha, *tmp_vec, beta);
@@ -86,9 +139,11 @@ namespace Ipopt
       }
       else {
         // Diagonal part
-        SmartPtr<Vector> tmp = x.MakeNewCopy();
-        tmp->ElementWiseMultiply(*D_);
-        y.AddOneVector(alpha, *tmp, beta);
+        if (!DenseDiagMultVector(alpha, *D_, x, beta, y)) {
+          SmartPtr<Vector> tmp = x.MakeNewCopy();
+          tmp->ElementWiseMultiply(*D_);
+          y.AddOneVector(alpha, *tmp, beta);
+        }
 
         // Get x into the smaller space
         SmartPtr<const VectorSpace> LR_vec_space = LowRankVectorSpace();
@@ -9,6 +9,7 @@
 #include "IpMultiVectorMatrix.hpp"
 #include "IpDenseVector.hpp"
 #include "IpDenseGenMatrix.hpp"
+#include "IpBlas.hpp"
 
 #ifdef HAVE_CSTDIO
 # include <cstdio>
@@ -20,6 +21,10 @@
 # endif
 #endif
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 namespace Ipopt
 {
 
@@ -27,14 +32,165 @@ namespace Ipopt
   static const Index dbg_verbosity = 0;
 #endif
 
+  /** Minimal number of elements of a MultiVectorMatrix for which the
+   *  products are computed with several threads. */
+  static const Index multivector_parallel_elements = 100000;
+
+  /** Number of threads used for the products with a matrix with the
+   *  given number of rows and columns.  The rows are distributed
+   *  among the threads. */
+  static Index MultiVectorNumThreads(Index nrows, Index ncols)
+  {
+#ifdef _OPENMP
+    if ((double)nrows*(double)ncols >= (double)multivector_parallel_elements) {
+      return Max(Index(1), Min(Index(omp_get_max_threads()), nrows));
+    }
+#endif
+    return 1;
+  }
+
+  /** Computes y = alpha*A*x + beta*y for the nrows x ncols matrix A,
+   *  stored column-wise with leading dimension nrows.  y is not read
+   *  if beta is zero. */
+  static void PackedMultVector(Index nrows, Index ncols, Number alpha,
+                               const Number* A, const Number* x,
+                               Number beta, Number* y)
+  {
+    const Index nthreads = MultiVectorNumThreads(nrows, ncols);
+    if (nthreads == 1) {
+      IpBlasDgemv(false, ncols, nrows, alpha, A, nrows, x, 1, beta, y, 1);
+      return;
+    }
+    const Index blk = nrows/nthreads;
+    const Index rem = nrows%nthreads;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (Index t=0; t<nthreads; t++) {
+      const Index rbeg = t*blk + Min(t, rem);
+      const Index rlen = blk + (t<rem ? 1 : 0);
+      IpBlasDgemv(false, ncols, rlen, alpha, A+rbeg, nrows, x, 1,
+                  beta, y+rbeg, 1);
+    }
+  }
+
+  /** Computes C = alpha*A^T*B + beta*C, where A (nrows x ncolsA) and
+   *  B (nrows x ncolsB) are stored column-wise with leading dimension
+   *  nrows, and C with leading dimension ldC.  With several threads,
+   *  each thread computes the product for a block of rows, and the
+   *  partial products are added in a fixed order.  C is not read if
+   *  beta is zero. */
+  static void PackedTransMultMatrix(Index nrows, Index ncolsA, Index ncolsB,
+                                    Number alpha, const Number* A,
+                                    const Number* B, Number beta,
+                                    Number* C, Index ldC)
+  {
+    const Index nthreads = MultiVectorNumThreads(nrows, ncolsA+ncolsB);
+    if (nthreads == 1) {
+      IpBlasDgemm(true, false, ncolsA, ncolsB, nrows, alpha, A, nrows,
+                  B, nrows, beta, C, ldC);
+      return;
+    }
+    const Index blk = nrows/nthreads;
+    const Index rem = nrows%nthreads;
+    const Index nC = ncolsA*ncolsB;
+    std::vector<Number> partial((size_t)nthreads*(size_t)nC);
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (Index t=0; t<nthreads; t++) {
+      const Index rbeg = t*blk + Min(t, rem);
+      const Index rlen = blk + (t<rem ? 1 : 0);
+      IpBlasDgemm(true, false, ncolsA, ncolsB, rlen, 1., A+rbeg, nrows,
+                  B+rbeg, nrows, 0., &partial[(size_t)t*(size_t)nC], ncolsA);
+    }
+    for (Index j=0; j<ncolsB; j++) {
+      for (Index i=0; i<ncolsA; i++) {
+        Number sum = 0.;
+        for (Index t=0; t<nthreads; t++) {
+          sum += partial[(size_t)t*(size_t)nC+i+j*ncolsA];
+        }
+        if (beta != 0.) {
+          C[i+j*ldC] = alpha*sum + beta*C[i+j*ldC];
+        }
+        else {
+          C[i+j*ldC] = alpha*sum;
+        }
+      }
+    }
+  }
+
   MultiVectorMatrix::MultiVectorMatrix(const MultiVectorMatrixSpace* owner_space)
       :
       Matrix(owner_space),
       owner_space_(owner_space),
       const_vecs_(owner_space->NCols()),
-      non_const_vecs_(owner_space->NCols())
+      non_const_vecs_(owner_space->NCols()),
+      packed_values_(NULL),
+      packed_tags_(owner_space->NCols())
   {}
 
+  MultiVectorMatrix::~MultiVectorMatrix()
+  {
+    delete [] packed_values_;
+  }
+
+  bool MultiVectorMatrix::UpdatePackedValues() const
+  {
+    const Index nrows = NRows();
+    const Index ncols = NCols();
+    if (nrows==0 || ncols==0) {
+      return false;
+    }
+    for (Index i=0; i<ncols; i++) {
+      if (IsNull(const_vecs_[i]) && IsNull(non_const_vecs_[i])) {
+        return false;
+      }
+      if (!dynamic_cast<const DenseVector*>(ConstVec(i))) {
+        return false;
+      }
+    }
+    if (!packed_values_) {
+      packed_values_ = new Number[(size_t)nrows*(size_t)ncols];
+    }
+    for (Index i=0; i<ncols; i++) {
+      const DenseVector* dvec = static_cast<const DenseVector*>(ConstVec(i));
+      if (packed_tags_[i] != dvec->GetTag()) {
+        IpBlasDcopy(nrows, dvec->ExpandedValues(), 1,
+                    packed_values_+(size_t)i*(size_t)nrows, 1);
+        packed_tags_[i] = dvec->GetTag();
+      }
+    }
+    return true;
+  }
+
+  const Number* MultiVectorMatrix::PackedValues() const
+  {
+    if (UpdatePackedValues()) {
+      return packed_values_;
+    }
+    return NULL;
+  }
+
+  bool MultiVectorMatrix::TransMultMultiVectorMatrix(Number alpha,
+      const MultiVectorMatrix& V,
+      Number beta,
+      Number* C,
+      Index ldC) const
+  {
+    DBG_ASSERT(NRows()==V.NRows());
+    DBG_ASSERT(ldC>=NCols());
+
+    const Number* Avalues = PackedValues();
+    const Number* Bvalues = V.PackedValues();
+    if (!Avalues || !Bvalues) {
+      return false;
+    }
+    PackedTransMultMatrix(NRows(), NCols(), V.NCols(), alpha, Avalues,
+                          Bvalues, beta, C, ldC);
+    return true;
+  }
+
   void MultiVectorMatrix::SetVector(Index i, const Vector& vec)
   {
     DBG_ASSERT(i<NCols());
@@ -58,6 +214,23 @@ namespace Ipopt
     DBG_ASSERT(NCols()==x.Dim());
     DBG_ASSERT(NRows()==y.Dim());
 
+    // See if we can understand the data
+    const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+    DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+    // If the columns are DenseVectors, this is one matrix-vector
+    // product with the contiguous copy of the columns
+    DenseVector* dense_y = dynamic_cast<DenseVector*>(&y);
+    if (dense_y) {
+      const Number* Avalues = PackedValues();
+      if (Avalues) {
+        Number* yvals = dense_y->Values();
+        PackedMultVector(NRows(), NCols(), alpha, Avalues,
+                         dense_x->ExpandedValues(), beta, yvals);
+        return;
+      }
+    }
+
     // Take care of the y part of the addition
     if ( beta!=0.0 ) {
       y.Scal(beta);
@@ -66,10 +239,6 @@ namespace Ipopt
       y.Set(0.0);  // In case y hasn't been initialized yet
     }
 
-    // See if we can understand the data
-    const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-    DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
     // We simply add all the Vectors one after the other
     if (dense_x->IsHomogeneous()) {
       Number val = dense_x->Scalar();
@@ -96,6 +265,19 @@ namespace Ipopt
     DenseVector* dense_y = static_cast<DenseVector*>(&y);
     DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
+    // If the columns are DenseVectors, this is one matrix-vector
+    // product with the contiguous copy of the columns
+    const DenseVector* dense_x = dynamic_cast<const DenseVector*>(&x);
+    if (dense_x) {
+      const Number* Avalues = PackedValues();
+      if (Avalues) {
+        Number *yvals=dense_y->Values();
+        PackedTransMultMatrix(NRows(), NCols(), 1, alpha, Avalues,
+                              dense_x->ExpandedValues(), beta, yvals, NCols());
+        return;
+      }
+    }
+
     // Use the individual dot products to get the matrix (transpose)
     // vector product
     Number *yvals=dense_y->Values();
@@ -123,6 +305,23 @@ namespace Ipopt
     DBG_PRINT((1, "alpha = %e beta = %e\n", alpha, beta));
     DBG_PRINT_VECTOR(2, "x", x);
 
+    // If all data is dense, compute t = V^T*x and y = alpha*V*t +
+    // beta*y with the contiguous copy of the columns
+    const DenseVector* dense_x = dynamic_cast<const DenseVector*>(&x);
+    DenseVector* dense_y = dynamic_cast<DenseVector*>(&y);
+    if (dense_x && dense_y) {
+      const Number* Avalues = PackedValues();
+      if (Avalues) {
+        std::vector<Number> t(NCols());
+        PackedTransMultMatrix(NRows(), NCols(), 1, 1., Avalues,
+                              dense_x->ExpandedValues(), 0., &t[0], NCols());
+        Number* yvals = dense_y->Values();
+        PackedMultVector(NRows(), NCols(), alpha, Avalues, &t[0], beta, yvals);
+        DBG_PRINT_VECTOR(2, "y", y);
+        return;
+      }
+    }
+
     if ( beta!=0.0 ) {
       y.Scal(beta);
     }
@@ -216,14 +415,51 @@ namespace Ipopt
       FillWithNewVectors();
     }
 
-    // ToDo: For now, we simply use MatrixVector multiplications, but
-    // we might be more efficient (at least in the non-parallel case)
-    // if we used Level 3 Blas
+    const DenseGenMatrix* dgm_C = static_cast<const DenseGenMatrix*>(&C);
+    DBG_ASSERT(dynamic_cast<const DenseGenMatrix*>(&C));
+
+    // If all columns are DenseVectors, compute the product as one
+    // matrix-matrix product for the contiguous copies of the columns,
+    // and copy the result into the column Vectors
+    const Number* Uvalues = U.PackedValues();
+    const Number* Vvalues = (b==0.) ? NULL : PackedValues();
+    bool dense_cols = (Uvalues != NULL) && (b==0. || Vvalues != NULL) &&
+                      NCols()>0;
+    for (Index i=0; i<NCols() && dense_cols; i++) {
+      dense_cols = (dynamic_cast<DenseVector*>(Vec(i)) != NULL);
+    }
+    if (dense_cols) {
+      const Index nrows = NRows();
+      if (!packed_values_) {
+        packed_values_ = new Number[(size_t)nrows*(size_t)NCols()];
+      }
+      const Index nthreads = MultiVectorNumThreads(nrows, NCols()+U.NCols());
+      const Index blk = nrows/nthreads;
+      const Index rem = nrows%nthreads;
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nthreads) if(nthreads>1) schedule(static,1)
+#endif
+      for (Index t=0; t<nthreads; t++) {
+        const Index rbeg = t*blk + Min(t, rem);
+        const Index rlen = blk + (t<rem ? 1 : 0);
+        IpBlasDgemm(false, false, rlen, NCols(), U.NCols(), a,
+                    Uvalues+rbeg, nrows, dgm_C->Values(), C.NRows(),
+                    b, packed_values_+rbeg, nrows);
+      }
+      for (Index i=0; i<NCols(); i++) {
+        DenseVector* dvec = static_cast<DenseVector*>(Vec(i));
+        IpBlasDcopy(nrows, packed_values_+(size_t)i*(size_t)nrows, 1,
+                    dvec->Values(), 1);
+        packed_tags_[i] = dvec->GetTag();
+      }
+      ObjectChanged();
+      return;
+    }
+
+    // Otherwise, we simply use MatrixVector multiplications
     SmartPtr<const DenseVectorSpace> mydspace = new DenseVectorSpace(C.NRows());
     SmartPtr<DenseVector> mydvec = mydspace->MakeNewDenseVector();
 
-    const DenseGenMatrix* dgm_C = static_cast<const DenseGenMatrix*>(&C);
-    DBG_ASSERT(dynamic_cast<const DenseGenMatrix*>(&C));
     for (Index i=0; i<NCols(); i++) {
       const Number* CValues = dgm_C->Values();
       Number* myvalues = mydvec->Values();
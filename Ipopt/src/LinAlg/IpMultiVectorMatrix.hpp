@@ -97,6 +97,22 @@ namespace Ipopt
     void LRMultVector(Number alpha, const Vector &x,
                       Number beta, Vector &y) const;
 
+    /** Computes the NCols() x V.NCols() matrix C = alpha*M^T*V +
+     *  beta*C, where M is this MultiVectorMatrix, and C is stored
+     *  column-wise with leading dimension ldC.  This is done with
+     *  one Level 3 BLAS call if the columns of both matrices are
+     *  DenseVectors; otherwise, false is returned and C is not
+     *  changed. */
+    bool TransMultMultiVectorMatrix(Number alpha, const MultiVectorMatrix& V,
+                                    Number beta, Number* C, Index ldC) const;
+
+    /** Values of all columns as one dense matrix, stored column-wise
+     *  with leading dimension NRows(), or NULL if not all columns are
+     *  DenseVectors.  This is a copy of the column Vectors that is
+     *  kept by this matrix; only the columns that have changed since
+     *  the last call (according to their tags) are copied again. */
+    const Number* PackedValues() const;
+
     /** Vector space for the columns */
     SmartPtr<const VectorSpace> ColVectorSpace() const;
 
@@ -156,6 +172,18 @@ namespace Ipopt
     /** space for storing the non-const Vector's */
     std::vector<SmartPtr<Vector> > non_const_vecs_;
 
+    /** @name Contiguous copy of the columns (see PackedValues) */
+    //@{
+    /** Values of the columns, stored column-wise */
+    mutable Number* packed_values_;
+    /** Tags of the Vectors at the time they were copied */
+    mutable std::vector<TaggedObject::Tag> packed_tags_;
+    //@}
+
+    /** Update the values of the columns in packed_values_ that have
+     *  changed.  Returns false if not all columns are DenseVectors. */
+    bool UpdatePackedValues() const;
+
     /** Method for accessing the internal Vectors internally */
     //@{
     inline const Vector* ConstVec(Index i) const
@@ -221,10 +249,6 @@ namespace Ipopt
 
   };
 
-  inline
-  MultiVectorMatrix::~MultiVectorMatrix()
-  {}
-
   inline
   SmartPtr<MultiVectorMatrix> MultiVectorMatrix::MakeNewMultiVectorMatrix() const
   {
@@ -674,6 +674,191 @@ namespace Ipopt
     THROW_EXCEPTION(UNKNOWN_VECTOR_TYPE,"Unknown vector type passed to TripletHelper::FillValues");
   }
 
+  void TripletHelper::FillValues(Index n_entries, const Matrix& matrix, Number* values, const Index* dest)
+  {
+    FillValuesScattered_(n_entries, matrix, 1., values, dest);
+  }
+
+  void TripletHelper::FillValuesScattered_(Index n_entries, const Matrix& matrix, Number factor, Number* values, const Index* dest)
+  {
+    if (n_entries == 0) {
+      return;
+    }
+    if (factor == 0.) {
+      ScatterConstant_(n_entries, 0., values, dest);
+      return;
+    }
+
+    const Matrix* mptr = &matrix;
+    const GenTMatrix* gent = dynamic_cast<const GenTMatrix*>(mptr);
+    if (gent) {
+      DBG_ASSERT(n_entries == gent->Nonzeros());
+      ScatterValues_(n_entries, gent->Values(), factor, values, dest);
+      return;
+    }
+
+    const SymTMatrix* symt = dynamic_cast<const SymTMatrix*>(mptr);
+    if (symt) {
+      DBG_ASSERT(n_entries == symt->Nonzeros());
+      ScatterValues_(n_entries, symt->Values(), factor, values, dest);
+      return;
+    }
+
+    const DiagMatrix* diag = dynamic_cast<const DiagMatrix*>(mptr);
+    if (diag) {
+      DBG_ASSERT(n_entries == diag->Dim());
+      ScatterValuesFromVector_(n_entries, *diag->GetDiag(), factor, values, dest);
+      return;
+    }
+
+    const IdentityMatrix* ident = dynamic_cast<const IdentityMatrix*>(mptr);
+    if (ident) {
+      DBG_ASSERT(n_entries == ident->Dim());
+      ScatterConstant_(n_entries, ident->GetFactor()*factor, values, dest);
+      return;
+    }
+
+    const ExpansionMatrix* exp = dynamic_cast<const ExpansionMatrix*>(mptr);
+    if (exp) {
+      DBG_ASSERT(n_entries == exp->NCols());
+      ScatterConstant_(n_entries, factor, values, dest);
+      return;
+    }
+
+    const SumMatrix* sum = dynamic_cast<const SumMatrix*>(mptr);
+    if (sum) {
+      for (Index i=0; i<sum->NTerms(); i++) {
+        Number retFactor = 0.0;
+        SmartPtr<const Matrix> retTerm;
+        sum->GetTerm(i, retFactor, retTerm);
+        Index term_n_entries = GetNumberEntries(*retTerm);
+        FillValuesScattered_(term_n_entries, *retTerm, factor*retFactor,
+                             values, dest);
+        dest += term_n_entries;
+      }
+      return;
+    }
+
+    const SumSymMatrix* sumsym = dynamic_cast<const SumSymMatrix*>(mptr);
+    if (sumsym) {
+      for (Index i=0; i<sumsym->NTerms(); i++) {
+        Number retFactor = 0.0;
+        SmartPtr<const SymMatrix> retTerm;
+        sumsym->GetTerm(i, retFactor, retTerm);
+        Index term_n_entries = GetNumberEntries(*retTerm);
+        FillValuesScattered_(term_n_entries, *retTerm, factor*retFactor,
+                             values, dest);
+        dest += term_n_entries;
+      }
+      return;
+    }
+
+    const CompoundMatrix* cmpd = dynamic_cast<const CompoundMatrix*>(mptr);
+    if (cmpd) {
+      for (Index i=0; i<cmpd->NComps_Rows(); i++) {
+        for (Index j=0; j<cmpd->NComps_Cols(); j++) {
+          SmartPtr<const Matrix> blk_mat = cmpd->GetComp(i, j);
+          if (IsValid(blk_mat)) {
+            Index blk_n_entries = GetNumberEntries(*blk_mat);
+            FillValuesScattered_(blk_n_entries, *blk_mat, factor, values, dest);
+            dest += blk_n_entries;
+          }
+        }
+      }
+      return;
+    }
+
+    const CompoundSymMatrix* cmpd_sym = dynamic_cast<const CompoundSymMatrix*>(mptr);
+    if (cmpd_sym) {
+      for (Index i=0; i<cmpd_sym->NComps_Dim(); i++) {
+        for (Index j=0; j<=i; j++) {
+          SmartPtr<const Matrix> blk_mat = cmpd_sym->GetComp(i, j);
+          if (IsValid(blk_mat)) {
+            Index blk_n_entries = GetNumberEntries(*blk_mat);
+            FillValuesScattered_(blk_n_entries, *blk_mat, factor, values, dest);
+            dest += blk_n_entries;
+          }
+        }
+      }
+      return;
+    }
+
+    // For all other matrix types, the values of the block are
+    // computed in a temporary array
+    Number* tmp = new Number[n_entries];
+    FillValues(n_entries, matrix, tmp);
+    ScatterValues_(n_entries, tmp, factor, values, dest);
+    delete [] tmp;
+  }
+
+  void TripletHelper::ScatterValues_(Index n_entries, const Number* vals, Number factor, Number* values, const Index* dest)
+  {
+    if (factor == 1.) {
+      for (Index i=0; i<n_entries; i++) {
+        const Index d = dest[i];
+        if (d >= 0) {
+          values[d] = vals[i];
+        }
+        else {
+          values[-d-1] += vals[i];
+        }
+      }
+    }
+    else {
+      for (Index i=0; i<n_entries; i++) {
+        const Index d = dest[i];
+        if (d >= 0) {
+          values[d] = factor*vals[i];
+        }
+        else {
+          values[-d-1] += factor*vals[i];
+        }
+      }
+    }
+  }
+
+  void TripletHelper::ScatterConstant_(Index n_entries, Number val, Number* values, const Index* dest)
+  {
+    for (Index i=0; i<n_entries; i++) {
+      const Index d = dest[i];
+      if (d >= 0) {
+        values[d] = val;
+      }
+      else {
+        values[-d-1] += val;
+      }
+    }
+  }
+
+  void TripletHelper::ScatterValuesFromVector_(Index dim, const Vector& vector, Number factor, Number* values, const Index* dest)
+  {
+    DBG_ASSERT(dim == vector.Dim());
+    const DenseVector* dv = dynamic_cast<const DenseVector*>(&vector);
+    if (dv) {
+      if (dv->IsHomogeneous()) {
+        ScatterConstant_(dim, factor*dv->Scalar(), values, dest);
+      }
+      else {
+        ScatterValues_(dim, dv->Values(), factor, values, dest);
+      }
+      return;
+    }
+
+    const CompoundVector* cv = dynamic_cast<const CompoundVector*>(&vector);
+    if (cv) {
+      Index ncomps = cv->NComps();
+      for (Index i=0; i<ncomps; i++) {
+        SmartPtr<const Vector> comp = cv->GetComp(i);
+        Index comp_dim = comp->Dim();
+        ScatterValuesFromVector_(comp_dim, *comp, factor, values, dest);
+        dest += comp_dim;
+      }
+      return;
+    }
+
+    THROW_EXCEPTION(UNKNOWN_VECTOR_TYPE,"Unknown vector type passed to TripletHelper::FillValues");
+  }
+
   void TripletHelper::FillRowCol_(Index n_entries, const ScaledMatrix& matrix, Index row_offset, Index col_offset, Index* iRow, Index* jCol)
   {
     FillRowCol(n_entries, *GetRawPtr(matrix.GetUnscaledMatrix()), iRow, jCol, row_offset, col_offset);
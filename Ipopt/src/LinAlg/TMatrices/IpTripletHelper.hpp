@@ -50,6 +50,14 @@ namespace Ipopt
     /** fill the values for the triplet format from the matrix */
     static void FillValues(Index n_entries, const Matrix& matrix, Number* values);
 
+    /** fill the values for the triplet format from the matrix
+     *  directly into another array, e.g., for a compressed format.
+     *  The value of the i-th triplet entry is stored in
+     *  values[dest[i]] if dest[i] is nonnegative, and it is added to
+     *  values[-dest[i]-1] otherwise.  No temporary array for the
+     *  triplet values is required for the usual leaf matrices. */
+    static void FillValues(Index n_entries, const Matrix& matrix, Number* values, const Index* dest);
+
     /** fill the values from the vector into a dense double* structure */
     static void FillValuesFromVector(Index dim, const Vector& vector, Number* values);
 
@@ -58,6 +66,20 @@ namespace Ipopt
     //@}
 
   private:
+    /** recursive part of the FillValues method with destination
+     *  positions; the values are multiplied by factor. */
+    static void FillValuesScattered_(Index n_entries, const Matrix& matrix, Number factor, Number* values, const Index* dest);
+
+    /** store factor*vals[i] at the destination position of entry i */
+    static void ScatterValues_(Index n_entries, const Number* vals, Number factor, Number* values, const Index* dest);
+
+    /** store the constant val at the destination positions */
+    static void ScatterConstant_(Index n_entries, Number val, Number* values, const Index* dest);
+
+    /** store factor times the elements of vector at the destination
+     *  positions */
+    static void ScatterValuesFromVector_(Index dim, const Vector& vector, Number factor, Number* values, const Index* dest);
+
     /** find the total number of triplet entries for the SumMatrix */
     static Index GetNumberEntries_(const SumMatrix& matrix);
 
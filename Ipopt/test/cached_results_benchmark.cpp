@@ -0,0 +1,170 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Microbenchmark for the lookups in CachedResults with the access
+// pattern of IpoptCalculatedQuantities: a quantity of the current
+// iterate is asked for several times per iteration, the first lookup
+// after a change of the iterate misses and adds the new result, and
+// the others find it.  The dependencies are one to three
+// TaggedObjects, or two TaggedObjects and a Number given in
+// std::vectors (as for the barrier objective).  This file is compiled
+// twice, once with the default implementation
+// (cached_results_benchmark) and once with -DIP_INLINE_CACHE
+// (cached_results_inline_benchmark), and reports the time per lookup.
+//
+// Usage: cached_results_benchmark [iterations] [lookups per iteration]
+
+#include "IpCachedResults.hpp"
+#include "IpUtils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Ipopt;
+
+/** TaggedObject that can be changed from outside */
+class ChangingObject: public TaggedObject
+{
+public:
+  ChangingObject()
+  {}
+
+  void Change()
+  {
+    ObjectChanged();
+  }
+};
+
+/** Type of the cached results.  A type of its own makes sure that
+ *  the CachedResults methods used here are not shared with the
+ *  instantiations in the library, which is compiled without
+ *  IP_INLINE_CACHE. */
+struct BenchmarkResult
+{
+  Number value;
+};
+
+/** Run niter iterations with nlookups lookups each in a cache of the
+ *  given size, with ndeps TaggedObject dependencies (1 to 3), or with
+ *  two TaggedObject and one Number dependency in std::vectors if
+ *  ndeps is 0.  Returns the wallclock time per lookup in ns; misses
+ *  is set to the number of lookups that did not find the result, and
+ *  wrong to the number of lookups that returned an outdated result. */
+static Number RunLookups(Index niter, Index nlookups, Int cache_size,
+                         Index ndeps, Index& misses, Index& wrong)
+{
+  CachedResults<BenchmarkResult> cache(cache_size);
+  ChangingObject x, s, y;
+  Number mu = 0.1;
+  BenchmarkResult result;
+  misses = 0;
+  wrong = 0;
+
+  Number time = WallclockTime();
+  for (Index iter=0; iter<niter; iter++) {
+    // new iterate
+    x.Change();
+    s.Change();
+    if (iter%4 == 0) {
+      y.Change();
+      mu *= 0.5;
+    }
+    for (Index k=0; k<nlookups; k++) {
+      switch (ndeps) {
+      case 1:
+        if (!cache.GetCachedResult1Dep(result, x)) {
+          misses++;
+          result.value = (Number)iter;
+          cache.AddCachedResult1Dep(result, x);
+        }
+        break;
+      case 2:
+        if (!cache.GetCachedResult2Dep(result, x, s)) {
+          misses++;
+          result.value = (Number)iter;
+          cache.AddCachedResult2Dep(result, x, s);
+        }
+        break;
+      case 3:
+        if (!cache.GetCachedResult3Dep(result, x, s, y)) {
+          misses++;
+          result.value = (Number)iter;
+          cache.AddCachedResult3Dep(result, x, s, y);
+        }
+        break;
+      default: {
+          std::vector<const TaggedObject*> tdeps(2);
+          tdeps[0] = &x;
+          tdeps[1] = &s;
+          std::vector<Number> sdeps(1);
+          sdeps[0] = mu;
+          if (!cache.GetCachedResult(result, tdeps, sdeps)) {
+            misses++;
+            result.value = (Number)iter;
+            cache.AddCachedResult(result, tdeps, sdeps);
+          }
+        }
+      }
+      if (result.value != (Number)iter) {
+        wrong++;
+      }
+    }
+  }
+  return 1e9*(WallclockTime() - time)/((Number)niter*nlookups);
+}
+
+int main(int argc, char** argv)
+{
+  Index niter = 200000;
+  Index nlookups = 8;
+  if (argc > 1) {
+    niter = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    nlookups = atoi(argv[2]);
+  }
+  if (niter < 1 || nlookups < 1) {
+    printf("Usage: %s [iterations >= 1] [lookups per iteration >= 1]\n",
+           argv[0]);
+    return 1;
+  }
+
+#ifdef IP_INLINE_CACHE
+  printf("CachedResults with IP_INLINE_CACHE, ");
+#else
+  printf("CachedResults with the default implementation, ");
+#endif
+  printf("%d iterations with %d lookups each\n", niter, nlookups);
+  printf("dependencies       cache size  [ns/lookup]\n");
+
+  bool ok = true;
+  const char* names[4] = {"2 + 1 Number", "1", "2", "3"};
+  const Int cache_sizes[2] = {1, 5};
+  for (Index ndeps=1; ndeps<=4; ndeps++) {
+    for (Index j=0; j<2; j++) {
+      Index misses, wrong;
+      const Number time = RunLookups(niter, nlookups, cache_sizes[j],
+                                     ndeps%4, misses, wrong);
+      printf("%-17s  %10d  %11.2f\n", names[ndeps%4], cache_sizes[j], time);
+      // Only the first lookup of each iteration may miss
+      if (misses != niter || wrong > 0) {
+        printf("%d misses instead of %d, %d outdated results.\n",
+               misses, niter, wrong);
+        ok = false;
+      }
+    }
+  }
+
+  if (!ok) {
+    printf("Benchmark FAILED!\n");
+    return 1;
+  }
+  printf("All lookups returned the expected results.\n");
+  return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Test for the semantics of CachedResults: a result is found again
+// for the same dependencies, it is not found after a dependency has
+// changed or for different scalar dependencies, and the oldest result
+// is evicted when the cache is full.  This file is compiled twice,
+// once with the default implementation (cached_results_test) and once
+// with -DIP_INLINE_CACHE (cached_results_inline_test).
+
+#include "IpCachedResults.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Ipopt;
+
+/** TaggedObject that can be changed from outside */
+class ChangingObject: public TaggedObject
+{
+public:
+  ChangingObject()
+  {}
+
+  void Change()
+  {
+    ObjectChanged();
+  }
+};
+
+/** Type of the cached results.  A type of its own makes sure that
+ *  the CachedResults methods used here are not shared with the
+ *  instantiations in the library, which is compiled without
+ *  IP_INLINE_CACHE. */
+struct TestResult
+{
+  Number value;
+};
+
+static TestResult MakeResult(Number value)
+{
+  TestResult result;
+  result.value = value;
+  return result;
+}
+
+static bool ok = true;
+
+/** Check that the result is found with the given value (or not
+ *  found, if expected is negative) */
+static void Check(const char* what, bool found, const TestResult& result,
+                  Number expected)
+{
+  if (expected < 0.) {
+    if (found) {
+      printf("%s: result %g found, but expected none\n", what, result.value);
+      ok = false;
+    }
+  }
+  else if (!found) {
+    printf("%s: no result found, expected %g\n", what, expected);
+    ok = false;
+  }
+  else if (result.value != expected) {
+    printf("%s: result %g found, expected %g\n", what, result.value, expected);
+    ok = false;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ChangingObject a, b, c;
+  TestResult result;
+
+  // Hit and miss after a change of a dependency
+  {
+    CachedResults<TestResult> cache(2);
+    Check("empty cache", cache.GetCachedResult1Dep(result, a), result, -1.);
+    cache.AddCachedResult1Dep(MakeResult(1.), a);
+    Check("one dependency", cache.GetCachedResult1Dep(result, a), result, 1.);
+    Check("other dependency", cache.GetCachedResult1Dep(result, b), result, -1.);
+    cache.AddCachedResult3Dep(MakeResult(3.), a, b, c);
+    Check("three dependencies", cache.GetCachedResult3Dep(result, a, b, c), result, 3.);
+    Check("other order", cache.GetCachedResult3Dep(result, a, c, b), result, -1.);
+    b.Change();
+    Check("changed dependency", cache.GetCachedResult3Dep(result, a, b, c), result, -1.);
+    Check("unchanged dependency", cache.GetCachedResult1Dep(result, a), result, 1.);
+    a.Change();
+    Check("changed single dependency", cache.GetCachedResult1Dep(result, a), result, -1.);
+  }
+
+  // Scalar dependencies and NULL dependencies
+  {
+    CachedResults<TestResult> cache(2);
+    std::vector<const TaggedObject*> tdeps(2);
+    tdeps[0] = &a;
+    tdeps[1] = &b;
+    std::vector<Number> sdeps(1, 0.5);
+    cache.AddCachedResult(MakeResult(4.), tdeps, sdeps);
+    Check("scalar dependency", cache.GetCachedResult(result, tdeps, sdeps), result, 4.);
+    sdeps[0] = 0.25;
+    Check("other scalar dependency", cache.GetCachedResult(result, tdeps, sdeps), result, -1.);
+    Check("no scalar dependency", cache.GetCachedResult(result, tdeps), result, -1.);
+    sdeps[0] = 0.5;
+    Check("two dependencies", cache.GetCachedResult2Dep(result, a, b), result, -1.);
+    cache.AddCachedResult2Dep(MakeResult(5.), &a, NULL);
+    Check("NULL dependency", cache.GetCachedResult2Dep(result, &a, NULL), result, 5.);
+    Check("instead of NULL", cache.GetCachedResult2Dep(result, &a, &b), result, -1.);
+    if (!cache.InvalidateResult(tdeps, sdeps)) {
+      printf("InvalidateResult: result not found\n");
+      ok = false;
+    }
+    Check("invalidated result", cache.GetCachedResult(result, tdeps, sdeps), result, -1.);
+    cache.Clear();
+    Check("cleared cache", cache.GetCachedResult2Dep(result, &a, NULL), result, -1.);
+  }
+
+  // Eviction of the oldest result at capacity
+  {
+    CachedResults<TestResult> cache(2);
+    cache.AddCachedResult1Dep(MakeResult(6.), a);
+    cache.AddCachedResult1Dep(MakeResult(7.), b);
+    cache.AddCachedResult1Dep(MakeResult(8.), c);
+    Check("evicted result", cache.GetCachedResult1Dep(result, a), result, -1.);
+    Check("second result", cache.GetCachedResult1Dep(result, b), result, 7.);
+    Check("newest result", cache.GetCachedResult1Dep(result, c), result, 8.);
+    cache.AddCachedResult1Dep(MakeResult(9.), c);
+    Check("replaced result", cache.GetCachedResult1Dep(result, c), result, 9.);
+  }
+
+  // A cache of size 0 keeps nothing
+  {
+    CachedResults<TestResult> cache(0);
+    cache.AddCachedResult1Dep(MakeResult(10.), a);
+    Check("cache of size 0", cache.GetCachedResult1Dep(result, a), result, -1.);
+  }
+
+  if (!ok) {
+    printf("CachedResults test FAILED!\n");
+    return 1;
+  }
+#ifdef IP_INLINE_CACHE
+  printf("All CachedResults tests passed (inline cache).\n");
+#else
+  printf("All CachedResults tests passed.\n");
+#endif
+  return 0;
+}
@@ -0,0 +1,294 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Test for the concurrent evaluation of the line search trial points
+// (option concurrent_trial_points).  The problem is hs071 from a
+// starting point for which the line search backtracks, and the TNLP
+// declares that its evaluation methods are thread-safe.  The problem
+// is solved with the serial line search and with concurrent trial
+// points, and the iterates (as reported by intermediate_callback) and
+// the solutions must be identical.
+
+#include "IpIpoptApplication.hpp"
+#include "IpSolveStatistics.hpp"
+#include "IpTNLP.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Ipopt;
+
+/** hs071 with thread-safe evaluation methods.  The iterates are
+ *  recorded in intermediate_callback. */
+class ThreadSafeHS071: public TNLP
+{
+public:
+  /** Values reported for one iteration */
+  struct IterInfo
+  {
+    Index iter;
+    Number obj_value;
+    Number inf_pr;
+    Number inf_du;
+    Number mu;
+    Number alpha_pr;
+    Index ls_trials;
+  };
+
+  ThreadSafeHS071()
+  {}
+
+  virtual ~ThreadSafeHS071()
+  {}
+
+  virtual bool get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
+                            Index& nnz_h_lag, IndexStyleEnum& index_style)
+  {
+    n = 4;
+    m = 2;
+    nnz_jac_g = 8;
+    nnz_h_lag = 10;
+    index_style = TNLP::C_STYLE;
+    return true;
+  }
+
+  virtual bool get_bounds_info(Index n, Number* x_l, Number* x_u,
+                               Index m, Number* g_l, Number* g_u)
+  {
+    for (Index i=0; i<4; i++) {
+      x_l[i] = 1.0;
+      x_u[i] = 5.0;
+    }
+    g_l[0] = 25;
+    g_u[0] = 2e19;
+    g_l[1] = g_u[1] = 40.0;
+    return true;
+  }
+
+  virtual bool get_starting_point(Index n, bool init_x, Number* x,
+                                  bool init_z, Number* z_L, Number* z_U,
+                                  Index m, bool init_lambda,
+                                  Number* lambda)
+  {
+    x[0] = 4.9;
+    x[1] = 1.1;
+    x[2] = 4.9;
+    x[3] = 1.1;
+    return true;
+  }
+
+  virtual bool eval_f(Index n, const Number* x, bool new_x, Number& obj_value)
+  {
+    obj_value = x[0] * x[3] * (x[0] + x[1] + x[2]) + x[2];
+    return true;
+  }
+
+  virtual bool eval_grad_f(Index n, const Number* x, bool new_x, Number* grad_f)
+  {
+    grad_f[0] = x[0] * x[3] + x[3] * (x[0] + x[1] + x[2]);
+    grad_f[1] = x[0] * x[3];
+    grad_f[2] = x[0] * x[3] + 1;
+    grad_f[3] = x[0] * (x[0] + x[1] + x[2]);
+    return true;
+  }
+
+  virtual bool eval_g(Index n, const Number* x, bool new_x, Index m, Number* g)
+  {
+    g[0] = x[0] * x[1] * x[2] * x[3];
+    g[1] = x[0]*x[0] + x[1]*x[1] + x[2]*x[2] + x[3]*x[3];
+    return true;
+  }
+
+  virtual bool eval_jac_g(Index n, const Number* x, bool new_x,
+                          Index m, Index nele_jac, Index* iRow, Index *jCol,
+                          Number* values)
+  {
+    if (values == NULL) {
+      for (Index k=0; k<8; k++) {
+        iRow[k] = k/4;
+        jCol[k] = k%4;
+      }
+    }
+    else {
+      values[0] = x[1]*x[2]*x[3];
+      values[1] = x[0]*x[2]*x[3];
+      values[2] = x[0]*x[1]*x[3];
+      values[3] = x[0]*x[1]*x[2];
+      values[4] = 2*x[0];
+      values[5] = 2*x[1];
+      values[6] = 2*x[2];
+      values[7] = 2*x[3];
+    }
+    return true;
+  }
+
+  virtual bool eval_h(Index n, const Number* x, bool new_x,
+                      Number obj_factor, Index m, const Number* lambda,
+                      bool new_lambda, Index nele_hess, Index* iRow,
+                      Index* jCol, Number* values)
+  {
+    if (values == NULL) {
+      Index idx=0;
+      for (Index row = 0; row < 4; row++) {
+        for (Index col = 0; col <= row; col++) {
+          iRow[idx] = row;
+          jCol[idx] = col;
+          idx++;
+        }
+      }
+    }
+    else {
+      values[0] = obj_factor * (2*x[3]) + lambda[1] * 2;
+      values[1] = obj_factor * (x[3]) + lambda[0] * (x[2] * x[3]);
+      values[2] = lambda[1] * 2;
+      values[3] = obj_factor * (x[3]) + lambda[0] * (x[1] * x[3]);
+      values[4] = lambda[0] * (x[0] * x[3]);
+      values[5] = lambda[1] * 2;
+      values[6] = obj_factor * (2*x[0] + x[1] + x[2]) + lambda[0] * (x[1] * x[2]);
+      values[7] = obj_factor * (x[0]) + lambda[0] * (x[0] * x[2]);
+      values[8] = obj_factor * (x[0]) + lambda[0] * (x[0] * x[1]);
+      values[9] = lambda[1] * 2;
+    }
+    return true;
+  }
+
+  virtual bool thread_safe_evaluation()
+  {
+    return true;
+  }
+
+  virtual bool intermediate_callback(AlgorithmMode mode,
+                                     Index iter, Number obj_value,
+                                     Number inf_pr, Number inf_du,
+                                     Number mu, Number d_norm,
+                                     Number regularization_size,
+                                     Number alpha_du, Number alpha_pr,
+                                     Index ls_trials,
+                                     const IpoptData* ip_data,
+                                     IpoptCalculatedQuantities* ip_cq)
+  {
+    IterInfo info;
+    info.iter = iter;
+    info.obj_value = obj_value;
+    info.inf_pr = inf_pr;
+    info.inf_du = inf_du;
+    info.mu = mu;
+    info.alpha_pr = alpha_pr;
+    info.ls_trials = ls_trials;
+    iterates_.push_back(info);
+    return true;
+  }
+
+  virtual void finalize_solution(SolverReturn status,
+                                 Index n, const Number* x, const Number* z_L, const Number* z_U,
+                                 Index m, const Number* g, const Number* lambda,
+                                 Number obj_value,
+                                 const IpoptData* ip_data,
+                                 IpoptCalculatedQuantities* ip_cq)
+  {
+    x_sol_.assign(x, x+n);
+  }
+
+  std::vector<IterInfo> iterates_;
+  std::vector<Number> x_sol_;
+
+private:
+  ThreadSafeHS071(const ThreadSafeHS071&);
+  ThreadSafeHS071& operator=(const ThreadSafeHS071&);
+};
+
+/** Solve the problem with the given number of concurrent trial
+ *  points.  Returns the number of objective function evaluations,
+ *  or -1 if the problem could not be solved. */
+static Index Solve(Index concurrent_trial_points, SmartPtr<ThreadSafeHS071> nlp)
+{
+  SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+  app->Options()->SetIntegerValue("print_level", 0);
+  app->Options()->SetIntegerValue("concurrent_trial_points",
+                                  concurrent_trial_points);
+  if (app->Initialize() != Solve_Succeeded) {
+    return -1;
+  }
+  ApplicationReturnStatus status = app->OptimizeTNLP(GetRawPtr(nlp));
+  if (status != Solve_Succeeded) {
+    printf("Solve with concurrent_trial_points = %d failed with status %d.\n",
+           concurrent_trial_points, status);
+    return -1;
+  }
+  Index num_obj_evals, num_constr_evals, num_obj_grad_evals;
+  Index num_constr_jac_evals, num_hess_evals;
+  app->Statistics()->NumberOfEvaluations(num_obj_evals, num_constr_evals,
+                                         num_obj_grad_evals,
+                                         num_constr_jac_evals,
+                                         num_hess_evals);
+  return num_obj_evals;
+}
+
+int main()
+{
+  SmartPtr<ThreadSafeHS071> serial = new ThreadSafeHS071();
+  SmartPtr<ThreadSafeHS071> concurrent = new ThreadSafeHS071();
+
+  const Index serial_evals = Solve(1, serial);
+  const Index concurrent_evals = Solve(4, concurrent);
+  if (serial_evals < 0 || concurrent_evals < 0) {
+    return 1;
+  }
+
+  bool ok = true;
+  bool backtracked = false;
+  if (serial->iterates_.size() != concurrent->iterates_.size()) {
+    printf("Number of iterations differs: %d (serial) vs %d (concurrent).\n",
+           (Index)serial->iterates_.size(), (Index)concurrent->iterates_.size());
+    ok = false;
+  }
+  for (Index k=0; ok && k<(Index)serial->iterates_.size(); k++) {
+    const ThreadSafeHS071::IterInfo& s = serial->iterates_[k];
+    const ThreadSafeHS071::IterInfo& c = concurrent->iterates_[k];
+    if (s.obj_value != c.obj_value || s.inf_pr != c.inf_pr ||
+        s.inf_du != c.inf_du || s.mu != c.mu ||
+        s.alpha_pr != c.alpha_pr || s.ls_trials != c.ls_trials) {
+      printf("Iterate %d differs:\n", s.iter);
+      printf("  serial:     f = %23.16e inf_pr = %9.2e alpha_pr = %9.2e ls = %d\n",
+             s.obj_value, s.inf_pr, s.alpha_pr, s.ls_trials);
+      printf("  concurrent: f = %23.16e inf_pr = %9.2e alpha_pr = %9.2e ls = %d\n",
+             c.obj_value, c.inf_pr, c.alpha_pr, c.ls_trials);
+      ok = false;
+    }
+    if (s.ls_trials > 1) {
+      backtracked = true;
+    }
+  }
+  for (Index i=0; ok && i<4; i++) {
+    if (serial->x_sol_[i] != concurrent->x_sol_[i]) {
+      printf("Solution component x[%d] differs: %23.16e vs %23.16e\n",
+             i, serial->x_sol_[i], concurrent->x_sol_[i]);
+      ok = false;
+    }
+  }
+
+  printf("%d iterations, %d (serial) and %d (concurrent) objective evaluations.\n",
+         (Index)serial->iterates_.size()-1, serial_evals, concurrent_evals);
+  // The test is only meaningful if the line search backtracked and
+  // the trial points were actually evaluated together
+  if (ok && !backtracked) {
+    printf("The line search did not backtrack.\n");
+    ok = false;
+  }
+  if (ok && concurrent_evals <= serial_evals) {
+    printf("The trial points have not been evaluated concurrently.\n");
+    ok = false;
+  }
+
+  if (!ok) {
+    printf("Concurrent line search test FAILED.\n");
+    return 1;
+  }
+  printf("Concurrent line search gives the same iterates.\n");
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Test that the sums of the elements of a large DenseVector (Sum and
+// SumLogs) are bitwise identical for one and for several threads
+// (option vector_num_threads).  The summation order of vectors with
+// at least vector_parallel_min_dim elements may only depend on the
+// dimension.
+
+#include "IpDenseVector.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace Ipopt;
+
+/** Compute Sum and SumLogs of the same values in a space with the
+ *  given number of threads */
+static void ComputeSums(Index dim, Index num_threads, Index min_dim,
+                        Number& sum, Number& sum_logs)
+{
+  SmartPtr<DenseVectorSpace> space = new DenseVectorSpace(dim);
+  space->SetParallelParameters(num_threads, min_dim);
+  SmartPtr<DenseVector> x = space->MakeNewDenseVector();
+  Number* values = x->Values();
+  // Values of very different magnitude, so that a different
+  // summation order changes the rounding
+  for (Index i=0; i<dim; i++) {
+    values[i] = (1. + 0.1*(i%7))*std::pow(10., (Number)(i%13 - 6));
+  }
+  sum = x->Sum();
+  sum_logs = x->SumLogs();
+}
+
+int main(int argc, char** argv)
+{
+  const Index dim = 100003;
+  const Index min_dim = 1000;
+
+  Number sum_1, sum_logs_1;
+  ComputeSums(dim, 1, min_dim, sum_1, sum_logs_1);
+
+  bool ok = true;
+  const Index threads[] = {2, 4};
+  for (Index k=0; k<2; k++) {
+    Number sum_n, sum_logs_n;
+    ComputeSums(dim, threads[k], min_dim, sum_n, sum_logs_n);
+    printf("threads = %d: Sum = %.17e (1 thread: %.17e)\n",
+           threads[k], sum_n, sum_1);
+    printf("threads = %d: SumLogs = %.17e (1 thread: %.17e)\n",
+           threads[k], sum_logs_n, sum_logs_1);
+    if (sum_n != sum_1 || sum_logs_n != sum_logs_1) {
+      printf("Results differ for %d threads.\n", threads[k]);
+      ok = false;
+    }
+  }
+
+  if (!ok) {
+    return 1;
+  }
+  printf("Sums of large vectors do not depend on the number of threads.\n");
+  return 0;
+}
@@ -0,0 +1,113 @@
+g3 1 1 0	# problem derivtest: hs071 with additional nonlinear terms
+ 4 3 1 0 1 0	# vars, constraints, objectives, ranges, eqns, lcons
+ 3 1	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 4 4 4	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 12 4	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 1 0 0 0 0	# common exprs: b,c,o,c1,o1
+V4 0 0	# t = x0*x3
+o2
+v0
+v3
+C0	# x0*x1*x2*x3 >= 25
+o2
+o2
+v0
+v1
+o2
+v2
+v3
+C1	# x0^2+x1^2+x2^2+x3^2 = 40
+o54
+4
+o5
+v0
+n2
+o5
+v1
+n2
+o5
+v2
+n2
+o5
+v3
+n2
+C2	# t/(1+x1^2) + x0*cos(x2) - sqrt(x3) <= 10
+o0
+o0
+o3
+v4
+o0
+n1
+o5
+v1
+n2
+o2
+v0
+o46
+v2
+o16
+o39
+v3
+O0 0	# t*(x0+x1+x2) + sin(x1)*exp(x3/5) + log(x0+x2) + x2
+o0
+o0
+o2
+v4
+o54
+3
+v0
+v1
+v2
+o2
+o41
+v1
+o44
+o3
+v3
+n5
+o43
+o0
+v0
+v2
+x4	# initial guess
+0 1
+1 5
+2 5
+3 1
+r	# constraint bounds
+2 25
+4 40
+1 10
+b	# variable bounds
+0 1 5
+0 1 5
+0 1 5
+0 1 5
+k3	# cumulative Jacobian column counts
+3
+6
+9
+J0 4
+0 0
+1 0
+2 0
+3 0
+J1 4
+0 0
+1 0
+2 0
+3 0
+J2 4
+0 0
+1 0
+2 0
+3 0
+G0 4
+0 0
+1 0
+2 1
+3 0
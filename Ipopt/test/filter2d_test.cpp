@@ -0,0 +1,115 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Unit test for Filter2D.  A pair (val1,val2) is acceptable to an
+// entry (e1,e2) if val1 <= e1 or val2 <= e2.  The test checks
+// insertions of dominated and non-dominated entries and pairs on the
+// boundary of the acceptable region, and compares Filter2D with the
+// general Filter(2) for random entries with many ties.
+
+#include "IpFilter.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Ipopt;
+
+static int nfailed = 0;
+
+static void Check(bool cond, const char* what)
+{
+  if (!cond) {
+    printf("FAILED: %s\n", what);
+    nfailed++;
+  }
+}
+
+int main()
+{
+  Filter2D filter;
+
+  // Empty filter
+  Check(filter.Acceptable(1e20, 1e20), "empty filter accepts everything");
+
+  // Non-dominated insertions forming a staircase
+  filter.AddEntry(1., 10., 1);
+  filter.AddEntry(10., 1., 2);
+  filter.AddEntry(5., 5., 3);
+
+  // Boundary of the acceptable region: equality in one coordinate
+  // is acceptable
+  Check(filter.Acceptable(1., 100.), "val1 == e1 is acceptable");
+  Check(filter.Acceptable(100., 1.), "val2 == e2 is acceptable");
+  Check(filter.Acceptable(5., 5.), "pair equal to an entry is acceptable");
+  Check(filter.Acceptable(5., 10.), "val1 == e1 of the middle entry");
+  Check(filter.Acceptable(7., 5.), "val2 == e2 of the middle entry");
+  Check(!filter.Acceptable(5.000001, 5.000001),
+        "pair slightly above an entry is rejected");
+  Check(!filter.Acceptable(1.000001, 10.000001),
+        "pair slightly above the first entry is rejected");
+  Check(!filter.Acceptable(10.000001, 5.),
+        "pair right of the last entry is rejected");
+  Check(filter.Acceptable(3., 7.), "pair below the staircase is acceptable");
+  Check(filter.Acceptable(0.5, 1e20), "pair left of all entries is acceptable");
+  Check(filter.Acceptable(1e20, 0.5), "pair below all entries is acceptable");
+
+  // Dominated insertions do not change the filter (an inserted
+  // (6,6) or (10,2) would break the order of the entries)
+  filter.AddEntry(6., 6., 4);
+  filter.AddEntry(5., 5., 5);
+  filter.AddEntry(10., 2., 6);
+  Check(!filter.Acceptable(7., 5.5),
+        "dominated entry (6,6) has not been inserted");
+  Check(!filter.Acceptable(11., 1.5),
+        "dominated entry (10,2) has not been inserted");
+
+  // A non-dominated insertion that dominates several entries
+  filter.AddEntry(2., 0.5, 7);
+  Check(!filter.Acceptable(3., 3.), "new entry (2,0.5) rejects (3,3)");
+  Check(!filter.Acceptable(11., 0.9), "new entry (2,0.5) rejects (11,0.9)");
+  Check(filter.Acceptable(2., 10.), "val1 == e1 of the new entry");
+  Check(filter.Acceptable(100., 0.5), "val2 == e2 of the new entry");
+  Check(!filter.Acceptable(1.5, 10.5), "entry (1,10) is still in the filter");
+  Check(filter.Acceptable(1.5, 10.), "val2 == e2 of the remaining entry (1,10)");
+
+  // An entry with the same first coordinate and a smaller second one
+  // replaces the existing entry
+  filter.AddEntry(1., 4., 8);
+  Check(!filter.Acceptable(1.5, 4.5), "entry (1,4) replaced (1,10)");
+  Check(filter.Acceptable(1., 1e20), "val1 == e1 of the replaced entry");
+
+  filter.Clear();
+  Check(filter.Acceptable(1e20, 1e20), "cleared filter accepts everything");
+
+  // Comparison with Filter(2) on random entries with many ties
+  srand(4711);
+  for (Index run=0; run<20; run++) {
+    Filter2D filter2d;
+    Filter reference(2);
+    for (Index k=0; k<200; k++) {
+      const Number val1 = (Number)(rand() % 50);
+      const Number val2 = (Number)(rand() % 50);
+      if (rand() % 2 == 0) {
+        filter2d.AddEntry(val1, val2, k);
+        reference.AddEntry(val1, val2, k);
+      }
+      else if (filter2d.Acceptable(val1, val2) !=
+               reference.Acceptable(val1, val2)) {
+        Check(false, "Filter2D agrees with Filter(2)");
+        break;
+      }
+    }
+  }
+
+  if (nfailed > 0) {
+    printf("%d Filter2D tests FAILED.\n", nfailed);
+    return 1;
+  }
+  printf("All Filter2D tests passed.\n");
+  return 0;
+}
@@ -0,0 +1,53 @@
+g3 1 1 0	# problem fixedvar: fixed variable x2 in nonlinear terms
+ 3 1 1 0 1 0	# vars, constraints, objectives, ranges, eqns, lcons
+ 1 1	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 3 3 3	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 3 3	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0	# x0*x2 + x1 = 1
+o2
+v0
+v2
+O0 0	# (x0-x2)^2 + x0*x1*x2 + 2*x1^2
+o54
+3
+o5
+o1
+v0
+v2
+n2
+o2
+o2
+v0
+v1
+v2
+o2
+n2
+o5
+v1
+n2
+x3	# initial guess
+0 2
+1 2
+2 3
+r	# constraint bounds
+4 1
+b	# variable bounds, x2 is fixed at 1
+3
+3
+4 1
+k2	# cumulative Jacobian column counts
+1
+2
+J0 3
+0 0
+1 1
+2 0
+G0 3
+0 0
+1 0
+2 0
@@ -0,0 +1,245 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Test for the Schur complement augmented system solver
+// (aug_system_solver=schur-complement) with a singular subdomain
+// block.  The meta data "subdomain" puts two variables into a
+// subdomain whose block of the Hessian is singular, while the
+// augmented system is not.  The solver must then fall back to the
+// full system solver and give the same iterates as the standard
+// augmented system solver, instead of reporting a singular system,
+// which would lead to a perturbation of the system.
+
+#include "IpIpoptApplication.hpp"
+#include "IpTNLP.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Ipopt;
+
+/** min (x0 - x1)^2 + (x2 - 2)^2 + (x3 - 3)^2
+ *  s.t. x0 + x2 = 1, x1 + x3 = 1
+ *
+ *  with x0 and x1 in subdomain 0 and the other variables in the
+ *  separator.  The Hessian block of subdomain 0 is singular. */
+class SingularSubdomainNLP: public TNLP
+{
+public:
+  SingularSubdomainNLP()
+  {}
+
+  virtual ~SingularSubdomainNLP()
+  {}
+
+  virtual bool get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
+                            Index& nnz_h_lag, IndexStyleEnum& index_style)
+  {
+    n = 4;
+    m = 2;
+    nnz_jac_g = 4;
+    nnz_h_lag = 5;
+    index_style = TNLP::C_STYLE;
+    return true;
+  }
+
+  virtual bool get_var_con_metadata(Index n,
+                                    StringMetaDataMapType& var_string_md,
+                                    IntegerMetaDataMapType& var_integer_md,
+                                    NumericMetaDataMapType& var_numeric_md,
+                                    Index m,
+                                    StringMetaDataMapType& con_string_md,
+                                    IntegerMetaDataMapType& con_integer_md,
+                                    NumericMetaDataMapType& con_numeric_md)
+  {
+    std::vector<Index> subdomain(n, -1);
+    subdomain[0] = 0;
+    subdomain[1] = 0;
+    var_integer_md["subdomain"] = subdomain;
+    return true;
+  }
+
+  virtual bool get_bounds_info(Index n, Number* x_l, Number* x_u,
+                               Index m, Number* g_l, Number* g_u)
+  {
+    for (Index i=0; i<n; i++) {
+      x_l[i] = -1e20;
+      x_u[i] = 1e20;
+    }
+    for (Index j=0; j<m; j++) {
+      g_l[j] = g_u[j] = 1.;
+    }
+    return true;
+  }
+
+  virtual bool get_starting_point(Index n, bool init_x, Number* x,
+                                  bool init_z, Number* z_L, Number* z_U,
+                                  Index m, bool init_lambda,
+                                  Number* lambda)
+  {
+    for (Index i=0; i<n; i++) {
+      x[i] = 0.;
+    }
+    return true;
+  }
+
+  virtual bool eval_f(Index n, const Number* x, bool new_x, Number& obj_value)
+  {
+    obj_value = (x[0] - x[1])*(x[0] - x[1]) + (x[2] - 2.)*(x[2] - 2.) +
+                (x[3] - 3.)*(x[3] - 3.);
+    return true;
+  }
+
+  virtual bool eval_grad_f(Index n, const Number* x, bool new_x, Number* grad_f)
+  {
+    grad_f[0] = 2.*(x[0] - x[1]);
+    grad_f[1] = -2.*(x[0] - x[1]);
+    grad_f[2] = 2.*(x[2] - 2.);
+    grad_f[3] = 2.*(x[3] - 3.);
+    return true;
+  }
+
+  virtual bool eval_g(Index n, const Number* x, bool new_x, Index m, Number* g)
+  {
+    g[0] = x[0] + x[2];
+    g[1] = x[1] + x[3];
+    return true;
+  }
+
+  virtual bool eval_jac_g(Index n, const Number* x, bool new_x,
+                          Index m, Index nele_jac, Index* iRow, Index *jCol,
+                          Number* values)
+  {
+    if (values == NULL) {
+      iRow[0] = 0;
+      jCol[0] = 0;
+      iRow[1] = 0;
+      jCol[1] = 2;
+      iRow[2] = 1;
+      jCol[2] = 1;
+      iRow[3] = 1;
+      jCol[3] = 3;
+    }
+    else {
+      for (Index k=0; k<4; k++) {
+        values[k] = 1.;
+      }
+    }
+    return true;
+  }
+
+  virtual bool eval_h(Index n, const Number* x, bool new_x,
+                      Number obj_factor, Index m, const Number* lambda,
+                      bool new_lambda, Index nele_hess, Index* iRow,
+                      Index* jCol, Number* values)
+  {
+    if (values == NULL) {
+      iRow[0] = 0;
+      jCol[0] = 0;
+      iRow[1] = 1;
+      jCol[1] = 0;
+      iRow[2] = 1;
+      jCol[2] = 1;
+      iRow[3] = 2;
+      jCol[3] = 2;
+      iRow[4] = 3;
+      jCol[4] = 3;
+    }
+    else {
+      values[0] = 2.*obj_factor;
+      values[1] = -2.*obj_factor;
+      values[2] = 2.*obj_factor;
+      values[3] = 2.*obj_factor;
+      values[4] = 2.*obj_factor;
+    }
+    return true;
+  }
+
+  virtual bool intermediate_callback(AlgorithmMode mode,
+                                     Index iter, Number obj_value,
+                                     Number inf_pr, Number inf_du,
+                                     Number mu, Number d_norm,
+                                     Number regularization_size,
+                                     Number alpha_du, Number alpha_pr,
+                                     Index ls_trials,
+                                     const IpoptData* ip_data,
+                                     IpoptCalculatedQuantities* ip_cq)
+  {
+    obj_values_.push_back(obj_value);
+    return true;
+  }
+
+  virtual void finalize_solution(SolverReturn status,
+                                 Index n, const Number* x, const Number* z_L, const Number* z_U,
+                                 Index m, const Number* g, const Number* lambda,
+                                 Number obj_value,
+                                 const IpoptData* ip_data,
+                                 IpoptCalculatedQuantities* ip_cq)
+  {
+    x_sol_.assign(x, x+n);
+  }
+
+  std::vector<Number> obj_values_;
+  std::vector<Number> x_sol_;
+
+private:
+  SingularSubdomainNLP(const SingularSubdomainNLP&);
+  SingularSubdomainNLP& operator=(const SingularSubdomainNLP&);
+};
+
+/** Solve the problem with the given augmented system solver. */
+static bool Solve(const std::string& aug_system_solver,
+                  SmartPtr<SingularSubdomainNLP> nlp)
+{
+  SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+  app->Options()->SetIntegerValue("print_level", 0);
+  app->Options()->SetStringValue("linear_solver", "native");
+  app->Options()->SetStringValue("aug_system_solver", aug_system_solver);
+  if (app->Initialize() != Solve_Succeeded) {
+    return false;
+  }
+  ApplicationReturnStatus status = app->OptimizeTNLP(GetRawPtr(nlp));
+  if (status != Solve_Succeeded) {
+    printf("Solve with aug_system_solver = %s failed with status %d.\n",
+           aug_system_solver.c_str(), status);
+    return false;
+  }
+  return true;
+}
+
+int main()
+{
+  SmartPtr<SingularSubdomainNLP> standard = new SingularSubdomainNLP();
+  SmartPtr<SingularSubdomainNLP> schur = new SingularSubdomainNLP();
+
+  if (!Solve("standard", standard) || !Solve("schur-complement", schur)) {
+    printf("Schur complement fallback test FAILED.\n");
+    return 1;
+  }
+
+  bool ok = (standard->obj_values_ == schur->obj_values_);
+  if (!ok) {
+    printf("The iterates differ: %d (standard) vs %d (schur-complement) iterations.\n",
+           (Index)standard->obj_values_.size()-1,
+           (Index)schur->obj_values_.size()-1);
+  }
+  for (Index i=0; ok && i<(Index)standard->x_sol_.size(); i++) {
+    if (standard->x_sol_[i] != schur->x_sol_[i]) {
+      printf("Solution component x[%d] differs: %23.16e vs %23.16e\n",
+             i, standard->x_sol_[i], schur->x_sol_[i]);
+      ok = false;
+    }
+  }
+
+  if (!ok) {
+    printf("Schur complement fallback test FAILED.\n");
+    return 1;
+  }
+  printf("Schur complement solver falls back to the full system.\n");
+  return 0;
+}
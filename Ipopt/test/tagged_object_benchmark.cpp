@@ -0,0 +1,125 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Microbenchmark for the tags of TaggedObjects.  Every thread changes
+// its own objects many times, as the vectors of IpoptApplications
+// running in different threads do.  The time is compared with a
+// single shared counter that is incremented atomically for every
+// change, and the test checks that no tag is given out twice.
+//
+// Usage: tagged_object_benchmark [changes per thread] [max. threads]
+
+#include "IpTaggedObject.hpp"
+#include "IpUtils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Ipopt;
+
+/** TaggedObject that can be changed from outside */
+class ChangingObject: public TaggedObject
+{
+public:
+  ChangingObject()
+  {}
+
+  void Change()
+  {
+    ObjectChanged();
+  }
+};
+
+/** Shared counter for the comparison */
+static volatile UInt64 shared_counter = 0;
+
+/** Change an object nchanges times in each of nthreads threads and
+ *  store the tags in tags.  If use_shared_counter is true, the shared
+ *  counter is incremented in addition for every change.  Returns the
+ *  wallclock time. */
+static Number RunChanges(Index nthreads, Index nchanges,
+                         bool use_shared_counter,
+                         std::vector<TaggedObject::Tag::second_type>& tags)
+{
+  tags.assign((size_t)nthreads*nchanges, 0);
+  Number time = WallclockTime();
+#ifdef _OPENMP
+  #pragma omp parallel num_threads(nthreads)
+#endif
+  {
+#ifdef _OPENMP
+    const Index t = omp_get_thread_num();
+#else
+    const Index t = 0;
+#endif
+    ChangingObject object;
+    TaggedObject::Tag::second_type* my_tags = &tags[(size_t)t*nchanges];
+    for (Index k=0; k<nchanges; k++) {
+      if (use_shared_counter) {
+        AtomicAdd(&shared_counter, 1);
+      }
+      object.Change();
+      my_tags[k] = object.GetTag().second;
+    }
+  }
+  return WallclockTime() - time;
+}
+
+int main(int argc, char** argv)
+{
+  Index nchanges = 2000000;
+  Index max_threads = 1;
+#ifdef _OPENMP
+  max_threads = omp_get_max_threads();
+#endif
+  if (argc > 1) {
+    nchanges = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    max_threads = atoi(argv[2]);
+  }
+  if (nchanges < 1 || max_threads < 1) {
+    printf("Usage: %s [changes per thread >= 1] [max. threads >= 1]\n",
+           argv[0]);
+    return 1;
+  }
+#ifndef _OPENMP
+  max_threads = 1;
+#endif
+
+  bool ok = true;
+  std::vector<TaggedObject::Tag::second_type> tags;
+  printf("%d changes per thread\n", nchanges);
+  printf("threads  tags [ns/change]  tags + shared counter [ns/change]\n");
+  for (Index nthreads=1; nthreads<=max_threads; nthreads*=2) {
+    const Number time_shared = RunChanges(nthreads, nchanges, true, tags);
+    const Number time_tags = RunChanges(nthreads, nchanges, false, tags);
+    printf("%7d  %17.2f  %34.2f\n", nthreads,
+           1e9*time_tags/nchanges, 1e9*time_shared/nchanges);
+
+    // All tags must be different
+    std::sort(tags.begin(), tags.end());
+    if (tags[0] == 0 || std::adjacent_find(tags.begin(), tags.end()) != tags.end()) {
+      printf("A tag has been given out twice with %d threads.\n", nthreads);
+      ok = false;
+    }
+  }
+
+  if (!ok) {
+    printf("Tag test FAILED!\n");
+    return 1;
+  }
+  printf("All tags are unique.\n");
+  return 0;
+}
@@ -0,0 +1,157 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// $Id$
+//
+// Authors:  Ipopt Project      2026-10-17
+
+// Microbenchmark for the conversion of a symmetric matrix from the
+// triplet format into the compressed sparse row format.  The matrix
+// has the structure of a KKT matrix of a 2D Laplacian with repeated
+// entries.  The result is compared with a straightforward reference
+// conversion, and the times per triplet entry for InitializeConverter
+// and ConvertValues are reported.  If Ipopt is compiled with OpenMP
+// support, the number of threads can be set with OMP_NUM_THREADS to
+// compare the parallel conversion with the serial one (matrices with
+// fewer than 100000 triplet entries are always converted by one
+// thread).
+//
+// Usage: triplet_to_csr_benchmark [grid size] [repetitions]
+
+#include "IpSmartPtr.hpp"
+#include "IpTripletToCSRConverter.hpp"
+#include "IpUtils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+using namespace Ipopt;
+
+/** Generate the triplet structure (counting from 1) of the lower
+ *  triangle of a KKT matrix of the 5-point Laplacian on an
+ *  m x m grid, where every diagonal element is listed twice. */
+static void GenerateStructure(Index m, std::vector<Index>& airn,
+                              std::vector<Index>& ajcn)
+{
+  const Index n = m*m;
+  for (Index i=0; i<m; i++) {
+    for (Index j=0; j<m; j++) {
+      const Index k = i*m + j + 1;
+      // Hessian block
+      airn.push_back(k);
+      ajcn.push_back(k);
+      // Constraint block (Laplacian stencil) in the rows n+1..2n
+      airn.push_back(n+k);
+      ajcn.push_back(k);
+      if (j>0) {
+        airn.push_back(n+k);
+        ajcn.push_back(k-1);
+      }
+      if (i>0) {
+        airn.push_back(n+k);
+        ajcn.push_back(k-m);
+      }
+      if (j<m-1) {
+        airn.push_back(k+1);
+        ajcn.push_back(n+k);
+      }
+      if (i<m-1) {
+        airn.push_back(k+m);
+        ajcn.push_back(n+k);
+      }
+      // Repeated diagonal element (e.g. from a regularization term)
+      airn.push_back(k);
+      ajcn.push_back(k);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Index m = 300;
+  Index nrep = 10;
+  if (argc > 1) {
+    m = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    nrep = atoi(argv[2]);
+  }
+  if (m < 2 || nrep < 1) {
+    printf("Usage: %s [grid size >= 2] [repetitions >= 1]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<Index> airn;
+  std::vector<Index> ajcn;
+  GenerateStructure(m, airn, ajcn);
+  const Index dim = 2*m*m;
+  const Index nonzeros = (Index)airn.size();
+  std::vector<Number> a_triplet(nonzeros);
+  for (Index i=0; i<nonzeros; i++) {
+    a_triplet[i] = 1. + (i%7)*0.25;
+  }
+
+  // Reference conversion
+  std::map<std::pair<Index,Index>, Number> ref;
+  for (Index i=0; i<nonzeros; i++) {
+    std::pair<Index,Index> key(Min(airn[i], ajcn[i]), Max(airn[i], ajcn[i]));
+    ref[key] += a_triplet[i];
+  }
+
+  SmartPtr<TripletToCSRConverter> converter = new TripletToCSRConverter(1);
+  Index nonzeros_compressed = 0;
+  Number time_init = WallclockTime();
+  for (Index r=0; r<nrep; r++) {
+    nonzeros_compressed =
+      converter->InitializeConverter(dim, nonzeros, &airn[0], &ajcn[0]);
+  }
+  time_init = (WallclockTime() - time_init)/nrep;
+
+  std::vector<Number> a_compressed(nonzeros_compressed);
+  Number time_values = WallclockTime();
+  for (Index r=0; r<nrep; r++) {
+    converter->ConvertValues(nonzeros, &a_triplet[0], nonzeros_compressed,
+                             &a_compressed[0]);
+  }
+  time_values = (WallclockTime() - time_values)/nrep;
+
+  // Compare the result with the reference conversion
+  bool ok = (nonzeros_compressed == (Index)ref.size());
+  const Index* ia = converter->IA();
+  const Index* ja = converter->JA();
+  std::map<std::pair<Index,Index>, Number>::const_iterator it = ref.begin();
+  for (Index i=0; ok && i<dim; i++) {
+    for (Index k=ia[i]-1; k<ia[i+1]-1; k++, it++) {
+      if (it == ref.end() || it->first.first != i+1 ||
+          it->first.second != ja[k] || a_compressed[k] != it->second) {
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  Index nthreads = 1;
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+  printf("Dimension %d, %d triplet entries, %d compressed entries, %d threads\n",
+         dim, nonzeros, nonzeros_compressed, nthreads);
+  printf("InitializeConverter: %10.3f ns/nonzero (%10.6f s)\n",
+         1e9*time_init/nonzeros, time_init);
+  printf("ConvertValues:       %10.3f ns/nonzero (%10.6f s)\n",
+         1e9*time_values/nonzeros, time_values);
+  if (!ok) {
+    printf("Conversion FAILED!\n");
+    return 1;
+  }
+  printf("Conversion correct.\n");
+  return 0;
+}